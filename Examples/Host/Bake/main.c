@@ -0,0 +1,218 @@
+// Bakes a scene described in a text file into an sdf2d_asset.h file, offline, so the game maps the
+// grids instead of baking them at boot. See collisions.txt for the scene format.
+//
+// usage: sdf2d_bake scene.txt out.sdfa [--area x y w h] [--cell c] [--range r]
+//                   [--format int8|uint16|float] [--dense] [--levels n] [--gradient]
+
+#define _POSIX_C_SOURCE 200809L // strdup
+
+#include "sdf2d_asset.h"
+#include "sdf2d_scene.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BAKE_MAX_NODES 1024
+#define BAKE_MAX_ARGS 512
+
+typedef struct {
+	SDScene scene;
+	char *names[BAKE_MAX_NODES];
+	int ids[BAKE_MAX_NODES];
+	int count;
+	float *vertices[BAKE_MAX_NODES];   // sdPolygon arrays, kept for the scene's lifetime
+	int numVertices;
+	int root;
+} Bake;
+
+static int bakeFind(const Bake *b, const char *name)
+{
+	for (int i = b->count - 1; i >= 0; i--)
+		if (!strcmp(b->names[i], name)) return b->ids[i];
+	return -1;
+}
+
+static int bakeShape(Bake *b, const char *type, char **args, int argc)
+{
+	SDShape shape = { kSDShapeCount };
+	for (int t = 0; t < kSDShapeCount; t++)
+		if (!strcmp(sdShapeTypeName(t), type)) shape.type = t;
+	if (shape.type == kSDShapeCount) return -1;
+
+	if (shape.type == kSDPolygon) {
+		int n = argc / 2;
+		if (n < 3 || argc % 2 || b->numVertices == BAKE_MAX_NODES) return -1;
+		float *v = malloc(2 * n * sizeof(float));
+		if (!v) return -1;
+		for (int i = 0; i < n; i++) {
+			v[i] = strtof(args[2 * i], NULL);
+			v[n + i] = strtof(args[2 * i + 1], NULL);
+		}
+		b->vertices[b->numVertices++] = v;
+		shape.n = n;
+		shape.vx = v;
+		shape.vy = v + n;
+	} else {
+		if (argc > 8) return -1;
+		for (int i = 0; i < argc; i++) shape.p[i] = strtof(args[i], NULL);
+		// sdRegularPolygon(r, n): the side count is an int
+		if (shape.type == kSDRegularPolygon) shape.n = (int)shape.p[1];
+	}
+	return sdSceneAddShape(&b->scene, &shape);
+}
+
+static int bakeOp(Bake *b, const char *op, char **args, int argc)
+{
+	static const struct { const char *name; SDNodeOp op; int nodes; } ops[] = {
+		{ "union", kSDUnion, 2 }, { "intersect", kSDIntersect, 2 }, { "subtract", kSDSubtract, 2 },
+		{ "smoothUnion", kSDSmoothUnion, 2 }, { "onion", kSDOnion, 1 }, { "round", kSDRound, 1 },
+	};
+	if (!strcmp(op, "unionAll")) {
+		int ids[BAKE_MAX_ARGS];
+		for (int i = 0; i < argc; i++)
+			if ((ids[i] = bakeFind(b, args[i])) < 0) return -1;
+		return sdSceneAddUnionAll(&b->scene, ids, argc);
+	}
+	for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+		if (strcmp(op, ops[i].name)) continue;
+		int k = ops[i].op == kSDUnion || ops[i].op == kSDIntersect || ops[i].op == kSDSubtract ? 0 : 1;
+		if (argc != ops[i].nodes + k) return -1;
+		int a = bakeFind(b, args[0]);
+		int c = ops[i].nodes == 2 ? bakeFind(b, args[1]) : -1;
+		if (a < 0 || (ops[i].nodes == 2 && c < 0)) return -1;
+		return sdSceneAddOp(&b->scene, ops[i].op, a, c, k ? strtof(args[argc - 1], NULL) : 0.0f);
+	}
+	return -1;
+}
+
+// name = shape-or-op args... [@ x y [angle]]
+static int bakeLine(Bake *b, char *line)
+{
+	char *args[BAKE_MAX_ARGS];
+	int argc = 0;
+	for (char *t = strtok(line, " \t\r\n"); t && argc < BAKE_MAX_ARGS; t = strtok(NULL, " \t\r\n")) {
+		if (t[0] == '#') break;
+		args[argc++] = t;
+	}
+	if (argc == 0) return 0;
+	if (argc < 3 || strcmp(args[1], "=") || b->count == BAKE_MAX_NODES) return -1;
+
+	int at = argc;
+	for (int i = 3; i < argc; i++)
+		if (!strcmp(args[i], "@")) at = i;
+	int id = !strncmp(args[2], "sd", 2) ? bakeShape(b, args[2], args + 3, at - 3) : bakeOp(b, args[2], args + 3, at - 3);
+	if (id < 0) return -1;
+	if (at < argc) {
+		if (argc - at - 1 < 2 || argc - at - 1 > 3) return -1;
+		float angle = argc - at - 1 == 3 ? strtof(args[at + 3], NULL) : 0.0f;
+		sdSceneSetTransform(&b->scene, id, strtof(args[at + 1], NULL), strtof(args[at + 2], NULL), angle);
+	}
+	b->names[b->count] = strdup(args[0]);
+	b->ids[b->count++] = id;
+	b->root = id;
+	return 0;
+}
+
+static void bakeFree(Bake *b)
+{
+	for (int i = 0; i < b->count; i++) free(b->names[i]);
+	for (int i = 0; i < b->numVertices; i++) free(b->vertices[i]);
+	sdSceneFree(&b->scene);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s scene.txt out.sdfa [--area x y w h] [--cell c] [--range r]\n"
+			"       [--format int8|uint16|float] [--dense] [--levels n] [--gradient]\n", argv[0]);
+		return 1;
+	}
+	float area[4] = { 0.0f, 0.0f, 400.0f, 240.0f };
+	SDAssetOptions options = { { kSDGridInt8, 0, 0, 0, 0, 2.0f, 16.0f, 1 }, 1, 0 };
+	for (int i = 3; i < argc; i++) {
+		const char *a = argv[i];
+		int more = argc - i - 1;
+		if (!strcmp(a, "--area") && more >= 4) {
+			for (int j = 0; j < 4; j++) area[j] = strtof(argv[++i], NULL);
+		} else if (!strcmp(a, "--cell") && more >= 1) {
+			options.layout.cell = strtof(argv[++i], NULL);
+		} else if (!strcmp(a, "--range") && more >= 1) {
+			options.layout.range = strtof(argv[++i], NULL);
+		} else if (!strcmp(a, "--format") && more >= 1) {
+			const char *f = argv[++i];
+			options.layout.format = !strcmp(f, "float") ? kSDGridFloat : !strcmp(f, "uint16") ? kSDGridUInt16 : kSDGridInt8;
+		} else if (!strcmp(a, "--dense")) {
+			options.layout.narrow = 0;
+		} else if (!strcmp(a, "--levels") && more >= 1) {
+			options.levels = atoi(argv[++i]);
+		} else if (!strcmp(a, "--gradient")) {
+			options.gradient = 1;
+		} else {
+			fprintf(stderr, "%s: unknown option %s\n", argv[0], a);
+			return 1;
+		}
+	}
+	if (!(options.layout.cell > 0.0f)) {
+		fprintf(stderr, "%s: bad cell size\n", argv[0]);
+		return 1;
+	}
+	options.layout.x = area[0];
+	options.layout.y = area[1];
+	options.layout.width = (int)ceilf(area[2] / options.layout.cell) + 1;
+	options.layout.height = (int)ceilf(area[3] / options.layout.cell) + 1;
+
+	FILE *in = fopen(argv[1], "r");
+	if (!in) {
+		perror(argv[1]);
+		return 1;
+	}
+	Bake *b = calloc(1, sizeof(Bake));
+	sdSceneInit(&b->scene);
+	b->root = -1;
+	char line[4096];
+	int lineNumber = 0, status = 0;
+	while (fgets(line, sizeof(line), in)) {
+		lineNumber++;
+		if (bakeLine(b, line)) {
+			fprintf(stderr, "%s:%d: bad node\n", argv[1], lineNumber);
+			status = 1;
+			break;
+		}
+	}
+	fclose(in);
+	if (!status && (b->root < 0 || sdSceneCompile(&b->scene, b->root))) {
+		fprintf(stderr, "%s: no root, or the scene is too deep to compile\n", argv[1]);
+		status = 1;
+	}
+
+	void *blob = NULL;
+	size_t size = 0;
+	if (!status && sdAssetBake(&b->scene, &options, &blob, &size)) {
+		fprintf(stderr, "%s: bake failed\n", argv[0]);
+		status = 1;
+	}
+	if (!status) {
+		FILE *out = fopen(argv[2], "wb");
+		if (!out || fwrite(blob, 1, size, out) != size) {
+			perror(argv[2]);
+			status = 1;
+		}
+		if (out && fclose(out)) status = 1;
+	}
+	if (!status) {
+		const SDAssetHeader *h = blob;
+		printf("%s: %d nodes, bounds (%g, %g) - (%g, %g), %zu bytes\n", argv[2], (int)h->nodes,
+			h->bounds[0], h->bounds[1], h->bounds[2], h->bounds[3], size);
+		for (int k = 0; k < (int)h->levels; k++) {
+			const SDAssetLevel *l = &h->level[k];
+			printf("  level %d: %d x %d every %g, %u bytes%s\n", k, (int)l->width, (int)l->height, l->cell,
+				(unsigned)l->dataBytes, l->gradientOffset ? " + gradient" : "");
+		}
+	}
+	free(blob);
+	bakeFree(b);
+	free(b);
+	return status;
+}
@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+
+#include "bench.h"
+
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+const char *benchDistNames[kBenchDistCount] = { "grid", "random", "inside", "outside", "surface" };
+
+double benchNow(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned int benchSeed = 0x2545F491u;
+
+unsigned int benchRandom(void)
+{
+	benchSeed ^= benchSeed << 13;
+	benchSeed ^= benchSeed >> 17;
+	benchSeed ^= benchSeed << 5;
+	return benchSeed;
+}
+
+float benchUniform(float lo, float hi)
+{
+	return lo + (hi - lo) * (benchRandom() >> 8) * (1.0f / 16777216.0f);
+}
+
+int benchSelected(const BenchContext *ctx, const char *name)
+{
+	return ctx->filter == NULL || strstr(name, ctx->filter) != NULL;
+}
+
+static int benchAccept(BenchDist dist, float d, int i)
+{
+	switch (dist) {
+	case kBenchInside: return (i % 10 == 0) ? d > 0.0f : d <= 0.0f;
+	case kBenchOutside: return (i % 10 == 0) ? d <= 0.0f : d > 0.0f;
+	case kBenchSurface: return d > -2.0f && d < 2.0f;
+	default: return 1;
+	}
+}
+
+void benchPoints(BenchDist dist, BenchEvalFunc f, float *px, float *py, int n)
+{
+	for (int i = 0; i < n; i++) {
+		if (dist == kBenchGrid) {
+			int cell = i % (400 * 240);
+			px[i] = (float)(cell % 400);
+			py[i] = (float)(cell / 400);
+			continue;
+		}
+		float x = 0.0f, y = 0.0f;
+		for (int tries = 0; tries < 10000; tries++) {
+			x = benchUniform(0.0f, 400.0f);
+			y = benchUniform(0.0f, 240.0f);
+			if (benchAccept(dist, f(x, y), i)) break;
+		}
+		px[i] = x;
+		py[i] = y;
+	}
+}
+
+void benchReport(BenchContext *ctx, const char *suite, const char *name, const char *variant, double ns)
+{
+	double perFrame = BENCH_FRAME_NS / ns;
+	fprintf(ctx->log, "%-12s %-26s %-12s %9.2f ns/call %10.0f /frame\n", suite, name, variant, ns, perFrame);
+	if (ctx->json) {
+		fprintf(ctx->json, "%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"variant\": \"%s\", \"ns_per_call\": %.4f, \"calls_per_frame\": %.1f}",
+			ctx->jsonCount ? "," : "", suite, name, variant, ns, perFrame);
+		ctx->jsonCount++;
+	}
+}
+
+void benchReportValue(BenchContext *ctx, const char *suite, const char *name, const char *variant, const char *unit, double value)
+{
+	fprintf(ctx->log, "%-12s %-26s %-12s %9.4g %s\n", suite, name, variant, value, unit);
+	if (ctx->json) {
+		fprintf(ctx->json, "%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"variant\": \"%s\", \"value\": %.6g, \"unit\": \"%s\"}",
+			ctx->jsonCount ? "," : "", suite, name, variant, value, unit);
+		ctx->jsonCount++;
+	}
+}
+
+void benchFail(BenchContext *ctx, const char *fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+	ctx->failures++;
+}
+
+double benchTime(const BenchContext *ctx, void (*fn)(void *arg), void *arg)
+{
+	double best = 1e30;
+	double start = benchNow();
+	int runs = 0;
+	fn(arg); // warm up
+	do {
+		double t0 = benchNow();
+		fn(arg);
+		double t = benchNow() - t0;
+		if (t < best) best = t;
+		runs++;
+	} while (runs < 3 || benchNow() - start < ctx->minTime);
+	return best;
+}
@@ -0,0 +1,81 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Host-side benchmark harness shared by the suites in this folder.
+
+#include <stdio.h>
+
+#define BENCH_FRAME_NS 20000000.0 // one 1/50th second Playdate frame
+
+// Point distributions used to stress branch prediction inside the SDFs.
+typedef enum {
+	kBenchGrid,        // the 400x240 screen scan used by the Playdate C benchmark
+	kBenchRandom,      // uniform random over the screen
+	kBenchInside,      // 90% of points inside the shape
+	kBenchOutside,     // 90% of points outside the shape
+	kBenchSurface,     // points within 2 px of the surface
+	kBenchDistCount
+} BenchDist;
+
+typedef struct {
+	const char *filter;   // only run cases whose name contains this
+	int points;           // points per distribution
+	double minTime;       // seconds per measurement
+	int quick;
+	FILE *log;            // human readable table
+	FILE *json;           // machine readable results, or NULL
+	int jsonCount;
+	int failures;         // failed checks: main exits with 1 if any
+} BenchContext;
+
+typedef float (*BenchEvalFunc)(float x, float y);
+
+extern const char *benchDistNames[kBenchDistCount];
+
+double benchNow(void);
+unsigned int benchRandom(void);
+float benchUniform(float lo, float hi);
+int benchSelected(const BenchContext *ctx, const char *name);
+
+// Fills px/py with n points drawn from dist, classified with f. Shapes with no interior (eg segments)
+// fall back to random points for the part of the distribution they cannot satisfy.
+void benchPoints(BenchDist dist, BenchEvalFunc f, float *px, float *py, int n);
+
+// Reports one measurement: ns per call, calls per 20 ms frame, and a JSON record when enabled.
+void benchReport(BenchContext *ctx, const char *suite, const char *name, const char *variant, double ns);
+
+// Reports a measurement that is not a timing, eg an error bound or a cost ratio.
+void benchReportValue(BenchContext *ctx, const char *suite, const char *name, const char *variant, const char *unit, double value);
+
+// Reports a failed correctness check (printf style, to stderr) and counts it in ctx->failures.
+void benchFail(BenchContext *ctx, const char *fmt, ...);
+
+// Times fn(arg) repeatedly for at least ctx->minTime and returns the best seconds per run.
+double benchTime(const BenchContext *ctx, void (*fn)(void *arg), void *arg);
+
+// Suites
+void benchPrimitives(BenchContext *ctx);
+void benchBatch(BenchContext *ctx);
+void benchScene(BenchContext *ctx);
+void benchBroadphase(BenchContext *ctx);
+void benchGradient(BenchContext *ctx);
+void benchGrid(BenchContext *ctx);
+void benchFixed(BenchContext *ctx);
+void benchPrepared(BenchContext *ctx);
+void benchRay(BenchContext *ctx);
+void benchRaster(BenchContext *ctx);
+void benchTiles(BenchContext *ctx);
+void benchFast(BenchContext *ctx);
+void benchSweep(BenchContext *ctx);
+void benchWorld(BenchContext *ctx);
+void benchRender(BenchContext *ctx);
+void benchDirty(BenchContext *ctx);
+void benchEdt(BenchContext *ctx);
+void benchPolygon(BenchContext *ctx);
+void benchTrack(BenchContext *ctx);
+void benchProfile(BenchContext *ctx);
+void benchExpr(BenchContext *ctx);
+void benchAsset(BenchContext *ctx);
+void benchContour(BenchContext *ctx);
+
+#endif
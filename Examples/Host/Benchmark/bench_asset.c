@@ -0,0 +1,211 @@
+// Baked asset benchmark: a 40-shape level baked into an sdf2d_asset.h file (int8 narrow band, 1 px
+// cells, three levels and the gradient channel) and loaded four ways. Reports the time to rebake the
+// grids at boot, to view a blob already in memory, to map the file, and to read it into memory as
+// a copying loader would; each but the view also does the first query, so page faults and cold
+// caches count. Also reports the file size. Checks that the loaded grids are the bytes a fresh bake
+// gives, that the rebuilt scene matches, that the stored gradient follows the scene and that
+// damaged files are refused.
+
+#define _POSIX_C_SOURCE 200809L // mkstemp
+
+#include "bench.h"
+#include "sdf2d_asset.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ASSET_SHAPES 40
+#define ASSET_LEVELS 3
+
+typedef struct {
+	SDScene scene;
+	SDAssetOptions options;
+	void *blob;
+	size_t size;
+	char path[64];
+	float sink;
+} AssetRun;
+
+static void buildLevel(SDScene *scene)
+{
+	static const SDShapeType types[] = { kSDCircle, kSDBox, kSDRoundedX, kSDHexagon, kSDSegment, kSDEllipse };
+	int ids[ASSET_SHAPES];
+	sdSceneInit(scene);
+	for (int i = 0; i < ASSET_SHAPES; i++) {
+		SDShape s = { types[i % 6], { benchUniform(5, 30), benchUniform(5, 30) } };
+		if (s.type == kSDSegment) {
+			float l = s.p[0];
+			s.p[0] = -l; s.p[1] = 0.0f; s.p[2] = l; s.p[3] = 0.0f;
+		}
+		ids[i] = sdSceneAddShape(scene, &s);
+		sdSceneSetTransform(scene, ids[i], benchUniform(0, 400), benchUniform(0, 240), benchUniform(0, 3.14159f));
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, ASSET_SHAPES));
+}
+
+static void runRebake(void *arg)
+{
+	AssetRun *r = arg;
+	SDGrid grids[ASSET_LEVELS];
+	for (int k = 0; k < ASSET_LEVELS; k++) {
+		SDGridLayout l = r->options.layout;
+		l.cell *= (float)(1 << k);
+		l.width = (l.width - 1 + (1 << k) - 1) / (1 << k) + 1;
+		l.height = (l.height - 1 + (1 << k) - 1) / (1 << k) + 1;
+		sdGridInit(&grids[k]);
+		sdGridBakeScene(&grids[k], &l, &r->scene);
+	}
+	r->sink = sdGridEval(&grids[0], 200.0f, 120.0f);
+	for (int k = 0; k < ASSET_LEVELS; k++) sdGridFree(&grids[k]);
+}
+
+static void runOpen(void *arg)
+{
+	AssetRun *r = arg;
+	SDAsset asset;
+	sdAssetOpen(&asset, r->blob, r->size);
+	r->sink = (float)asset.levels;
+	sdAssetClose(&asset);
+}
+
+static void runMap(void *arg)
+{
+	AssetRun *r = arg;
+	SDAsset asset;
+	if (sdAssetMap(&asset, r->path)) return;
+	r->sink = sdGridEval(&asset.grids[0], 200.0f, 120.0f);
+	sdAssetClose(&asset);
+}
+
+static void runRead(void *arg)
+{
+	AssetRun *r = arg;
+	FILE *f = fopen(r->path, "rb");
+	if (!f) return;
+	void *data = malloc(r->size);
+	SDAsset asset;
+	if (data && fread(data, 1, r->size, f) == r->size && !sdAssetOpen(&asset, data, r->size)) {
+		r->sink = sdGridEval(&asset.grids[0], 200.0f, 120.0f);
+		sdAssetClose(&asset);
+	}
+	free(data);
+	fclose(f);
+}
+
+// The loaded asset against a fresh bake and the scene
+static void checkAsset(BenchContext *ctx, AssetRun *r, const SDAsset *asset)
+{
+	for (int k = 0; k < ASSET_LEVELS; k++) {
+		SDGridLayout l = r->options.layout;
+		l.cell *= (float)(1 << k);
+		l.width = (l.width - 1 + (1 << k) - 1) / (1 << k) + 1;
+		l.height = (l.height - 1 + (1 << k) - 1) / (1 << k) + 1;
+		SDGrid grid;
+		sdGridInit(&grid);
+		sdGridBakeScene(&grid, &l, &r->scene);
+		const SDGrid *a = &asset->grids[k];
+		int same = a->bytes == grid.bytes && !memcmp(a->data, grid.data, grid.bytes) && a->tilesX == grid.tilesX &&
+			a->tilesY == grid.tilesY && !memcmp(a->tiles, grid.tiles, grid.tilesX * grid.tilesY * sizeof(int));
+		if (!same) benchFail(ctx, "asset: level %d differs from a fresh bake\n", k);
+		sdGridFree(&grid);
+	}
+
+	SDScene scene;
+	if (sdAssetScene(asset, &scene)) {
+		benchFail(ctx, "asset: scene rebuild failed\n");
+		return;
+	}
+	int wrong = 0, near = 0;
+	float dot = 0.0f;
+	for (int i = 0; i < 4096; i++) {
+		float x = benchUniform(0, 400), y = benchUniform(0, 240);
+		float d = sdSceneEval(&r->scene, x, y);
+		if (sdSceneEval(&scene, x, y) != d) wrong++;
+		if (fabsf(d) > 4.0f || fabsf(d) < 1.0f) continue;
+		// away from the surface and kinks, the stored gradient is the scene's
+		float gx, gy, e = 0.01f;
+		sdAssetGradient(asset, 0, x, y, &gx, &gy);
+		float sx = sdSceneEval(&r->scene, x + e, y) - sdSceneEval(&r->scene, x - e, y);
+		float sy = sdSceneEval(&r->scene, x, y + e) - sdSceneEval(&r->scene, x, y - e);
+		float len = sqrtf(sx * sx + sy * sy);
+		if (len > 0.0f) {
+			dot += (gx * sx + gy * sy) / len;
+			near++;
+		}
+	}
+	if (wrong) benchFail(ctx, "asset: rebuilt scene differs at %d points\n", wrong);
+	if (near && dot / near < 0.95f) benchFail(ctx, "asset: stored gradient off the scene's, mean cos %g\n", dot / near);
+	sdSceneFree(&scene);
+}
+
+// Damaged files must be refused, not read out of bounds
+static void checkDamage(BenchContext *ctx, AssetRun *r)
+{
+	unsigned char *copy = malloc(r->size);
+	SDAsset asset;
+	memcpy(copy, r->blob, r->size);
+	SDAssetHeader *h = (SDAssetHeader *)copy;
+	h->version++;
+	if (!sdAssetOpen(&asset, copy, r->size)) benchFail(ctx, "asset: wrong version accepted\n");
+	h->version--;
+	if (!sdAssetOpen(&asset, copy, r->size / 2)) benchFail(ctx, "asset: truncated file accepted\n");
+	h->level[0].dataOffset = h->bytes - 4;
+	if (!sdAssetOpen(&asset, copy, r->size)) benchFail(ctx, "asset: section past the end accepted\n");
+	memcpy(copy, r->blob, r->size);
+	if (h->level[0].tileOffset) {
+		((int32_t *)(copy + h->level[0].tileOffset))[0] = 1 << 30;
+		if (!sdAssetOpen(&asset, copy, r->size)) benchFail(ctx, "asset: tile past the data accepted\n");
+	}
+	free(copy);
+}
+
+void benchAsset(BenchContext *ctx)
+{
+	if (!benchSelected(ctx, "asset")) return;
+	AssetRun *r = calloc(1, sizeof(AssetRun));
+	volatile float sink = 0.0f;
+	buildLevel(&r->scene);
+	SDAssetOptions options = { { kSDGridInt8, 0, 0, 401, 241, 1.0f, 16.0f, 1 }, ASSET_LEVELS, 1 };
+	r->options = options;
+	strcpy(r->path, "/tmp/sdf2d_assetXXXXXX");
+	int fd = mkstemp(r->path);
+	FILE *f = fd >= 0 ? fdopen(fd, "wb") : NULL;
+	if (sdAssetBake(&r->scene, &r->options, &r->blob, &r->size) || !f ||
+		fwrite(r->blob, 1, r->size, f) != r->size || fclose(f)) {
+		benchFail(ctx, "asset: bake or write failed\n");
+		sdSceneFree(&r->scene);
+		free(r->blob);
+		free(r);
+		return;
+	}
+
+	double t = benchTime(ctx, runRebake, r);
+	sink += r->sink;
+	benchReportValue(ctx, "asset", "level", "rebake + first query", "ms", t * 1e3);
+	t = benchTime(ctx, runOpen, r);
+	sink += r->sink;
+	benchReportValue(ctx, "asset", "level", "sdAssetOpen", "us", t * 1e6);
+	t = benchTime(ctx, runMap, r);
+	sink += r->sink;
+	benchReportValue(ctx, "asset", "level", "sdAssetMap + first query", "us", t * 1e6);
+	t = benchTime(ctx, runRead, r);
+	sink += r->sink;
+	benchReportValue(ctx, "asset", "level", "read + first query", "us", t * 1e6);
+	benchReportValue(ctx, "asset", "level", "file", "KB", r->size / 1024.0);
+
+	SDAsset asset;
+	if (sdAssetMap(&asset, r->path)) {
+		benchFail(ctx, "asset: map failed\n");
+	} else {
+		checkAsset(ctx, r, &asset);
+		sdAssetClose(&asset);
+	}
+	checkDamage(ctx, r);
+
+	unlink(r->path);
+	sdSceneFree(&r->scene);
+	free(r->blob);
+	free(r);
+}
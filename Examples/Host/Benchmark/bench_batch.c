@@ -0,0 +1,145 @@
+// Batched entry points (sdXxxBatch) against a loop over the scalar sdXxx calls. Shapes and parameters
+// follow bench_prep.c, evaluated in the shape frame (u, v) = (x - cx, y - cy), which is filled in
+// before timing. Both runs write every distance to an array, as a grid scan would.
+//
+// The batch bodies repeat the scalar arithmetic in the same order, and the SIMD kernels (SDF2D_SIMD)
+// are meant to as well, so the check is for equal results, not a tolerance. Fractional parameters
+// catch a reordering such as |p| - (s - r) for |p| - s + r, which whole ones round the same way.
+
+#include "bench.h"
+#include "sdf2d.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+
+#define BATCH_CASES(X) \
+	X(1, "sdCircle", 200, 120, sdCircle(u, v, 110), sdCircleBatch(u, v, out, n, 110)) \
+	X(2, "sdSegment", 0, 0, sdSegment(u, v, 50, 220, 350, 20), sdSegmentBatch(u, v, out, n, 50, 220, 350, 20)) \
+	X(3, "sdBox", 200, 120, sdBox(u, v, 160, 70), sdBoxBatch(u, v, out, n, 160, 70)) \
+	X(4, "sdOrientedBox", 0, 0, sdOrientedBox(u, v, 50, 20, 350, 220, 20), sdOrientedBoxBatch(u, v, out, n, 50, 20, 350, 220, 20)) \
+	X(5, "sdRoundedBox", 200, 120, sdRoundedBox(u, v, 70, 40, 10, 20, 0, 20), sdRoundedBoxBatch(u, v, out, n, 70, 40, 10, 20, 0, 20)) \
+	X(6, "sdRoundSquare", 200, 120, sdRoundSquare(u, v, 100, 20), sdRoundSquareBatch(u, v, out, n, 100, 20)) \
+	X(7, "sdRhombus", 200, 120, sdRhombus(u, v, 100, 30), sdRhombusBatch(u, v, out, n, 100, 30)) \
+	X(8, "sdTrapezoid", 200, 120, sdTrapezoid(u, v, 100, 30, 40), sdTrapezoidBatch(u, v, out, n, 100, 30, 40)) \
+	X(9, "sdParallelogram", 200, 120, sdParallelogram(u, v, 150, 50, 30), sdParallelogramBatch(u, v, out, n, 150, 50, 30)) \
+	X(10, "sdEquilateralTriangle", 200, 120, sdEquilateralTriangle(u, v, 100), sdEquilateralTriangleBatch(u, v, out, n, 100)) \
+	X(11, "sdTriangleIsosceles", 200, 120, sdTriangleIsosceles(u, v, 160, 50), sdTriangleIsoscelesBatch(u, v, out, n, 160, 50)) \
+	X(12, "sdTriangle", 0, 0, sdTriangle(u, v, 40, 10, 50, 200, 350, 80), sdTriangleBatch(u, v, out, n, 40, 10, 50, 200, 350, 80)) \
+	X(13, "sdQuad", 0, 0, sdQuad(u, v, 40, 10, 50, 200, 320, 180, 350, 80), sdQuadBatch(u, v, out, n, 40, 10, 50, 200, 320, 180, 350, 80)) \
+	X(14, "sdUnevenCapsule", 200, 120, sdUnevenCapsule(u, v, 40, 30, 80), sdUnevenCapsuleBatch(u, v, out, n, 40, 30, 80)) \
+	X(15, "sdEgg", 200, 120, sdEgg(u, v, 50, 10), sdEggBatch(u, v, out, n, 50, 10)) \
+	X(16, "sdPie", 200, 120, sdPie(u, v, 0.866f, -0.5f, 100), sdPieBatch(u, v, out, n, 0.866f, -0.5f, 100)) \
+	X(17, "sdCutDisk", 200, 120, sdCutDisk(u, v, 100, -75), sdCutDiskBatch(u, v, out, n, 100, -75)) \
+	X(18, "sdMoon", 200, 120, sdMoon(u, v, 45, 110, 90), sdMoonBatch(u, v, out, n, 45, 110, 90)) \
+	X(19, "sdVesica", 200, 120, sdVesica(u, v, 110, 60), sdVesicaBatch(u, v, out, n, 110, 60)) \
+	X(20, "sdOrientedVesica", 0, 0, sdOrientedVesica(u, v, 110, 10, 290, 190, 30), sdOrientedVesicaBatch(u, v, out, n, 110, 10, 290, 190, 30)) \
+	X(21, "sdTunnel", 200, 120, sdTunnel(u, v, 80, 40), sdTunnelBatch(u, v, out, n, 80, 40)) \
+	X(22, "sdArc", 200, 120, sdArc(u, v, 0.7071f, -0.7071f, 80, 10), sdArcBatch(u, v, out, n, 0.7071f, -0.7071f, 80, 10)) \
+	X(23, "sdRing", 200, 120, sdRing(u, v, -0.7071f, 0.7071f, 100, 10), sdRingBatch(u, v, out, n, -0.7071f, 0.7071f, 100, 10)) \
+	X(24, "sdHorseshoe", 200, 120, sdHorseshoe(u, v, 0, 1, 80, 100, 5), sdHorseshoeBatch(u, v, out, n, 0, 1, 80, 100, 5)) \
+	X(25, "sdParabola", 200, 120, sdParabola(u, v, 0.002f), sdParabolaBatch(u, v, out, n, 0.002f)) \
+	X(26, "sdCross", 200, 120, sdCross(u, v, 100, 40, 14), sdCrossBatch(u, v, out, n, 100, 40, 14)) \
+	X(27, "sdRoundedX", 200, 120, sdRoundedX(u, v, 180, 20), sdRoundedXBatch(u, v, out, n, 180, 20)) \
+	X(28, "sdEllipse", 200, 120, sdEllipse(u, v, 160, 80), sdEllipseBatch(u, v, out, n, 160, 80)) \
+	X(29, "sdStar5", 200, 120, sdStar5(u, v, 35, 3), sdStar5Batch(u, v, out, n, 35, 3)) \
+	X(30, "sdHexagram", 200, 120, sdHexagram(u, v, 45), sdHexagramBatch(u, v, out, n, 45)) \
+	X(31, "sdPentagon", 200, 120, sdPentagon(u, v, 90), sdPentagonBatch(u, v, out, n, 90)) \
+	X(32, "sdRegularPolygon (5)", 200, 120, sdRegularPolygon(u, v, 90, 5), sdRegularPolygonBatch(u, v, out, n, 90, 5)) \
+	X(33, "sdHexagon", 200, 120, sdHexagon(u, v, 90), sdHexagonBatch(u, v, out, n, 90)) \
+	X(34, "sdOctagon", 200, 120, sdOctagon(u, v, 90), sdOctagonBatch(u, v, out, n, 90)) \
+	X(35, "sdPolygon (4)", 0, 0, sdPolygon(u, v, vx, vy, 4), sdPolygonBatch(u, v, out, n, vx, vy, 4)) \
+	X(36, "sdSegmentLinf", 0, 0, sdSegmentLinf(u, v, 50, 220, 350, 20), sdSegmentLinfBatch(u, v, out, n, 50, 220, 350, 20)) \
+	X(37, "sdBoxLinf", 200, 120, sdBoxLinf(u, v, 160, 70), sdBoxLinfBatch(u, v, out, n, 160, 70)) \
+	X(38, "sdRhombusLinf", 200, 120, sdRhombusLinf(u, v, 100, 30), sdRhombusLinfBatch(u, v, out, n, 100, 30)) \
+	X(39, "sdEllipseLinf", 200, 120, sdEllipseLinf(u, v, 160, 80), sdEllipseLinfBatch(u, v, out, n, 160, 80)) \
+	X(40, "sdBezier", 0, 0, sdBezier(u, v, 50, 220, 200, -100, 350, 220, 10), sdBezierBatch(u, v, out, n, 50, 220, 200, -100, 350, 220, 10)) \
+	X(41, "sdRoundSquare (fractional)", 200, 120, sdRoundSquare(u, v, 99.7f, 20.3f), sdRoundSquareBatch(u, v, out, n, 99.7f, 20.3f)) \
+
+typedef struct {
+	const float *u;
+	const float *v;
+	float *out;
+	int n;
+} BatchRun;
+
+#define X(id, label, cx, cy, sdExpr, batchCall) \
+	static float eval##id(float x, float y) { float u = x - (cx), v = y - (cy); return (sdExpr); } \
+	static void runSd##id(void *arg) { \
+		BatchRun *r = arg; \
+		for (int i = 0; i < r->n; i++) { float u = r->u[i], v = r->v[i]; r->out[i] = (sdExpr); } \
+	} \
+	static void runBatch##id(void *arg) { \
+		BatchRun *r = arg; \
+		const float *u = r->u, *v = r->v; \
+		float *out = r->out; \
+		size_t n = (size_t)r->n; \
+		batchCall; \
+	}
+BATCH_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	float cx, cy;
+	BenchEvalFunc eval;
+	void (*runSd)(void *arg);
+	void (*runBatch)(void *arg);
+} batchCases[] = {
+#define X(id, label, cx, cy, sdExpr, batchCall) { label, cx, cy, eval##id, runSd##id, runBatch##id },
+	BATCH_CASES(X)
+#undef X
+};
+
+void benchBatch(BenchContext *ctx)
+{
+	// odd, so that every batch also runs its scalar tail
+	int n = ctx->points | 1;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	float *u = malloc(n * sizeof(float));
+	float *v = malloc(n * sizeof(float));
+	float *outSd = malloc(n * sizeof(float));
+	float *outBatch = malloc(n * sizeof(float));
+	for (size_t c = 0; c < sizeof(batchCases) / sizeof(batchCases[0]); c++) {
+		const char *name = batchCases[c].name;
+		if (!benchSelected(ctx, name)) continue;
+
+		int mismatches = 0;
+		float maxError = 0.0f;
+		for (int dist = 0; dist < kBenchDistCount; dist++) {
+			benchPoints((BenchDist)dist, batchCases[c].eval, px, py, n);
+			for (int i = 0; i < n; i++) {
+				u[i] = px[i] - batchCases[c].cx;
+				v[i] = py[i] - batchCases[c].cy;
+			}
+			BatchRun sd = { u, v, outSd, n };
+			BatchRun batch = { u, v, outBatch, n };
+			if (dist == kBenchGrid) {
+				double tsd = benchTime(ctx, batchCases[c].runSd, &sd);
+				double tbatch = benchTime(ctx, batchCases[c].runBatch, &batch);
+				benchReport(ctx, "batch", name, "sd", tsd * 1e9 / n);
+				benchReport(ctx, "batch", name, "batch", tbatch * 1e9 / n);
+				benchReportValue(ctx, "batch", name, "speedup", "x sd", tsd / tbatch);
+			} else {
+				batchCases[c].runSd(&sd);
+				batchCases[c].runBatch(&batch);
+			}
+			for (int i = 0; i < n; i++) {
+				if (outSd[i] == outBatch[i] || (isnan(outSd[i]) && isnan(outBatch[i]))) continue;
+				mismatches++;
+				maxError = fmaxf(maxError, fabsf(outSd[i] - outBatch[i]));
+			}
+		}
+		if (mismatches)
+			benchFail(ctx, "batch: %s differs from sd at %d points, by up to %g\n", name, mismatches, maxError);
+	}
+	free(px);
+	free(py);
+	free(u);
+	free(v);
+	free(outSd);
+	free(outBatch);
+}
@@ -0,0 +1,103 @@
+// Broadphase benchmark: closest-shape and radius queries at 10 to 10,000 shapes, against a linear
+// scan of every shape (the pattern used by pd_collisions.lua), plus build and refit cost.
+
+#include "bench.h"
+#include "sdf2d_broadphase.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define QUERIES 4096
+
+typedef struct {
+	SDBroadphase bp;
+	float px[QUERIES];
+	float py[QUERIES];
+	int hits[64];
+	float sink;
+} BroadphaseRun;
+
+static void runScan(void *arg)
+{
+	BroadphaseRun *r = arg;
+	float t = 0.0f;
+	for (int q = 0; q < QUERIES; q++) {
+		float best = 1e30f;
+		for (int i = 0; i < r->bp.numItems; i++) {
+			const SDBroadphaseItem *it = &r->bp.items[i];
+			best = fminf(best, sdShapeEval(&it->shape, r->px[q] - it->x, r->py[q] - it->y));
+		}
+		t += best;
+	}
+	r->sink = t;
+}
+
+static void runClosest(void *arg)
+{
+	BroadphaseRun *r = arg;
+	float t = 0.0f;
+	for (int q = 0; q < QUERIES; q++) {
+		float d;
+		sdBroadphaseClosest(&r->bp, r->px[q], r->py[q], &d);
+		t += d;
+	}
+	r->sink = t;
+}
+
+static void runRadius(void *arg)
+{
+	BroadphaseRun *r = arg;
+	int t = 0;
+	for (int q = 0; q < QUERIES; q++)
+		t += sdBroadphaseQueryRadius(&r->bp, r->px[q], r->py[q], 3.0f, r->hits, NULL, 64);
+	r->sink = (float)t;
+}
+
+static void runRefit(void *arg)
+{
+	BroadphaseRun *r = arg;
+	for (int i = 0; i < r->bp.numItems; i++)
+		sdBroadphaseMove(&r->bp, i, r->bp.items[i].x + 0.5f, r->bp.items[i].y);
+	sdBroadphaseRefit(&r->bp);
+}
+
+static void runBuild(void *arg)
+{
+	BroadphaseRun *r = arg;
+	sdBroadphaseBuild(&r->bp);
+}
+
+void benchBroadphase(BenchContext *ctx)
+{
+	static const int sizes[] = { 10, 100, 1000, 10000 };
+	static const SDShapeType types[] = { kSDCircle, kSDBox, kSDQuad, kSDEllipse };
+	char variant[32];
+
+	if (!benchSelected(ctx, "broadphase")) return;
+	BroadphaseRun *r = malloc(sizeof(BroadphaseRun));
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		int n = sizes[s];
+		float side = 40.0f * sqrtf((float)n); // constant shape density
+		sdBroadphaseInit(&r->bp);
+		for (int i = 0; i < n; i++) {
+			SDShape shape = { types[i % 4], { benchUniform(4, 12), benchUniform(4, 12) } };
+			if (shape.type == kSDQuad) {
+				float q[8] = { -10, -3, -10, 3, 10, 5, 10, -5 };
+				for (int k = 0; k < 8; k++) shape.p[k] = q[k];
+			}
+			sdBroadphaseAdd(&r->bp, &shape, benchUniform(0, side), benchUniform(0, side));
+		}
+		for (int q = 0; q < QUERIES; q++) {
+			r->px[q] = benchUniform(0, side);
+			r->py[q] = benchUniform(0, side);
+		}
+		snprintf(variant, sizeof(variant), "n=%d", n);
+		benchReport(ctx, "broadphase", "build per shape", variant, benchTime(ctx, runBuild, r) * 1e9 / n);
+		benchReport(ctx, "broadphase", "closest scan", variant, benchTime(ctx, runScan, r) * 1e9 / QUERIES);
+		benchReport(ctx, "broadphase", "closest bvh", variant, benchTime(ctx, runClosest, r) * 1e9 / QUERIES);
+		benchReport(ctx, "broadphase", "radius bvh", variant, benchTime(ctx, runRadius, r) * 1e9 / QUERIES);
+		benchReport(ctx, "broadphase", "refit per shape", variant, benchTime(ctx, runRefit, r) * 1e9 / n);
+		sdBroadphaseFree(&r->bp);
+	}
+	free(r);
+}
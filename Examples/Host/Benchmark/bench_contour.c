@@ -0,0 +1,184 @@
+// Contour benchmark: the outlines of shapes and of the pd_collisions.lua terrain as polylines over
+// the 401 x 241 lattice of screen pixel corners. Times sdContourTrace, which follows the surface from
+// the tiles near it, against full-grid marching squares (sdContourTraceDense), and against the
+// per-pixel outline pass it replaces (sdRasterShape, 1.5 px outline). Reports SDF calls, polylines
+// and vertices, before and after simplifying to 0.25 px. Checks that both tracers give the same
+// polylines, that every vertex is on the surface and that the inside is on the right of every line.
+
+#include "bench.h"
+#include "sdf2d_contour.h"
+#include "sdf2d_raster.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONTOUR_W 400
+#define CONTOUR_H 240
+#define CONTOUR_ROWBYTES 52
+
+typedef struct {
+	const char *name;
+	SDShape shape;       // kSDShapeCount: the scene
+	float x, y;
+} ContourCase;
+
+typedef struct {
+	const ContourCase *c;
+	const SDScene *scene;
+	SDContourLayout layout;
+	SDContours lines;
+	SDContourStats stats;
+	SDBitmap bm;
+} ContourRun;
+
+static void runTrace(void *arg)
+{
+	ContourRun *r = arg;
+	r->stats = (SDContourStats){ 0 };
+	if (r->c->shape.type == kSDShapeCount) sdContourScene(&r->lines, &r->layout, r->scene, &r->stats);
+	else sdContourShape(&r->lines, &r->layout, &r->c->shape, r->c->x, r->c->y, &r->stats);
+}
+
+static void runDense(void *arg)
+{
+	ContourRun *r = arg;
+	SDTileShape placed = { &r->c->shape, r->c->x, r->c->y };
+	r->stats = (SDContourStats){ 0 };
+	if (r->c->shape.type == kSDShapeCount) sdContourTraceDense(&r->lines, &r->layout, sdTileSampleScene, (void *)r->scene, &r->stats);
+	else sdContourTraceDense(&r->lines, &r->layout, sdTileSampleShape, &placed, &r->stats);
+}
+
+static void runRaster(void *arg)
+{
+	ContourRun *r = arg;
+	static const SDRasterStyle outline = { kSDRasterOutline, 1.5f, 0.0f };
+	if (r->c->shape.type == kSDShapeCount) sdRasterScene(&r->bm, r->scene, &outline);
+	else sdRasterShape(&r->bm, &r->c->shape, r->c->x, r->c->y, &outline);
+}
+
+// The terrain of pd_collisions.lua, as in Examples/Host/Bake/collisions.txt
+static void buildTerrain(SDScene *scene)
+{
+	sdSceneInit(scene);
+	int ids[10], n = 0;
+	int box = sdSceneAddShape(scene, &(SDShape){ kSDBox, { 110, 60 } });
+	ids[n] = sdSceneAddOp(scene, kSDOnion, box, -1, 7.0f);
+	sdSceneSetTransform(scene, ids[n++], 200, 90, 0);
+	ids[n] = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { 15 } });
+	sdSceneSetTransform(scene, ids[n++], 230, 180, 0);
+	ids[n] = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { 15 } });
+	sdSceneSetTransform(scene, ids[n++], 280, 180, 0);
+	ids[n] = sdSceneAddShape(scene, &(SDShape){ kSDPentagon, { 35 } });
+	sdSceneSetTransform(scene, ids[n++], 200, 65, 0);
+	ids[n++] = sdSceneAddShape(scene, &(SDShape){ kSDOrientedBox, { 120, 100, 200, 130, 8 } });
+	int across = sdSceneAddShape(scene, &(SDShape){ kSDRoundedBox, { 32, 8, 8, 8, 8, 8 } });
+	int down = sdSceneAddShape(scene, &(SDShape){ kSDRoundedBox, { 8, 32, 8, 8, 8, 8 } });
+	ids[n] = sdSceneAddOp(scene, kSDUnion, across, down, 0.0f);
+	sdSceneSetTransform(scene, ids[n++], 130, 200, 0);
+	static const float walls[4][4] = { { 66.67f, 125, 0, 120 }, { 66.67f, 125, 400, 120 }, { 205, 5, 200, -5 }, { 205, 5, 200, 245 } };
+	for (int i = 0; i < 4; i++) {
+		ids[n] = sdSceneAddShape(scene, &(SDShape){ kSDBox, { walls[i][0], walls[i][1] } });
+		sdSceneSetTransform(scene, ids[n++], walls[i][2], walls[i][3], 0);
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, n));
+}
+
+static float contourEval(const ContourRun *r, float x, float y)
+{
+	if (r->c->shape.type == kSDShapeCount) return sdSceneEval(r->scene, x, y);
+	return sdShapeEval(&r->c->shape, x - r->c->x, y - r->c->y);
+}
+
+static int sameLines(const SDContours *a, const SDContours *b)
+{
+	return a->count == b->count && a->vertices == b->vertices &&
+		!memcmp(a->start, b->start, (a->count + 1) * sizeof(int)) && !memcmp(a->closed, b->closed, a->count) &&
+		!memcmp(a->x, b->x, a->vertices * sizeof(float)) && !memcmp(a->y, b->y, a->vertices * sizeof(float));
+}
+
+// Vertices on the surface, and the inside a quarter pixel right of the middle of each segment.
+// Returns the largest distance of a vertex from the surface.
+static float checkLines(const ContourRun *r, const SDContours *lines, int *wrongSide)
+{
+	float worst = 0.0f;
+	int wrong = 0, segments = 0;
+	for (int v = 0; v < lines->vertices; v++) worst = fmaxf(worst, fabsf(contourEval(r, lines->x[v], lines->y[v])));
+	for (int i = 0; i < lines->count; i++) {
+		int first = lines->start[i], last = lines->start[i + 1] - 1;
+		for (int v = first; v <= last; v++) {
+			int w = v < last ? v + 1 : first;
+			if (v == last && !lines->closed[i]) break;
+			float dx = lines->x[w] - lines->x[v], dy = lines->y[w] - lines->y[v];
+			float len = sqrtf(dx * dx + dy * dy);
+			if (len < 0.5f) continue;
+			float mx = 0.5f * (lines->x[v] + lines->x[w]), my = 0.5f * (lines->y[v] + lines->y[w]);
+			float nx = -dy / len * 0.25f, ny = dx / len * 0.25f;
+			segments++;
+			wrong += !(contourEval(r, mx + nx, my + ny) < contourEval(r, mx - nx, my - ny));
+		}
+	}
+	*wrongSide = segments && wrong * 100 > segments ? wrong : 0;
+	return worst;
+}
+
+void benchContour(BenchContext *ctx)
+{
+	static const ContourCase cases[] = {
+		{ "small sdCircle", { kSDCircle, { 20 } }, 200, 120 },
+		{ "sdEllipse", { kSDEllipse, { 160, 80 } }, 200, 120 },
+		{ "sdStar5", { kSDStar5, { 35, 3 } }, 200, 120 },
+		{ "sdRoundedX", { kSDRoundedX, { 180, 20 } }, 200, 120 },
+		{ "sdBoxLinf", { kSDBoxLinf, { 160, 70 } }, 200, 120 },
+		{ "sdParabola", { kSDParabola, { 0.002f } }, 200, 120 },
+		{ "terrain scene", { kSDShapeCount }, 0, 0 },
+	};
+	const double pixels = (CONTOUR_W + 1) * (CONTOUR_H + 1);
+	uint8_t *bitmap = calloc(CONTOUR_H, CONTOUR_ROWBYTES);
+	SDScene scene;
+	SDContours dense;
+	sdContoursInit(&dense);
+	buildTerrain(&scene);
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		if (!benchSelected(ctx, cases[c].name)) continue;
+		ContourRun run = { &cases[c], &scene, { 0, 0, CONTOUR_W + 1, CONTOUR_H + 1, 1.0f, 0.0f, 0.0f } };
+		run.bm = (SDBitmap){ bitmap, CONTOUR_W, CONTOUR_H, CONTOUR_ROWBYTES };
+		sdContoursInit(&run.lines);
+
+		benchReport(ctx, "contour", cases[c].name, "raster outline", benchTime(ctx, runRaster, &run) * 1e9);
+		double t = benchTime(ctx, runDense, &run);
+		benchReport(ctx, "contour", cases[c].name, "marching squares", t * 1e9);
+		benchReportValue(ctx, "contour", cases[c].name, "marching squares", "samples", run.stats.samples);
+		// keep the marching squares polylines, and trace into the other buffers
+		SDContours tmp = dense;
+		dense = run.lines;
+		run.lines = tmp;
+		double traced = benchTime(ctx, runTrace, &run);
+		benchReport(ctx, "contour", cases[c].name, "traced", traced * 1e9);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "samples", run.stats.samples);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "x fewer calls", pixels / run.stats.samples);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "speedup", t / traced);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "polylines", run.lines.count);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "vertices", run.lines.vertices);
+
+		if (!sameLines(&run.lines, &dense))
+			benchFail(ctx, "contour: %s traced polylines differ from marching squares\n", cases[c].name);
+		int wrongSide;
+		float worst = checkLines(&run, &run.lines, &wrongSide);
+		benchReportValue(ctx, "contour", cases[c].name, "traced", "max px off", worst);
+		if (worst > 0.5f) benchFail(ctx, "contour: %s vertex %g px off the surface\n", cases[c].name, worst);
+		if (wrongSide) benchFail(ctx, "contour: %s inside left of %d segments\n", cases[c].name, wrongSide);
+
+		run.layout.tolerance = 0.25f;
+		t = benchTime(ctx, runTrace, &run);
+		benchReport(ctx, "contour", cases[c].name, "traced 0.25 px", t * 1e9);
+		benchReportValue(ctx, "contour", cases[c].name, "traced 0.25 px", "vertices", run.lines.vertices);
+		checkLines(&run, &run.lines, &wrongSide);
+		if (wrongSide) benchFail(ctx, "contour: %s simplified: inside left of %d segments\n", cases[c].name, wrongSide);
+		sdContoursFree(&run.lines);
+	}
+	sdContoursFree(&dense);
+	sdSceneFree(&scene);
+	free(bitmap);
+}
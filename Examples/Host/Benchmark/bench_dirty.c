@@ -0,0 +1,181 @@
+// Dirty region benchmark: ellipses smooth-blended into one scene, as in pd_sprites.lua, with one of
+// them moving a few pixels per frame. Keeping a baked grid and a 1-bit screen up to date through
+// sdf2d_dirty.h is timed against rebaking and redrawing everything, and checked to give the same
+// samples and pixels.
+
+#include "bench.h"
+#include "sdf2d_dirty.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DIRTY_SPRITES 8
+#define DIRTY_BLEND 8.0f         // smooth union radius
+#define DIRTY_CELL 2.0f
+#define DIRTY_RANGE 16.0f
+#define DIRTY_FRAMES 50          // frames moved before checking against a full update
+#define DIRTY_MOVER (DIRTY_SPRITES - 1)   // the last sprite blended in, so under a single smooth union
+
+typedef struct {
+	SDScene scene;
+	int nodes[DIRTY_SPRITES];
+	SDShape shapes[DIRTY_SPRITES];
+	float x[DIRTY_SPRITES], y[DIRTY_SPRITES];
+	int root;
+	int frame;
+	SDDirty dirty;
+	SDDirtyStats stats;
+	SDGridLayout layout;
+	SDGrid grid;
+	SDBitmap bm;
+	SDRasterStyle style;
+} DirtyRun;
+
+static void buildSprites(DirtyRun *r)
+{
+	sdSceneInit(&r->scene);
+	int a = -1;
+	for (int i = 0; i < DIRTY_SPRITES; i++) {
+		r->shapes[i] = (SDShape){ kSDEllipse, { benchUniform(15, 40), benchUniform(10, 25) } };
+		r->x[i] = benchUniform(50, 350);
+		r->y[i] = benchUniform(40, 200);
+		r->nodes[i] = sdSceneAddShape(&r->scene, &r->shapes[i]);
+		sdSceneSetTransform(&r->scene, r->nodes[i], r->x[i], r->y[i], 0.0f);
+		a = a < 0 ? r->nodes[i] : sdSceneAddOp(&r->scene, kSDSmoothUnion, a, r->nodes[i], DIRTY_BLEND);
+	}
+	r->root = a;
+	sdSceneCompile(&r->scene, r->root);
+}
+
+// The mover goes round a 30 x 30 square, 3 px per frame. Returns its old position.
+static void moveSprite(DirtyRun *r, float *ox, float *oy)
+{
+	static const float dx[] = { 3, 0, -3, 0 }, dy[] = { 0, 3, 0, -3 };
+	int side = r->frame / 10;
+	*ox = r->x[DIRTY_MOVER];
+	*oy = r->y[DIRTY_MOVER];
+	r->x[DIRTY_MOVER] += dx[side];
+	r->y[DIRTY_MOVER] += dy[side];
+	r->frame = (r->frame + 1) % 40;
+	sdSceneSetTransform(&r->scene, r->nodes[DIRTY_MOVER], r->x[DIRTY_MOVER], r->y[DIRTY_MOVER], 0.0f);
+	sdSceneCompile(&r->scene, r->root);
+}
+
+static void runGridFull(void *arg)
+{
+	DirtyRun *r = arg;
+	float ox, oy;
+	moveSprite(r, &ox, &oy);
+	sdGridBakeScene(&r->grid, &r->layout, &r->scene);
+}
+
+static void runGridDirty(void *arg)
+{
+	DirtyRun *r = arg;
+	float ox, oy;
+	moveSprite(r, &ox, &oy);
+	sdDirtyAddMove(&r->dirty, &r->shapes[DIRTY_MOVER], ox, oy, r->x[DIRTY_MOVER], r->y[DIRTY_MOVER], 0.0f, DIRTY_RANGE + DIRTY_BLEND);
+	sdDirtyUpdateGrid(&r->dirty, &r->grid, sdTileSampleScene, &r->scene, &r->stats);
+	sdDirtyClear(&r->dirty);
+}
+
+static void runBitmapFull(void *arg)
+{
+	DirtyRun *r = arg;
+	float ox, oy;
+	moveSprite(r, &ox, &oy);
+	sdRasterSceneCulled(&r->bm, &r->scene, &r->style, NULL);
+}
+
+static void runBitmapDirty(void *arg)
+{
+	DirtyRun *r = arg;
+	float ox, oy;
+	moveSprite(r, &ox, &oy);
+	sdDirtyAddMove(&r->dirty, &r->shapes[DIRTY_MOVER], ox, oy, r->x[DIRTY_MOVER], r->y[DIRTY_MOVER], 0.0f, DIRTY_BLEND);
+	sdDirtyUpdateBitmap(&r->dirty, &r->bm, &r->scene, &r->style, &r->stats);
+	sdDirtyClear(&r->dirty);
+}
+
+// Samples of the updated grid that differ from a fresh bake
+static int gridMismatches(DirtyRun *r)
+{
+	SDGrid ref;
+	sdGridInit(&ref);
+	if (sdGridBakeScene(&ref, &r->layout, &r->scene) < 0) return -1;
+	int wrong = 0;
+	for (int j = 0; j < r->layout.height; j++) {
+		for (int i = 0; i < r->layout.width; i++) {
+			float x = r->layout.x + i * r->layout.cell, y = r->layout.y + j * r->layout.cell;
+			wrong += sdGridEval(&r->grid, x, y) != sdGridEval(&ref, x, y);
+		}
+	}
+	sdGridFree(&ref);
+	return wrong;
+}
+
+void benchDirty(BenchContext *ctx)
+{
+	static const char *formats[] = { "int8", "uint16", "float" };
+	DirtyRun *r = calloc(1, sizeof(DirtyRun));
+	buildSprites(r);
+	sdDirtyInit(&r->dirty);
+	sdGridInit(&r->grid);
+	char name[32];
+	int frames = ctx->quick ? DIRTY_FRAMES / 5 : DIRTY_FRAMES;
+
+	for (int narrow = 0; narrow <= 1; narrow++) {
+		for (int f = kSDGridInt8; f <= kSDGridFloat; f += kSDGridFloat - kSDGridInt8) {
+			snprintf(name, sizeof(name), "grid %s%s", formats[f], narrow ? " band" : "");
+			if (!benchSelected(ctx, name)) continue;
+			r->layout = (SDGridLayout){ (SDGridFormat)f, 0, 0, 201, 121, DIRTY_CELL, DIRTY_RANGE, narrow };
+			if (sdGridBakeScene(&r->grid, &r->layout, &r->scene) < 0) {
+				benchFail(ctx, "dirty: %s bake failed\n", name);
+				continue;
+			}
+			double t = benchTime(ctx, runGridFull, r);
+			benchReport(ctx, "dirty", name, "full bake", t * 1e9);
+			t = benchTime(ctx, runGridDirty, r);
+			benchReport(ctx, "dirty", name, "dirty", t * 1e9);
+
+			r->stats = (SDDirtyStats){ 0 };
+			for (int i = 0; i < frames; i++) runGridDirty(r);
+			long cells = (long)r->layout.width * r->layout.height;
+			benchReportValue(ctx, "dirty", name, "dirty", "samples/frame", (double)r->stats.cells / frames);
+			benchReportValue(ctx, "dirty", name, "dirty", "% of grid", 100.0 * r->stats.cells / frames / cells);
+			int wrong = gridMismatches(r);
+			if (wrong) benchFail(ctx, "dirty: %s differs from a fresh bake at %d samples\n", name, wrong);
+			sdGridFree(&r->grid);
+		}
+	}
+
+	if (benchSelected(ctx, "bitmap fill")) {
+		int rowbytes = 52;
+		r->bm = (SDBitmap){ malloc(rowbytes * 240), 400, 240, rowbytes };
+		uint8_t *ref = malloc(rowbytes * 240);
+		// the padding past pixel 400 is never written
+		memset(r->bm.data, 0xff, rowbytes * 240);
+		memset(ref, 0xff, rowbytes * 240);
+		r->style = (SDRasterStyle){ kSDRasterFill, 0.0f, 0.0f };
+		sdRasterScene(&r->bm, &r->scene, &r->style);
+		double t = benchTime(ctx, runBitmapFull, r);
+		benchReport(ctx, "dirty", "bitmap fill", "full culled", t * 1e9);
+		t = benchTime(ctx, runBitmapDirty, r);
+		benchReport(ctx, "dirty", "bitmap fill", "dirty", t * 1e9);
+
+		r->stats = (SDDirtyStats){ 0 };
+		for (int i = 0; i < frames; i++) runBitmapDirty(r);
+		benchReportValue(ctx, "dirty", "bitmap fill", "dirty", "pixels/frame", (double)r->stats.cells / frames);
+		benchReportValue(ctx, "dirty", "bitmap fill", "dirty", "% of screen", 100.0 * r->stats.cells / frames / (400 * 240));
+		SDBitmap full = { ref, 400, 240, rowbytes };
+		sdRasterScene(&full, &r->scene, &r->style);
+		if (memcmp(ref, r->bm.data, rowbytes * 240))
+			benchFail(ctx, "dirty: bitmap fill differs from a full redraw\n");
+		free(ref);
+		free(r->bm.data);
+	}
+
+	sdDirtyFree(&r->dirty);
+	sdSceneFree(&r->scene);
+	free(r);
+}
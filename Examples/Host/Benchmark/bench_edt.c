@@ -0,0 +1,183 @@
+// Distance transform benchmark: shapes filled into 1-bit masks with sdRasterShape, then turned back
+// into fields with sdEdtField, exact and jump flooding. Reports ns per pixel, the time to bake an int8
+// grid with range 16 (where jump flooding starts at a stride of 16), how far jump flooding
+// is from exact and how far both are from the SDF the mask was drawn from, and the lookup cost of
+// the baked grid against the SDF. The exact transform is checked against a brute force search.
+
+#include "bench.h"
+#include "sdf2d_edt.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EDT_RANGE 16.0f
+
+typedef struct {
+	const char *name;
+	SDShape shape;
+	int width, height;
+} EdtCase;
+
+typedef struct {
+	SDBitmap mask;
+	SDEdtMode mode;
+	float *field;
+	const SDGrid *grid;
+	const SDShape *shape;
+	float ox, oy;
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} EdtRun;
+
+static void runField(void *arg)
+{
+	EdtRun *r = arg;
+	sdEdtField(&r->mask, 0, r->mode, r->field);
+}
+
+static void runBake(void *arg)
+{
+	EdtRun *r = arg;
+	SDGridLayout layout = { kSDGridInt8, 0, 0, r->mask.width, r->mask.height, 1.0f, EDT_RANGE, 0 };
+	SDGrid grid;
+	sdGridInit(&grid);
+	sdEdtBake(&grid, &layout, &r->mask, 0, r->mode);
+	sdGridFree(&grid);
+}
+
+static void runShape(void *arg)
+{
+	EdtRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) {
+		float gx, gy;
+		t += sdShapeEvalGrad(r->shape, r->px[i] - r->ox, r->py[i] - r->oy, &gx, &gy) + gx + gy;
+	}
+	r->sink = t;
+}
+
+static void runGrid(void *arg)
+{
+	EdtRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) {
+		float gx, gy;
+		t += sdgGridEval(r->grid, r->px[i], r->py[i], &gx, &gy) + gx + gy;
+	}
+	r->sink = t;
+}
+
+// Largest difference between the exact field and a search over every pixel
+static float bruteForceError(const SDBitmap *mask, const float *field)
+{
+	int w = mask->width, h = mask->height;
+	float worst = 0.0f;
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			int in = ((mask->data[y * mask->rowbytes + (x >> 3)] >> (7 - (x & 7))) & 1) == 0;
+			// beyond the bitmap is outside
+			float best = in ? (float)(x + 1) : HUGE_VALF;
+			if (in) best = fminf(best, fminf((float)(w - x), fminf((float)(y + 1), (float)(h - y))));
+			for (int j = 0; j < h; j++) {
+				for (int i = 0; i < w; i++) {
+					int other = ((mask->data[j * mask->rowbytes + (i >> 3)] >> (7 - (i & 7))) & 1) == 0;
+					if (other != in) best = fminf(best, sqrtf((float)((i - x) * (i - x) + (j - y) * (j - y))));
+				}
+			}
+			float d = in ? 0.5f - best : best - 0.5f;
+			worst = fmaxf(worst, fabsf(d - field[y * w + x]));
+		}
+	}
+	return worst;
+}
+
+void benchEdt(BenchContext *ctx)
+{
+	static const EdtCase cases[] = {
+		{ "sdStar5 sprite", { kSDStar5, { 28, 0.5f } }, 64, 64 },
+		{ "sdEllipse screen", { kSDEllipse, { 160, 80 } }, 400, 240 },
+	};
+	static const char *modes[] = { "exact", "jump flood" };
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		const EdtCase *e = &cases[c];
+		if (!benchSelected(ctx, e->name)) continue;
+		int w = e->width, h = e->height, rowbytes = (w + 31) / 32 * 4;
+		size_t pixels = (size_t)w * h;
+		EdtRun run = { { malloc(rowbytes * h), w, h, rowbytes }, kSDEdtExact, NULL, NULL, &e->shape, w * 0.5f, h * 0.5f };
+		float *exact = malloc(pixels * sizeof(float));
+		run.field = malloc(pixels * sizeof(float));
+		sdRasterShape(&run.mask, &e->shape, run.ox, run.oy, &(SDRasterStyle){ kSDRasterFill });
+
+		for (int m = kSDEdtExact; m <= kSDEdtJumpFlood; m++) {
+			run.mode = (SDEdtMode)m;
+			double t = benchTime(ctx, runField, &run);
+			benchReport(ctx, "edt", e->name, modes[m], t * 1e9 / pixels);
+			benchReportValue(ctx, "edt", e->name, modes[m], "ms/mask", t * 1e3);
+			t = benchTime(ctx, runBake, &run);
+			benchReportValue(ctx, "edt", e->name, modes[m], "ms/int8 bake", t * 1e3);
+			if (m == kSDEdtExact) memcpy(exact, run.field, pixels * sizeof(float));
+
+			// against the SDF, where it is within range: the mask is the shape rounded to pixels
+			float worst = 0.0f, jfa = 0.0f;
+			int wrong = 0;
+			for (size_t i = 0; i < pixels; i++) {
+				float d = sdShapeEval(&e->shape, (float)(i % w) - run.ox, (float)(i / w) - run.oy);
+				if (fabsf(d) <= EDT_RANGE) worst = fmaxf(worst, fabsf(run.field[i] - d));
+				jfa = fmaxf(jfa, fabsf(run.field[i] - exact[i]));
+				wrong += fabsf(run.field[i]) < fabsf(exact[i]) - 1e-4f;
+			}
+			benchReportValue(ctx, "edt", e->name, modes[m], "max error vs SDF", worst);
+			if (m == kSDEdtJumpFlood) {
+				benchReportValue(ctx, "edt", e->name, modes[m], "max error vs exact", jfa);
+				if (wrong) benchFail(ctx, "edt: %s jump flood nearer the surface than exact at %d pixels\n", e->name, wrong);
+			}
+		}
+		if (pixels <= 64 * 64) {
+			float err = bruteForceError(&run.mask, exact);
+			if (err > 1e-3f) benchFail(ctx, "edt: %s exact field differs from brute force by %g\n", e->name, err);
+		}
+
+		// lookups with gradient: the baked mask against the SDF itself
+		SDGridLayout layout = { kSDGridInt8, 0, 0, w, h, 1.0f, EDT_RANGE, 0 };
+		SDGrid grid;
+		sdGridInit(&grid);
+		if (sdEdtBake(&grid, &layout, &run.mask, 0, kSDEdtExact) < 0) {
+			benchFail(ctx, "edt: %s bake failed\n", e->name);
+		} else {
+			for (int i = 0; i < n; i++) {
+				px[i] = benchUniform(0, (float)w);
+				py[i] = benchUniform(0, (float)h);
+			}
+			run.grid = &grid;
+			run.px = px;
+			run.py = py;
+			run.n = n;
+			double t = benchTime(ctx, runShape, &run);
+			sink += run.sink;
+			benchReport(ctx, "edt", e->name, "sdShapeEvalGrad", t * 1e9 / n);
+			t = benchTime(ctx, runGrid, &run);
+			sink += run.sink;
+			benchReport(ctx, "edt", e->name, "sdgGridEval", t * 1e9 / n);
+			float worst = 0.0f;
+			for (size_t i = 0; i < pixels; i++) {
+				float x = (float)(i % w), y = (float)(i / w);
+				worst = fmaxf(worst, fabsf(sdGridEval(&grid, x, y) - fmaxf(-EDT_RANGE, fminf(exact[i], EDT_RANGE))));
+			}
+			if (worst > grid.scale * 0.5f + 1e-4f) benchFail(ctx, "edt: %s grid differs from the field by %g\n", e->name, worst);
+			sdGridFree(&grid);
+		}
+		free(run.mask.data);
+		free(run.field);
+		free(exact);
+	}
+	free(px);
+	free(py);
+}
@@ -0,0 +1,200 @@
+// Expression template benchmark: the same scenes built as an SDScene, dispatched at run time, and
+// as sdf2d_expr.hpp types, inlined by the compiler. Two cases: the terrain of pd_collisions.lua,
+// with its onion screen, D-pad and borders, and a blob that uses every transform and operator.
+// Reports ns per point over the 400x240 screen for sdSceneEval, sdSceneEvalBatch, the expression
+// one point at a time and evalBatch, and how many times faster the expression is than the scene.
+// The two are checked against each other.
+
+#include "sdf2d_expr.hpp"
+
+extern "C" {
+#include "bench.h"
+#include "sdf2d_scene.h"
+}
+
+#include <cmath>
+#include <cstdlib>
+
+using namespace sdf2d;
+
+namespace {
+
+// pd_collisions.lua's terrain. sdDPad's rounded boxes are boxes grown by their radius.
+constexpr float kScreenW = 400.0f, kScreenH = 240.0f;
+constexpr auto collisions =
+	translate(box(110, 60).onion(7), 200, 90) |
+	translate(circle(15), 230, 180) |
+	translate(circle(15), 280, 180) |
+	translate(fn<sdPentagon>(35.0f), 200, 65) |
+	fn<sdOrientedBox>(120.0f, 100.0f, 200.0f, 130.0f, 8.0f) |
+	translate(box(24, 0).round(8) | box(0, 24).round(8), 130, 200) |
+	translate(box(kScreenW / 6, kScreenH / 2 + 5), 0, kScreenH / 2) |
+	translate(box(kScreenW / 6, kScreenH / 2 + 5), kScreenW, kScreenH / 2) |
+	translate(box(kScreenW / 2 + 5, 5), kScreenW / 2, -5) |
+	translate(box(kScreenW / 2 + 5, 5), kScreenW / 2, kScreenH + 5);
+
+// Two mirrored circles smoothly joined to a rotated rounded box, a hexagon carved out, the lot
+// turned into a shell and a segment added
+constexpr float kCos30 = 0.866025404f, kSin30 = 0.5f;
+constexpr auto blob = translate(
+	(smoothUnion(mirrorX(translate(circle(30), 60, 0)), rotate(box(50, 20).round(4), kCos30, kSin30), 16) - hexagon(12)).onion(3) |
+	segment(-100, -80, 100, -80), 200, 120);
+
+int buildCollisions(SDScene *scene)
+{
+	auto add = [scene](SDShape s, float x, float y) {
+		int id = sdSceneAddShape(scene, &s);
+		sdSceneSetTransform(scene, id, x, y, 0.0f);
+		return id;
+	};
+	int screen = sdSceneAddOp(scene, kSDOnion, add({ kSDBox, { 110, 60 } }, 0, 0), -1, 7);
+	sdSceneSetTransform(scene, screen, 200, 90, 0.0f);
+	int dpad = sdSceneAddOp(scene, kSDUnion, add({ kSDRoundedBox, { 32, 8, 8, 8, 8, 8 } }, 0, 0),
+		add({ kSDRoundedBox, { 8, 32, 8, 8, 8, 8 } }, 0, 0), 0);
+	sdSceneSetTransform(scene, dpad, 130, 200, 0.0f);
+	int ids[] = {
+		screen,
+		add({ kSDCircle, { 15 } }, 230, 180),
+		add({ kSDCircle, { 15 } }, 280, 180),
+		add({ kSDPentagon, { 35 } }, 200, 65),
+		add({ kSDOrientedBox, { 120, 100, 200, 130, 8 } }, 0, 0),
+		dpad,
+		add({ kSDBox, { kScreenW / 6, kScreenH / 2 + 5 } }, 0, kScreenH / 2),
+		add({ kSDBox, { kScreenW / 6, kScreenH / 2 + 5 } }, kScreenW, kScreenH / 2),
+		add({ kSDBox, { kScreenW / 2 + 5, 5 } }, kScreenW / 2, -5),
+		add({ kSDBox, { kScreenW / 2 + 5, 5 } }, kScreenW / 2, kScreenH + 5),
+	};
+	return sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, sizeof(ids) / sizeof(ids[0])));
+}
+
+// The scene has no mirror: the mirrored circle is both circles
+int buildBlob(SDScene *scene)
+{
+	SDShape left = { kSDCircle, { 30 } }, right = left, body = { kSDBox, { 50, 20 } };
+	SDShape hex = { kSDHexagon, { 12 } }, bar = { kSDSegment, { -100, -80, 100, -80 } };
+	int a = sdSceneAddShape(scene, &left), b = sdSceneAddShape(scene, &right);
+	sdSceneSetTransform(scene, a, -60, 0, 0.0f);
+	sdSceneSetTransform(scene, b, 60, 0, 0.0f);
+	int box = sdSceneAddOp(scene, kSDRound, sdSceneAddShape(scene, &body), -1, 4);
+	sdSceneSetTransform(scene, box, 0, 0, 0.523598776f);
+	int joined = sdSceneAddOp(scene, kSDSmoothUnion, sdSceneAddOp(scene, kSDUnion, a, b, 0), box, 16);
+	int carved = sdSceneAddOp(scene, kSDSubtract, joined, sdSceneAddShape(scene, &hex), 0);
+	int root = sdSceneAddOp(scene, kSDUnion, sdSceneAddOp(scene, kSDOnion, carved, -1, 3), sdSceneAddShape(scene, &bar), 0);
+	sdSceneSetTransform(scene, root, 200, 120, 0.0f);
+	return sdSceneCompile(scene, root);
+}
+
+struct ExprRun {
+	const SDScene *scene;
+	const void *expr;
+	const float *px;
+	const float *py;
+	float *out;
+	int n;
+	float sink;
+};
+
+void runScene(void *arg)
+{
+	ExprRun *r = static_cast<ExprRun *>(arg);
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sdSceneEval(r->scene, r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+void runSceneBatch(void *arg)
+{
+	ExprRun *r = static_cast<ExprRun *>(arg);
+	sdSceneEvalBatch(r->scene, r->px, r->py, r->out, r->n);
+	r->sink = r->out[0];
+}
+
+template <class E>
+void runExpr(void *arg)
+{
+	ExprRun *r = static_cast<ExprRun *>(arg);
+	const E &e = *static_cast<const E *>(r->expr);
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += e(r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+template <class E>
+void runExprBatch(void *arg)
+{
+	ExprRun *r = static_cast<ExprRun *>(arg);
+	evalBatch(*static_cast<const E *>(r->expr), r->px, r->py, r->out, r->n);
+	r->sink = r->out[0];
+}
+
+struct ExprCase {
+	const char *name;
+	int (*build)(SDScene *scene);
+	const void *expr;
+	void (*run)(void *arg);
+	void (*runBatch)(void *arg);
+	float (*eval)(float px, float py);
+};
+
+template <class E, const E &e>
+float evalExpr(float px, float py) { return e(px, py); }
+
+template <class E, const E &e>
+constexpr ExprCase exprCase(const char *name, int (*build)(SDScene *))
+{
+	return { name, build, &e, runExpr<E>, runExprBatch<E>, evalExpr<E, e> };
+}
+
+const ExprCase exprCases[] = {
+	exprCase<decltype(collisions), collisions>("collisions level", buildCollisions),
+	exprCase<decltype(blob), blob>("blob", buildBlob),
+};
+
+} // namespace
+
+extern "C" void benchExpr(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = static_cast<float *>(malloc(n * sizeof(float)));
+	float *py = static_cast<float *>(malloc(n * sizeof(float)));
+	float *out = static_cast<float *>(malloc(n * sizeof(float)));
+	volatile float sink = 0.0f;
+	for (int i = 0; i < n; i++) {
+		px[i] = benchUniform(0.0f, kScreenW);
+		py[i] = benchUniform(0.0f, kScreenH);
+	}
+
+	for (const ExprCase &c : exprCases) {
+		if (!benchSelected(ctx, c.name)) continue;
+		SDScene scene;
+		sdSceneInit(&scene);
+		if (c.build(&scene) < 0) {
+			benchFail(ctx, "expr: %s scene build failed\n", c.name);
+			sdSceneFree(&scene);
+			continue;
+		}
+		ExprRun run = { &scene, c.expr, px, py, out, n, 0.0f };
+		double tscene = benchTime(ctx, runScene, &run);
+		sink += run.sink;
+		benchReport(ctx, "expr", c.name, "sdSceneEval", tscene * 1e9 / n);
+		double t = benchTime(ctx, runSceneBatch, &run);
+		sink += run.sink;
+		benchReport(ctx, "expr", c.name, "sdSceneEvalBatch", t * 1e9 / n);
+		double texpr = benchTime(ctx, c.run, &run);
+		sink += run.sink;
+		benchReport(ctx, "expr", c.name, "expression", texpr * 1e9 / n);
+		t = benchTime(ctx, c.runBatch, &run);
+		sink += run.sink;
+		benchReport(ctx, "expr", c.name, "evalBatch", t * 1e9 / n);
+		benchReportValue(ctx, "expr", c.name, "speedup", "x sdSceneEval", tscene / texpr);
+
+		// against the scene: the same tree, up to float rounding and sdRoundedBox for the D-pad
+		float worst = 0.0f;
+		for (int i = 0; i < n; i++) worst = std::fmax(worst, std::fabs(c.eval(px[i], py[i]) - sdSceneEval(&scene, px[i], py[i])));
+		if (!(worst <= 1e-3f)) benchFail(ctx, "expr: %s differs from the scene by %g\n", c.name, worst);
+		sdSceneFree(&scene);
+	}
+	free(px);
+	free(py);
+	free(out);
+}
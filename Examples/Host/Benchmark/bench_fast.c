@@ -0,0 +1,105 @@
+// Fast-math SDFs (sdf2d_fast.h) against their exact versions: speed over random points, and the
+// largest absolute error over a dense grid covering the screen and a margin around it, at several
+// shape parameters each. Rebuild with other SDF2D_FAST_* values to pick an accuracy/speed tradeoff.
+
+#include "bench.h"
+#include "sdf2d.h"
+#include "sdf2d_fast.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define FAST_TOLERANCE 0.01f
+#define FAST_GRID_STEP 0.5f  // px between error samples; 4x coarser with --quick
+
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+static float starX[10], starY[10];
+
+#define FAST_CASES(X) \
+	X(1, "sdEllipse 160x80", 200, 120, sdEllipse(u, v, 160, 80), sdEllipseFast(u, v, 160, 80)) \
+	X(2, "sdEllipse 150x15", 200, 120, sdEllipse(u, v, 150, 15), sdEllipseFast(u, v, 150, 15)) \
+	X(3, "sdEllipse 60x58", 200, 120, sdEllipse(u, v, 60, 58), sdEllipseFast(u, v, 60, 58)) \
+	X(11, "sdEllipse 80x79.99", 200, 120, sdEllipse(u, v, 80, 79.99f), sdEllipseFast(u, v, 80, 79.99f)) \
+	X(4, "sdParabola 0.002", 200, 120, sdParabola(u, v, 0.002f), sdParabolaFast(u, v, 0.002f)) \
+	X(5, "sdParabola 0.05", 200, 120, sdParabola(u, v, 0.05f), sdParabolaFast(u, v, 0.05f)) \
+	X(6, "sdRegularPolygon (3)", 200, 120, sdRegularPolygon(u, v, 90, 3), sdRegularPolygonFast(u, v, 90, 3)) \
+	X(7, "sdRegularPolygon (5)", 200, 120, sdRegularPolygon(u, v, 90, 5), sdRegularPolygonFast(u, v, 90, 5)) \
+	X(8, "sdRegularPolygon (12)", 200, 120, sdRegularPolygon(u, v, 110, 12), sdRegularPolygonFast(u, v, 110, 12)) \
+	X(9, "sdPolygon (4)", 0, 0, sdPolygon(u, v, vx, vy, 4), sdPolygonFast(u, v, vx, vy, 4)) \
+	X(10, "sdPolygon (10)", 0, 0, sdPolygon(u, v, starX, starY, 10), sdPolygonFast(u, v, starX, starY, 10)) \
+
+typedef struct {
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} FastRun;
+
+#define X(id, label, cx, cy, sdExpr, fastExpr) \
+	static float evalSd##id(float x, float y) { float u = x - (cx), v = y - (cy); return (sdExpr); } \
+	static float evalFast##id(float x, float y) { float u = x - (cx), v = y - (cy); return (fastExpr); } \
+	static void runSd##id(void *arg) { \
+		FastRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy); t += (sdExpr); } \
+		r->sink = t; \
+	} \
+	static void runFast##id(void *arg) { \
+		FastRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy); t += (fastExpr); } \
+		r->sink = t; \
+	}
+FAST_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	BenchEvalFunc evalSd;
+	BenchEvalFunc evalFast;
+	void (*runSd)(void *arg);
+	void (*runFast)(void *arg);
+} fastCases[] = {
+#define X(id, label, cx, cy, sdExpr, fastExpr) { label, evalSd##id, evalFast##id, runSd##id, runFast##id },
+	FAST_CASES(X)
+#undef X
+};
+
+void benchFast(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	float step = ctx->quick ? 4.0f * FAST_GRID_STEP : FAST_GRID_STEP;
+	volatile float sink = 0.0f;
+	for (int i = 0; i < 10; i++) {
+		float r = (i & 1) ? 40.0f : 100.0f, a = i * 0.6283185f;
+		starX[i] = 200.0f + r * cosf(a);
+		starY[i] = 120.0f + r * sinf(a);
+	}
+	for (size_t c = 0; c < sizeof(fastCases) / sizeof(fastCases[0]); c++) {
+		const char *name = fastCases[c].name;
+		if (!benchSelected(ctx, name)) continue;
+
+		benchPoints(kBenchRandom, fastCases[c].evalSd, px, py, n);
+		FastRun run = { px, py, n, 0.0f };
+		double tsd = benchTime(ctx, fastCases[c].runSd, &run);
+		sink += run.sink;
+		double tfast = benchTime(ctx, fastCases[c].runFast, &run);
+		sink += run.sink;
+		benchReport(ctx, "fast", name, "sd", tsd * 1e9 / n);
+		benchReport(ctx, "fast", name, "fast", tfast * 1e9 / n);
+		benchReportValue(ctx, "fast", name, "speedup", "x sd", tsd / tfast);
+
+		float maxError = 0.0f;
+		for (float y = -60.0f; y <= 300.0f; y += step)
+			for (float x = -100.0f; x <= 500.0f; x += step)
+				maxError = fmaxf(maxError, fabsf(fastCases[c].evalFast(x, y) - fastCases[c].evalSd(x, y)));
+		benchReportValue(ctx, "fast", name, "max error", "px", maxError);
+		if (!(maxError <= FAST_TOLERANCE))
+			benchFail(ctx, "fast: %s differs from sd by %g\n", name, maxError);
+	}
+	free(px);
+	free(py);
+}
@@ -0,0 +1,163 @@
+// Fixed-point SDFs (sdf2d_fixed.h) against the float ones. Shapes and parameters follow
+// bench_primitives.c, evaluated in the shape frame (u, v) = (x - cx, y - cy).
+//
+// Reports ns per call for both, and the largest difference between sdqXxx and sdXxx over random
+// and near-surface points. Parameters that do not survive quantisation (the parabola's k) are
+// passed to the float version already snapped to the fixed-point grid.
+//
+// On a host with an FPU the float version is usually faster; the fixed version pays off on cores
+// where float is emulated: build with SOFTFLOAT=1 for an ARM soft-float target (see the Makefile)
+// to measure that.
+
+#include "bench.h"
+#include "sdf2d.h"
+#include "sdf2d_fixed.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define Q(x) sdFixedConst(x)
+
+// Q16.16 resolves about 1e-5, but sqrt, CORDIC and the ellipse iterations each lose a few bits. At
+// 24.8 unit vectors and projections only carry 8 bits, about 0.4% of a 200 px shape.
+#define FIXED_TOLERANCE fmaxf(0.02f, 512.0f / SD_FIXED_ONE)
+
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+static const SDFixed qvx[] = {Q(10), Q(370), Q(190), Q(30)};
+static const SDFixed qvy[] = {Q(10), Q(115), Q(190), Q(80)};
+
+#define FIXED_CASES(X) \
+	X(1, "sdCircle", 200, 120, sdCircle(u, v, 110), sdqCircle(u, v, Q(110))) \
+	X(2, "sdSegment", 0, 0, sdSegment(u, v, 50, 220, 350, 20), sdqSegment(u, v, Q(50), Q(220), Q(350), Q(20))) \
+	X(3, "sdBox", 200, 120, sdBox(u, v, 160, 70), sdqBox(u, v, Q(160), Q(70))) \
+	X(4, "sdOrientedBox", 0, 0, sdOrientedBox(u, v, 50, 20, 350, 220, 20), sdqOrientedBox(u, v, Q(50), Q(20), Q(350), Q(220), Q(20))) \
+	X(5, "sdRoundedBox", 200, 120, sdRoundedBox(u, v, 70, 40, 10, 20, 0, 20), sdqRoundedBox(u, v, Q(70), Q(40), Q(10), Q(20), 0, Q(20))) \
+	X(6, "sdRoundSquare", 200, 120, sdRoundSquare(u, v, 100, 20), sdqRoundSquare(u, v, Q(100), Q(20))) \
+	X(7, "sdRhombus", 200, 120, sdRhombus(u, v, 100, 30), sdqRhombus(u, v, Q(100), Q(30))) \
+	X(8, "sdTrapezoid", 200, 120, sdTrapezoid(u, v, 100, 30, 40), sdqTrapezoid(u, v, Q(100), Q(30), Q(40))) \
+	X(9, "sdParallelogram", 200, 120, sdParallelogram(u, v, 150, 50, 30), sdqParallelogram(u, v, Q(150), Q(50), Q(30))) \
+	X(10, "sdEquilateralTriangle", 200, 120, sdEquilateralTriangle(u, v, 100), sdqEquilateralTriangle(u, v, Q(100))) \
+	X(11, "sdTriangleIsosceles", 200, 120, sdTriangleIsosceles(u, v, 160, 50), sdqTriangleIsosceles(u, v, Q(160), Q(50))) \
+	X(12, "sdTriangle", 0, 0, sdTriangle(u, v, 40, 10, 50, 200, 350, 80), sdqTriangle(u, v, Q(40), Q(10), Q(50), Q(200), Q(350), Q(80))) \
+	X(13, "sdQuad", 0, 0, sdQuad(u, v, 40, 10, 50, 200, 320, 180, 350, 80), sdqQuad(u, v, Q(40), Q(10), Q(50), Q(200), Q(320), Q(180), Q(350), Q(80))) \
+	X(14, "sdUnevenCapsule", 200, 120, sdUnevenCapsule(u, v, 40, 30, 80), sdqUnevenCapsule(u, v, Q(40), Q(30), Q(80))) \
+	X(15, "sdEgg", 200, 120, sdEgg(u, v, 50, 10), sdqEgg(u, v, Q(50), Q(10))) \
+	X(16, "sdPie", 200, 120, sdPie(u, v, 0.866f, -0.5f, 100), sdqPie(u, v, Q(0.866), Q(-0.5), Q(100))) \
+	X(17, "sdCutDisk", 200, 120, sdCutDisk(u, v, 100, -75), sdqCutDisk(u, v, Q(100), Q(-75))) \
+	X(18, "sdMoon", 200, 120, sdMoon(u, v, 45, 110, 90), sdqMoon(u, v, Q(45), Q(110), Q(90))) \
+	X(19, "sdVesica", 200, 120, sdVesica(u, v, 110, 60), sdqVesica(u, v, Q(110), Q(60))) \
+	X(20, "sdOrientedVesica", 0, 0, sdOrientedVesica(u, v, 110, 10, 290, 190, 30), sdqOrientedVesica(u, v, Q(110), Q(10), Q(290), Q(190), Q(30))) \
+	X(21, "sdTunnel", 200, 120, sdTunnel(u, v, 80, 40), sdqTunnel(u, v, Q(80), Q(40))) \
+	X(22, "sdArc", 200, 120, sdArc(u, v, 0.7071f, -0.7071f, 80, 10), sdqArc(u, v, Q(0.7071), Q(-0.7071), Q(80), Q(10))) \
+	X(23, "sdRing", 200, 120, sdRing(u, v, -0.7071f, 0.7071f, 100, 10), sdqRing(u, v, Q(-0.7071), Q(0.7071), Q(100), Q(10))) \
+	X(24, "sdHorseshoe", 200, 120, sdHorseshoe(u, v, 0, 1, 80, 100, 5), sdqHorseshoe(u, v, 0, Q(1), Q(80), Q(100), Q(5))) \
+	X(25, "sdParabola", 200, 120, sdParabola(u, v, sdFixedToFloat(Q(0.002))), sdqParabola(u, v, Q(0.002))) \
+	X(26, "sdCross", 200, 120, sdCross(u, v, 100, 40, 14), sdqCross(u, v, Q(100), Q(40), Q(14))) \
+	X(27, "sdRoundedX", 200, 120, sdRoundedX(u, v, 180, 20), sdqRoundedX(u, v, Q(180), Q(20))) \
+	X(28, "sdEllipse", 200, 120, sdEllipse(u, v, 160, 80), sdqEllipse(u, v, Q(160), Q(80))) \
+	X(29, "sdStar5", 200, 120, sdStar5(u, v, 35, 3), sdqStar5(u, v, Q(35), Q(3))) \
+	X(30, "sdHexagram", 200, 120, sdHexagram(u, v, 45), sdqHexagram(u, v, Q(45))) \
+	X(31, "sdPentagon", 200, 120, sdPentagon(u, v, 90), sdqPentagon(u, v, Q(90))) \
+	X(32, "sdRegularPolygon (5)", 200, 120, sdRegularPolygon(u, v, 90, 5), sdqRegularPolygon(u, v, Q(90), 5)) \
+	X(33, "sdHexagon", 200, 120, sdHexagon(u, v, 90), sdqHexagon(u, v, Q(90))) \
+	X(34, "sdRegularPolygon (6)", 200, 120, sdRegularPolygon(u, v, 90, 6), sdqRegularPolygon(u, v, Q(90), 6)) \
+	X(35, "sdOctagon", 200, 120, sdOctagon(u, v, 90), sdqOctagon(u, v, Q(90))) \
+	X(36, "sdRegularPolygon (8)", 200, 120, sdRegularPolygon(u, v, 90, 8), sdqRegularPolygon(u, v, Q(90), 8)) \
+	X(37, "sdPolygon (4)", 0, 0, sdPolygon(u, v, vx, vy, 4), sdqPolygon(u, v, qvx, qvy, 4)) \
+	X(38, "sdSegmentLinf", 0, 0, sdSegmentLinf(u, v, 50, 220, 350, 20), sdqSegmentLinf(u, v, Q(50), Q(220), Q(350), Q(20))) \
+	X(39, "sdBoxLinf", 200, 120, sdBoxLinf(u, v, 160, 70), sdqBoxLinf(u, v, Q(160), Q(70))) \
+	X(40, "sdRhombusLinf", 200, 120, sdRhombusLinf(u, v, 100, 30), sdqRhombusLinf(u, v, Q(100), Q(30))) \
+	X(41, "sdEllipseLinf", 200, 120, sdEllipseLinf(u, v, 160, 80), sdqEllipseLinf(u, v, Q(160), Q(80))) \
+
+typedef struct {
+	const float *px;
+	const float *py;
+	const SDFixed *qx;
+	const SDFixed *qy;
+	int n;
+	float sink;
+} FixedRun;
+
+#define X(id, label, cx, cy, sdExpr, sdqExpr) \
+	static float eval##id(float x, float y) { float u = x - (cx), v = y - (cy); return (sdExpr); } \
+	static SDFixed evalq##id(SDFixed x, SDFixed y) { SDFixed u = x - Q(cx), v = y - Q(cy); return (sdqExpr); } \
+	static void runSd##id(void *arg) { \
+		FixedRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy); t += (sdExpr); } \
+		r->sink = t; \
+	} \
+	static void runSdq##id(void *arg) { \
+		FixedRun *r = arg; \
+		int64_t t = 0; \
+		for (int i = 0; i < r->n; i++) { SDFixed u = r->qx[i] - Q(cx), v = r->qy[i] - Q(cy); t += (sdqExpr); } \
+		r->sink = (float)t; \
+	}
+FIXED_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	BenchEvalFunc eval;
+	SDFixed (*evalq)(SDFixed x, SDFixed y);
+	void (*runSd)(void *arg);
+	void (*runSdq)(void *arg);
+} fixedCases[] = {
+#define X(id, label, cx, cy, sdExpr, sdqExpr) { label, eval##id, evalq##id, runSd##id, runSdq##id },
+	FIXED_CASES(X)
+#undef X
+};
+
+// Points are snapped to the fixed-point grid so that both versions see the same input
+static void fixedPoints(BenchDist dist, BenchEvalFunc f, float *px, float *py, SDFixed *qx, SDFixed *qy, int n)
+{
+	benchPoints(dist, f, px, py, n);
+	for (int i = 0; i < n; i++) {
+		qx[i] = sdFixedFromFloat(px[i]);
+		qy[i] = sdFixedFromFloat(py[i]);
+		px[i] = sdFixedToFloat(qx[i]);
+		py[i] = sdFixedToFloat(qy[i]);
+	}
+}
+
+void benchFixed(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	SDFixed *qx = malloc(n * sizeof(SDFixed));
+	SDFixed *qy = malloc(n * sizeof(SDFixed));
+	volatile float sink = 0.0f;
+	for (size_t c = 0; c < sizeof(fixedCases) / sizeof(fixedCases[0]); c++) {
+		const char *name = fixedCases[c].name;
+		if (!benchSelected(ctx, name)) continue;
+
+		fixedPoints(kBenchRandom, fixedCases[c].eval, px, py, qx, qy, n);
+		FixedRun run = { px, py, qx, qy, n, 0.0f };
+		double tsd = benchTime(ctx, fixedCases[c].runSd, &run);
+		sink += run.sink;
+		double tsdq = benchTime(ctx, fixedCases[c].runSdq, &run);
+		sink += run.sink;
+		benchReport(ctx, "fixed", name, "float", tsd * 1e9 / n);
+		benchReport(ctx, "fixed", name, "fixed", tsdq * 1e9 / n);
+		benchReportValue(ctx, "fixed", name, "speedup", "x float", tsd / tsdq);
+
+		float maxError = 0.0f;
+		for (int dist = kBenchRandom; dist <= kBenchSurface; dist += kBenchSurface - kBenchRandom) {
+			fixedPoints((BenchDist)dist, fixedCases[c].eval, px, py, qx, qy, n);
+			for (int i = 0; i < n; i++) {
+				float d = fixedCases[c].eval(px[i], py[i]);
+				float e = fabsf(sdFixedToFloat(fixedCases[c].evalq(qx[i], qy[i])) - d);
+				maxError = fmaxf(maxError, e);
+			}
+		}
+		benchReportValue(ctx, "fixed", name, "max error", "px", maxError);
+		if (maxError > FIXED_TOLERANCE)
+			benchFail(ctx, "fixed: %s error %g exceeds %g\n", name, maxError, FIXED_TOLERANCE);
+	}
+	free(px);
+	free(py);
+	free(qx);
+	free(qy);
+}
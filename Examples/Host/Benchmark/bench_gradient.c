@@ -0,0 +1,172 @@
+// Cost and accuracy of the sdg* gradient functions against the plain sd* calls. Shapes and
+// parameters follow bench_primitives.c, evaluated in the shape frame (u, v) = (x - cx, y - cy).
+//
+// Accuracy: the distance must match sdXxx, and the gradient must match central differences
+// wherever the function is smooth, ie where the forward and backward differences agree. Points
+// within GRAD_SURFACE of the surface are skipped: there the closest point vector is a few ulps
+// long and its direction is float noise. sdEllipse is itself approximate (three iterations), so a
+// handful of its points disagree with the differences near the ends of the major axis.
+
+#include "bench.h"
+#include "sdf2d.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define GRAD_STEP 0.01f
+#define GRAD_TOLERANCE 0.02f
+#define GRAD_SURFACE 0.01f
+
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+
+#define GRADIENT_CASES(X) \
+	X(1, "sdCircle", 200, 120, sdCircle(u, v, 110), sdgCircle(u, v, 110, &gx, &gy)) \
+	X(2, "sdSegment", 0, 0, sdSegment(u, v, 50, 220, 350, 20), sdgSegment(u, v, 50, 220, 350, 20, &gx, &gy)) \
+	X(3, "sdBox", 200, 120, sdBox(u, v, 160, 70), sdgBox(u, v, 160, 70, &gx, &gy)) \
+	X(4, "sdOrientedBox", 0, 0, sdOrientedBox(u, v, 50, 20, 350, 220, 20), sdgOrientedBox(u, v, 50, 20, 350, 220, 20, &gx, &gy)) \
+	X(5, "sdRoundedBox", 200, 120, sdRoundedBox(u, v, 70, 40, 10, 20, 0, 20), sdgRoundedBox(u, v, 70, 40, 10, 20, 0, 20, &gx, &gy)) \
+	X(6, "sdRoundSquare", 200, 120, sdRoundSquare(u, v, 100, 20), sdgRoundSquare(u, v, 100, 20, &gx, &gy)) \
+	X(7, "sdRhombus", 200, 120, sdRhombus(u, v, 100, 30), sdgRhombus(u, v, 100, 30, &gx, &gy)) \
+	X(8, "sdTrapezoid", 200, 120, sdTrapezoid(u, v, 100, 30, 40), sdgTrapezoid(u, v, 100, 30, 40, &gx, &gy)) \
+	X(9, "sdParallelogram", 200, 120, sdParallelogram(u, v, 150, 50, 30), sdgParallelogram(u, v, 150, 50, 30, &gx, &gy)) \
+	X(10, "sdEquilateralTriangle", 200, 120, sdEquilateralTriangle(u, v, 100), sdgEquilateralTriangle(u, v, 100, &gx, &gy)) \
+	X(11, "sdTriangleIsosceles", 200, 120, sdTriangleIsosceles(u, v, 160, 50), sdgTriangleIsosceles(u, v, 160, 50, &gx, &gy)) \
+	X(12, "sdTriangle", 0, 0, sdTriangle(u, v, 40, 10, 50, 200, 350, 80), sdgTriangle(u, v, 40, 10, 50, 200, 350, 80, &gx, &gy)) \
+	X(13, "sdQuad", 0, 0, sdQuad(u, v, 40, 10, 50, 200, 320, 180, 350, 80), sdgQuad(u, v, 40, 10, 50, 200, 320, 180, 350, 80, &gx, &gy)) \
+	X(14, "sdUnevenCapsule", 200, 120, sdUnevenCapsule(u, v, 40, 30, 80), sdgUnevenCapsule(u, v, 40, 30, 80, &gx, &gy)) \
+	X(15, "sdEgg", 200, 120, sdEgg(u, v, 50, 10), sdgEgg(u, v, 50, 10, &gx, &gy)) \
+	X(16, "sdPie", 200, 120, sdPie(u, v, 0.866f, -0.5f, 100), sdgPie(u, v, 0.866f, -0.5f, 100, &gx, &gy)) \
+	X(17, "sdCutDisk", 200, 120, sdCutDisk(u, v, 100, -75), sdgCutDisk(u, v, 100, -75, &gx, &gy)) \
+	X(18, "sdMoon", 200, 120, sdMoon(u, v, 45, 110, 90), sdgMoon(u, v, 45, 110, 90, &gx, &gy)) \
+	X(19, "sdVesica", 200, 120, sdVesica(u, v, 110, 60), sdgVesica(u, v, 110, 60, &gx, &gy)) \
+	X(20, "sdOrientedVesica", 0, 0, sdOrientedVesica(u, v, 110, 10, 290, 190, 30), sdgOrientedVesica(u, v, 110, 10, 290, 190, 30, &gx, &gy)) \
+	X(21, "sdTunnel", 200, 120, sdTunnel(u, v, 80, 40), sdgTunnel(u, v, 80, 40, &gx, &gy)) \
+	X(22, "sdArc", 200, 120, sdArc(u, v, 0.7071f, -0.7071f, 80, 10), sdgArc(u, v, 0.7071f, -0.7071f, 80, 10, &gx, &gy)) \
+	X(23, "sdRing", 200, 120, sdRing(u, v, -0.7071f, 0.7071f, 100, 10), sdgRing(u, v, -0.7071f, 0.7071f, 100, 10, &gx, &gy)) \
+	X(24, "sdHorseshoe", 200, 120, sdHorseshoe(u, v, 0, 1, 80, 100, 5), sdgHorseshoe(u, v, 0, 1, 80, 100, 5, &gx, &gy)) \
+	X(25, "sdParabola", 200, 120, sdParabola(u, v, 0.002f), sdgParabola(u, v, 0.002f, &gx, &gy)) \
+	X(26, "sdCross", 200, 120, sdCross(u, v, 100, 40, 14), sdgCross(u, v, 100, 40, 14, &gx, &gy)) \
+	X(27, "sdRoundedX", 200, 120, sdRoundedX(u, v, 180, 20), sdgRoundedX(u, v, 180, 20, &gx, &gy)) \
+	X(28, "sdEllipse", 200, 120, sdEllipse(u, v, 160, 80), sdgEllipse(u, v, 160, 80, &gx, &gy)) \
+	X(29, "sdStar5", 200, 120, sdStar5(u, v, 35, 3), sdgStar5(u, v, 35, 3, &gx, &gy)) \
+	X(30, "sdHexagram", 200, 120, sdHexagram(u, v, 45), sdgHexagram(u, v, 45, &gx, &gy)) \
+	X(31, "sdPentagon", 200, 120, sdPentagon(u, v, 90), sdgPentagon(u, v, 90, &gx, &gy)) \
+	X(32, "sdRegularPolygon (5)", 200, 120, sdRegularPolygon(u, v, 90, 5), sdgRegularPolygon(u, v, 90, 5, &gx, &gy)) \
+	X(33, "sdHexagon", 200, 120, sdHexagon(u, v, 90), sdgHexagon(u, v, 90, &gx, &gy)) \
+	X(34, "sdRegularPolygon (6)", 200, 120, sdRegularPolygon(u, v, 90, 6), sdgRegularPolygon(u, v, 90, 6, &gx, &gy)) \
+	X(35, "sdOctagon", 200, 120, sdOctagon(u, v, 90), sdgOctagon(u, v, 90, &gx, &gy)) \
+	X(36, "sdRegularPolygon (8)", 200, 120, sdRegularPolygon(u, v, 90, 8), sdgRegularPolygon(u, v, 90, 8, &gx, &gy)) \
+	X(37, "sdPolygon (4)", 0, 0, sdPolygon(u, v, vx, vy, 4), sdgPolygon(u, v, vx, vy, 4, &gx, &gy)) \
+	X(38, "sdSegmentLinf", 0, 0, sdSegmentLinf(u, v, 50, 220, 350, 20), sdgSegmentLinf(u, v, 50, 220, 350, 20, &gx, &gy)) \
+	X(39, "sdBoxLinf", 200, 120, sdBoxLinf(u, v, 160, 70), sdgBoxLinf(u, v, 160, 70, &gx, &gy)) \
+	X(40, "sdRhombusLinf", 200, 120, sdRhombusLinf(u, v, 100, 30), sdgRhombusLinf(u, v, 100, 30, &gx, &gy)) \
+	X(41, "sdEllipseLinf", 200, 120, sdEllipseLinf(u, v, 160, 80), sdgEllipseLinf(u, v, 160, 80, &gx, &gy)) \
+	X(42, "sdBezier", 0, 0, sdBezier(u, v, 50, 220, 200, -100, 350, 220, 10), sdgBezier(u, v, 50, 220, 200, -100, 350, 220, 10, &gx, &gy)) \
+	X(43, "sdParabola (k < 0)", 200, 120, sdParabola(u, v, -0.002f), sdgParabola(u, v, -0.002f, &gx, &gy)) \
+
+typedef struct {
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} GradientRun;
+
+#define X(id, label, cx, cy, sdExpr, sdgExpr) \
+	static float eval##id(float x, float y) { float u = x - (cx), v = y - (cy); return (sdExpr); } \
+	static float grad##id(float x, float y, float *pgx, float *pgy) { \
+		float u = x - (cx), v = y - (cy), gx, gy; \
+		float d = (sdgExpr); \
+		*pgx = gx; \
+		*pgy = gy; \
+		return d; \
+	} \
+	static void runSd##id(void *arg) { \
+		GradientRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy); t += (sdExpr); } \
+		r->sink = t; \
+	} \
+	static void runSdg##id(void *arg) { \
+		GradientRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy), gx, gy; t += (sdgExpr) + gx + gy; } \
+		r->sink = t; \
+	}
+GRADIENT_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	BenchEvalFunc eval;
+	float (*grad)(float x, float y, float *gx, float *gy);
+	void (*runSd)(void *arg);
+	void (*runSdg)(void *arg);
+} gradientCases[] = {
+#define X(id, label, cx, cy, sdExpr, sdgExpr) { label, eval##id, grad##id, runSd##id, runSdg##id },
+	GRADIENT_CASES(X)
+#undef X
+};
+
+// Central difference of f at (x, y) with step h. Returns 0 if the forward and backward differences
+// disagree, ie there is a kink within h of (x, y) and the difference is meaningless.
+static int gradientDiff(BenchEvalFunc f, float x, float y, float h, float *gx, float *gy)
+{
+	float d = f(x, y);
+	float fx = (f(x + h, y) - d) / h;
+	float bx = (d - f(x - h, y)) / h;
+	float fy = (f(x, y + h) - d) / h;
+	float by = (d - f(x, y - h)) / h;
+	*gx = (fx + bx) * 0.5f;
+	*gy = (fy + by) * 0.5f;
+	return fabsf(fx - bx) + fabsf(fy - by) < GRAD_TOLERANCE * 0.5f;
+}
+
+void benchGradient(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+	for (size_t c = 0; c < sizeof(gradientCases) / sizeof(gradientCases[0]); c++) {
+		const char *name = gradientCases[c].name;
+		if (!benchSelected(ctx, name)) continue;
+
+		benchPoints(kBenchRandom, gradientCases[c].eval, px, py, n);
+		GradientRun run = { px, py, n, 0.0f };
+		double tsd = benchTime(ctx, gradientCases[c].runSd, &run);
+		sink += run.sink;
+		double tsdg = benchTime(ctx, gradientCases[c].runSdg, &run);
+		sink += run.sink;
+		benchReport(ctx, "gradient", name, "sd", tsd * 1e9 / n);
+		benchReport(ctx, "gradient", name, "sdg", tsdg * 1e9 / n);
+		benchReportValue(ctx, "gradient", name, "cost", "x sd", tsdg / tsd);
+
+		// accuracy over random and near-surface points, where most of the branches are
+		float maxDist = 0.0f;
+		float maxGrad = 0.0f;
+		int checked = 0;
+		int failed = 0;
+		for (int dist = kBenchRandom; dist <= kBenchSurface; dist += kBenchSurface - kBenchRandom) {
+			benchPoints((BenchDist)dist, gradientCases[c].eval, px, py, n);
+			for (int i = 0; i < n; i++) {
+				float gx, gy, fx, fy;
+				float d = gradientCases[c].grad(px[i], py[i], &gx, &gy);
+				maxDist = fmaxf(maxDist, fabsf(d - gradientCases[c].eval(px[i], py[i])));
+				if (fabsf(d) < GRAD_SURFACE) continue;
+				if (!gradientDiff(gradientCases[c].eval, px[i], py[i], GRAD_STEP, &fx, &fy)) continue;
+				float e = fmaxf(fabsf(gx - fx), fabsf(gy - fy));
+				maxGrad = fmaxf(maxGrad, e);
+				checked++;
+				if (e > GRAD_TOLERANCE) failed++;
+			}
+		}
+		benchReportValue(ctx, "gradient", name, "dist error", "px", maxDist);
+		benchReportValue(ctx, "gradient", name, "grad error", "max", maxGrad);
+		benchReportValue(ctx, "gradient", name, "grad fails", "points", failed);
+		if (failed * 1000 > checked || maxDist > 1e-3f)
+			benchFail(ctx, "gradient: %s fails %d of %d checked points\n", name, failed, checked);
+	}
+	free(px);
+	free(py);
+}
@@ -0,0 +1,150 @@
+// Baked grid benchmark: lookups in int8/uint16/float grids, dense and narrow band, against the exact
+// SDFs they were baked from. Also checks the documented error bound and reports the memory used.
+
+#include "bench.h"
+#include "sdf2d_grid.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define GRID_CELL 2.0f
+#define GRID_RANGE 16.0f
+#define GRID_CIRCLES 30
+
+typedef struct {
+	const char *name;
+	SDShape shape;       // kSDShapeCount: the scene
+	float x, y;
+} GridCase;
+
+typedef struct {
+	const GridCase *c;
+	const SDScene *scene;
+	const SDGrid *grid;
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} GridRun;
+
+static GridRun *gridBench;
+
+static float gridEvalExact(float x, float y)
+{
+	const GridCase *c = gridBench->c;
+	if (c->shape.type == kSDShapeCount) return sdSceneEval(gridBench->scene, x, y);
+	return sdShapeEval(&c->shape, x - c->x, y - c->y);
+}
+
+static void runExact(void *arg)
+{
+	GridRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += gridEvalExact(r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+static void runGrid(void *arg)
+{
+	GridRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sdGridEval(r->grid, r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+static void runGridGrad(void *arg)
+{
+	GridRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) {
+		float gx, gy;
+		t += sdgGridEval(r->grid, r->px[i], r->py[i], &gx, &gy) + gx + gy;
+	}
+	r->sink = t;
+}
+
+static void buildTerrain(SDScene *scene)
+{
+	int ids[GRID_CIRCLES];
+	sdSceneInit(scene);
+	for (int i = 0; i < GRID_CIRCLES; i++) {
+		ids[i] = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { benchUniform(8, 30) } });
+		sdSceneSetTransform(scene, ids[i], benchUniform(0, 400), benchUniform(160, 240), 0.0f);
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, GRID_CIRCLES));
+}
+
+void benchGrid(BenchContext *ctx)
+{
+	static const GridCase cases[] = {
+		{ "sdEllipse", { kSDEllipse, { 160, 80 } }, 200, 120 },
+		{ "sdRegularPolygon (5)", { kSDRegularPolygon, { 90 }, 5 }, 200, 120 },
+		{ "terrain scene", { kSDShapeCount }, 0, 0 },
+	};
+	static const char *formats[] = { "int8", "uint16", "float" };
+	char variant[32];
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+	SDScene scene;
+	buildTerrain(&scene);
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		if (!benchSelected(ctx, cases[c].name)) continue;
+		GridRun run = { &cases[c], &scene, NULL, px, py, n, 0.0f };
+		gridBench = &run;
+		benchPoints(kBenchRandom, gridEvalExact, px, py, n);
+		double t = benchTime(ctx, runExact, &run);
+		sink += run.sink;
+		benchReport(ctx, "grid", cases[c].name, "exact", t * 1e9 / n);
+
+		for (int narrow = 0; narrow <= 1; narrow++) {
+			for (int f = kSDGridInt8; f <= kSDGridFloat; f++) {
+				SDGridLayout layout = { (SDGridFormat)f, 0, 0, 201, 121, GRID_CELL, GRID_RANGE, narrow };
+				SDGrid grid;
+				sdGridInit(&grid);
+				double t0 = benchNow();
+				int r = cases[c].shape.type == kSDShapeCount ?
+					sdGridBakeScene(&grid, &layout, &scene) :
+					sdGridBakeShape(&grid, &layout, &cases[c].shape, cases[c].x, cases[c].y);
+				double bake = benchNow() - t0;
+				if (r < 0) {
+					benchFail(ctx, "grid: %s bake failed\n", cases[c].name);
+					continue;
+				}
+				run.grid = &grid;
+				snprintf(variant, sizeof(variant), "%s%s", formats[f], narrow ? " band" : "");
+				t = benchTime(ctx, runGrid, &run);
+				sink += run.sink;
+				benchReport(ctx, "grid", cases[c].name, variant, t * 1e9 / n);
+				t = benchTime(ctx, runGridGrad, &run);
+				sink += run.sink;
+				snprintf(variant, sizeof(variant), "%s%s grad", formats[f], narrow ? " band" : "");
+				benchReport(ctx, "grid", cases[c].name, variant, t * 1e9 / n);
+
+				// the bound holds wherever the exact distance is within range
+				float maxError = 0.0f;
+				for (int dist = kBenchRandom; dist <= kBenchSurface; dist += kBenchSurface - kBenchRandom) {
+					benchPoints((BenchDist)dist, gridEvalExact, px, py, n);
+					for (int i = 0; i < n; i++) {
+						float d = gridEvalExact(px[i], py[i]);
+						if (fabsf(d) <= GRID_RANGE) maxError = fmaxf(maxError, fabsf(sdGridEval(&grid, px[i], py[i]) - d));
+					}
+				}
+				snprintf(variant, sizeof(variant), "%s%s", formats[f], narrow ? " band" : "");
+				benchReportValue(ctx, "grid", cases[c].name, variant, "bake ms", bake * 1e3);
+				benchReportValue(ctx, "grid", cases[c].name, variant, "bytes", (double)(grid.bytes + grid.tilesX * grid.tilesY * sizeof(int)));
+				benchReportValue(ctx, "grid", cases[c].name, variant, "max error", maxError);
+				benchReportValue(ctx, "grid", cases[c].name, variant, "error bound", grid.error);
+				if (maxError > grid.error)
+					benchFail(ctx, "grid: %s %s error %g exceeds the bound %g\n", cases[c].name, variant, maxError, grid.error);
+				benchPoints(kBenchRandom, gridEvalExact, px, py, n);
+				sdGridFree(&grid);
+			}
+		}
+	}
+	sdSceneFree(&scene);
+	free(px);
+	free(py);
+}
@@ -0,0 +1,164 @@
+// Large polygon benchmark: a wavy closed outline at 4, 64, 1024 and 16384 vertices, evaluated with
+// sdPolygon, the prepared sdPolygonEval and an SDPolygonIndex. Reports ns per point, the build time
+// of the index and the cost of sdPolygonIndexInside alone. Points are uniform over the polygon's
+// bounds grown by a quarter. The index is checked against sdPolygon, distance and sign.
+
+#include "bench.h"
+#include "sdf2d.h"
+#include "sdf2d_polygon.h"
+#include "sdf2d_prep.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define POLYGON_RADIUS 100.0f
+
+typedef struct {
+	float *vx, *vy;       // sdPolygon takes them non-const
+	int num;
+	SDPolygonPrep prep;
+	SDPolygonIndex index;
+	const float *px;
+	const float *py;
+	float *out;
+	int n;
+	float sink;
+} PolygonRun;
+
+static void runPolygon(void *arg)
+{
+	PolygonRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sdPolygon(r->px[i], r->py[i], r->vx, r->vy, r->num);
+	r->sink = t;
+}
+
+static void runPrep(void *arg)
+{
+	PolygonRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sdPolygonEval(&r->prep, r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+static void runIndex(void *arg)
+{
+	PolygonRun *r = arg;
+	sdPolygonIndexEvalBatch(&r->index, r->px, r->py, r->out, r->n);
+	r->sink = r->out[0];
+}
+
+static void runGrad(void *arg)
+{
+	PolygonRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) {
+		float gx, gy;
+		t += sdgPolygonIndexEval(&r->index, r->px[i], r->py[i], &gx, &gy) + gx + gy;
+	}
+	r->sink = t;
+}
+
+static void runInside(void *arg)
+{
+	PolygonRun *r = arg;
+	int t = 0;
+	for (int i = 0; i < r->n; i++) t += sdPolygonIndexInside(&r->index, r->px[i], r->py[i]);
+	r->sink = (float)t;
+}
+
+static void runBuild(void *arg)
+{
+	PolygonRun *r = arg;
+	SDPolygonIndex index;
+	sdPolygonIndexInit(&index);
+	sdPolygonIndexBuild(&index, r->vx, r->vy, r->num);
+	sdPolygonIndexFree(&index);
+}
+
+void benchPolygon(BenchContext *ctx)
+{
+	static const int sizes[] = { 4, 64, 1024, 16384 };
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	float *out = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+
+	for (size_t c = 0; c < sizeof(sizes) / sizeof(sizes[0]); c++) {
+		int num = sizes[c];
+		char name[32];
+		snprintf(name, sizeof(name), "sdPolygon (%d)", num);
+		if (!benchSelected(ctx, name)) continue;
+		float *vx = malloc(num * sizeof(float));
+		float *vy = malloc(num * sizeof(float));
+		float *edges = malloc(3 * num * sizeof(float));
+		// a coastline: a lobed circle with fine ripples, so the edges vary in length and direction
+		for (int i = 0; i < num; i++) {
+			float a = 6.2831853f * i / num;
+			float r = POLYGON_RADIUS * (1.0f + 0.3f * sinf(5.0f * a) + 0.05f * sinf(37.0f * a));
+			vx[i] = r * cosf(a);
+			vy[i] = r * sinf(a);
+		}
+		float lo = -1.25f * 1.35f * POLYGON_RADIUS, hi = -lo;
+		for (int i = 0; i < n; i++) {
+			px[i] = benchUniform(lo, hi);
+			py[i] = benchUniform(lo, hi);
+		}
+
+		PolygonRun run = { vx, vy, num };
+		sdPolygonPrepare(&run.prep, vx, vy, num, edges);
+		sdPolygonIndexInit(&run.index);
+		if (sdPolygonIndexBuild(&run.index, vx, vy, num) < 0) {
+			benchFail(ctx, "polygon: %s build failed\n", name);
+			free(vx);
+			free(vy);
+			free(edges);
+			continue;
+		}
+		run.px = px;
+		run.py = py;
+		run.out = out;
+		// the linear versions visit every edge: fewer points keep the large cases quick
+		run.n = num > 1024 ? (n < 256 ? n : 256) : n;
+		double t = benchTime(ctx, runPolygon, &run);
+		sink += run.sink;
+		benchReport(ctx, "polygon", name, "sdPolygon", t * 1e9 / run.n);
+		t = benchTime(ctx, runPrep, &run);
+		sink += run.sink;
+		benchReport(ctx, "polygon", name, "sdPolygonEval", t * 1e9 / run.n);
+		run.n = n;
+		t = benchTime(ctx, runIndex, &run);
+		sink += run.sink;
+		benchReport(ctx, "polygon", name, "sdPolygonIndexEval", t * 1e9 / n);
+		t = benchTime(ctx, runGrad, &run);
+		sink += run.sink;
+		benchReport(ctx, "polygon", name, "sdgPolygonIndexEval", t * 1e9 / n);
+		t = benchTime(ctx, runInside, &run);
+		sink += run.sink;
+		benchReport(ctx, "polygon", name, "sdPolygonIndexInside", t * 1e9 / n);
+		t = benchTime(ctx, runBuild, &run);
+		benchReportValue(ctx, "polygon", name, "sdPolygonIndexBuild", "ms/build", t * 1e3);
+
+		// against sdPolygon: distances to float rounding, and the sign away from the surface
+		int checks = num > 1024 ? (n < 4096 ? n : 4096) : n, wrong = 0;
+		float worst = 0.0f;
+		sdPolygonIndexEvalBatch(&run.index, px, py, out, checks);
+		for (int i = 0; i < checks; i++) {
+			float d = sdPolygon(px[i], py[i], vx, vy, num);
+			worst = fmaxf(worst, fabsf(fabsf(out[i]) - fabsf(d)) / (1.0f + fabsf(d)));
+			if (fabsf(d) > 1e-3f && (out[i] < 0.0f) != (d < 0.0f)) wrong++;
+			if (fabsf(d) > 1e-3f && sdPolygonIndexInside(&run.index, px[i], py[i]) != (d < 0.0f)) wrong++;
+		}
+		if (worst > 1e-4f) benchFail(ctx, "polygon: %s distance differs from sdPolygon by %g\n", name, worst);
+		if (wrong) benchFail(ctx, "polygon: %s sign differs from sdPolygon at %d points\n", name, wrong);
+
+		sdPolygonIndexFree(&run.index);
+		free(vx);
+		free(vy);
+		free(edges);
+	}
+	free(px);
+	free(py);
+	free(out);
+}
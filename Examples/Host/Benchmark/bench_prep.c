@@ -0,0 +1,134 @@
+// Prepared shapes (sdf2d_prep.h) against the plain sdXxx calls. Shapes and parameters follow
+// bench_primitives.c, evaluated in the shape frame (u, v) = (x - cx, y - cy). The prepared runs
+// call sdXxxPrepare once per run, as an app would once per frame, then sdXxxEval per point.
+//
+// Also checks that the prepared result matches sdXxx, which it should to within float rounding.
+
+#include "bench.h"
+#include "sdf2d.h"
+#include "sdf2d_prep.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define PREP_TOLERANCE 1e-3f
+
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+static float polyEdges[3 * 4];
+
+#define PREP_CASES(X) \
+	X(1, "sdCircle", 200, 120, sdCircle(u, v, 110), SDCirclePrep, sdCirclePrepare(&s, 110), sdCircleEval) \
+	X(2, "sdSegment", 0, 0, sdSegment(u, v, 50, 220, 350, 20), SDSegmentPrep, sdSegmentPrepare(&s, 50, 220, 350, 20), sdSegmentEval) \
+	X(3, "sdBox", 200, 120, sdBox(u, v, 160, 70), SDBoxPrep, sdBoxPrepare(&s, 160, 70), sdBoxEval) \
+	X(4, "sdOrientedBox", 0, 0, sdOrientedBox(u, v, 50, 20, 350, 220, 20), SDOrientedBoxPrep, sdOrientedBoxPrepare(&s, 50, 20, 350, 220, 20), sdOrientedBoxEval) \
+	X(5, "sdRoundedBox", 200, 120, sdRoundedBox(u, v, 70, 40, 10, 20, 0, 20), SDRoundedBoxPrep, sdRoundedBoxPrepare(&s, 70, 40, 10, 20, 0, 20), sdRoundedBoxEval) \
+	X(6, "sdRoundSquare", 200, 120, sdRoundSquare(u, v, 100, 20), SDRoundSquarePrep, sdRoundSquarePrepare(&s, 100, 20), sdRoundSquareEval) \
+	X(7, "sdRhombus", 200, 120, sdRhombus(u, v, 100, 30), SDRhombusPrep, sdRhombusPrepare(&s, 100, 30), sdRhombusEval) \
+	X(8, "sdTrapezoid", 200, 120, sdTrapezoid(u, v, 100, 30, 40), SDTrapezoidPrep, sdTrapezoidPrepare(&s, 100, 30, 40), sdTrapezoidEval) \
+	X(9, "sdParallelogram", 200, 120, sdParallelogram(u, v, 150, 50, 30), SDParallelogramPrep, sdParallelogramPrepare(&s, 150, 50, 30), sdParallelogramEval) \
+	X(10, "sdEquilateralTriangle", 200, 120, sdEquilateralTriangle(u, v, 100), SDEquilateralTrianglePrep, sdEquilateralTrianglePrepare(&s, 100), sdEquilateralTriangleEval) \
+	X(11, "sdTriangleIsosceles", 200, 120, sdTriangleIsosceles(u, v, 160, 50), SDTriangleIsoscelesPrep, sdTriangleIsoscelesPrepare(&s, 160, 50), sdTriangleIsoscelesEval) \
+	X(12, "sdTriangle", 0, 0, sdTriangle(u, v, 40, 10, 50, 200, 350, 80), SDTrianglePrep, sdTrianglePrepare(&s, 40, 10, 50, 200, 350, 80), sdTriangleEval) \
+	X(13, "sdQuad", 0, 0, sdQuad(u, v, 40, 10, 50, 200, 320, 180, 350, 80), SDQuadPrep, sdQuadPrepare(&s, 40, 10, 50, 200, 320, 180, 350, 80), sdQuadEval) \
+	X(14, "sdUnevenCapsule", 200, 120, sdUnevenCapsule(u, v, 40, 30, 80), SDUnevenCapsulePrep, sdUnevenCapsulePrepare(&s, 40, 30, 80), sdUnevenCapsuleEval) \
+	X(15, "sdEgg", 200, 120, sdEgg(u, v, 50, 10), SDEggPrep, sdEggPrepare(&s, 50, 10), sdEggEval) \
+	X(16, "sdPie", 200, 120, sdPie(u, v, 0.866f, -0.5f, 100), SDPiePrep, sdPiePrepare(&s, 0.866f, -0.5f, 100), sdPieEval) \
+	X(17, "sdCutDisk", 200, 120, sdCutDisk(u, v, 100, -75), SDCutDiskPrep, sdCutDiskPrepare(&s, 100, -75), sdCutDiskEval) \
+	X(18, "sdMoon", 200, 120, sdMoon(u, v, 45, 110, 90), SDMoonPrep, sdMoonPrepare(&s, 45, 110, 90), sdMoonEval) \
+	X(19, "sdVesica", 200, 120, sdVesica(u, v, 110, 60), SDVesicaPrep, sdVesicaPrepare(&s, 110, 60), sdVesicaEval) \
+	X(20, "sdOrientedVesica", 0, 0, sdOrientedVesica(u, v, 110, 10, 290, 190, 30), SDOrientedVesicaPrep, sdOrientedVesicaPrepare(&s, 110, 10, 290, 190, 30), sdOrientedVesicaEval) \
+	X(21, "sdTunnel", 200, 120, sdTunnel(u, v, 80, 40), SDTunnelPrep, sdTunnelPrepare(&s, 80, 40), sdTunnelEval) \
+	X(22, "sdArc", 200, 120, sdArc(u, v, 0.7071f, -0.7071f, 80, 10), SDArcPrep, sdArcPrepare(&s, 0.7071f, -0.7071f, 80, 10), sdArcEval) \
+	X(23, "sdRing", 200, 120, sdRing(u, v, -0.7071f, 0.7071f, 100, 10), SDRingPrep, sdRingPrepare(&s, -0.7071f, 0.7071f, 100, 10), sdRingEval) \
+	X(24, "sdHorseshoe", 200, 120, sdHorseshoe(u, v, 0, 1, 80, 100, 5), SDHorseshoePrep, sdHorseshoePrepare(&s, 0, 1, 80, 100, 5), sdHorseshoeEval) \
+	X(25, "sdParabola", 200, 120, sdParabola(u, v, 0.002f), SDParabolaPrep, sdParabolaPrepare(&s, 0.002f), sdParabolaEval) \
+	X(26, "sdCross", 200, 120, sdCross(u, v, 100, 40, 14), SDCrossPrep, sdCrossPrepare(&s, 100, 40, 14), sdCrossEval) \
+	X(27, "sdRoundedX", 200, 120, sdRoundedX(u, v, 180, 20), SDRoundedXPrep, sdRoundedXPrepare(&s, 180, 20), sdRoundedXEval) \
+	X(28, "sdEllipse", 200, 120, sdEllipse(u, v, 160, 80), SDEllipsePrep, sdEllipsePrepare(&s, 160, 80), sdEllipseEval) \
+	X(29, "sdStar5", 200, 120, sdStar5(u, v, 35, 3), SDStar5Prep, sdStar5Prepare(&s, 35, 3), sdStar5Eval) \
+	X(30, "sdHexagram", 200, 120, sdHexagram(u, v, 45), SDHexagramPrep, sdHexagramPrepare(&s, 45), sdHexagramEval) \
+	X(31, "sdPentagon", 200, 120, sdPentagon(u, v, 90), SDPentagonPrep, sdPentagonPrepare(&s, 90), sdPentagonEval) \
+	X(32, "sdRegularPolygon (5)", 200, 120, sdRegularPolygon(u, v, 90, 5), SDRegularPolygonPrep, sdRegularPolygonPrepare(&s, 90, 5), sdRegularPolygonEval) \
+	X(33, "sdHexagon", 200, 120, sdHexagon(u, v, 90), SDHexagonPrep, sdHexagonPrepare(&s, 90), sdHexagonEval) \
+	X(34, "sdRegularPolygon (6)", 200, 120, sdRegularPolygon(u, v, 90, 6), SDRegularPolygonPrep, sdRegularPolygonPrepare(&s, 90, 6), sdRegularPolygonEval) \
+	X(35, "sdOctagon", 200, 120, sdOctagon(u, v, 90), SDOctagonPrep, sdOctagonPrepare(&s, 90), sdOctagonEval) \
+	X(36, "sdRegularPolygon (8)", 200, 120, sdRegularPolygon(u, v, 90, 8), SDRegularPolygonPrep, sdRegularPolygonPrepare(&s, 90, 8), sdRegularPolygonEval) \
+	X(37, "sdPolygon (4)", 0, 0, sdPolygon(u, v, vx, vy, 4), SDPolygonPrep, sdPolygonPrepare(&s, vx, vy, 4, polyEdges), sdPolygonEval) \
+	X(38, "sdSegmentLinf", 0, 0, sdSegmentLinf(u, v, 50, 220, 350, 20), SDSegmentLinfPrep, sdSegmentLinfPrepare(&s, 50, 220, 350, 20), sdSegmentLinfEval) \
+	X(39, "sdBoxLinf", 200, 120, sdBoxLinf(u, v, 160, 70), SDBoxLinfPrep, sdBoxLinfPrepare(&s, 160, 70), sdBoxLinfEval) \
+	X(40, "sdRhombusLinf", 200, 120, sdRhombusLinf(u, v, 100, 30), SDRhombusLinfPrep, sdRhombusLinfPrepare(&s, 100, 30), sdRhombusLinfEval) \
+	X(41, "sdEllipseLinf", 200, 120, sdEllipseLinf(u, v, 160, 80), SDEllipseLinfPrep, sdEllipseLinfPrepare(&s, 160, 80), sdEllipseLinfEval) \
+
+typedef struct {
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} PrepRun;
+
+#define X(id, label, cx, cy, sdExpr, Prep, prepare, eval) \
+	static float evalSd##id(float x, float y) { float u = x - (cx), v = y - (cy); return (sdExpr); } \
+	static float evalPrep##id(float x, float y) { Prep s; prepare; return eval(&s, x - (cx), y - (cy)); } \
+	static void runSd##id(void *arg) { \
+		PrepRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float u = r->px[i] - (cx), v = r->py[i] - (cy); t += (sdExpr); } \
+		r->sink = t; \
+	} \
+	static void runPrep##id(void *arg) { \
+		PrepRun *r = arg; \
+		float t = 0.0f; \
+		Prep s; \
+		prepare; \
+		for (int i = 0; i < r->n; i++) t += eval(&s, r->px[i] - (cx), r->py[i] - (cy)); \
+		r->sink = t; \
+	}
+PREP_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	BenchEvalFunc evalSd;
+	BenchEvalFunc evalPrep;
+	void (*runSd)(void *arg);
+	void (*runPrep)(void *arg);
+} prepCases[] = {
+#define X(id, label, cx, cy, sdExpr, Prep, prepare, eval) { label, evalSd##id, evalPrep##id, runSd##id, runPrep##id },
+	PREP_CASES(X)
+#undef X
+};
+
+void benchPrepared(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+	for (size_t c = 0; c < sizeof(prepCases) / sizeof(prepCases[0]); c++) {
+		const char *name = prepCases[c].name;
+		if (!benchSelected(ctx, name)) continue;
+
+		benchPoints(kBenchRandom, prepCases[c].evalSd, px, py, n);
+		PrepRun run = { px, py, n, 0.0f };
+		double tsd = benchTime(ctx, prepCases[c].runSd, &run);
+		sink += run.sink;
+		double tprep = benchTime(ctx, prepCases[c].runPrep, &run);
+		sink += run.sink;
+		benchReport(ctx, "prepared", name, "sd", tsd * 1e9 / n);
+		benchReport(ctx, "prepared", name, "prepared", tprep * 1e9 / n);
+		benchReportValue(ctx, "prepared", name, "speedup", "x sd", tsd / tprep);
+
+		float maxError = 0.0f;
+		for (int dist = kBenchRandom; dist <= kBenchSurface; dist += kBenchSurface - kBenchRandom) {
+			benchPoints((BenchDist)dist, prepCases[c].evalSd, px, py, n);
+			for (int i = 0; i < n; i++)
+				maxError = fmaxf(maxError, fabsf(prepCases[c].evalPrep(px[i], py[i]) - prepCases[c].evalSd(px[i], py[i])));
+		}
+		benchReportValue(ctx, "prepared", name, "max error", "px", maxError);
+		if (maxError > PREP_TOLERANCE)
+			benchFail(ctx, "prepared: %s differs from sd by %g\n", name, maxError);
+	}
+	free(px);
+	free(py);
+}
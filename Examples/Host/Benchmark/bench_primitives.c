@@ -0,0 +1,105 @@
+// Scalar benchmark of the 41 cases in the Playdate C benchmark (Examples/Playdate/Lua_C_Bindings/C benchmark),
+// using the same shapes and parameters, over several point distributions.
+
+#include "bench.h"
+#include "sdf2d.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+static const float qx = 200.0f;
+static const float qy = 120.0f;
+static float vx[] = {10.0f, 370.0f, 190.0f, 30.0f};
+static float vy[] = {10.0f, 115.0f, 190.0f, 80.0f};
+
+#define PRIMITIVE_CASES(X) \
+	X(1, "sdCircle", sdCircle(qx-x, qy-y, 110)) \
+	X(2, "sdSegment", sdSegment(x, y, 50, 220, 350, 20)) \
+	X(3, "sdBox", sdBox(qx-x, qy-y, 160, 70)) \
+	X(4, "sdOrientedBox", sdOrientedBox(x, y, 50, 20, 350, 220, 20)) \
+	X(5, "sdRoundedBox", sdRoundedBox(qx-x, qy-y, 70, 40, 10, 20, 0, 20)) \
+	X(6, "sdRoundSquare", sdRoundSquare(x-qx,y-qy, 100, 20)) \
+	X(7, "sdRhombus", sdRhombus(qx-x, qy-y, 100, 30)) \
+	X(8, "sdTrapezoid", sdTrapezoid(qx-x, qy-y, 100, 30, 40)) \
+	X(9, "sdParallelogram", sdParallelogram(qx-x, qy-y, 150, 50, 30)) \
+	X(10, "sdEquilateralTriangle", sdEquilateralTriangle(qx-x, qy-y, 100)) \
+	X(11, "sdTriangleIsosceles", sdTriangleIsosceles(qx-x, qy-y, 160, 50)) \
+	X(12, "sdTriangle", sdTriangle(x, y, 40, 10, 50, 200, 350, 80)) \
+	X(13, "sdQuad", sdQuad(x, y, 40, 10, 50, 200, 320, 180, 350, 80)) \
+	X(14, "sdUnevenCapsule", sdUnevenCapsule(x-qx,y-qy, 40, 30, 80)) \
+	X(15, "sdEgg", sdEgg(x-qx,y-qy, 50, 10)) \
+	X(16, "sdPie", sdPie(qx-x,qy-y,0.866f, -0.5f, 100)) \
+	X(17, "sdCutDisk", sdCutDisk(qx-x,qy-y,100,-75)) \
+	X(18, "sdMoon", sdMoon(qx-x,qy-y,45,110,90)) \
+	X(19, "sdVesica", sdVesica(qx-x,qy-y,110,60)) \
+	X(20, "sdOrientedVesica", sdOrientedVesica(x,y,110,10,290,190,30)) \
+	X(21, "sdTunnel", sdTunnel(qx-x,qy-y,80,40)) \
+	X(22, "sdArc", sdArc(qx-x,qy-y,0.7071f,-0.7071f,80,10)) \
+	X(23, "sdRing", sdRing(qx-x,qy-y,-0.7071f,0.7071f,100,10)) \
+	X(24, "sdHorseshoe", sdHorseshoe(qx-x,qy-y,0,1,80,100,5)) \
+	X(25, "sdParabola", sdParabola(qx-x,qy-y,0.002)) \
+	X(26, "sdCross", sdCross(qx-x,qy-y,100,40,14)) \
+	X(27, "sdRoundedX", sdRoundedX(qx-x,qy-y,180,20)) \
+	X(28, "sdEllipse", sdEllipse(x-qx,y-qy,160,80)) \
+	X(29, "sdStar5", sdStar5(qx-x,qy-y,35,3)) \
+	X(30, "sdHexagram", sdHexagram(qx-x,qy-y,45)) \
+	X(31, "sdPentagon", sdPentagon(qx-x,qy-y,90)) \
+	X(32, "sdRegularPolygon (5)", sdRegularPolygon(qx-x,qy-y,90,5)) \
+	X(33, "sdHexagon", sdHexagon(qx-x,qy-y,90)) \
+	X(34, "sdRegularPolygon (6)", sdRegularPolygon(qx-x,qy-y,90,6)) \
+	X(35, "sdOctagon", sdOctagon(qx-x,qy-y,90)) \
+	X(36, "sdRegularPolygon (8)", sdRegularPolygon(qx-x,qy-y,90,8)) \
+	X(37, "sdPolygon (4)", sdPolygon(x, y, vx, vy, 4)) \
+	X(38, "sdSegmentLinf", sdSegmentLinf(x, y, 50, 220, 350, 20)) \
+	X(39, "sdBoxLinf", sdBoxLinf(qx-x, qy-y, 160, 70)) \
+	X(40, "sdRhombusLinf", sdRhombusLinf(qx-x, qy-y, 100, 30)) \
+	X(41, "sdEllipseLinf", sdEllipseLinf(x-qx,y-qy,160,80)) \
+	X(42, "sdBezier", sdBezier(x, y, 50, 220, 200, -100, 350, 220, 10)) \
+
+typedef struct {
+	const float *px;
+	const float *py;
+	int n;
+	float sink;
+} PrimitiveRun;
+
+#define X(id, label, expr) \
+	static float eval##id(float x, float y) { return (expr); } \
+	static void run##id(void *arg) { \
+		PrimitiveRun *r = arg; \
+		float t = 0.0f; \
+		for (int i = 0; i < r->n; i++) { float x = r->px[i], y = r->py[i]; t += (expr); } \
+		r->sink = t; \
+	}
+PRIMITIVE_CASES(X)
+#undef X
+
+static const struct {
+	const char *name;
+	BenchEvalFunc eval;
+	void (*run)(void *arg);
+} primitiveCases[] = {
+#define X(id, label, expr) { label, eval##id, run##id },
+	PRIMITIVE_CASES(X)
+#undef X
+};
+
+void benchPrimitives(BenchContext *ctx)
+{
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+	for (size_t c = 0; c < sizeof(primitiveCases) / sizeof(primitiveCases[0]); c++) {
+		if (!benchSelected(ctx, primitiveCases[c].name)) continue;
+		for (int dist = 0; dist < kBenchDistCount; dist++) {
+			benchPoints((BenchDist)dist, primitiveCases[c].eval, px, py, n);
+			PrimitiveRun run = { px, py, n, 0.0f };
+			double t = benchTime(ctx, primitiveCases[c].run, &run);
+			sink += run.sink;
+			benchReport(ctx, "primitives", primitiveCases[c].name, benchDistNames[dist], t * 1e9 / n);
+		}
+	}
+	free(px);
+	free(py);
+}
@@ -0,0 +1,147 @@
+// Profiling benchmark: frames of a 50-shape level of six shape types, evaluated with
+// sdSceneEvalBatch at points uniform over the screen. Reports ns per point; run it from a build
+// with and one without SDF2D_PROFILE for the cost of the counters. Profile builds also time every
+// call and one in 256, and report how much of the frame the shape estimates account for. The
+// report of sdProfileReport goes to the log. Counts are checked against the points evaluated, and
+// the trace for balanced JSON.
+
+#include "bench.h"
+#include "sdf2d_profile.h"
+#include "sdf2d_scene.h"
+
+#include <stdlib.h>
+
+#define PROFILE_SHAPES 50
+#define PROFILE_FRAMES 20
+
+typedef struct {
+	SDScene scene;
+	int leaves[PROFILE_SHAPES];
+	const float *px;
+	const float *py;
+	float *out;
+	int n;
+	float sink;
+} ProfileRun;
+
+static void runFrame(void *arg)
+{
+	ProfileRun *r = arg;
+	sdSceneEvalBatch(&r->scene, r->px, r->py, r->out, r->n);
+	sdProfileFrame();
+	r->sink = r->out[r->n - 1];
+}
+
+static void buildLevel(ProfileRun *r)
+{
+	static const SDShapeType types[] = { kSDCircle, kSDBox, kSDRoundedX, kSDHexagon, kSDSegment, kSDEllipse };
+	sdSceneInit(&r->scene);
+	for (int i = 0; i < PROFILE_SHAPES; i++) {
+		SDShape s = { types[i % 6], { benchUniform(5, 20), benchUniform(5, 20) } };
+		if (s.type == kSDSegment) {
+			float l = s.p[0];
+			s.p[0] = -l; s.p[1] = 0.0f; s.p[2] = l; s.p[3] = 0.0f;
+		}
+		r->leaves[i] = sdSceneAddShape(&r->scene, &s);
+		sdSceneSetTransform(&r->scene, r->leaves[i], benchUniform(0, 400), benchUniform(0, 240), 0.0f);
+	}
+	sdSceneCompile(&r->scene, sdSceneAddUnionAll(&r->scene, r->leaves, PROFILE_SHAPES));
+}
+
+static void writeLog(void *ctx, const char *text, size_t len)
+{
+	fwrite(text, 1, len, ctx);
+}
+
+typedef struct {
+	long bytes;
+	int depth;           // open braces and brackets
+	int unbalanced;
+} TraceCheck;
+
+static void writeCheck(void *ctx, const char *text, size_t len)
+{
+	TraceCheck *c = ctx;
+	for (size_t i = 0; i < len; i++) {
+		if (text[i] == '{' || text[i] == '[') c->depth++;
+		if (text[i] == '}' || text[i] == ']') c->depth--;
+		if (c->depth < 0) c->unbalanced = 1;
+	}
+	c->bytes += (long)len;
+}
+
+void benchProfile(BenchContext *ctx)
+{
+	if (!benchSelected(ctx, "profile")) return;
+	ProfileRun *r = malloc(sizeof(ProfileRun));
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	float *out = malloc(n * sizeof(float));
+	volatile float sink = 0.0f;
+	for (int i = 0; i < n; i++) {
+		px[i] = benchUniform(0, 400);
+		py[i] = benchUniform(0, 240);
+	}
+	buildLevel(r);
+	r->px = px;
+	r->py = py;
+	r->out = out;
+	r->n = n;
+	sdProfileScene(&r->scene, "level");
+
+	double t = benchTime(ctx, runFrame, r);
+	sink += r->sink;
+	int enabled = sdProfileCounterCount() > 0;
+	benchReport(ctx, "profile", "level frame", enabled ? "profiled" : "off", t * 1e9 / n);
+
+	if (enabled) {
+		sdProfileSetSampling(1);
+		t = benchTime(ctx, runFrame, r);
+		sink += r->sink;
+		benchReport(ctx, "profile", "level frame", "time all", t * 1e9 / n);
+		sdProfileSetSampling(256);
+		t = benchTime(ctx, runFrame, r);
+		sink += r->sink;
+		benchReport(ctx, "profile", "level frame", "1 in 256", t * 1e9 / n);
+		sdProfileSetSampling(16);
+
+		// a clean run: every leaf counted once per point, and the shape types add up to the leaves
+		sdProfileReset();
+		double start = benchNow();
+		for (int f = 0; f < PROFILE_FRAMES; f++) runFrame(r);
+		double wall = benchNow() - start;
+		long long leaves = 0, types = 0, ticks = 0;
+		int wrong = 0, base = -1;
+		for (int i = 0; i < sdProfileCounterCount(); i++) {
+			const SDProfileCounter *c = sdProfileCounterGet(i);
+			if (i < kSDShapeCount) {
+				types += c->calls;
+				ticks += c->ticks;
+			} else if (base < 0) {
+				base = i;
+			}
+		}
+		for (int j = 0; j < PROFILE_SHAPES; j++) {
+			const SDProfileCounter *c = sdProfileCounterGet(base + r->leaves[j]);
+			if (!c || c->calls != (long long)PROFILE_FRAMES * n || c->frames != PROFILE_FRAMES) wrong++;
+			else leaves += c->calls;
+		}
+		if (wrong) benchFail(ctx, "profile: %d leaves miscounted\n", wrong);
+		if (types != leaves) benchFail(ctx, "profile: shape types counted %lld points, leaves %lld\n", types, leaves);
+		// with the default clock, ticks are ns
+		benchReportValue(ctx, "profile", "level frame", "shapes", "% of frame", 100.0 * ticks * 1e-9 / wall);
+
+		TraceCheck check = { 0, 0, 0 };
+		sdProfileTrace(writeCheck, &check);
+		if (check.depth || check.unbalanced) benchFail(ctx, "profile: trace JSON is unbalanced\n");
+		benchReportValue(ctx, "profile", "level frame", "trace", "KB", check.bytes / 1024.0);
+		sdProfileReport(writeLog, ctx->log);
+	}
+
+	sdSceneFree(&r->scene);
+	free(r);
+	free(px);
+	free(py);
+	free(out);
+}
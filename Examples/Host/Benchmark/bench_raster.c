@@ -0,0 +1,145 @@
+// Raster benchmark: full-screen 1-bit renders with sdRasterShape/sdRasterScene against the per-pixel
+// loop of the Playdate C benchmark (sdXxx, fmodf and a read-modify-write per bit). Checks that both
+// produce the same bitmap, and that rect renders touch only their rect.
+
+#include "bench.h"
+#include "sdf2d_raster.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RASTER_W 400
+#define RASTER_H 240
+#define RASTER_ROWBYTES 52   // as LCDBitmap pads rows
+#define RASTER_CIRCLES 30
+
+typedef struct {
+	const char *name;
+	SDShape shape;       // kSDShapeCount: the scene
+} RasterCase;
+
+typedef struct {
+	const RasterCase *c;
+	const SDScene *scene;
+	const SDRasterStyle *style;
+	SDBitmap bm;
+} RasterRun;
+
+static float rasterEval(const RasterRun *r, float x, float y)
+{
+	if (r->c->shape.type == kSDShapeCount) return sdSceneEval(r->scene, x, y);
+	return sdShapeEval(&r->c->shape, x - 200, y - 120);
+}
+
+// The loop from Examples/Playdate/Lua_C_Bindings/C benchmark/main.c, generalised to the three modes
+static void runReference(void *arg)
+{
+	RasterRun *r = arg;
+	const SDRasterStyle *s = r->style;
+	memset(r->bm.data, 0xff, RASTER_H * RASTER_ROWBYTES);
+	for (int y = 0; y < RASTER_H; y++) {
+		for (int x = 0; x < RASTER_W; x++) {
+			float d = rasterEval(r, x, y);
+			int black;
+			if (s->mode == kSDRasterFill) black = d <= 0.0f;
+			else if (s->mode == kSDRasterOutline) black = fabsf(d) <= s->width;
+			else {
+				float remainder = fmodf(fabsf(d), s->spacing);
+				int line = remainder <= s->width || (s->spacing - remainder) <= s->width;
+				black = line == (d > 0.0f);
+			}
+			if (black) r->bm.data[y * RASTER_ROWBYTES + x / 8] &= ~(1 << (uint8_t)(7 - (x % 8)));
+		}
+	}
+}
+
+static void runRaster(void *arg)
+{
+	RasterRun *r = arg;
+	if (r->c->shape.type == kSDShapeCount) sdRasterScene(&r->bm, r->scene, r->style);
+	else sdRasterShape(&r->bm, &r->c->shape, 200, 120, r->style);
+}
+
+static int pixel(const uint8_t *data, int x, int y)
+{
+	return (data[y * RASTER_ROWBYTES + x / 8] >> (7 - x % 8)) & 1;
+}
+
+static int countMismatch(const uint8_t *a, const uint8_t *b)
+{
+	int n = 0;
+	for (int y = 0; y < RASTER_H; y++)
+		for (int x = 0; x < RASTER_W; x++) n += pixel(a, x, y) != pixel(b, x, y);
+	return n;
+}
+
+static void buildTerrain(SDScene *scene)
+{
+	int ids[RASTER_CIRCLES];
+	sdSceneInit(scene);
+	for (int i = 0; i < RASTER_CIRCLES; i++) {
+		ids[i] = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { benchUniform(8, 30) } });
+		sdSceneSetTransform(scene, ids[i], benchUniform(0, 400), benchUniform(160, 240), 0.0f);
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, RASTER_CIRCLES));
+}
+
+void benchRaster(BenchContext *ctx)
+{
+	static const RasterCase cases[] = {
+		{ "sdCircle", { kSDCircle, { 110 } } },
+		{ "sdBox", { kSDBox, { 160, 70 } } },
+		{ "sdHexagon", { kSDHexagon, { 90 } } },
+		{ "sdEllipse", { kSDEllipse, { 160, 80 } } },
+		{ "terrain scene", { kSDShapeCount } },
+	};
+	static const SDRasterStyle styles[] = {
+		{ kSDRasterFill, 0.0f, 0.0f },
+		{ kSDRasterOutline, 1.5f, 0.0f },
+		{ kSDRasterContour, 0.9f, 10.0f },
+	};
+	static const char *styleNames[] = { "fill", "outline", "contour" };
+	char variant[32];
+	uint8_t *ref = malloc(RASTER_H * RASTER_ROWBYTES);
+	uint8_t *out = malloc(RASTER_H * RASTER_ROWBYTES);
+	uint8_t *rect = malloc(RASTER_H * RASTER_ROWBYTES);
+	SDScene scene;
+	buildTerrain(&scene);
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		if (!benchSelected(ctx, cases[c].name)) continue;
+		for (int s = 0; s < 3; s++) {
+			RasterRun run = { &cases[c], &scene, &styles[s], { ref, RASTER_W, RASTER_H, RASTER_ROWBYTES } };
+			snprintf(variant, sizeof(variant), "%s per pixel", styleNames[s]);
+			benchReport(ctx, "raster", cases[c].name, variant, benchTime(ctx, runReference, &run) * 1e9);
+			run.bm.data = out;
+			snprintf(variant, sizeof(variant), "%s packed", styleNames[s]);
+			benchReport(ctx, "raster", cases[c].name, variant, benchTime(ctx, runRaster, &run) * 1e9);
+
+			// contour lines are classified without fmodf, which may flip a pixel sitting exactly on a line edge
+			int mismatch = countMismatch(ref, out);
+			benchReportValue(ctx, "raster", cases[c].name, variant, "pixels differ", mismatch);
+			if (mismatch > RASTER_W * RASTER_H / 10000)
+				benchFail(ctx, "raster: %s %s differs from the per-pixel loop in %d pixels\n", cases[c].name, styleNames[s], mismatch);
+
+			// a rect with unaligned edges on a patterned bitmap: the rect matches, the rest is untouched
+			memset(rect, 0x5a, RASTER_H * RASTER_ROWBYTES);
+			run.bm.data = rect;
+			int rx = 37, ry = 21, rw = 203, rh = 150, bad = 0;
+			if (cases[c].shape.type == kSDShapeCount) sdRasterSceneRect(&run.bm, &scene, &styles[s], rx, ry, rw, rh);
+			else sdRasterShapeRect(&run.bm, &cases[c].shape, 200, 120, &styles[s], rx, ry, rw, rh);
+			for (int y = 0; y < RASTER_H; y++) {
+				for (int x = 0; x < RASTER_W; x++) {
+					int inside = x >= rx && x < rx + rw && y >= ry && y < ry + rh;
+					bad += pixel(rect, x, y) != (inside ? pixel(out, x, y) : (0x5a >> (7 - x % 8)) & 1);
+				}
+			}
+			if (bad) benchFail(ctx, "raster: %s %s rect render wrong in %d pixels\n", cases[c].name, styleNames[s], bad);
+		}
+	}
+	sdSceneFree(&scene);
+	free(ref);
+	free(out);
+	free(rect);
+}
@@ -0,0 +1,179 @@
+// Ray benchmark: packets of random rays through a small level, plain sphere tracing against
+// over-relaxed, in packets and one ray at a time, then the 400x240 light maps built on top. Reports
+// rays per second and SDF evaluations per ray, and checks that relaxation finds the same hits.
+
+#include "bench.h"
+#include "sdf2d_ray.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define RAY_SHAPES 16
+#define RAY_LIGHT_RAYS 720
+
+typedef struct {
+	SDScene scene;
+	SDRayParams params;
+	float *ox, *oy, *dx, *dy, *t;
+	unsigned char *hit;
+	unsigned char *map;
+	int n;
+	int single;
+	int width, height;
+	float cell;
+	SDVisibility vis;
+	SDRayStats stats;
+} RayRun;
+
+static void runMarch(void *arg)
+{
+	RayRun *r = arg;
+	r->stats = (SDRayStats){ 0 };
+	if (!r->single) {
+		sdRayMarch(&r->scene, &r->params, r->ox, r->oy, r->dx, r->dy, r->t, r->hit, r->n, &r->stats);
+		return;
+	}
+	for (int i = 0; i < r->n; i++)
+		sdRayMarch(&r->scene, &r->params, r->ox + i, r->oy + i, r->dx + i, r->dy + i, r->t + i, r->hit + i, 1, &r->stats);
+}
+
+static void runVisibility(void *arg)
+{
+	RayRun *r = arg;
+	r->stats = (SDRayStats){ 0 };
+	sdVisibilityBuild(&r->vis, &r->scene, &r->params, 200, 120, RAY_LIGHT_RAYS, &r->stats);
+}
+
+static void runRaster(void *arg)
+{
+	RayRun *r = arg;
+	sdVisibilityRaster(&r->vis, r->map, r->width, r->height, r->cell);
+}
+
+static void runShadow(void *arg)
+{
+	RayRun *r = arg;
+	r->stats = (SDRayStats){ 0 };
+	sdShadowMap(&r->scene, &r->params, 200, 120, 8.0f, r->map, r->width, r->height, r->cell, &r->stats);
+}
+
+// Pillars and debris around an open middle, where the light sits
+static void buildLevel(SDScene *scene)
+{
+	int ids[RAY_SHAPES];
+	sdSceneInit(scene);
+	for (int i = 0; i < RAY_SHAPES; i++) {
+		float a = i * 6.283185f / RAY_SHAPES, rad = benchUniform(50, 110);
+		SDShape s = { kSDCircle, { benchUniform(6, 16) } };
+		if (i % 4 == 1) s = (SDShape){ kSDBox, { benchUniform(6, 20), benchUniform(4, 12) } };
+		if (i % 4 == 2) s = (SDShape){ kSDHexagon, { benchUniform(6, 14) } };
+		if (i % 4 == 3) s = (SDShape){ kSDSegment, { -12, 0, 12, 0 } };
+		ids[i] = sdSceneAddShape(scene, &s);
+		sdSceneSetTransform(scene, ids[i], 200 + rad * 1.6f * cosf(a), 120 + rad * sinf(a), benchUniform(0, 3));
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, RAY_SHAPES));
+}
+
+static void reportStats(BenchContext *ctx, const char *name, const char *variant, double seconds, const SDRayStats *s)
+{
+	benchReportValue(ctx, "ray", name, variant, "ms", seconds * 1e3);
+	benchReportValue(ctx, "ray", name, variant, "rays/s", s->rays / seconds);
+	benchReportValue(ctx, "ray", name, variant, "steps/ray", (double)s->steps / s->rays);
+}
+
+void benchRay(BenchContext *ctx)
+{
+	static const float relax[] = { 1.0f, 1.6f };
+	static const char *variants[] = { "plain", "relaxed" };
+	RayRun *r = malloc(sizeof(RayRun));
+	int n = ctx->points;
+	r->params = (SDRayParams)SD_RAY_DEFAULTS;
+	r->n = n;
+	r->ox = malloc(n * sizeof(float));
+	r->oy = malloc(n * sizeof(float));
+	r->dx = malloc(n * sizeof(float));
+	r->dy = malloc(n * sizeof(float));
+	r->t = malloc(n * sizeof(float));
+	r->hit = malloc(n);
+	r->map = malloc(400 * 240);
+	float *plainT = malloc(n * sizeof(float));
+	unsigned char *plainHit = malloc(n);
+	buildLevel(&r->scene);
+	sdVisibilityInit(&r->vis);
+
+	// rays from random free points in random directions
+	for (int i = 0; i < n; i++) {
+		do {
+			r->ox[i] = benchUniform(0, 400);
+			r->oy[i] = benchUniform(0, 240);
+		} while (sdSceneEval(&r->scene, r->ox[i], r->oy[i]) < 1.0f);
+		float a = benchUniform(0, 6.283185f);
+		r->dx[i] = cosf(a);
+		r->dy[i] = sinf(a);
+	}
+
+	if (benchSelected(ctx, "march")) {
+		for (int v = 0; v < 2; v++) {
+			r->params.relax = relax[v];
+			for (r->single = 0; r->single <= 1; r->single++) {
+				const char *name = r->single ? "march single" : "march packet";
+				double t = benchTime(ctx, runMarch, r);
+				benchReport(ctx, "ray", name, variants[v], t * 1e9 / n);
+				reportStats(ctx, name, variants[v], t, &r->stats);
+			}
+			if (v == 0) {
+				for (int i = 0; i < n; i++) {
+					plainT[i] = r->t[i];
+					plainHit[i] = r->hit[i];
+				}
+				continue;
+			}
+			// the fallback step keeps relaxed hits on the same surfaces as plain sphere tracing
+			int mismatch = 0;
+			for (int i = 0; i < n; i++)
+				if (r->hit[i] != plainHit[i] || (r->hit[i] && fabsf(r->t[i] - plainT[i]) > 2.0f * r->params.epsilon)) mismatch++;
+			benchReportValue(ctx, "ray", "march packet", "relaxed", "% mismatch", 100.0 * mismatch / n);
+			if (mismatch > n / 100) benchFail(ctx, "ray: %d of %d relaxed rays differ from plain sphere tracing\n", mismatch, n);
+		}
+	}
+
+	r->params.relax = relax[1];
+	if (benchSelected(ctx, "visibility")) {
+		double t = benchTime(ctx, runVisibility, r);
+		reportStats(ctx, "visibility 720 rays", "build", t, &r->stats);
+		r->width = 400;
+		r->height = 240;
+		r->cell = 1.0f;
+		benchReportValue(ctx, "ray", "visibility 400x240", "raster", "ms", benchTime(ctx, runRaster, r) * 1e3);
+	}
+
+	if (benchSelected(ctx, "shadow")) {
+		static const struct { const char *name; int width, height; float cell; } maps[] = {
+			{ "shadow 400x240", 400, 240, 1.0f },
+			{ "shadow 100x60", 100, 60, 4.0f },
+		};
+		for (int m = 0; m < 2; m++) {
+			r->width = maps[m].width;
+			r->height = maps[m].height;
+			r->cell = maps[m].cell;
+			for (int v = 0; v < 2; v++) {
+				r->params.relax = relax[v];
+				double t = benchTime(ctx, runShadow, r);
+				reportStats(ctx, maps[m].name, variants[v], t, &r->stats);
+			}
+		}
+	}
+
+	sdVisibilityFree(&r->vis);
+	sdSceneFree(&r->scene);
+	free(plainT);
+	free(plainHit);
+	free(r->map);
+	free(r->hit);
+	free(r->t);
+	free(r->dx);
+	free(r->dy);
+	free(r->ox);
+	free(r->oy);
+	free(r);
+}
@@ -0,0 +1,166 @@
+// Render benchmark: 1920 x 1080 frames (480 x 270 with --quick) through sdRender on 1 to N threads,
+// with and without work stealing. The "clustered" frame samples a broadphase whose shapes crowd one
+// corner, so tiles there cost many times the others; the "scene" frame costs the same everywhere.
+// Reports ms per frame and the speedup over one thread, and checks that every thread count and
+// format gives the same pixels as a one-thread render, and that distances match the sampler.
+
+#include "bench.h"
+#include "sdf2d_broadphase.h"
+#include "sdf2d_render.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef SDF2D_THREADS
+#include <unistd.h>
+#endif
+
+#define RENDER_W 1920
+#define RENDER_H 1080
+#define RENDER_CLUSTER 300        // shapes in the crowded corner
+#define RENDER_SPREAD 40          // shapes over the rest of the frame
+
+typedef struct {
+	SDRenderPool pool;
+	SDRenderTarget target;
+	SDTileSampler sample;
+	void *ctx;
+	SDRenderStats stats;
+} RenderRun;
+
+static void runRender(void *arg)
+{
+	RenderRun *r = arg;
+	r->stats = (SDRenderStats){ 0 };
+	sdRender(&r->pool, &r->target, r->sample, r->ctx, &r->stats);
+}
+
+// Distance to the closest broadphase shape: cheap where shapes are sparse, dear where they crowd
+static void sampleBroadphase(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	for (size_t i = 0; i < n; i++) sdBroadphaseClosest(ctx, px[i], py[i], &out[i]);
+}
+
+static void buildCluster(SDBroadphase *bp, float w, float h)
+{
+	sdBroadphaseInit(bp);
+	for (int i = 0; i < RENDER_CLUSTER + RENDER_SPREAD; i++) {
+		int crowd = i < RENDER_CLUSTER;
+		float x = crowd ? benchUniform(0, w * 0.3f) : benchUniform(0, w);
+		float y = crowd ? benchUniform(0, h * 0.3f) : benchUniform(0, h);
+		float s = crowd ? benchUniform(2, 8) : benchUniform(10, 40);
+		SDShape shape = { kSDCircle, { s } };
+		if (i % 3 == 1) shape = (SDShape){ kSDBox, { s, s * 0.5f } };
+		if (i % 3 == 2) shape = (SDShape){ kSDHexagon, { s } };
+		sdBroadphaseAdd(bp, &shape, x, y);
+	}
+	sdBroadphaseBuild(bp);
+}
+
+static void buildScene(SDScene *scene, float w, float h)
+{
+	int ids[16];
+	sdSceneInit(scene);
+	for (int i = 0; i < 16; i++) {
+		SDShape s = { kSDCircle, { benchUniform(20, 80) * w / RENDER_W } };
+		if (i % 2) s = (SDShape){ kSDStar5, { benchUniform(30, 90) * w / RENDER_W, 3 } };
+		ids[i] = sdSceneAddShape(scene, &s);
+		sdSceneSetTransform(scene, ids[i], benchUniform(0, w), benchUniform(0, h), benchUniform(0, 3));
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, 16));
+}
+
+static size_t rowBytes(SDRenderFormat format, int w)
+{
+	return format == kSDRenderDistance ? w * sizeof(float) : format == kSDRenderCoverage ? (size_t)w : (size_t)(w + 7) / 8;
+}
+
+void benchRender(BenchContext *ctx)
+{
+	static const char *formatNames[] = { "distance", "coverage", "bitmap" };
+	int w = ctx->quick ? RENDER_W / 4 : RENDER_W, h = ctx->quick ? RENDER_H / 4 : RENDER_H;
+	// 1, 2, 4, ... up to the cores, and at least to 4 so that stealing is checked on small hosts
+	int threads[8] = { 1 }, numThreads = 1;
+#ifdef SDF2D_THREADS
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cores < 4) cores = 4;
+	while (numThreads < 8 && threads[numThreads - 1] < cores && threads[numThreads - 1] * 2 <= SD_RENDER_MAX_THREADS) {
+		threads[numThreads] = threads[numThreads - 1] * 2;
+		numThreads++;
+	}
+#endif
+	SDBroadphase bp;
+	SDScene scene;
+	buildCluster(&bp, w, h);
+	buildScene(&scene, w, h);
+	RenderRun *r = malloc(sizeof(RenderRun));
+	uint8_t *frame = malloc((size_t)w * h * sizeof(float));
+	uint8_t *reference = malloc((size_t)w * h * sizeof(float));
+	char variant[32];
+
+	static const char *names[] = { "clustered", "scene" };
+	for (int c = 0; c < 2; c++) {
+		if (!benchSelected(ctx, names[c])) continue;
+		r->sample = c == 0 ? sampleBroadphase : sdTileSampleScene;
+		r->ctx = c == 0 ? (void *)&bp : (void *)&scene;
+
+		// scaling, on coverage frames
+		size_t bytes = (size_t)w * h;
+		r->target = (SDRenderTarget){ kSDRenderCoverage, frame, w, h, w, 0.0f, 0.0f, 1.0f };
+		double single = 0.0;
+		for (int t = 0; t < numThreads; t++) {
+			for (int steal = 1; steal >= (t > 0 ? 0 : 1); steal--) {
+				sdRenderPoolInit(&r->pool, threads[t]);
+				r->pool.steal = steal;
+				double s = benchTime(ctx, runRender, r);
+				sdRenderPoolFree(&r->pool);
+				if (t == 0) {
+					single = s;
+					memcpy(reference, frame, bytes);
+				} else if (memcmp(reference, frame, bytes) != 0) {
+					benchFail(ctx, "render: %s on %d threads differs from one thread\n", names[c], threads[t]);
+				}
+				snprintf(variant, sizeof(variant), "%d thread%s%s", threads[t], t ? "s" : "", steal ? "" : " no steal");
+				benchReportValue(ctx, "render", names[c], variant, "ms", s * 1e3);
+				benchReportValue(ctx, "render", names[c], variant, "x 1 thread", single / s);
+				if (t > 0 && steal) benchReportValue(ctx, "render", names[c], variant, "% stolen", 100.0 * r->stats.stolen / r->stats.tiles);
+			}
+		}
+
+		// the other formats: the most threads against one, and distances against the sampler
+		for (int f = kSDRenderDistance; f <= kSDRenderBitmap; f += 2) {
+			bytes = rowBytes(f, w) * h;
+			r->target = (SDRenderTarget){ f, frame, w, h, (int)rowBytes(f, w), 0.0f, 0.0f, 1.0f };
+			for (int t = 0; t < numThreads; t += numThreads - 1) {
+				sdRenderPoolInit(&r->pool, threads[t]);
+				memset(frame, 0x55, bytes);
+				runRender(r);
+				sdRenderPoolFree(&r->pool);
+				if (t == 0) memcpy(reference, frame, bytes);
+				else if (memcmp(reference, frame, bytes) != 0)
+					benchFail(ctx, "render: %s %s on %d threads differs from one thread\n", names[c], formatNames[f], threads[t]);
+				if (numThreads == 1) break;
+			}
+			if (f != kSDRenderDistance) continue;
+			// batch kernels may round differently on the tail of a row than on a full tile row
+			int wrong = 0;
+			float px[RENDER_W], py[RENDER_W], d[RENDER_W];
+			for (int y = 0; y < h; y++) {
+				const float *row = (const float *)reference + (size_t)y * w;
+				for (int x = 0; x < w; x++) {
+					px[x] = x;
+					py[x] = y;
+				}
+				r->sample(r->ctx, px, py, d, w);
+				for (int x = 0; x < w; x++) wrong += fabsf(d[x] - row[x]) > 1e-3f;
+			}
+			if (wrong) benchFail(ctx, "render: %s distances differ from the sampler at %d pixels\n", names[c], wrong);
+		}
+	}
+
+	sdBroadphaseFree(&bp);
+	sdSceneFree(&scene);
+	free(frame);
+	free(reference);
+	free(r);
+}
@@ -0,0 +1,131 @@
+// Scene benchmark: a 50-shape level evaluated as a loop over shapes (the pattern used by the Lua
+// examples), as a compiled scene one point at a time, and as a compiled scene in batches. Checks
+// that a smooth union with blend radius 0 is a plain union.
+
+#include "bench.h"
+#include "sdf2d_scene.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SCENE_SHAPES 50
+
+typedef struct {
+	SDShape shapes[SCENE_SHAPES];
+	float ox[SCENE_SHAPES];
+	float oy[SCENE_SHAPES];
+	SDScene scene;
+	const float *px;
+	const float *py;
+	float *out;
+	int n;
+	float sink;
+} SceneRun;
+
+static SceneRun *sceneBench;
+
+static float sceneEvalLoop(float x, float y)
+{
+	float d = 1e30f;
+	for (int j = 0; j < SCENE_SHAPES; j++)
+		d = fminf(d, sdShapeEval(&sceneBench->shapes[j], x - sceneBench->ox[j], y - sceneBench->oy[j]));
+	return d;
+}
+
+static void runLoop(void *arg)
+{
+	SceneRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sceneEvalLoop(r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+static void runScene(void *arg)
+{
+	SceneRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += sdSceneEval(&r->scene, r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+static void runSceneBatch(void *arg)
+{
+	SceneRun *r = arg;
+	sdSceneEvalBatch(&r->scene, r->px, r->py, r->out, r->n);
+	r->sink = r->out[r->n - 1];
+}
+
+static void buildLevel(SceneRun *r)
+{
+	static const SDShapeType types[] = { kSDCircle, kSDBox, kSDRoundedX, kSDHexagon, kSDSegment, kSDEllipse };
+	int ids[SCENE_SHAPES];
+	sdSceneInit(&r->scene);
+	for (int i = 0; i < SCENE_SHAPES; i++) {
+		SDShape s = { types[i % 6], { benchUniform(5, 20), benchUniform(5, 20) } };
+		if (s.type == kSDSegment) {
+			float l = s.p[0];
+			s.p[0] = -l; s.p[1] = 0.0f; s.p[2] = l; s.p[3] = 0.0f;
+		}
+		r->shapes[i] = s;
+		r->ox[i] = benchUniform(0, 400);
+		r->oy[i] = benchUniform(0, 240);
+		ids[i] = sdSceneAddShape(&r->scene, &s);
+		sdSceneSetTransform(&r->scene, ids[i], r->ox[i], r->oy[i], 0.0f);
+	}
+	sdSceneCompile(&r->scene, sdSceneAddUnionAll(&r->scene, ids, SCENE_SHAPES));
+}
+
+// kSDSmoothUnion with k = 0, one point at a time and in a batch
+static void checkSmoothUnion(BenchContext *ctx)
+{
+	SDScene smooth, plain;
+	float px[64], py[64], out[64];
+	for (int s = 0; s < 2; s++) {
+		SDScene *scene = s ? &plain : &smooth;
+		sdSceneInit(scene);
+		int a = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { 40 } });
+		int b = sdSceneAddShape(scene, &(SDShape){ kSDBox, { 30, 20 } });
+		sdSceneSetTransform(scene, b, 50, 10, 0);
+		sdSceneCompile(scene, sdSceneAddOp(scene, s ? kSDUnion : kSDSmoothUnion, a, b, 0.0f));
+	}
+	for (int i = 0; i < 64; i++) {
+		px[i] = benchUniform(-100, 100);
+		py[i] = benchUniform(-100, 100);
+	}
+	sdSceneEvalBatch(&smooth, px, py, out, 64);
+	int wrong = 0;
+	for (int i = 0; i < 64; i++) {
+		float d = sdSceneEval(&plain, px[i], py[i]);
+		wrong += !(sdSceneEval(&smooth, px[i], py[i]) == d && out[i] == d);
+	}
+	if (wrong) benchFail(ctx, "scene: smooth union with k = 0 differs from the union at %d points\n", wrong);
+	sdSceneFree(&smooth);
+	sdSceneFree(&plain);
+}
+
+void benchScene(BenchContext *ctx)
+{
+	if (!benchSelected(ctx, "scene")) return;
+	SceneRun *r = malloc(sizeof(SceneRun));
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	r->out = malloc(n * sizeof(float));
+	buildLevel(r);
+	sceneBench = r;
+	for (int dist = 0; dist < kBenchDistCount; dist++) {
+		benchPoints((BenchDist)dist, sceneEvalLoop, px, py, n);
+		r->px = px;
+		r->py = py;
+		r->n = n;
+		benchReport(ctx, "scene", "loop 50 shapes", benchDistNames[dist], benchTime(ctx, runLoop, r) * 1e9 / n);
+		benchReport(ctx, "scene", "scene 50 shapes", benchDistNames[dist], benchTime(ctx, runScene, r) * 1e9 / n);
+		benchReport(ctx, "scene", "batch 50 shapes", benchDistNames[dist], benchTime(ctx, runSceneBatch, r) * 1e9 / n);
+	}
+	checkSmoothUnion(ctx);
+	sdSceneFree(&r->scene);
+	free(r->out);
+	free(px);
+	free(py);
+	free(r);
+}
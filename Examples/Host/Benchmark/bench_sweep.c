@@ -0,0 +1,174 @@
+// Sweep benchmark: fast circles against the 10 px wide bezier quads of pd_complex.lua, swept with
+// conservative advancement in packets and one at a time, and tested at 4 substeps per move as
+// pd_complex.lua does. Reports SDF evaluations per sweep and how many moves substepping tunnels
+// through, and checks sweeps against a dense reference: no missed hit and no overlap at the stop.
+// Also slides a circle along a box floor 0.1 and 0.3 px above it, which must not report a contact.
+
+#include "bench.h"
+#include "sdf2d_sweep.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SWEEP_RADIUS 3.0f
+#define SWEEP_SUBSTEPS 4
+#define SWEEP_REFERENCE 2000      // sweeps checked against the dense reference; 200 with --quick
+#define SWEEP_REFERENCE_STEP 0.05f
+
+typedef struct {
+	SDScene scene;
+	SDSweepParams params;
+	float *x0, *y0, *x1, *y1, *r;
+	SDSweepHit *hit;
+	unsigned char *substepHit;
+	int n;
+	int single;
+	SDSweepStats stats;
+} SweepRun;
+
+static void runSweep(void *arg)
+{
+	SweepRun *s = arg;
+	s->stats = (SDSweepStats){ 0 };
+	if (!s->single) {
+		sdSweepCircles(sdTileSampleScene, &s->scene, &s->params, s->x0, s->y0, s->x1, s->y1, s->r, s->hit, s->n, &s->stats);
+		return;
+	}
+	for (int i = 0; i < s->n; i++)
+		sdSweepCircle(sdTileSampleScene, &s->scene, &s->params, s->x0[i], s->y0[i], s->x1[i], s->y1[i], s->r[i], s->hit + i, &s->stats);
+}
+
+// pd_complex.lua: the ball is tested for overlap after each of 4 substeps of the move
+static void runSubsteps(void *arg)
+{
+	SweepRun *s = arg;
+	for (int i = 0; i < s->n; i++) {
+		s->substepHit[i] = 0;
+		for (int k = 1; k <= SWEEP_SUBSTEPS && !s->substepHit[i]; k++) {
+			float f = (float)k / SWEEP_SUBSTEPS;
+			float x = s->x0[i] + (s->x1[i] - s->x0[i]) * f, y = s->y0[i] + (s->y1[i] - s->y0[i]) * f;
+			s->substepHit[i] = sdSceneEval(&s->scene, x, y) < s->r[i];
+		}
+	}
+}
+
+// The quads along a bezier curve, as built by buildBezierQuads in pd_complex.lua
+static void buildBezier(SDScene *scene)
+{
+	int ids[20];
+	float prev[4] = { 0 };
+	int count = 0;
+	sdSceneInit(scene);
+	for (int k = 0; k <= 20; k++) {
+		float t = k * 0.05f, u = 1.0f - t;
+		float x = u * u * 20 + 2 * u * t * 100 + t * t * 200, y = u * u * 30 + 2 * u * t * 200 + t * t * 90;
+		float tx = 2 * u * 80 + 2 * t * 100, ty = 2 * u * 170 + 2 * t * -110;
+		float l = sqrtf(tx * tx + ty * ty), nx = -ty / l * 10, ny = tx / l * 10;
+		float off[4] = { x + nx, y + ny, x - nx, y - ny };
+		if (k > 0) {
+			SDShape quad = { kSDQuad, { prev[0], prev[1], prev[2], prev[3], off[2], off[3], off[0], off[1] } };
+			ids[count++] = sdSceneAddShape(scene, &quad);
+		}
+		for (int j = 0; j < 4; j++) prev[j] = off[j];
+	}
+	sdSceneCompile(scene, sdSceneAddUnionAll(scene, ids, count));
+}
+
+static void reportStats(BenchContext *ctx, const char *name, double seconds, const SDSweepStats *s)
+{
+	benchReport(ctx, "sweep", name, "sweep", seconds * 1e9 / s->sweeps);
+	benchReportValue(ctx, "sweep", name, "sweep", "steps/sweep", (double)s->steps / s->sweeps);
+	benchReportValue(ctx, "sweep", name, "sweep", "% hits", 100.0 * s->hits / s->sweeps);
+	benchReportValue(ctx, "sweep", name, "sweep", "% unfinished", 100.0 * s->unfinished / s->sweeps);
+}
+
+// An r = 5 circle moving 20 px along the top of a box, gap px above it: too close to finish in
+// maxSteps, but never a contact
+static void checkGraze(BenchContext *ctx, const SDSweepParams *params, float gap)
+{
+	SDShape ground = { kSDBox, { 200, 10 } };
+	SDTileShape placed = { &ground, 200, 230 };
+	SDSweepHit hit;
+	SDSweepStats stats = { 0 };
+	float y = 220 - 5 - gap;
+	sdSweepCircle(sdTileSampleShape, &placed, params, 100, y, 120, y, 5, &hit, &stats);
+	benchReportValue(ctx, "sweep", "graze", gap < 0.2f ? "0.1 px gap" : "0.3 px gap", "t", hit.t);
+	if (hit.hit) benchFail(ctx, "sweep: sliding %g px above a floor hits at t = %g\n", gap, hit.t);
+	if (hit.t < 1.0f && !stats.unfinished) benchFail(ctx, "sweep: sliding %g px above a floor stops unreported\n", gap);
+}
+
+void benchSweep(BenchContext *ctx)
+{
+	SweepRun *s = malloc(sizeof(SweepRun));
+	int n = ctx->points;
+	s->params = (SDSweepParams)SD_SWEEP_DEFAULTS;
+	s->n = n;
+	s->x0 = malloc(n * sizeof(float));
+	s->y0 = malloc(n * sizeof(float));
+	s->x1 = malloc(n * sizeof(float));
+	s->y1 = malloc(n * sizeof(float));
+	s->r = malloc(n * sizeof(float));
+	s->hit = malloc(n * sizeof(SDSweepHit));
+	s->substepHit = malloc(n);
+	buildBezier(&s->scene);
+
+	// moves of 20 to 120 px (1000 to 6000 px/s at 50 fps) from free points near the curve
+	for (int i = 0; i < n; i++) {
+		do {
+			s->x0[i] = benchUniform(0, 240);
+			s->y0[i] = benchUniform(0, 200);
+		} while (sdSceneEval(&s->scene, s->x0[i], s->y0[i]) < SWEEP_RADIUS + 1.0f);
+		float a = benchUniform(0, 6.283185f), l = benchUniform(20, 120);
+		s->x1[i] = s->x0[i] + l * cosf(a);
+		s->y1[i] = s->y0[i] + l * sinf(a);
+		s->r[i] = SWEEP_RADIUS;
+	}
+
+	if (benchSelected(ctx, "bezier")) {
+		for (s->single = 0; s->single <= 1; s->single++) {
+			const char *name = s->single ? "bezier single" : "bezier packet";
+			reportStats(ctx, name, benchTime(ctx, runSweep, s), &s->stats);
+		}
+		double t = benchTime(ctx, runSubsteps, s);
+		benchReport(ctx, "sweep", "bezier substeps", "4 substeps", t * 1e9 / n);
+
+		// dense reference: the first overlap along the path at SWEEP_REFERENCE_STEP px
+		int checked = ctx->quick ? SWEEP_REFERENCE / 10 : SWEEP_REFERENCE;
+		if (checked > n) checked = n;
+		int tunnelled = 0, missed = 0, overlapping = 0;
+		for (int i = 0; i < checked; i++) {
+			float mx = s->x1[i] - s->x0[i], my = s->y1[i] - s->y0[i];
+			float len = sqrtf(mx * mx + my * my), tref = 2.0f;
+			for (float u = 0.0f; u <= len; u += SWEEP_REFERENCE_STEP) {
+				if (sdSceneEval(&s->scene, s->x0[i] + mx * u / len, s->y0[i] + my * u / len) < s->r[i]) {
+					tref = u / len;
+					break;
+				}
+			}
+			const SDSweepHit *h = &s->hit[i];
+			if (tref <= 1.0f && !s->substepHit[i]) tunnelled++;
+			// an unfinished sweep stops short of the hit, which the next sweep finds
+			if (tref <= 1.0f && (h->t > tref + SWEEP_REFERENCE_STEP / len || (!h->hit && h->t == 1.0f))) missed++;
+			if (sdSceneEval(&s->scene, h->x, h->y) < s->r[i] - 1e-3f) overlapping++;
+		}
+		benchReportValue(ctx, "sweep", "bezier substeps", "4 substeps", "% tunnelled", 100.0 * tunnelled / checked);
+		benchReportValue(ctx, "sweep", "bezier packet", "sweep", "% tunnelled", 100.0 * missed / checked);
+		if (missed) benchFail(ctx, "sweep: %d of %d sweeps miss a hit of the dense reference\n", missed, checked);
+		if (overlapping) benchFail(ctx, "sweep: %d of %d sweeps stop overlapping the scene\n", overlapping, checked);
+	}
+
+	if (benchSelected(ctx, "graze")) {
+		checkGraze(ctx, &s->params, 0.1f);
+		checkGraze(ctx, &s->params, 0.3f);
+	}
+
+	sdSceneFree(&s->scene);
+	free(s->substepHit);
+	free(s->hit);
+	free(s->r);
+	free(s->x0);
+	free(s->y0);
+	free(s->x1);
+	free(s->y1);
+	free(s);
+}
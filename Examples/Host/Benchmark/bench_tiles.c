@@ -0,0 +1,169 @@
+// Tile culling benchmark: full-screen 1-bit renders, occupancy masks and grid bakes with and without
+// the quadtree culling of sdf2d_tiles.h. Reports SDF calls against the 96000 of a full scan, and
+// checks that culling changes no pixel, no mask entry and no baked sample.
+
+#include "bench.h"
+#include "sdf2d_grid.h"
+#include "sdf2d_raster.h"
+#include "sdf2d_tiles.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILES_W 400
+#define TILES_H 240
+#define TILES_ROWBYTES 52
+#define TILES_CIRCLES 30
+
+typedef struct {
+	const char *name;
+	SDShape shape;       // kSDShapeCount: the scene
+	float x, y;
+} TilesCase;
+
+typedef struct {
+	const TilesCase *c;
+	const SDScene *scene;
+	const SDRasterStyle *style;
+	SDBitmap bm;
+	unsigned char *mask;
+	SDTileStats stats;
+} TilesRun;
+
+typedef struct {
+	SDTileSampler sample;
+	void *ctx;
+	long samples;
+} CountingSampler;
+
+static void countSamples(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	CountingSampler *c = ctx;
+	c->samples += n;
+	c->sample(c->ctx, px, py, out, n);
+}
+
+static void runFull(void *arg)
+{
+	TilesRun *r = arg;
+	if (r->c->shape.type == kSDShapeCount) sdRasterScene(&r->bm, r->scene, r->style);
+	else sdRasterShape(&r->bm, &r->c->shape, r->c->x, r->c->y, r->style);
+}
+
+static void runCulled(void *arg)
+{
+	TilesRun *r = arg;
+	r->stats = (SDTileStats){ 0 };
+	if (r->c->shape.type == kSDShapeCount) sdRasterSceneCulled(&r->bm, r->scene, r->style, &r->stats);
+	else sdRasterShapeCulled(&r->bm, &r->c->shape, r->c->x, r->c->y, r->style, &r->stats);
+}
+
+static void runOccupancy(void *arg)
+{
+	TilesRun *r = arg;
+	SDTileLayout layout = { 0, 0, TILES_W, TILES_H, 1.0f, 0.0f, 0.0f };
+	SDTileShape placed = { &r->c->shape, r->c->x, r->c->y };
+	r->stats = (SDTileStats){ 0 };
+	if (r->c->shape.type == kSDShapeCount) sdTileOccupancy(&layout, sdTileSampleScene, (void *)r->scene, r->mask, &r->stats);
+	else sdTileOccupancy(&layout, sdTileSampleShape, &placed, r->mask, &r->stats);
+}
+
+// Circles along the bottom of the screen, smooth unioned left to right
+static void buildTerrain(SDScene *scene)
+{
+	sdSceneInit(scene);
+	int root = -1;
+	for (int i = 0; i < TILES_CIRCLES; i++) {
+		int id = sdSceneAddShape(scene, &(SDShape){ kSDCircle, { benchUniform(8, 30) } });
+		sdSceneSetTransform(scene, id, i * 400.0f / TILES_CIRCLES, benchUniform(190, 240), 0.0f);
+		root = root < 0 ? id : sdSceneAddOp(scene, kSDSmoothUnion, root, id, 6.0f);
+	}
+	sdSceneCompile(scene, root);
+}
+
+static float tilesEval(const TilesRun *r, float x, float y)
+{
+	if (r->c->shape.type == kSDShapeCount) return sdSceneEval(r->scene, x, y);
+	return sdShapeEval(&r->c->shape, x - r->c->x, y - r->c->y);
+}
+
+void benchTiles(BenchContext *ctx)
+{
+	static const TilesCase cases[] = {
+		{ "small sdCircle", { kSDCircle, { 20 } }, 200, 120 },
+		{ "sdHexagon", { kSDHexagon, { 90 } }, 200, 120 },
+		{ "sdEllipse", { kSDEllipse, { 160, 80 } }, 200, 120 },
+		{ "sdParabola", { kSDParabola, { 0.002f } }, 200, 120 },
+		{ "sdParabola k < 0", { kSDParabola, { -0.002f } }, 200, 120 },
+		{ "sdBoxLinf", { kSDBoxLinf, { 160, 70 } }, 200, 120 },
+		{ "sdStar5", { kSDStar5, { 35, 3 } }, 200, 120 },
+		{ "terrain scene", { kSDShapeCount }, 0, 0 },
+	};
+	static const SDRasterStyle styles[] = {
+		{ kSDRasterFill, 0.0f, 0.0f },
+		{ kSDRasterOutline, 1.5f, 0.0f },
+	};
+	static const char *styleNames[] = { "fill", "outline" };
+	const double pixels = TILES_W * TILES_H;
+	char variant[32];
+	// zeroed: the row padding past TILES_W is never written, and is compared too
+	uint8_t *full = calloc(TILES_H, TILES_ROWBYTES);
+	uint8_t *culled = calloc(TILES_H, TILES_ROWBYTES);
+	unsigned char *mask = malloc(TILES_W * TILES_H);
+	SDScene scene;
+	buildTerrain(&scene);
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		if (!benchSelected(ctx, cases[c].name)) continue;
+		TilesRun run = { &cases[c], &scene, NULL, { full, TILES_W, TILES_H, TILES_ROWBYTES }, mask, { 0 } };
+
+		for (int s = 0; s < 2; s++) {
+			run.style = &styles[s];
+			run.bm.data = full;
+			snprintf(variant, sizeof(variant), "%s full", styleNames[s]);
+			benchReport(ctx, "tiles", cases[c].name, variant, benchTime(ctx, runFull, &run) * 1e9);
+			run.bm.data = culled;
+			snprintf(variant, sizeof(variant), "%s culled", styleNames[s]);
+			benchReport(ctx, "tiles", cases[c].name, variant, benchTime(ctx, runCulled, &run) * 1e9);
+			benchReportValue(ctx, "tiles", cases[c].name, variant, "samples", run.stats.samples);
+			benchReportValue(ctx, "tiles", cases[c].name, variant, "x fewer calls", pixels / run.stats.samples);
+			if (memcmp(full, culled, TILES_H * TILES_ROWBYTES) != 0)
+				benchFail(ctx, "tiles: %s %s culled render differs from the full one\n", cases[c].name, styleNames[s]);
+		}
+
+		benchReport(ctx, "tiles", cases[c].name, "occupancy", benchTime(ctx, runOccupancy, &run) * 1e9);
+		benchReportValue(ctx, "tiles", cases[c].name, "occupancy", "x fewer calls", pixels / run.stats.samples);
+		int wrong = 0;
+		for (int y = 0; y < TILES_H; y++)
+			for (int x = 0; x < TILES_W; x++) wrong += mask[y * TILES_W + x] != (tilesEval(&run, x, y) <= 0.0f);
+		if (wrong) benchFail(ctx, "tiles: %s occupancy wrong at %d samples\n", cases[c].name, wrong);
+
+		// dense bake: count the samples, and compare against every sample baked directly
+		SDGridLayout layout = { kSDGridFloat, 0, 0, 201, 121, 2.0f, 16.0f, 0 };
+		SDTileShape placed = { &cases[c].shape, cases[c].x, cases[c].y };
+		CountingSampler counter = { sdTileSampleShape, &placed, 0 };
+		if (cases[c].shape.type == kSDShapeCount) {
+			counter.sample = sdTileSampleScene;
+			counter.ctx = &scene;
+		}
+		SDGrid grid;
+		sdGridInit(&grid);
+		if (sdGridBake(&grid, &layout, countSamples, &counter) == 0) {
+			benchReportValue(ctx, "tiles", cases[c].name, "grid bake", "x fewer calls", (double)layout.width * layout.height / counter.samples);
+			wrong = 0;
+			for (int y = 0; y < layout.height; y++) {
+				for (int x = 0; x < layout.width; x++) {
+					float d = tilesEval(&run, x * layout.cell, y * layout.cell);
+					wrong += ((const float *)grid.data)[y * layout.width + x] != fmaxf(-layout.range, fminf(d, layout.range));
+				}
+			}
+			if (wrong) benchFail(ctx, "tiles: %s grid bake wrong at %d samples\n", cases[c].name, wrong);
+		}
+		sdGridFree(&grid);
+	}
+	sdSceneFree(&scene);
+	free(full);
+	free(culled);
+	free(mask);
+}
@@ -0,0 +1,290 @@
+// Track benchmark: the thick quadratic Bezier of pd_complex.lua, which the example builds from 20
+// sdQuad calls behind bounding box checks, against one sdBezier call and against SDPolygonIndex
+// polylines through points on the curve. Then long polylines of 1024 and 16384 vertices, a loop over
+// sdSegment against sdPolylineIndexEval. Reports ns per point over the 400x240 screen, and for the
+// track also within a track width of its surface, and how far the quad chain is from sdBezier. sdBezier is checked against a finely sampled polyline and its gradient
+// against central differences, and the indexed polylines against the loop over sdSegment.
+
+#include "bench.h"
+#include "sdf2d.h"
+#include "sdf2d_polygon.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define TRACK_QUADS 20
+#define TRACK_WIDTH 10.0f    // either side of the curve
+
+static const float trackCurve[6] = { 20, 30, 100, 200, 200, 90 };
+
+typedef struct {
+	float q[TRACK_QUADS][8];
+	SDBounds bounds[TRACK_QUADS];
+	const SDPolygonIndex *line;
+	const float *vx, *vy;
+	int num;
+	const float *px;
+	const float *py;
+	float *out;
+	int n;
+	float sink;
+} TrackRun;
+
+static void trackPoint(float t, float *x, float *y)
+{
+	const float *c = trackCurve;
+	float u = 1.0f - t;
+	*x = u * u * c[0] + 2.0f * u * t * c[2] + t * t * c[4];
+	*y = u * u * c[1] + 2.0f * u * t * c[3] + t * t * c[5];
+}
+
+// As buildBezierQuads in pd_complex.lua: points at t = 0, 0.05 .. 1 offset along the normal
+static void trackQuads(TrackRun *r)
+{
+	const float *c = trackCurve;
+	float prev[4] = { 0 };
+	for (int k = 0; k <= TRACK_QUADS; k++) {
+		float t = (float)k / TRACK_QUADS, x, y;
+		trackPoint(t, &x, &y);
+		float tx = (c[2] - c[0]) * 2.0f * (1.0f - t) + (c[4] - c[2]) * 2.0f * t;
+		float ty = (c[3] - c[1]) * 2.0f * (1.0f - t) + (c[5] - c[3]) * 2.0f * t;
+		float l = sqrtf(tx * tx + ty * ty);
+		float nx = -ty / l * TRACK_WIDTH, ny = tx / l * TRACK_WIDTH;
+		float off[4] = { x + nx, y + ny, x - nx, y - ny };
+		if (k > 0) {
+			float *q = r->q[k - 1];
+			float v[8] = { prev[0], prev[1], prev[2], prev[3], off[2], off[3], off[0], off[1] };
+			SDBounds *b = &r->bounds[k - 1];
+			b->minx = b->maxx = v[0];
+			b->miny = b->maxy = v[1];
+			for (int i = 0; i < 8; i++) q[i] = v[i];
+			for (int i = 1; i < 4; i++) {
+				b->minx = fminf(b->minx, v[2 * i]);
+				b->maxx = fmaxf(b->maxx, v[2 * i]);
+				b->miny = fminf(b->miny, v[2 * i + 1]);
+				b->maxy = fmaxf(b->maxy, v[2 * i + 1]);
+			}
+		}
+		for (int i = 0; i < 4; i++) prev[i] = off[i];
+	}
+}
+
+// The nearest quad, among those whose box is within reach
+static float trackQuadDistance(const TrackRun *r, float x, float y, float reach)
+{
+	float d = 1e30f;
+	for (int k = 0; k < TRACK_QUADS; k++) {
+		const SDBounds *b = &r->bounds[k];
+		if (x < b->minx - reach || x > b->maxx + reach || y < b->miny - reach || y > b->maxy + reach) continue;
+		const float *q = r->q[k];
+		d = fminf(d, sdQuad(x, y, q[0], q[1], q[2], q[3], q[4], q[5], q[6], q[7]));
+	}
+	return d;
+}
+
+static void runQuads(void *arg)
+{
+	TrackRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += trackQuadDistance(r, r->px[i], r->py[i], 3.0f);
+	r->sink = t;
+}
+
+static void runBezier(void *arg)
+{
+	TrackRun *r = arg;
+	const float *c = trackCurve;
+	sdBezierBatch(r->px, r->py, r->out, r->n, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH);
+	r->sink = r->out[0];
+}
+
+static void runBezierGrad(void *arg)
+{
+	TrackRun *r = arg;
+	const float *c = trackCurve;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) {
+		float gx, gy;
+		t += sdgBezier(r->px[i], r->py[i], c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH, &gx, &gy) + gx + gy;
+	}
+	r->sink = t;
+}
+
+static void runPolyline(void *arg)
+{
+	TrackRun *r = arg;
+	sdPolylineIndexEvalBatch(r->line, r->px, r->py, r->out, r->n, TRACK_WIDTH);
+	r->sink = r->out[0];
+}
+
+static float segmentLoop(const TrackRun *r, float x, float y)
+{
+	float d = 1e30f;
+	for (int k = 1; k < r->num; k++) d = fminf(d, sdSegment(x, y, r->vx[k - 1], r->vy[k - 1], r->vx[k], r->vy[k]));
+	return d - TRACK_WIDTH;
+}
+
+static void runSegments(void *arg)
+{
+	TrackRun *r = arg;
+	float t = 0.0f;
+	for (int i = 0; i < r->n; i++) t += segmentLoop(r, r->px[i], r->py[i]);
+	r->sink = t;
+}
+
+// A polyline through num points of the curve, evenly spaced in t
+static int trackPolyline(TrackRun *r, SDPolygonIndex *line, float *vx, float *vy, int num)
+{
+	for (int k = 0; k < num; k++) trackPoint((float)k / (num - 1), &vx[k], &vy[k]);
+	r->vx = vx;
+	r->vy = vy;
+	r->num = num;
+	r->line = line;
+	return sdPolylineIndexBuild(line, vx, vy, num);
+}
+
+// Largest difference between the index and the loop over sdSegment
+static float polylineError(TrackRun *r, int checks)
+{
+	float worst = 0.0f;
+	sdPolylineIndexEvalBatch(r->line, r->px, r->py, r->out, checks, TRACK_WIDTH);
+	for (int i = 0; i < checks; i++) {
+		float d = segmentLoop(r, r->px[i], r->py[i]);
+		worst = fmaxf(worst, fabsf(r->out[i] - d) / (1.0f + fabsf(d)));
+	}
+	return worst;
+}
+
+void benchTrack(BenchContext *ctx)
+{
+	static const int chains[] = { 1024, 16384 };
+	int n = ctx->points;
+	float *px = malloc(n * sizeof(float));
+	float *py = malloc(n * sizeof(float));
+	float *out = malloc(n * sizeof(float));
+	float *vx = malloc(16384 * sizeof(float));
+	float *vy = malloc(16384 * sizeof(float));
+	volatile float sink = 0.0f;
+	TrackRun run = { .px = px, .py = py, .out = out, .n = n };
+	SDPolygonIndex line;
+	sdPolygonIndexInit(&line);
+	for (int i = 0; i < n; i++) {
+		px[i] = benchUniform(0, 400);
+		py[i] = benchUniform(0, 240);
+	}
+
+	if (benchSelected(ctx, "pd_complex track")) {
+		const float *c = trackCurve;
+		trackQuads(&run);
+		// over the screen, where the boxes cull most quads, and within a track width of the surface
+		static const char *sets[] = { "pd_complex track", "pd_complex track surface" };
+		float *sx = malloc(n * sizeof(float));
+		float *sy = malloc(n * sizeof(float));
+		for (int i = 0; i < n;) {
+			sx[i] = benchUniform(0, 400);
+			sy[i] = benchUniform(0, 240);
+			if (fabsf(sdBezier(sx[i], sy[i], c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH)) < TRACK_WIDTH) i++;
+		}
+		for (int set = 0; set < 2; set++) {
+			const char *name = sets[set];
+			run.px = set ? sx : px;
+			run.py = set ? sy : py;
+			double t = benchTime(ctx, runQuads, &run);
+			sink += run.sink;
+			benchReport(ctx, "track", name, "20 sdQuad + boxes", t * 1e9 / n);
+			t = benchTime(ctx, runBezier, &run);
+			sink += run.sink;
+			benchReport(ctx, "track", name, "sdBezier", t * 1e9 / n);
+			t = benchTime(ctx, runBezierGrad, &run);
+			sink += run.sink;
+			benchReport(ctx, "track", name, "sdgBezier", t * 1e9 / n);
+			static const int samples[] = { 21, 256 };
+			for (int k = 0; k < 2; k++) {
+				char variant[48];
+				if (trackPolyline(&run, &line, vx, vy, samples[k]) < 0) {
+					benchFail(ctx, "track: polyline build failed\n");
+					continue;
+				}
+				snprintf(variant, sizeof(variant), "sdSegment loop (%d)", samples[k]);
+				t = benchTime(ctx, runSegments, &run);
+				sink += run.sink;
+				benchReport(ctx, "track", name, variant, t * 1e9 / n);
+				snprintf(variant, sizeof(variant), "sdPolylineIndexEval (%d)", samples[k]);
+				t = benchTime(ctx, runPolyline, &run);
+				sink += run.sink;
+				benchReport(ctx, "track", name, variant, t * 1e9 / n);
+			}
+		}
+		run.px = px;
+		run.py = py;
+		free(sx);
+		free(sy);
+
+		// near the track, where the seams are: the quads within reach, against the exact curve
+		float seams = 0.0f, worst = 0.0f, grad = 0.0f;
+		int wrong = 0;
+		trackPolyline(&run, &line, vx, vy, 4096);
+		for (int i = 0; i < n; i++) {
+			float x = px[i], y = py[i];
+			float d = sdBezier(x, y, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH);
+			// away from the ends, which are round on the curve and square on the quads
+			float ea = (x - c[0]) * (x - c[0]) + (y - c[1]) * (y - c[1]);
+			float ec = (x - c[4]) * (x - c[4]) + (y - c[5]) * (y - c[5]);
+			int ends = fminf(ea, ec) < 4.0f * TRACK_WIDTH * TRACK_WIDTH;
+			if (fabsf(d) < 2.0f && !ends) seams = fmaxf(seams, fabsf(trackQuadDistance(&run, x, y, 3.0f) - d));
+			worst = fmaxf(worst, fabsf(sdPolylineIndexEval(&line, x, y, TRACK_WIDTH) - d));
+			if (d > -TRACK_WIDTH + 0.5f) {
+				float gx, gy, e = 1e-2f;
+				sdgBezier(x, y, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH, &gx, &gy);
+				float fx = sdBezier(x + e, y, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH) - sdBezier(x - e, y, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH);
+				float fy = sdBezier(x, y + e, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH) - sdBezier(x, y - e, c[0], c[1], c[2], c[3], c[4], c[5], TRACK_WIDTH);
+				float err = fmaxf(fabsf(fx / (2.0f * e) - gx), fabsf(fy / (2.0f * e) - gy));
+				grad = fmaxf(grad, err);
+				wrong += err > 0.05f;
+			}
+		}
+		benchReportValue(ctx, "track", "pd_complex track", "20 sdQuad + boxes", "max error vs sdBezier", seams);
+		if (worst > 1e-2f) benchFail(ctx, "track: sdBezier differs from a 4096 point polyline by %g\n", worst);
+		// the central differences straddle the medial axis at a few points
+		if (wrong > n / 100) benchFail(ctx, "track: sdgBezier differs from central differences at %d points (max %g)\n", wrong, grad);
+	}
+
+	for (size_t c = 0; c < sizeof(chains) / sizeof(chains[0]); c++) {
+		int num = chains[c];
+		char name[32];
+		snprintf(name, sizeof(name), "polyline (%d)", num);
+		if (!benchSelected(ctx, name)) continue;
+		// a winding road across the screen and back: lanes 24 px apart
+		for (int k = 0; k < num; k++) {
+			float t = (float)k / (num - 1), lane = floorf(t * 8.0f), u = t * 8.0f - lane;
+			float x = ((int)lane & 1) ? 390.0f - 380.0f * u : 10.0f + 380.0f * u;
+			vx[k] = x;
+			vy[k] = 24.0f + lane * 24.0f + 6.0f * sinf(x * 0.1f + t * 40.0f);
+		}
+		run.vx = vx;
+		run.vy = vy;
+		run.num = num;
+		run.line = &line;
+		if (sdPolylineIndexBuild(&line, vx, vy, num) < 0) {
+			benchFail(ctx, "track: %s build failed\n", name);
+			continue;
+		}
+		// the loop visits every segment: fewer points keep the large case quick
+		run.n = num > 1024 ? (n < 256 ? n : 256) : n;
+		double t = benchTime(ctx, runSegments, &run);
+		sink += run.sink;
+		benchReport(ctx, "track", name, "sdSegment loop", t * 1e9 / run.n);
+		run.n = n;
+		t = benchTime(ctx, runPolyline, &run);
+		sink += run.sink;
+		benchReport(ctx, "track", name, "sdPolylineIndexEval", t * 1e9 / n);
+		float err = polylineError(&run, num > 1024 ? (n < 4096 ? n : 4096) : n);
+		if (err > 1e-4f) benchFail(ctx, "track: %s index differs from sdSegment by %g\n", name, err);
+	}
+	sdPolygonIndexFree(&line);
+	free(px);
+	free(py);
+	free(out);
+	free(vx);
+	free(vy);
+}
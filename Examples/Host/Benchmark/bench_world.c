@@ -0,0 +1,111 @@
+// World benchmark: balls dropped into a bin of pegs, stepped with sdWorldStep on 1 to 8 threads.
+// Reports balls stepped per millisecond and contacts per step, and checks that every thread count
+// gives the same positions.
+
+#include "bench.h"
+#include "sdf2d_world.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WORLD_BALLS 4096         // 1024 with --quick
+#define WORLD_STEPS 10           // fixed steps per timed run, from the state after 300 steps
+#define WORLD_PEGS 60
+
+typedef struct {
+	SDWorld world;
+	float *x, *y, *vx, *vy;      // starting state, restored before each run
+	SDWorldStats stats;
+} WorldRun;
+
+static void runWorld(void *arg)
+{
+	WorldRun *w = arg;
+	size_t bytes = w->world.count * sizeof(float);
+	memcpy(w->world.x, w->x, bytes);
+	memcpy(w->world.y, w->y, bytes);
+	memcpy(w->world.vx, w->vx, bytes);
+	memcpy(w->world.vy, w->vy, bytes);
+	w->stats = (SDWorldStats){ 0 };
+	sdWorldStep(&w->world, WORLD_STEPS, &w->stats);
+}
+
+// A 400 x 240 bin: floor, walls and staggered rows of pegs
+static void buildBin(SDBroadphase *bp)
+{
+	sdBroadphaseInit(bp);
+	sdBroadphaseAdd(bp, &(SDShape){ kSDBox, { 200, 10 } }, 200, 240);
+	sdBroadphaseAdd(bp, &(SDShape){ kSDBox, { 10, 130 } }, 0, 120);
+	sdBroadphaseAdd(bp, &(SDShape){ kSDBox, { 10, 130 } }, 400, 120);
+	for (int i = 0; i < WORLD_PEGS; i++) {
+		int row = i / 12, col = i % 12;
+		float x = 25 + col * 32 + (row & 1) * 16, y = 80 + row * 28;
+		SDShape peg = { kSDCircle, { 5 } };
+		if (i % 3 == 1) peg = (SDShape){ kSDHexagon, { 5 } };
+		if (i % 3 == 2) peg = (SDShape){ kSDSegment, { -6, -3, 6, 3 } };
+		sdBroadphaseAdd(bp, &peg, x, y);
+	}
+	sdBroadphaseBuild(bp);
+}
+
+void benchWorld(BenchContext *ctx)
+{
+	static const int threads[] = { 1, 2, 4, 8 };
+	int balls = ctx->quick ? WORLD_BALLS / 4 : WORLD_BALLS;
+	SDBroadphase bp;
+	buildBin(&bp);
+	WorldRun *w = malloc(sizeof(WorldRun));
+	SDWorldParams params = SD_WORLD_DEFAULTS;
+	sdWorldInit(&w->world, &bp, &params);
+	for (int i = 0; i < balls; i++)
+		sdWorldAdd(&w->world, benchUniform(20, 380), benchUniform(0, 200), benchUniform(-100, 100), benchUniform(-50, 150), 2.0f);
+	// six seconds in, most balls are resting on the floor or on pegs
+	sdWorldStep(&w->world, 300, NULL);
+	w->x = malloc(balls * sizeof(float));
+	w->y = malloc(balls * sizeof(float));
+	w->vx = malloc(balls * sizeof(float));
+	w->vy = malloc(balls * sizeof(float));
+	memcpy(w->x, w->world.x, balls * sizeof(float));
+	memcpy(w->y, w->world.y, balls * sizeof(float));
+	memcpy(w->vx, w->world.vx, balls * sizeof(float));
+	memcpy(w->vy, w->world.vy, balls * sizeof(float));
+	float *refX = malloc(balls * sizeof(float));
+	float *refY = malloc(balls * sizeof(float));
+	char variant[32];
+
+	if (benchSelected(ctx, "pegs")) {
+#ifdef SDF2D_THREADS
+		int variants = sizeof(threads) / sizeof(threads[0]);
+#else
+		int variants = 1;
+#endif
+		for (int v = 0; v < variants; v++) {
+			w->world.params.threads = threads[v];
+			double t = benchTime(ctx, runWorld, w);
+			snprintf(variant, sizeof(variant), "%d thread%s", threads[v], threads[v] > 1 ? "s" : "");
+			benchReport(ctx, "world", "pegs", variant, t * 1e9 / w->stats.steps);
+			benchReportValue(ctx, "world", "pegs", variant, "balls/ms", w->stats.steps / (t * 1e3));
+			benchReportValue(ctx, "world", "pegs", variant, "contacts/step", (double)w->stats.contacts / w->stats.steps);
+			if (v == 0) {
+				memcpy(refX, w->world.x, balls * sizeof(float));
+				memcpy(refY, w->world.y, balls * sizeof(float));
+				int escaped = 0;
+				for (int i = 0; i < balls; i++) escaped += w->world.y[i] > 240.0f || w->world.x[i] < 0.0f || w->world.x[i] > 400.0f;
+				if (escaped) benchFail(ctx, "world: %d of %d balls left the bin\n", escaped, balls);
+			} else if (memcmp(refX, w->world.x, balls * sizeof(float)) || memcmp(refY, w->world.y, balls * sizeof(float))) {
+				benchFail(ctx, "world: %d threads give different positions than 1\n", threads[v]);
+			}
+		}
+	}
+
+	sdWorldFree(&w->world);
+	sdBroadphaseFree(&bp);
+	free(refX);
+	free(refY);
+	free(w->x);
+	free(w->y);
+	free(w->vx);
+	free(w->vy);
+	free(w);
+}
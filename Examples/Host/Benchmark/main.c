@@ -0,0 +1,97 @@
+// Host benchmark for the SDF library. Runs on Linux (x86 and ARM) without the Playdate SDK.
+//
+// usage: sdf2d_bench [suite] [--filter name] [--points n] [--time seconds] [--quick] [--json file|-]
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const struct {
+	const char *name;
+	void (*run)(BenchContext *ctx);
+} suites[] = {
+	{ "primitives", benchPrimitives },
+	{ "batch", benchBatch },
+	{ "scene", benchScene },
+	{ "broadphase", benchBroadphase },
+	{ "gradient", benchGradient },
+	{ "grid", benchGrid },
+	{ "fixed", benchFixed },
+	{ "prepared", benchPrepared },
+	{ "ray", benchRay },
+	{ "raster", benchRaster },
+	{ "tiles", benchTiles },
+	{ "fast", benchFast },
+	{ "sweep", benchSweep },
+	{ "world", benchWorld },
+	{ "render", benchRender },
+	{ "dirty", benchDirty },
+	{ "edt", benchEdt },
+	{ "polygon", benchPolygon },
+	{ "track", benchTrack },
+	{ "profile", benchProfile },
+	{ "expr", benchExpr },
+	{ "asset", benchAsset },
+	{ "contour", benchContour },
+};
+
+static int usage(const char *prog)
+{
+	fprintf(stderr, "usage: %s [suite] [--filter name] [--points n] [--time seconds] [--quick] [--json file|-]\nsuites:", prog);
+	for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++)
+		fprintf(stderr, " %s", suites[i].name);
+	fprintf(stderr, "\n");
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	BenchContext ctx = { NULL, 400 * 240, 0.05, 0, stdout, NULL, 0, 0 };
+	const char *suite = NULL;
+	const char *jsonPath = NULL;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) ctx.filter = argv[++i];
+		else if (strcmp(argv[i], "--points") == 0 && i + 1 < argc) ctx.points = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) ctx.minTime = atof(argv[++i]);
+		else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--quick") == 0) ctx.quick = 1;
+		else if (argv[i][0] != '-' && suite == NULL) suite = argv[i];
+		else return usage(argv[0]);
+	}
+	if (ctx.quick) {
+		ctx.points = 4096;
+		ctx.minTime = 0.0;
+	}
+	if (ctx.points <= 0) return usage(argv[0]);
+
+	FILE *stdoutJson = NULL;
+	if (jsonPath) {
+		if (strcmp(jsonPath, "-") == 0) {
+			// Keep stdout parseable: the human readable table goes to stderr.
+			stdoutJson = stdout;
+			ctx.json = stdout;
+			ctx.log = stderr;
+		} else if ((ctx.json = fopen(jsonPath, "w")) == NULL) {
+			perror(jsonPath);
+			return 1;
+		}
+		fprintf(ctx.json, "{\"frame_ns\": %.0f, \"points\": %d, \"results\": [", BENCH_FRAME_NS, ctx.points);
+	}
+
+	int ran = 0;
+	for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++) {
+		if (suite && strcmp(suite, suites[i].name) != 0) continue;
+		suites[i].run(&ctx);
+		ran++;
+	}
+
+	if (ctx.json) {
+		fprintf(ctx.json, "\n]}\n");
+		if (ctx.json != stdoutJson) fclose(ctx.json);
+	}
+	if (!ran) return usage(argv[0]);
+	if (ctx.failures) fprintf(stderr, "%d failed checks\n", ctx.failures);
+	return ctx.failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+-- Checks every binding of sdf2d_lua.c, and the SDShape objects and their contours, against Source/Lua/SDF2D.lua. Then
+-- times a screen of calls through SDF2D.lua, the C bindings one call per point and one sdXxxGrid
+-- call, and of contacts through table.unpack, SDShape and SDShapeC.
+-- Mismatches are printed to stderr, and the script fails if there were any.
+--
+-- usage: sdf2d_lua check.lua [path to SDF2D.lua]
+
+local path = arg[1] or "../../../Source/Lua/SDF2D.lua"
+
+-- SDF2D.lua defines globals with the same names, so it is loaded into a table of its own
+local lua = setmetatable({}, { __index = _G })
+math.pow = math.pow or function(x, y) return x ^ y end
+assert(loadfile(path, "t", lua))()
+
+local rad = math.pi / 180
+local cases = {
+	{ "sdCircle", 50 },
+	{ "sdSegment", 20, 20, 80, 80 },
+	{ "sdSegmentLinf", 20, 20, 80, 80 },
+	{ "sdBox", 40, 40 },
+	{ "sdBoxLinf", 40, 40 },
+	{ "sdRoundedBox", 40, 40, 0, 20, 0, 20 },
+	{ "sdOrientedBox", 20, 20, 80, 80, 20 },
+	{ "sdRoundSquare", 40, 20 },
+	{ "sdRhombus", 50, 40 },
+	{ "sdRhombusLinf", 50, 40 },
+	{ "sdTrapezoid", 50, 30, 40 },
+	{ "sdParallelogram", 40, 40, 10 },
+	{ "sdEquilateralTriangle", 45 },
+	{ "sdTriangleIsosceles", 50, 50 },
+	{ "sdTriangle", 10, 10, 90, 90, 10, 80 },
+	{ "sdQuad", 10, 10, 10, 80, 90, 90, 70, 15 },
+	{ "sdUnevenCapsule", 20, 5, 40 },
+	{ "sdEgg", 30, 10 },
+	{ "sdPie", math.sin(120 * rad), math.cos(120 * rad), 40 },
+	{ "sdCutDisk", 50, -25 },
+	{ "sdVesica", 50, 30 },
+	{ "sdOrientedVesica", 10, 10, 90, 90, 30 },
+	{ "sdMoon", 15, 40, 30 },
+	{ "sdTunnel", 40, 20 },
+	{ "sdArc", math.sin(135 * rad), math.cos(135 * rad), 40, 5 },
+	{ "sdRing", math.cos(135 * rad), math.sin(135 * rad), 40, 5 },
+	{ "sdHorseshoe", 0, 1, 40, 20, 5 },
+	{ "sdParabola", 0.025 },
+	{ "sdCross", 50, 20, 7 },
+	{ "sdRoundedX", 60, 10 },
+	{ "sdEllipse", 40, 20 },
+	{ "sdEllipseLinf", 40, 20 },
+	{ "sdStar5", 15, 3 },
+	{ "sdHexagram", 25 },
+	{ "sdPentagon", 40 },
+	{ "sdHexagon", 40 },
+	{ "sdOctagon", 40 },
+	{ "sdRegularPolygon", 40, 5 },
+	{ "sdBezier", 20, 30, 100, 200, 200, 90, 10 },
+}
+
+-- sdPolygon takes tables in SDF2D.lua and packed floats in C
+local vx, vy = { 10, 70, 90, 10 }, { 10, 15, 90, 80 }
+local polygon = { "sdPolygon", string.pack("ffff", table.unpack(vx)), string.pack("ffff", table.unpack(vy)), 4 }
+local polygonLua = { "sdPolygon", vx, vy, 4 }
+
+local failures = 0
+local function fail(fmt, ...)
+	io.stderr:write(string.format(fmt, ...), "\n")
+	failures = failures + 1
+end
+
+local function floats(s)
+	local t = {}
+	for i = 1, #s // 4 do t[i] = string.unpack("f", s, 4 * (i - 1) + 1) end
+	return t
+end
+
+local W, H, CELL = 40, 24, 4          -- the grid checked: -40 .. 116 by -40 .. 52
+local X0, Y0 = -40, -40
+
+local function check(case, luaCase)
+	local name = case[1]
+	local c = _G[name]
+	local ref = lua[name]
+	local g = _G["sdg" .. name:sub(3)]
+	local args = { table.unpack(case, 2) }
+	local luaArgs = { table.unpack(luaCase, 2) }
+
+	-- scalar and gradient, against SDF2D.lua
+	local xs, ys, worst = {}, {}, 0
+	for j = 0, H - 1 do
+		for i = 0, W - 1 do
+			local px, py = X0 + i * CELL, Y0 + j * CELL
+			xs[#xs + 1], ys[#ys + 1] = px, py
+			local d = c(px, py, table.unpack(args))
+			local e = math.abs(d - ref(px, py, table.unpack(luaArgs)))
+			worst = math.max(worst, e / math.max(1, math.abs(d)))
+			local gd, gx, gy = g(px, py, table.unpack(args))
+			if not gy or math.abs(gd - d) > 1e-4 * math.max(1, math.abs(d)) then
+				fail("%s: sdg distance %s, sd %g at %g, %g", name, tostring(gd), d, px, py)
+			end
+		end
+	end
+	-- C is float and SDF2D.lua double
+	if worst > 0.01 then fail("%s: C differs from SDF2D.lua by %g", name, worst) end
+
+	-- batch and grid, against the scalar binding
+	local pxs = string.pack(string.rep("f", #xs), table.unpack(xs))
+	local pys = string.pack(string.rep("f", #ys), table.unpack(ys))
+	local batch = floats(_G[name .. "Batch"](pxs, pys, table.unpack(args)))
+	local grid = floats(_G[name .. "Grid"](X0, Y0, W, H, CELL, table.unpack(args)))
+	if #batch ~= #xs or #grid ~= #xs then fail("%s: %d batch and %d grid distances for %d points", name, #batch, #grid, #xs) end
+	for k = 1, math.min(#xs, #batch, #grid) do
+		local d = c(xs[k], ys[k], table.unpack(args))
+		local tol = 1e-4 * math.max(1, math.abs(d))
+		if math.abs(batch[k] - d) > tol or math.abs(grid[k] - d) > tol then
+			fail("%s: batch %g, grid %g, scalar %g at %g, %g", name, batch[k], grid[k], d, xs[k], ys[k])
+			break
+		end
+	end
+
+	-- bitmap of the same area, one pixel per unit: black where the distance is <= 0, allowing for
+	-- the sdf2d_fast.h shapes of an SDF2D_FAST_MATH build near the surface
+	local img = newBitmap(W * CELL, H * CELL)
+	_G[name .. "Bitmap"](img, -X0, -Y0, table.unpack(args))
+	local data, rowbytes = bitmapData(img)
+	local wrong = 0
+	for j = 0, H * CELL - 1 do
+		for i = 0, W * CELL - 1 do
+			local d = c(i + X0, j + Y0, table.unpack(args))
+			local byte = data:byte(j * rowbytes + i // 8 + 1)
+			local black = (byte >> (7 - i % 8)) & 1 == 0
+			if black ~= (d <= 0) and math.abs(d) > 0.01 then wrong = wrong + 1 end
+		end
+	end
+	if wrong > 0 then fail("%s: %d bitmap pixels wrong", name, wrong) end
+end
+
+-- SDShape objects from SDF2D.lua and SDShapeC objects from C, placed at 30, -20
+local function checkShape(case, luaCase)
+	local name = case[1]
+	local args = { table.unpack(case, 2) }
+	local luaArgs = { table.unpack(luaCase, 2) }
+	local SDShape = lua.SDShape
+	SDShape.useC = false
+	local ls = SDShape.new(name, 30, -20, table.unpack(luaArgs))
+	SDShape.useC = true
+	local cs = SDShape.new(name, 30, -20, table.unpack(luaArgs))
+	if getmetatable(ls) ~= SDShape or type(cs) ~= "userdata" then return fail("%s: SDShape.new gave the wrong objects", name) end
+
+	-- off the integer lattice, where the kinks of the L infinity shapes and of sdCross lie
+	local disagree, count = 0, 0
+	for j = 0, H - 1 do
+		for i = 0, W - 1 do
+			local px, py = X0 + i * CELL + 0.37, Y0 + j * CELL + 0.21
+			local d = lua[name](px - 30, py + 20, table.unpack(luaArgs))
+			local ld, lx, ly = ls:distanceGradient(px, py)
+			local cd, cx, cy = cs:distanceGradient(px, py)
+			if ld ~= d or ls:distance(px, py) ~= d then fail("%s: SDShape distance %g, expected %g", name, ld, d) return end
+			local e = _G[name](px - 30, py + 20, table.unpack(args))
+			if math.abs(cd - e) > 0.01 or math.abs(cs:distance(px, py) - cd) > 0.01 then fail("%s: SDShapeC distance %g, expected %g", name, cd, e) return end
+			local gx, gy = cs:gradient(px, py)
+			local len2 = cx * cx + cy * cy
+			if gx ~= cx or gy ~= cy or (len2 ~= 0 and math.abs(len2 - 1) > 1e-3) then fail("%s: SDShapeC normal %g, %g", name, cx, cy) return end
+			-- central differences and the exact gradient only part on the kinks of the distance
+			count = count + 1
+			if lx * cx + ly * cy < 0.99 then disagree = disagree + 1 end
+		end
+	end
+	if disagree > count // 20 then fail("%s: SDShape and SDShapeC normals differ at %d of %d points", name, disagree, count) end
+	cs:moveTo(0, 0)
+	if math.abs(cs:distance(5, 7) - _G[name](5, 7, table.unpack(args))) > 0.01 then fail("%s: SDShapeC moveTo", name) end
+
+	-- contour polylines over the grid, every vertex on the surface as in the contour bench
+	local xy, starts = cs:contour(X0, Y0, W * CELL + 1, H * CELL + 1, 1, 0)
+	if not xy then return fail("%s: SDShapeC contour failed", name) end
+	local lines = #starts // 4 - 1
+	if lines < 0 or string.unpack("i4", starts) ~= 0 or string.unpack("i4", starts, 4 * lines + 1) ~= #xy // 8 then
+		return fail("%s: SDShapeC contour starts do not cover its %d vertices", name, #xy // 8)
+	end
+	for v = 0, #xy // 8 - 1 do
+		local x, y = string.unpack("ff", xy, 8 * v + 1)
+		local d = _G[name](x, y, table.unpack(args))
+		if math.abs(d) > 0.5 then return fail("%s: SDShapeC contour vertex %g px off the surface", name, d) end
+	end
+end
+
+for _, case in ipairs(cases) do check(case, case) checkShape(case, case) end
+check(polygon, polygonLua)
+checkShape(polygon, polygonLua)
+if sdPolygon(0, 0, "", "", 4) ~= nil then fail("sdPolygon: a result without vertices") end
+if SDShapeC.new("sdNothing", 0, 0) ~= nil then fail("SDShapeC: an object for an unknown shape") end
+do
+	local xy, starts = SDShapeC.new("sdCircle", 200, 120, 50):contour(0, 0, 401, 241, 1, 0.25)
+	if #starts ~= 8 or #xy < 8 * 16 then fail("SDShapeC contour: %d polylines of %d vertices around a circle", #starts // 4 - 1, #xy // 8) end
+end
+
+-- timing: a 400 x 240 screen of sdCircle and sdEllipse distances
+local function time(f)
+	local t = os.clock()
+	f()
+	return os.clock() - t
+end
+
+local SW, SH = 400, 240
+for _, case in ipairs({ { "sdCircle", 110 }, { "sdEllipse", 110, 60 } }) do
+	local name, a, b = case[1], case[2], case[3]
+	local ref, c, grid = lua[name], _G[name], _G[name .. "Grid"]
+	local tLua = time(function()
+		for y = 0, SH - 1 do for x = 0, SW - 1 do ref(x - 200, y - 120, a, b) end end
+	end)
+	local tC = time(function()
+		for y = 0, SH - 1 do for x = 0, SW - 1 do c(x - 200, y - 120, a, b) end end
+	end)
+	local tGrid = time(function() grid(-200, -120, SW, SH, 1, a, b) end)
+	local calls = SW * SH
+	print(string.format("%-10s calls per 20 ms frame: SDF2D.lua %8.0f  C per call %8.0f  C grid %10.0f",
+		name, calls * 0.02 / tLua, calls * 0.02 / tC, calls * 0.02 / math.max(tGrid, 1e-9)))
+end
+
+-- contacts, distance and normal, as pd_collisions.lua makes them and through shape objects
+local params = { 110, 60 }
+local function unpackedContact(px, py)
+	local f, eps = lua.sdEllipse, 1e-4
+	local ds = { f(px + eps, py, table.unpack(params)), f(px - eps, py, table.unpack(params)),
+		f(px, py + eps, table.unpack(params)), f(px, py - eps, table.unpack(params)) }
+	return f(px, py, table.unpack(params)), (ds[1] - ds[2]) / (2 * eps), (ds[3] - ds[4]) / (2 * eps)
+end
+lua.SDShape.useC = false
+local ls = lua.SDShape.new("sdEllipse", 200, 120, 110, 60)
+lua.SDShape.useC = true
+local cs = lua.SDShape.new("sdEllipse", 200, 120, 110, 60)
+local tUnpack = time(function()
+	for y = 0, SH - 1 do for x = 0, SW - 1 do unpackedContact(x - 200, y - 120) end end
+end)
+local tShape = time(function()
+	for y = 0, SH - 1 do for x = 0, SW - 1 do ls:distanceGradient(x, y) end end
+end)
+local tShapeC = time(function()
+	for y = 0, SH - 1 do for x = 0, SW - 1 do cs:distanceGradient(x, y) end end
+end)
+print(string.format("%-10s contacts per 20 ms frame: table.unpack %8.0f  SDShape %8.0f  SDShapeC %8.0f",
+	"sdEllipse", SW * SH * 0.02 / tUnpack, SW * SH * 0.02 / tShape, SW * SH * 0.02 / tShapeC))
+
+if failures > 0 then
+	io.stderr:write(failures, " failures\n")
+	os.exit(1)
+end
+print("all bindings match")
@@ -0,0 +1,35 @@
+// Runs a Lua script with the sdf2d_lua.c bindings registered, as the Playdate does after kEventInitLua.
+//
+// usage: sdf2d_lua script.lua [args]
+
+#include "pd_api.h"
+#include "sdf2d_lua.h"
+
+#include <lauxlib.h>
+#include <lua.h>
+#include <lualib.h>
+#include <stdio.h>
+
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s script.lua [args]\n", argv[0]);
+		return 1;
+	}
+	lua_State *L = luaL_newstate();
+	luaL_openlibs(L);
+	if (sdLuaRegister(pdShimInit(L)) != 0) return 1;
+
+	// arg as in the lua interpreter: the script at 0, its arguments from 1
+	lua_createtable(L, argc - 2, 1);
+	for (int i = 1; i < argc; i++) {
+		lua_pushstring(L, argv[i]);
+		lua_rawseti(L, -2, i - 1);
+	}
+	lua_setglobal(L, "arg");
+
+	int status = luaL_dofile(L, argv[1]);
+	if (status != LUA_OK) fprintf(stderr, "%s\n", lua_tostring(L, -1));
+	lua_close(L);
+	return status == LUA_OK ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#ifndef PD_API_H
+#define PD_API_H
+
+// Stand-in for the Playdate SDK's pd_api.h, so that Source/C/sdf2d_lua.c builds and runs on Linux
+// against stock Lua 5.4. Only the calls the bindings make are declared, with the SDK's names and
+// signatures; pd_shim.c implements them on a lua_State.
+
+#include <stddef.h>
+#include <stdint.h>
+
+// the same typedefs as lua.h, so that both headers can be included
+typedef struct lua_State lua_State;
+typedef int (*lua_CFunction)(lua_State *L);
+
+typedef struct LCDBitmap LCDBitmap;
+typedef struct LuaUDObject LuaUDObject;
+
+typedef struct {
+	const char *name;
+	lua_CFunction func;
+} lua_reg;
+
+enum LuaValueType { kInt, kFloat, kStr };
+
+typedef struct {
+	const char *name;
+	enum LuaValueType type;
+	union {
+		unsigned int intval;
+		float floatval;
+		const char *strval;
+	} v;
+} lua_val;
+
+struct playdate_sys {
+	void *(*realloc)(void *ptr, size_t size);
+	void (*logToConsole)(const char *fmt, ...);
+};
+
+struct playdate_graphics {
+	void (*getBitmapData)(LCDBitmap *bitmap, int *width, int *height, int *rowbytes, uint8_t **mask, uint8_t **data);
+};
+
+struct playdate_lua {
+	int (*addFunction)(lua_CFunction f, const char *name, const char **outErr);
+	int (*registerClass)(const char *name, const lua_reg *reg, const lua_val *vals, int isstatic, const char **outErr);
+	int (*getArgCount)(void);
+	int (*getArgInt)(int pos);
+	float (*getArgFloat)(int pos);
+	const char *(*getArgString)(int pos);
+	const char *(*getArgBytes)(int pos, size_t *outlen);
+	void *(*getArgObject)(int pos, char *type, LuaUDObject **outud);
+	LCDBitmap *(*getBitmap)(int pos);
+	void (*pushNil)(void);
+	void (*pushInt)(int val);
+	void (*pushFloat)(float val);
+	void (*pushBytes)(const char *str, size_t len);
+	LuaUDObject *(*pushObject)(void *obj, char *type, int nValues);
+};
+
+typedef struct PlaydateAPI {
+	const struct playdate_sys *system;
+	const struct playdate_graphics *graphics;
+	const struct playdate_lua *lua;
+} PlaydateAPI;
+
+// The API for calls made on L. It also adds newBitmap(w, h) and bitmapData(image) to Lua, in place
+// of playdate.graphics.image.new and image:getBitmapData: a 1-bit image, white, and its rows as a string.
+PlaydateAPI *pdShimInit(lua_State *L);
+
+#endif
@@ -0,0 +1,180 @@
+// The pd->lua, pd->system and pd->graphics calls of pd_api.h on stock Lua 5.4. As on the Playdate,
+// the get/push calls act on the Lua function being called, so each added function (and class
+// method) is wrapped in a closure that makes its lua_State the current one.
+
+#include "pd_api.h"
+
+#include <lauxlib.h>
+#include <lua.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BITMAP_META "LCDBitmap"
+
+struct LCDBitmap {
+	int width, height;
+	int rowbytes;
+	uint8_t data[];
+};
+
+static lua_State *current = NULL;
+
+static int callFunction(lua_State *L)
+{
+	lua_CFunction f = *(lua_CFunction *)lua_touserdata(L, lua_upvalueindex(1));
+	lua_State *caller = current;
+	current = L;
+	int results = f(L);
+	current = caller;
+	return results;
+}
+
+static int addFunction(lua_CFunction f, const char *name, const char **outErr)
+{
+	if (!current || !name || strchr(name, '.')) {
+		*outErr = "the shim only adds global functions";
+		return 0;
+	}
+	lua_CFunction *box = lua_newuserdatauv(current, sizeof(lua_CFunction), 0);
+	*box = f;
+	lua_pushcclosure(current, callFunction, 1);
+	lua_setglobal(current, name);
+	return 1;
+}
+
+// A class is a metatable, also set as a global, holding the functions; objects are userdata with
+// a pointer to the C object. Constants (vals) are not supported.
+static int registerClass(const char *name, const lua_reg *reg, const lua_val *vals, int isstatic, const char **outErr)
+{
+	if (!current || !name || strchr(name, '.') || vals) {
+		*outErr = "the shim only registers global classes without constants";
+		return 0;
+	}
+	if (isstatic) lua_newtable(current);
+	else luaL_newmetatable(current, name);
+	for (; reg->name; reg++) {
+		lua_CFunction *box = lua_newuserdatauv(current, sizeof(lua_CFunction), 0);
+		*box = reg->func;
+		lua_pushcclosure(current, callFunction, 1);
+		lua_setfield(current, -2, reg->name);
+	}
+	if (!isstatic && lua_getfield(current, -1, "__index") == LUA_TNIL) {
+		lua_pop(current, 1);
+		lua_pushvalue(current, -1);
+		lua_setfield(current, -2, "__index");
+	} else if (!isstatic) {
+		lua_pop(current, 1);
+	}
+	lua_setglobal(current, name);
+	return 1;
+}
+
+static int getArgCount(void) { return lua_gettop(current); }
+static int getArgInt(int pos) { return (int)lua_tonumber(current, pos); }
+static float getArgFloat(int pos) { return (float)lua_tonumber(current, pos); }
+
+static const char *getArgString(int pos)
+{
+	return lua_type(current, pos) == LUA_TSTRING ? lua_tostring(current, pos) : NULL;
+}
+
+static const char *getArgBytes(int pos, size_t *outlen)
+{
+	// lua_tolstring would turn a number into a string in place
+	if (lua_type(current, pos) != LUA_TSTRING) return NULL;
+	return lua_tolstring(current, pos, outlen);
+}
+
+static void *getArgObject(int pos, char *type, LuaUDObject **outud)
+{
+	void **ud = luaL_testudata(current, pos, type);
+	if (outud) *outud = (LuaUDObject *)ud;
+	return ud ? *ud : NULL;
+}
+
+static LCDBitmap *getBitmap(int pos) { return luaL_testudata(current, pos, BITMAP_META); }
+
+static void pushNil(void) { lua_pushnil(current); }
+static void pushInt(int val) { lua_pushinteger(current, val); }
+static void pushFloat(float val) { lua_pushnumber(current, val); }
+static void pushBytes(const char *str, size_t len) { lua_pushlstring(current, str, len); }
+
+static LuaUDObject *pushObject(void *obj, char *type, int nValues)
+{
+	void **ud = lua_newuserdatauv(current, sizeof(void *), nValues);
+	*ud = obj;
+	luaL_setmetatable(current, type);
+	return (LuaUDObject *)ud;
+}
+
+static void *shimRealloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		free(ptr);
+		return NULL;
+	}
+	return realloc(ptr, size);
+}
+
+static void logToConsole(const char *fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+
+static void getBitmapData(LCDBitmap *bitmap, int *width, int *height, int *rowbytes, uint8_t **mask, uint8_t **data)
+{
+	if (width) *width = bitmap->width;
+	if (height) *height = bitmap->height;
+	if (rowbytes) *rowbytes = bitmap->rowbytes;
+	if (mask) *mask = NULL;
+	if (data) *data = bitmap->data;
+}
+
+// newBitmap(w, h): a white 1-bit image, rows padded to 32 bits as on the Playdate
+static int newBitmap(lua_State *L)
+{
+	int w = (int)luaL_checkinteger(L, 1), h = (int)luaL_checkinteger(L, 2);
+	luaL_argcheck(L, w > 0 && h > 0, 1, "empty bitmap");
+	int rowbytes = (w + 31) / 32 * 4;
+	LCDBitmap *bm = lua_newuserdatauv(L, sizeof(LCDBitmap) + (size_t)rowbytes * h, 0);
+	bm->width = w;
+	bm->height = h;
+	bm->rowbytes = rowbytes;
+	memset(bm->data, 0xff, (size_t)rowbytes * h);
+	luaL_setmetatable(L, BITMAP_META);
+	return 1;
+}
+
+// bitmapData(image): the rows as a string, and rowbytes
+static int bitmapData(lua_State *L)
+{
+	LCDBitmap *bm = luaL_checkudata(L, 1, BITMAP_META);
+	lua_pushlstring(L, (const char *)bm->data, (size_t)bm->rowbytes * bm->height);
+	lua_pushinteger(L, bm->rowbytes);
+	return 2;
+}
+
+static const struct playdate_sys sys = { shimRealloc, logToConsole };
+static const struct playdate_graphics graphics = { getBitmapData };
+static const struct playdate_lua lua = {
+	addFunction, registerClass, getArgCount, getArgInt, getArgFloat, getArgString, getArgBytes, getArgObject,
+	getBitmap, pushNil, pushInt, pushFloat, pushBytes, pushObject,
+};
+static PlaydateAPI api = { &sys, &graphics, &lua };
+
+PlaydateAPI *pdShimInit(lua_State *L)
+{
+	// functions are added at kEventInitLua time, outside any call
+	current = L;
+	luaL_newmetatable(L, BITMAP_META);
+	lua_pop(L, 1);
+	lua_register(L, "newBitmap", newBitmap);
+	lua_register(L, "bitmapData", bitmapData);
+	return &api;
+}
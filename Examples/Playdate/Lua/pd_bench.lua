@@ -54,8 +54,79 @@ local testObjects = {
 {sdPolygon, 	"sdPolygon 4", 		vec2(0,0), {{10,70,90,10},{10,15,90,80},4}},
 }
 
+-- Contact queries, the call pattern of pd_collisions.lua and pd_complex.lua: the SDF with
+-- table.unpack(params), then four more such calls for a central difference gradient. Compared with
+-- SDShape objects from SDF2D.lua, which store the offset and parameters once, and with the C backed
+-- SDShapeC objects when Source/C/sdf2d_lua.c is registered.
+local contactObjects = {
+{"sdBox", 			vec2(50,50), 	{40,40}},
+{"sdEllipse", 		vec2(50,50), 	{40,20}},
+{"sdQuad", 			vec2(0,0), 		{10,10, 10,80, 90,90, 70,15}},
+}
+
+local function unpackedGradient(p, f, o, params) -- as calcNormalizedGradient in pd_collisions.lua
+	local eps = 1e-4
+	local ds = {f(p.x + eps-o.x, p.y-o.y, table.unpack(params)),
+				f(p.x - eps-o.x, p.y-o.y, table.unpack(params)),
+				f(p.x-o.x, p.y + eps-o.y, table.unpack(params)),
+				f(p.x-o.x, p.y - eps-o.y, table.unpack(params))}
+	return vec2((ds[1]-ds[2])/(2*eps), (ds[3]-ds[4])/(2*eps)):normalized()
+end
+
+-- calls of fn(x, y) per 1/50 sec over the benchmark grid
+local function callsPerFrame(fn)
+	local timeCount, distCount = 0, 0
+	for x = 0, gridSize - 1 do
+		playdate.resetElapsedTime()
+		for y = 0, gridSize - 1 do
+			fn(x, y)
+		end
+		local thistimecount = playdate.getElapsedTime()
+		timeCount+=thistimecount
+		distCount+=gridSize
+		if thistimecount*2 > 1/fps then 
+			coroutine.yield()
+		end
+	end
+	return math.floor(distCount/timeCount/50)
+end
+
+local function benchContacts()
+	for i=1,#contactObjects do
+		local name, o, params = contactObjects[i][1], contactObjects[i][2], contactObjects[i][3]
+		local f = _G[name]
+		local p = vec2(0, 0)
+		SDShape.useC = false
+		local shape = SDShape.new(name, o.x, o.y, table.unpack(params))
+		SDShape.useC = true
+		local variants = {
+			{"unpack distance", function(x, y) return f(x-o.x, y-o.y, table.unpack(params)) end},
+			{"SDShape distance", function(x, y) return shape:distance(x, y) end},
+			{"unpack contact", function(x, y)
+				p.x, p.y = x, y
+				return f(x-o.x, y-o.y, table.unpack(params)), unpackedGradient(p, f, o, params)
+			end},
+			{"SDShape contact", function(x, y) return shape:distanceGradient(x, y) end},
+		}
+		if SDShapeC then
+			local cshape = SDShape.new(name, o.x, o.y, table.unpack(params))
+			variants[#variants+1] = {"SDShapeC distance", function(x, y) return cshape:distance(x, y) end}
+			variants[#variants+1] = {"SDShapeC contact", function(x, y) return cshape:distanceGradient(x, y) end}
+		end
+		playdate.graphics.clear()
+		for v=1,#variants do
+			local calls = callsPerFrame(variants[v][2])
+			print(name, variants[v][1], calls)
+			playdate.graphics.drawText(name .. " " .. variants[v][1] .. ": " .. calls, 20, 20 * v)
+		end
+		coroutine.yield()
+	end
+end
+
 function playdate.update()
 	
+	benchContacts()
+
 	for i=1,#testObjects do
 		obj = testObjects[i]
 		local grid = {}
@@ -38,7 +38,29 @@ function drawDemoBox(p,t) -- for sdBox
 	gfx.fillRect(p.x-t[1], p.y-t[2], t[1]*2, t[2]*2)
 end
 
+-- With the C bindings (Source/C/sdf2d_lua.c) registered, a shape can be filled from its traced
+-- contour, so that what is drawn is exactly what the ball collides with. Returns false without them.
+function fillContour(name, p, ...)
+	local shape = SDShapeC and SDShapeC.new(name, p.x, p.y, ...)
+	local xy, starts = nil, nil
+	if shape then xy, starts = shape:contour(0, 0, sw+1, sh+1, 1, 0.25) end
+	if not xy then return false end
+	gfx.setColor(playdate.graphics.kColorBlack)
+	for i = 0, #starts // 4 - 2 do -- one loop per polyline, as these shapes have no holes
+		local first, last = string.unpack("i4", starts, 4*i+1), string.unpack("i4", starts, 4*i+5)
+		local poly = pd.geometry.polygon.new(last - first)
+		for v = first, last - 1 do
+			local x, y = string.unpack("ff", xy, 8*v+1)
+			poly:setPointAt(v - first + 1, x, y)
+		end
+		poly:close()
+		gfx.fillPolygon(poly)
+	end
+	return true
+end
+
 function drawOrientedBox(p, q) -- for sdOrientedBox
+	if fillContour("sdOrientedBox", p, table.unpack(q)) then return end
 	local sx, sy, ex, ey, t = table.unpack(q)
 	local s = vec2(sx, sy)
 	local e = vec2(ex, ey)
@@ -91,8 +113,11 @@ function drawScreen(p,t) -- for sdScreen
 	gfx.fillRect(p.x-t[1]+t[3], p.y-t[2]+t[3], (t[1]-t[3])*2, (t[2]-t[3])*2)
 end
 
+local ngons = {[5] = "sdPentagon", [6] = "sdHexagon", [8] = "sdOctagon"} -- take the apothem
+
 function drawNGonByApothem(p, q)
 	local apothem, n = table.unpack(q)
+	if ngons[n] and fillContour(ngons[n], p, apothem) then return end
 	local poly = pd.geometry.polygon.new(n)
 	for i = 0, n-1 do
 		local x = p.x + apothem / math.cos(math.pi / n) * math.cos((2 * math.pi) / n * i + math.pi/2)
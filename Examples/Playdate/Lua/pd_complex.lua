@@ -21,42 +21,36 @@ pd.display.setRefreshRate(fps)
 
 local sw, sh = pd.display.getSize()
 
--- We'll build a sequence of quads along a bezier curve
-function drawQuad(p, q)
-	gfx.drawPolygon(q[1],q[2],q[3],q[4],q[5],q[6],q[7],q[8],q[1],q[2])
-end
-
+-- The track is one thick quadratic bezier curve: a single sdBezier call, with no seams where pieces meet
 function bezierPoint(t, P0, P1, P2)
 	return vec2((1 - t)^2 * P0.x + 2 * (1 - t) * t * P1.x + t^2 * P2.x,
 				(1 - t)^2 * P0.y + 2 * (1 - t) * t * P1.y + t^2 * P2.y)
 end
 
-function bezierTangent(t, P0, P1, P2)
-	return ((P1 - P0) * 2 * (1 - t) + (P2 - P1) * 2 * t):normalized()
-end
-
-function buildBezierQuads ()	
-	local P0, P1, P2 = vec2(20, 30), vec2(100, 200), vec2(200, 90)
-	local terrain = {}
-	local po = nil
-	for t = 0, 1, 0.05 do
+function drawBezier(p, q)
+	local P0, P1, P2 = vec2(q[1], q[2]), vec2(q[3], q[4]), vec2(q[5], q[6])
+	gfx.setLineWidth(q[7] * 2)
+	gfx.setLineCapStyle(gfx.kLineCapStyleRound)
+	local po = P0
+	for t = 0.05, 1.001, 0.05 do
 		local point = bezierPoint(t, P0, P1, P2)
-		local tangent = bezierTangent(t, P0, P1, P2)
-		local normal = vec2(-tangent.y, tangent.x):normalized()
-		local off = {point + normal * 10, point - normal * 10}
-		if po then
-			local bb = { 	math.min(po[1].x, po[2].x, off[2].x, off[1].x),
-							math.max(po[1].x, po[2].x, off[2].x, off[1].x),
-							math.min(po[1].y, po[2].y, off[2].y, off[1].y),
-							math.max(po[1].y, po[2].y, off[2].y, off[1].y)}
-			table.insert(terrain, {sdQuad, vec2(0,0), {po[1].x, po[1].y, po[2].x, po[2].y, off[2].x, off[2].y, off[1].x, off[1].y}, bb, drawQuad})
-		end
-		po = off 
+		gfx.drawLine(po.x + p.x, po.y + p.y, point.x + p.x, point.y + p.y)
+		po = point
 	end
-	return terrain
-end	
+	gfx.setLineWidth(1)
+end
+
+function buildBezierTrack()
+	local params = {20, 30, 100, 200, 200, 90, 10} -- start, control point, end, half width
+	-- the curve lies in the triangle of its control points
+	local bb = {	math.min(params[1], params[3], params[5]) - params[7],
+					math.max(params[1], params[3], params[5]) + params[7],
+					math.min(params[2], params[4], params[6]) - params[7],
+					math.max(params[2], params[4], params[6]) + params[7]}
+	return {{sdBezier, vec2(0,0), params, bb, drawBezier}}
+end
 
-local terrain = buildBezierQuads()
+local terrain = buildBezierTrack()
 
 -- draw the shapes
 local backgroundImage = gfx.image.new(sw,sh)
@@ -448,8 +448,9 @@ float sdArc(float px, float py, float scx, float scy, float ra, float rb) {
 // Ring (https://www.shadertoy.com/view/DsccDH)
 float sdRing(float px, float py, float nx, float ny, float r, float th) {
 	px = fabsf(px);
-	float rx = nx * px + ny * py;  
-	py = -ny * px + nx * py; 
+	// p = mat2(n.x, n.y, -n.y, n.x) * p; GLSL matrices are column-major
+	float rx = nx * px - ny * py;
+	py = ny * px + nx * py;
 	px = rx;
 	float l = sqrtf(px * px + py * py); 
 	float d1 = fabsf(l - r) - th * 0.5f;
@@ -494,7 +495,9 @@ float sdParabola(float px, float py, float k) {
 	float dx = px - x;
 	float dy = py - (k * x * x);
 	float d = sqrtf(dx * dx + dy * dy); 
-	return (px < x) ? -d : d;
+	// inside is on the concave side, above the curve for k > 0 and below it for k < 0; px < x misses
+	// the points on the axis, where x is 0
+	return ((py - k * px * px) * k > 0.0f) ? -d : d;
 }
 
 // Cross (https://www.shadertoy.com/view/XtGfzw)
@@ -728,3 +731,1838 @@ float sdPolygon(float px, float py, float vx[], float vy[], int n)
 	}
 	return s * sqrtf(d);
 }
+
+// A Newton step on dot(v(t), v'(t)) = 0, v(t) = d + (2qa + qb t) t the vector from p to the curve
+static inline float sdBezierNewton(float t, float dx, float dy, float qax, float qay, float qbx, float qby)
+{
+	float tx = qax+qbx*t;
+	float ty = qay+qby*t;
+	float vx = dx+(2.0f*qax+qbx*t)*t;
+	float vy = dy+(2.0f*qay+qby*t)*t;
+	float f = vx*tx+vy*ty;
+	float df = 2.0f*(tx*tx+ty*ty)+vx*qbx+vy*qby;
+	return df > 0.0f ? t-f/df : t;
+}
+
+// Quadratic Bezier (https://www.shadertoy.com/view/MlKcDD): the closest point is a root of a cubic in
+// t, solved in closed form. Returns the squared distance and writes the vector from p to the curve.
+static inline float sdBezierClosest(float px, float py, float ax, float ay, float bx, float by, float cx, float cy, float *vx, float *vy)
+{
+	float qax = bx-ax;
+	float qay = by-ay;
+	float qbx = ax-2.0f*bx+cx;
+	float qby = ay-2.0f*by+cy;
+	float dx = ax-px;
+	float dy = ay-py;
+	float bb = qbx*qbx+qby*qby;
+	if (bb <= 1e-8f*(qax*qax+qay*qay)) {
+		// straight with b halfway: the segment a..c
+		float ex = cx-ax;
+		float ey = cy-ay;
+		float l = ex*ex+ey*ey;
+		float h = l > 0.0f ? fmaxf(0.0f, fminf(1.0f, -(dx*ex+dy*ey)/l)) : 0.0f;
+		*vx = dx+ex*h;
+		*vy = dy+ey*h;
+		return *vx * *vx + *vy * *vy;
+	}
+	float kk = 1.0f/bb;
+	float kx = kk*(qax*qbx+qay*qby);
+	float ky = kk*(2.0f*(qax*qax+qay*qay)+dx*qbx+dy*qby)/3.0f;
+	float kz = kk*(dx*qax+dy*qay);
+	float p = ky-kx*kx;
+	float q = kx*(2.0f*kx*kx-3.0f*ky)+kz;
+	float h = q*q+4.0f*p*p*p;
+	float t0, t1;
+	if (h >= 0.0f) {
+		h = sqrtf(h);
+		// the sum of cube roots cancels near the curve: polish the root before clamping it
+		float t = cbrtf((h-q)*0.5f)+cbrtf((-h-q)*0.5f)-kx;
+		t = sdBezierNewton(t, dx, dy, qax, qay, qbx, qby);
+		t = sdBezierNewton(t, dx, dy, qax, qay, qbx, qby);
+		t0 = t1 = fmaxf(0.0f, fminf(1.0f, t));
+	} else {
+		// three real roots; the third cannot be the closest
+		float z = sqrtf(-p);
+		float v = acosf(fmaxf(-1.0f, fminf(1.0f, q/(p*z*2.0f))))/3.0f;
+		float m = cosf(v);
+		float n = sinf(v)*1.732050808f;
+		t0 = fmaxf(0.0f, fminf(1.0f, (m+m)*z-kx));
+		t1 = fmaxf(0.0f, fminf(1.0f, (-n-m)*z-kx));
+	}
+	float v0x = dx+(2.0f*qax+qbx*t0)*t0;
+	float v0y = dy+(2.0f*qay+qby*t0)*t0;
+	float v1x = dx+(2.0f*qax+qbx*t1)*t1;
+	float v1y = dy+(2.0f*qay+qby*t1)*t1;
+	float d0 = v0x*v0x+v0y*v0y;
+	float d1 = v1x*v1x+v1y*v1y;
+	*vx = d0 < d1 ? v0x : v1x;
+	*vy = d0 < d1 ? v0y : v1y;
+	return fminf(d0, d1);
+}
+
+// Thick quadratic Bezier from a through control point b to c, th either side of the curve
+float sdBezier(float px, float py, float ax, float ay, float bx, float by, float cx, float cy, float th)
+{
+	float vx, vy;
+	return sqrtf(sdBezierClosest(px, py, ax, ay, bx, by, cx, cy, &vx, &vy))-th;
+}
+
+// Gradients
+//
+// sdgXxx returns the same distance as sdXxx and writes its exact gradient to (*gx, *gy), following
+// iq's sdgBox/sdgCircle (https://iquilezles.org/articles/distgradfunctions2d/). For the Euclidean
+// SDFs the gradient is the unit vector from the closest surface point, computed in the folded frame
+// and unfolded through the same symmetries. Where the gradient is undefined (eg the centre of a
+// circle) it is (0, 0).
+
+static inline float sgnf(float v)
+{
+	return v < 0.0f ? -1.0f : 1.0f;
+}
+
+// d = s*|v|, gradient = s*v/|v|
+static inline float sdgLength(float vx, float vy, float s, float *gx, float *gy)
+{
+	float l = sqrtf(vx*vx+vy*vy);
+	float il = l > 0.0f ? s/l : 0.0f;
+	*gx = vx*il;
+	*gy = vy*il;
+	return s*l;
+}
+
+// Undo the reflection p -= 2*dot(p,k)*k (unit k) on a gradient
+static inline void sdgReflect(float kx, float ky, float *gx, float *gy)
+{
+	float d = 2.0f*(*gx*kx+*gy*ky);
+	*gx -= d*kx;
+	*gy -= d*ky;
+}
+
+// Box-like tail shared by several shapes: length(max(q,0)) + min(max(qx,qy),0)
+static inline float sdgBoxTail(float qx, float qy, float *gx, float *gy)
+{
+	float g = fmaxf(qx, qy);
+	if (g > 0.0f) {
+		float mx = fmaxf(qx, 0.0f);
+		float my = fmaxf(qy, 0.0f);
+		return sdgLength(mx, my, 1.0f, gx, gy);
+	}
+	*gx = (qx > qy) ? 1.0f : 0.0f;
+	*gy = (qx > qy) ? 0.0f : 1.0f;
+	return g;
+}
+
+float sdgCircle(float px, float py, float r, float *gx, float *gy)
+{
+	return sdgLength(px, py, 1.0f, gx, gy)-r;
+}
+
+float sdgSegment(float px, float py, float ax, float ay, float bx, float by, float *gx, float *gy)
+{
+	float pax = px-ax;
+	float pay = py-ay;
+	float bax = bx-ax;
+	float bay = by-ay;
+	float h = fmaxf(0.0f, fminf(1.0f, (pax*bax+pay*bay) / (bax*bax+bay*bay)));
+	return sdgLength(pax-bax*h, pay-bay*h, 1.0f, gx, gy);
+}
+
+float sdgSegmentLinf(float px, float py, float ax, float ay, float bx, float by, float *gx, float *gy)
+{
+	float pax = px-ax;
+	float pay = py-ay;
+	float bax = bx-ax;
+	float bay = by-ay;
+	float s = (bax*bay>0.0)?1.0f:-1.0f;
+	float den = bay+s*bax;
+	float m = (pay+s*pax) / den;
+	float h = fmaxf(0.0f, fminf(1.0f, m));
+	float rx = pax-h*bax;
+	float ry = pay-h*bay;
+	float qx = fabsf(rx);
+	float qy = fabsf(ry);
+	if (m > 0.0f && m < 1.0f) {
+		// the closest point moves with p, keeping |qx| == |qy|
+		*gx = sgnf(rx)*bay/den;
+		*gy = -sgnf(rx)*bax/den;
+	} else if (qx > qy) {
+		*gx = sgnf(rx);
+		*gy = 0.0f;
+	} else {
+		*gx = 0.0f;
+		*gy = sgnf(ry);
+	}
+	return fmaxf(qx,qy);
+}
+
+float sdgBox(float px, float py, float bx, float by, float *gx, float *gy)
+{
+	float d = sdgBoxTail(fabsf(px)-bx, fabsf(py)-by, gx, gy);
+	*gx *= sgnf(px);
+	*gy *= sgnf(py);
+	return d;
+}
+
+float sdgBoxLinf(float px, float py, float bx, float by, float *gx, float *gy)
+{
+	float qx = fabsf(px)-bx;
+	float qy = fabsf(py)-by;
+	*gx = (qx > qy) ? sgnf(px) : 0.0f;
+	*gy = (qx > qy) ? 0.0f : sgnf(py);
+	return fmaxf(qx,qy);
+}
+
+float sdgOrientedBox(float px, float py, float ax, float ay, float bx, float by, float th, float *gx, float *gy)
+{
+	float bmax = bx-ax;
+	float bmay = by-ay;
+	float l = sqrtf(bmax*bmax+bmay*bmay);
+	float dx = bmax/l;
+	float dy = bmay/l;
+	float cx = px-(ax+bx)*0.5f;
+	float cy = py-(ay+by)*0.5f;
+	float u = dx*cx+dy*cy;
+	float v = -dy*cx+dx*cy;
+	float lx, ly;
+	float d = sdgBoxTail(fabsf(u)-l*0.5f, fabsf(v)-th, &lx, &ly);
+	lx *= sgnf(u);
+	ly *= sgnf(v);
+	*gx = lx*dx-ly*dy;
+	*gy = lx*dy+ly*dx;
+	return d;
+}
+
+float sdgRoundedBox(float px, float py, float bx, float by, float rw, float rx, float ry, float rz, float *gx, float *gy)
+{
+	if (px <= 0) { rw=ry; rx=rz; }
+	if (py < 0) { rw=rx; }
+	float d = sdgBoxTail(fabsf(px)-bx+rw, fabsf(py)-by+rw, gx, gy);
+	*gx *= sgnf(px);
+	*gy *= sgnf(py);
+	return d-rw;
+}
+
+float sdgRoundSquare(float px, float py, float s, float r, float *gx, float *gy)
+{
+	float d = sdgBoxTail(fabsf(px)-s+r, fabsf(py)-s+r, gx, gy);
+	*gx *= sgnf(px);
+	*gy *= sgnf(py);
+	return d-r;
+}
+
+float sdgRhombus(float px, float py, float bx, float by, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float f1x = bx-px*2.0f;
+	float f1y = by-py*2.0f;
+	float f = (f1x*bx-f1y*by) / (bx*bx+by*by);
+	float h = fmaxf(-1.0f, fminf(f, 1.0f));
+	float dvx = px-((bx*0.5f)*(1.0f-h));
+	float dvy = py-((by*0.5f)*(1.0f+h));
+	float r = px*by+py*bx-bx*by;
+	float d = sdgLength(dvx, dvy, (float)((r>0)-(r<0)), gx, gy);
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgRhombusLinf(float px, float py, float w, float h, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	px -= w;
+	float f0 = (py-px)/(h+w);
+	float f = fmaxf(0.0f, fminf(f0, 1.0f));
+	float ax = px+f*w;
+	float ay = py-f*h;
+	float s = (h*px+w*py>0.0f)?1.0f:-1.0f;
+	if (f0 > 0.0f && f0 < 1.0f) {
+		// here |ax| == |ay| == |h*px+w*py|/(h+w)
+		*gx = h/(h+w);
+		*gy = w/(h+w);
+	} else if (fabsf(ax) > fabsf(ay)) {
+		*gx = s*sgnf(ax);
+		*gy = 0.0f;
+	} else {
+		*gx = 0.0f;
+		*gy = s*sgnf(ay);
+	}
+	*gx *= sx;
+	*gy *= sy;
+	return fmaxf(fabsf(ax),fabsf(ay))*s;
+}
+
+float sdgTrapezoid(float px, float py, float r1, float r2, float he, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float k2x = r2-r1;
+	float k2y = 2.0f*he;
+	float cax = px - fminf(px, (py < 0.0f) ? r1 : r2);
+	float cay = fabsf(py)-he;
+	float d = fmaxf(0.0f, fminf((k2x*(r2-px)+k2y*(he-py))/(k2x*k2x+k2y*k2y), 1.0f));
+	float cbx = px-r2+(k2x*d);
+	float cby = py-he+(k2y*d);
+	float s = (cbx < 0.0f && cay < 0.0f) ? -1.0f : 1.0f;
+	float dist;
+	if (cax*cax+cay*cay < cbx*cbx+cby*cby)
+		dist = sdgLength(cax, cay*sgnf(py), s, gx, gy);
+	else
+		dist = sdgLength(cbx, cby, s, gx, gy);
+	*gx *= sx;
+	return dist;
+}
+
+float sdgParallelogram(float px, float py, float wi, float he, float sk, float *gx, float *gy)
+{
+	float ex = sk, ey = he;
+	float f1 = 1.0f;
+	if (py < 0.0f) { px = -px; py = -py; f1 = -1.0f; }
+	float wx = px - ex;
+	float wy = py - ey;
+	wx -= fmaxf(-wi, fminf(wx, wi));
+	float dx = wx * wx + wy * wy;
+	float dy = -wy;
+	float s = px * ey - py * ex;
+	float f2 = 1.0f;
+	if (s < 0.0f) { px = -px; py = -py; f2 = -1.0f; }
+	float vx = px - wi;
+	float vy = py;
+	float dve = vx * ex + vy * ey;
+	float dee = ex * ex + ey * ey;
+	float c = fmaxf(-1.0f, fminf(dve / dee, 1.0f));
+	vx -= ex * c;
+	vy -= ey * c;
+	dy = fminf(dy, wi * he - fabsf(s));
+	float sg = (float)((-dy > 0) - (-dy < 0));
+	if (vx * vx + vy * vy < dx)
+		return sdgLength(vx * f1 * f2, vy * f1 * f2, sg, gx, gy);
+	return sdgLength(wx * f1, wy * f1, sg, gx, gy);
+}
+
+float sdgEquilateralTriangle(float px, float py, float r, float *gx, float *gy)
+{
+	float k = 1.73205f;
+	float sx = sgnf(px);
+	px = fabsf(px) - r;
+	py = py + r/k;
+	int reflected = (px+k*py) > 0.0f;
+	if (reflected) {
+		float ppx = (px - k * py) / 2.0f;
+		float ppy = (-k * px - py) / 2.0f;
+		px = ppx;
+		py = ppy;
+	}
+	px -= fmaxf(-2.0f*r, fminf(px, 0.0f));
+	float d = sdgLength(px, py, -(float)((py>0)-(py<0)), gx, gy);
+	if (reflected) {
+		float tx = (*gx - k * *gy) / 2.0f;
+		float ty = (-k * *gx - *gy) / 2.0f;
+		*gx = tx;
+		*gy = ty;
+	}
+	*gx *= sx;
+	return d;
+}
+
+float sdgTriangleIsosceles(float px, float py, float qx, float qy, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float m1 = fmaxf(0.0f, fminf((px*qx+py*qy)/(qx*qx+qy*qy), 1.0f));
+	float ax = px-qx*m1;
+	float ay = py-qy*m1;
+	float n = fmaxf(0.0f, fminf(px/qx, 1.0f));
+	float bx = px-qx*n;
+	float by = py-qy;
+	float s = fmaxf(((qy>0)-(qy<0)) * (px*qy-py*qx), ((qy>0)-(qy<0))*(py-qy));
+	float sg = (float)((s>0)-(s<0));
+	float d = (ax*ax+ay*ay < bx*bx+by*by) ? sdgLength(ax, ay, sg, gx, gy) : sdgLength(bx, by, sg, gx, gy);
+	*gx *= sx;
+	return d;
+}
+
+float sdgTriangle(float px, float py, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float *gx, float *gy)
+{
+	float ex[3] = { p1x-p0x, p2x-p1x, p0x-p2x };
+	float ey[3] = { p1y-p0y, p2y-p1y, p0y-p2y };
+	float vx[3] = { px-p0x, px-p1x, px-p2x };
+	float vy[3] = { py-p0y, py-p1y, py-p2y };
+	float s = ex[0]*ey[2]-ey[0]*ex[2];
+	s = (float)((s>0)-(s<0));
+	float bx = 0.0f, by = 0.0f;
+	float dx = 1e30f, dy = 1e30f;
+	for (int i = 0; i < 3; i++) {
+		float m = fmaxf(0.0f, fminf((vx[i]*ex[i]+vy[i]*ey[i]) / (ex[i]*ex[i]+ey[i]*ey[i]), 1.0f));
+		float qx = vx[i]-ex[i]*m;
+		float qy = vy[i]-ey[i]*m;
+		float dq = qx*qx+qy*qy;
+		if (dq < dx) { dx = dq; bx = qx; by = qy; }
+		dy = fminf(dy, s*(vx[i]*ey[i]-vy[i]*ex[i]));
+	}
+	return sdgLength(bx, by, -(float)((dy>0)-(dy<0)), gx, gy);
+}
+
+float sdgQuad(float px, float py, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float p3x, float p3y, float *gx, float *gy)
+{
+	float ex[4] = { p1x-p0x, p2x-p1x, p3x-p2x, p0x-p3x };
+	float ey[4] = { p1y-p0y, p2y-p1y, p3y-p2y, p0y-p3y };
+	float vx[4] = { px-p0x, px-p1x, px-p2x, px-p3x };
+	float vy[4] = { py-p0y, py-p1y, py-p2y, py-p3y };
+	float bx = 0.0f, by = 0.0f;
+	float dx = 1e30f, dy = 1e30f;
+	for (int i = 0; i < 4; i++) {
+		float m = fmaxf(0.0f, fminf((vx[i]*ex[i]+vy[i]*ey[i]) / (ex[i]*ex[i]+ey[i]*ey[i]), 1.0f));
+		float qx = vx[i]-ex[i]*m;
+		float qy = vy[i]-ey[i]*m;
+		float dq = qx*qx+qy*qy;
+		if (dq < dx) { dx = dq; bx = qx; by = qy; }
+		dy = fminf(dy, vx[i]*ey[i]-vy[i]*ex[i]);
+	}
+	return sdgLength(bx, by, -(float)((dy>0)-(dy<0)), gx, gy);
+}
+
+float sdgUnevenCapsule(float px, float py, float r1, float r2, float h, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float b = (r1 - r2) / h;
+	float a = sqrtf(1.0f - b * b);
+	float k = (-b * px) + (a * py);
+	float d;
+	if (k < 0.0f) {
+		d = sdgLength(px, py, 1.0f, gx, gy) - r1;
+	} else if (k > a * h) {
+		d = sdgLength(px, py - h, 1.0f, gx, gy) - r2;
+	} else {
+		*gx = a;
+		*gy = b;
+		d = (a * px) + (b * py) - r1;
+	}
+	*gx *= sx;
+	return d;
+}
+
+float sdgEgg(float px, float py, float ra, float rb, float *gx, float *gy)
+{
+	const float k = 1.73205f;
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float r = ra - rb;
+	float d;
+	if (py < 0.0f)
+		d = sdgLength(px, py, 1.0f, gx, gy) - r - rb;
+	else if (k * (px + r) < py)
+		d = sdgLength(px, py - k * r, 1.0f, gx, gy) - rb;
+	else
+		d = sdgLength(px + r, py, 1.0f, gx, gy) - 2.0f * r - rb;
+	*gx *= sx;
+	return d;
+}
+
+float sdgPie(float px, float py, float cx, float cy, float r, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float l = sqrtf(px*px + py*py) - r;
+	float dpc = px*cx + py*cy;
+	float cd = fmaxf(0.0f, fminf(dpc, r));
+	float mx = px - cx*cd;
+	float my = py - cy*cd;
+	float m = sqrtf(mx*mx + my*my);
+	float s = (cy * px - cx * py > 0.0f) ? 1.0f : -1.0f;
+	float d;
+	if (l > m * s) {
+		d = sdgLength(px, py, 1.0f, gx, gy) - r;
+	} else {
+		d = sdgLength(mx, my, s, gx, gy);
+		if (dpc > 0.0f && dpc < r) {
+			// c is only unit length to float precision: project out the component along c
+			float gc = *gx*cx + *gy*cy;
+			*gx -= gc*cx;
+			*gy -= gc*cy;
+		}
+	}
+	*gx *= sx;
+	return d;
+}
+
+float sdgCutDisk(float px, float py, float r, float h, float *gx, float *gy)
+{
+	float w = sqrtf(r*r - h*h);
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float s = fmaxf((h - r) * px * px + w * w * (h + r - 2.0f * py), h * px - w * py);
+	float d;
+	if (s < 0.0f) {
+		d = sdgLength(px, py, 1.0f, gx, gy) - r;
+	} else if (px < w) {
+		*gx = 0.0f;
+		*gy = -1.0f;
+		d = h - py;
+	} else {
+		d = sdgLength(px - w, py - h, 1.0f, gx, gy);
+	}
+	*gx *= sx;
+	return d;
+}
+
+float sdgMoon(float px, float py, float d, float ra, float rb, float *gx, float *gy)
+{
+	float sy = sgnf(py);
+	py = fabsf(py);
+	float a = (ra * ra - rb * rb + d * d) / (2.0f * d);
+	float b = sqrtf(fmaxf(ra * ra - a * a, 0.0f));
+	float dist;
+	if (d * (px * b - py * a) > d * d * fmaxf(b - py, 0.0f)) {
+		dist = sdgLength(px - a, py - b, 1.0f, gx, gy);
+	} else {
+		float l1 = sqrtf(px * px + py * py);
+		float pdx = px - d;
+		float l2 = sqrtf(pdx * pdx + py * py);
+		if (l1 - ra > -(l2 - rb))
+			dist = sdgLength(px, py, 1.0f, gx, gy) - ra;
+		else
+			dist = sdgLength(pdx, py, -1.0f, gx, gy) + rb;
+	}
+	*gy *= sy;
+	return dist;
+}
+
+float sdgVesica(float px, float py, float r, float d, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float b = sqrtf(r*r-d*d);
+	float dist;
+	if ((py - b) * d > px * b)
+		dist = sdgLength(px, py - b, (float)((d > 0) - (d < 0)), gx, gy);
+	else
+		dist = sdgLength(px + d, py, 1.0f, gx, gy) - r;
+	*gx *= sx;
+	*gy *= sy;
+	return dist;
+}
+
+float sdgOrientedVesica(float px, float py, float ax, float ay, float bx, float by, float w, float *gx, float *gy)
+{
+	float dx = bx - ax;
+	float dy = by - ay;
+	float r = 0.5f * sqrtf(dx * dx + dy * dy);
+	float d = 0.5f * (r * r - w * w) / w;
+	float vx = dx / r;
+	float vy = dy / r;
+	float qx = px - 0.5f * (bx + ax);
+	float qy = py - 0.5f * (by + ay);
+	// (u1, u2) is an orthonormal frame: |(vx, vy)| == 2
+	float u = 0.5f * (vy * qx + vx * qy);
+	float v = 0.5f * (-vx * qx + vy * qy);
+	float mqx = fabsf(u);
+	float mqy = fabsf(v);
+	float dist, lx, ly;
+	if (r * mqx < d * (mqy - r))
+		dist = sdgLength(mqx, mqy - r, 1.0f, &lx, &ly);
+	else
+		dist = sdgLength(mqx + d, mqy, 1.0f, &lx, &ly) - (d + w);
+	lx *= sgnf(u);
+	ly *= sgnf(v);
+	*gx = 0.5f * (lx * vy - ly * vx);
+	*gy = 0.5f * (lx * vx + ly * vy);
+	return dist;
+}
+
+float sdgTunnel(float px, float py, float whx, float why, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	py = -py;
+	float qx = px - whx;
+	float qy = py - why;
+	float m0 = fmaxf(qx, 0.0f);
+	float d1 = m0 * m0 + qy * qy;
+	float l = sqrtf(px * px + py * py);
+	float jx = 1.0f, jy = 0.0f; // d(qx)/dp after the select below
+	if (py <= 0.0f) {
+		qx = l - whx;
+		jx = l > 0.0f ? px / l : 0.0f;
+		jy = l > 0.0f ? py / l : 0.0f;
+	}
+	float m1 = fmaxf(qy, 0.0f);
+	float d2 = qx * qx + m1 * m1;
+	float s = (fmaxf(qx, qy) < 0.0f) ? -1.0f : 1.0f;
+	float d = sqrtf(fminf(d1, d2));
+	float il = d > 0.0f ? s / d : 0.0f;
+	if (d1 < d2) {
+		*gx = m0 * il;
+		*gy = qy * il;
+	} else {
+		*gx = qx * jx * il;
+		*gy = (qx * jy + m1) * il;
+	}
+	*gx *= sx;
+	*gy = -*gy;
+	return s * d;
+}
+
+float sdgArc(float px, float py, float scx, float scy, float ra, float rb, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float d;
+	px = fabsf(px);
+	if (scy * px > scx * py) {
+		d = sdgLength(px - scx * ra, py - scy * ra, 1.0f, gx, gy) - rb;
+	} else {
+		float l = sdgLength(px, py, 1.0f, gx, gy);
+		if (l < ra) { *gx = -*gx; *gy = -*gy; }
+		d = fabsf(l - ra) - rb;
+	}
+	*gx *= sx;
+	return d;
+}
+
+float sdgRing(float px, float py, float nx, float ny, float r, float th, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float rx = nx * px - ny * py;
+	float ry = ny * px + nx * py;
+	float l = sqrtf(rx * rx + ry * ry);
+	float d1 = fabsf(l - r) - th * 0.5f;
+	float ey = fabsf(r - ry) - th * 0.5f;
+	float my = fmaxf(0.0f, ey);
+	float l2 = sqrtf(rx * rx + my * my);
+	float s2 = (float)((rx > 0) - (rx < 0));
+	float d2 = l2 * s2;
+	float lx, ly;
+	if (d1 > d2) {
+		sdgLength(rx, ry, sgnf(l - r), &lx, &ly);
+	} else {
+		float il = l2 > 0.0f ? s2 / l2 : 0.0f;
+		lx = rx * il;
+		ly = (ey > 0.0f) ? -sgnf(r - ry) * my * il : 0.0f;
+	}
+	*gx = (nx * lx + ny * ly) * sx;
+	*gy = -ny * lx + nx * ly;
+	return fmaxf(d1, d2);
+}
+
+float sdgHorseshoe(float px, float py, float cx, float cy, float r, float le, float th, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	py = -py;
+	float l = sqrtf(px * px + py * py);
+	float lx = l > 0.0f ? px / l : 0.0f;
+	float ly = l > 0.0f ? py / l : 0.0f;
+	float tx = -cx * px + cy * py;
+	float ty = cy * px + cx * py;
+	// rows of d(tx, ty)/d(px, py)
+	float jxx = -cx, jxy = cy;
+	float jyx = cy, jyy = cx;
+	if (!(ty > 0.0f || tx > 0.0f)) {
+		float s = (-cx > 0.0f) ? 1.0f : -1.0f;
+		tx = l * s;
+		jxx = lx * s;
+		jxy = ly * s;
+	}
+	if (!(tx > 0.0f)) {
+		ty = l;
+		jyx = lx;
+		jyy = ly;
+	}
+	tx = tx - le;
+	float sy = sgnf(ty - r);
+	ty = fabsf(ty - r) - th;
+	float bx, by;
+	float d = sdgBoxTail(tx, ty, &bx, &by);
+	by *= sy;
+	*gx = (bx * jxx + by * jyx) * sx;
+	*gy = -(bx * jxy + by * jyy);
+	return d;
+}
+
+float sdgParabola(float px, float py, float k, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float ik = 1.0f / k;
+	float p = ik * (py - 0.5f * ik) / 3.0f;
+	float q = 0.25f * ik * ik * px;
+	float h = q * q - p * p * p;
+	float r = sqrtf(fabsf(h));
+	float x;
+	if (h > 0.0f) {
+		x = cbrtf(q + r) + cbrtf(fabsf(q - r)) * ((p > 0) - (p < 0));
+	} else {
+		x = 2.0f * cosf(atan2f(r, q) / 3.0f) * sqrtf(p);
+	}
+	float d = sdgLength(px - x, py - (k * x * x), ((py - k * px * px) * k > 0.0f) ? -1.0f : 1.0f, gx, gy);
+	*gx *= sx;
+	return d;
+}
+
+float sdgCross(float px, float py, float bx, float by, float r, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	int swap = py > px;
+	if (swap) {
+		float temp = px;
+		px = py;
+		py = temp;
+	}
+	float qx = px - bx;
+	float qy = py - by;
+	float k = fmaxf(qx, qy);
+	float ax, ay;
+	float d;
+	if (k > 0.0f) {
+		d = sdgLength(fmaxf(qx, 0.0f), fmaxf(qy, 0.0f), 1.0f, &ax, &ay);
+	} else {
+		// w = (by - px, -k)
+		float m1 = fmaxf(by - px, 0.0f);
+		float m2 = fmaxf(-k, 0.0f);
+		float l = sqrtf(m1 * m1 + m2 * m2);
+		float il = l > 0.0f ? 1.0f / l : 0.0f;
+		ax = m1 * il;
+		ay = 0.0f;
+		if (qx > qy) ax += m2 * il;
+		else ay = m2 * il;
+		// on the outline of the unrounded cross, k = 0: the normal of the face, as on either side
+		if (l == 0.0f) {
+			ax = (qx > qy) ? 1.0f : 0.0f;
+			ay = 1.0f - ax;
+		}
+		d = -l;
+	}
+	if (swap) {
+		float temp = ax;
+		ax = ay;
+		ay = temp;
+	}
+	*gx = ax * sx;
+	*gy = ay * sy;
+	return d + r;
+}
+
+float sdgRoundedX(float px, float py, float w, float r, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float m = fminf(px + py, w) * 0.5f;
+	float d = sdgLength(px - m, py - m, 1.0f, gx, gy) - r;
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgEllipse(float px, float py, float ex, float ey, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float eiX = 1.0f / ex;
+	float eiY = 1.0f / ey;
+	float e2X = ex * ex;
+	float e2Y = ey * ey;
+	float veX = eiX * (e2X - e2Y);
+	float veY = eiY * (e2Y - e2X);
+	float tX = 0.70710678118654752f;
+	float tY = 0.70710678118654752f;
+	for (int i = 0; i < 3; i++) {
+		float vX = veX * tX * tX * tX;
+		float vY = veY * tY * tY * tY;
+		float tmx = px - vX;
+		float tmy = py - vY;
+		float n = sqrtf(tmx * tmx + tmy * tmy);
+		float uX = (tmx / n) * sqrtf((tX * ex - vX) * (tX * ex - vX) + (tY * ey - vY) * (tY * ey - vY));
+		float uY = (tmy / n) * sqrtf((tX * ex - vX) * (tX * ex - vX) + (tY * ey - vY) * (tY * ey - vY));
+		float wX = eiX * (vX + uX);
+		float wY = eiY * (vY + uY);
+		float cx = fmaxf(0.0f, fminf(wX, 1.0f));
+		float cy = fmaxf(0.0f, fminf(wY, 1.0f));
+		n = sqrtf(cx * cx + cy * cy);
+		tX = cx / n;
+		tY = cy / n;
+	}
+	float nx = tX * ex;
+	float ny = tY * ey;
+	float dp = px * px + py * py;
+	float dn = nx * nx + ny * ny;
+	float d = sdgLength(px - nx, py - ny, dp < dn ? -1.0f : 1.0f, gx, gy);
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgEllipseLinf(float px, float py, float ex, float ey, float *gx, float *gy)
+{
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float ay = px-ex;
+	float ax = py-ey;
+	int ux = ax > px;  // u = max(px, py-ey) takes py
+	int vy = ay > py;  // v = max(py, px-ex) takes px
+	float u = fmaxf(px,ax);
+	float v = fmaxf(py,ay);
+	float m = ex*ex+ey*ey;
+	float d = v-u;
+	float sq = sqrtf(m-d*d);
+	float k = ex/m*(-ey*d/sq-ex);  // -d(dist)/d(d)
+	float du = 1.0f+k;
+	float dv = -k;
+	float g1 = (ux ? 0.0f : du) + (vy ? dv : 0.0f);
+	float g2 = (ux ? du : 0.0f) + (vy ? 0.0f : dv);
+	*gx = g1*sx;
+	*gy = g2*sy;
+	return u - (ey*sq-ex*d) * ex/m;
+}
+
+float sdgStar5(float px, float py, float r, float rf, float *gx, float *gy)
+{
+	float kx = 0.809016994375f;
+	float ky = -0.587785252292f;
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float f1 = fmaxf((kx*px+ky*py),0.0f)*2.0f;
+	px = px-kx*f1;
+	py = py-ky*f1;
+	float f2 = fmaxf((-kx*px+ky*py),0.0f)*2.0f;
+	px = px-(-kx*f2);
+	float sx3 = sgnf(px);
+	px = fabsf(px);
+	py = py-(ky*f2)-r;
+	float bax = -ky*rf;
+	float bay = kx*rf-1.0f;
+	float h = fmaxf(0.0f, fminf(((px*bax+py*bay)/(bax*bax+bay*bay)), r));
+	float s = py*bax-px*bay;
+	float d = sdgLength(px-bax*h, py-bay*h, (float)((s>0)-(s<0)), gx, gy);
+	*gx *= sx3;
+	if (f2 > 0.0f) sdgReflect(-kx, ky, gx, gy);
+	if (f1 > 0.0f) sdgReflect(kx, ky, gx, gy);
+	*gx *= sx;
+	return d;
+}
+
+float sdgHexagram(float px, float py, float r, float *gx, float *gy)
+{
+	float kx = -0.5f;
+	float ky = 0.8660254038f;
+	float kz = 0.5773502692f;
+	float kw = 1.7320508076f;
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float d1 = kx * px + ky * py;
+	px -= 2.0f * fminf(d1, 0.0f) * kx;
+	py -= 2.0f * fminf(d1, 0.0f) * ky;
+	float d2 = ky * px + kx * py;
+	px -= 2.0f * fminf(d2, 0.0f) * ky;
+	py -= 2.0f * fminf(d2, 0.0f) * kx;
+	px -= fmaxf(r * kz, fminf(px, r * kw));
+	py -= r;
+	float d = sdgLength(px, py, (float)((py > 0) - (py < 0)), gx, gy);
+	if (d2 < 0.0f) sdgReflect(ky, kx, gx, gy);
+	if (d1 < 0.0f) sdgReflect(kx, ky, gx, gy);
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgPentagon(float px, float py, float r, float *gx, float *gy)
+{
+	float kx = 0.809016994f;
+	float ky = 0.587785252f;
+	float kz = 0.726542528f;
+	float sx = sgnf(px);
+	px = fabsf(px);
+	float d1 = -kx * px + ky * py;
+	px -= 2.0f * fminf(d1, 0.0f) * -kx;
+	py -= 2.0f * fminf(d1, 0.0f) * ky;
+	float d2 = kx * px + ky * py;
+	px -= 2.0f * fminf(d2, 0.0f) * kx;
+	py -= 2.0f * fminf(d2, 0.0f) * ky;
+	px -= fmaxf(-r * kz, fminf(px, r * kz));
+	py -= r;
+	float d = sdgLength(px, py, (float)((py > 0) - (py < 0)), gx, gy);
+	if (d2 < 0.0f) sdgReflect(kx, ky, gx, gy);
+	if (d1 < 0.0f) sdgReflect(-kx, ky, gx, gy);
+	*gx *= sx;
+	return d;
+}
+
+float sdgHexagon(float px, float py, float s, float *gx, float *gy)
+{
+	float kx = -0.866025404f;
+	float ky = 0.5f;
+	float kz = 0.577350269f;
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float kxyp = (kx*px+ky*py);
+	px -= kx * fminf(kxyp,0.0f) * 2.0f;
+	py -= ky * fminf(kxyp,0.0f) * 2.0f;
+	px -= fmaxf(-kz*s, fminf(px, kz*s));
+	py -= s;
+	float d = sdgLength(px, py, (float)((py>0)-(py<0)), gx, gy);
+	if (kxyp < 0.0f) sdgReflect(kx, ky, gx, gy);
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgOctagon(float px, float py, float r, float *gx, float *gy)
+{
+	float kx = -0.9238795325f;
+	float ky = 0.3826834323f;
+	float kz = 0.4142135623f;
+	float sx = sgnf(px);
+	float sy = sgnf(py);
+	px = fabsf(px);
+	py = fabsf(py);
+	float d1 = kx * px + ky * py;
+	px -= 2.0f * fminf(d1, 0.0f) * kx;
+	py -= 2.0f * fminf(d1, 0.0f) * ky;
+	float d2 = -kx * px + ky * py;
+	px -= 2.0f * fminf(d2, 0.0f) * (-kx);
+	py -= 2.0f * fminf(d2, 0.0f) * ky;
+	px -= fmaxf(-kz*r, fminf(px, kz*r));
+	py -= r;
+	float d = sdgLength(px, py, (float)((py > 0) - (py < 0)), gx, gy);
+	if (d2 < 0.0f) sdgReflect(-kx, ky, gx, gy);
+	if (d1 < 0.0f) sdgReflect(kx, ky, gx, gy);
+	*gx *= sx;
+	*gy *= sy;
+	return d;
+}
+
+float sdgRegularPolygon(float px, float py, float r, int n, float *gx, float *gy)
+{
+	float an = 3.141593f / n;
+	float acs_x = cosf(an);
+	float acs_y = sinf(an);
+	float fm = fmodf(atan2f(py, px), (2.0f * an));
+	if (fm < 0) { fm += 2.0f * an; }
+	float bn = fm - an;
+	float cb = cosf(bn);
+	float sb = sinf(bn);
+	float p_mag = sqrtf(px * px + py * py);
+	// rotation taking the sector frame back to p: cos/sin of (angle(p) - bn)
+	float ip = p_mag > 0.0f ? 1.0f / p_mag : 0.0f;
+	float rc = (px * cb + py * sb) * ip;
+	float rs = (py * cb - px * sb) * ip;
+	float qx = cb * p_mag - acs_x*r;
+	float qy = fabsf(sb) * p_mag - acs_y*r;
+	qy += fmaxf(0.0f, fminf(-qy, acs_y * r));
+	float lx, ly;
+	float d = sdgLength(qx, qy, (float)((qx>0.0f)-(qx<0.0f)), &lx, &ly);
+	ly *= sgnf(sb);
+	*gx = rc * lx - rs * ly;
+	*gy = rs * lx + rc * ly;
+	return d;
+}
+
+float sdgPolygon(float px, float py, float vx[], float vy[], int n, float *gx, float *gy)
+{
+	float bx = px - vx[0];
+	float by = py - vy[0];
+	float d = bx * bx + by * by;
+	float s = 1.0f;
+	int j = n - 1;
+	for (int i = 0; i < n; j = i++)
+	{
+		float ex = vx[j] - vx[i];
+		float ey = vy[j] - vy[i];
+		float wx = px - vx[i];
+		float wy = py - vy[i];
+		float pr = (wx * ex + wy * ey) / (ex * ex + ey * ey);
+		pr = fmaxf(0.0f, fminf(pr, 1.0f));
+		float cx = wx - ex * pr;
+		float cy = wy - ey * pr;
+		float dc = cx * cx + cy * cy;
+		if (dc < d) { d = dc; bx = cx; by = cy; }
+		int c1 = (py >= vy[i]);
+		int c2 = (py < vy[j]);
+		int c3 = (ex * wy > ey * wx);
+		if ((c1 && c2 && c3) || (!c1 && !c2 && !c3))
+			s = -s;
+	}
+	return sdgLength(bx, by, s, gx, gy);
+}
+
+float sdgBezier(float px, float py, float ax, float ay, float bx, float by, float cx, float cy, float th, float *gx, float *gy)
+{
+	float vx, vy;
+	sdBezierClosest(px, py, ax, ay, bx, by, cx, cy, &vx, &vy);
+	return sdgLength(-vx, -vy, 1.0f, gx, gy)-th;
+}
+
+// Batched entry points (SoA)
+//
+// Each loop evaluates one shape with fixed parameters over n points. The bodies repeat the scalar
+// functions above with the branches turned into selects and fminf/fmaxf into bminf/bmaxf, so that
+// gcc and clang auto-vectorise them at -O3 once sdf2d.c is compiled with -fno-math-errno
+// -fno-trapping-math, as the host builds do: without them sqrtf keeps a call for errno and gcc keeps
+// the selects as branches. The operations are the same and in the same order, so every batch gives
+// the scalar result exactly. sdParabola, sdRegularPolygon and
+// sdBezier need cbrtf, atan2f or cosf per point and stay scalar loops. The shapes most used in grid
+// scans and particle queries also have explicit SIMD kernels, enabled by compiling with SDF2D_SIMD
+// defined: AVX on x86 when __AVX__ is set, else SSE2, and NEON on AArch64.
+
+// a < b ? a : b is what minps and maxps compute, so unlike fminf/fmaxf, which must skip a NaN
+// operand, these vectorise without -ffinite-math-only. They agree with fminf/fmaxf on numbers.
+static inline float bminf(float a, float b)
+{
+	return a < b ? a : b;
+}
+
+static inline float bmaxf(float a, float b)
+{
+	return a > b ? a : b;
+}
+
+// (v > 0) - (v < 0) as a float select
+static inline float bsgnf(float v)
+{
+	return v > 0.0f ? 1.0f : (v < 0.0f ? -1.0f : 0.0f);
+}
+
+#if defined(SDF2D_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define SDV_WIDTH 8
+typedef __m256 sdv;
+#define sdvLoad(p) _mm256_loadu_ps(p)
+#define sdvStore(p, v) _mm256_storeu_ps(p, v)
+#define sdvSet(x) _mm256_set1_ps(x)
+#define sdvAdd(a, b) _mm256_add_ps(a, b)
+#define sdvSub(a, b) _mm256_sub_ps(a, b)
+#define sdvMul(a, b) _mm256_mul_ps(a, b)
+#define sdvDiv(a, b) _mm256_div_ps(a, b)
+#define sdvMin(a, b) _mm256_min_ps(a, b)
+#define sdvMax(a, b) _mm256_max_ps(a, b)
+#define sdvSqrt(a) _mm256_sqrt_ps(a)
+#define sdvAbs(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a)
+#elif defined(SDF2D_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define SDV_WIDTH 4
+typedef __m128 sdv;
+#define sdvLoad(p) _mm_loadu_ps(p)
+#define sdvStore(p, v) _mm_storeu_ps(p, v)
+#define sdvSet(x) _mm_set1_ps(x)
+#define sdvAdd(a, b) _mm_add_ps(a, b)
+#define sdvSub(a, b) _mm_sub_ps(a, b)
+#define sdvMul(a, b) _mm_mul_ps(a, b)
+#define sdvDiv(a, b) _mm_div_ps(a, b)
+#define sdvMin(a, b) _mm_min_ps(a, b)
+#define sdvMax(a, b) _mm_max_ps(a, b)
+#define sdvSqrt(a) _mm_sqrt_ps(a)
+#define sdvAbs(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+#elif defined(SDF2D_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SDV_WIDTH 4
+typedef float32x4_t sdv;
+#define sdvLoad(p) vld1q_f32(p)
+#define sdvStore(p, v) vst1q_f32(p, v)
+#define sdvSet(x) vdupq_n_f32(x)
+#define sdvAdd(a, b) vaddq_f32(a, b)
+#define sdvSub(a, b) vsubq_f32(a, b)
+#define sdvMul(a, b) vmulq_f32(a, b)
+#define sdvDiv(a, b) vdivq_f32(a, b)
+#define sdvMin(a, b) vminq_f32(a, b)
+#define sdvMax(a, b) vmaxq_f32(a, b)
+#define sdvSqrt(a) vsqrtq_f32(a)
+#define sdvAbs(a) vabsq_f32(a)
+#endif
+
+void sdCircleBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r)
+{
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vr = sdvSet(r);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv x = sdvLoad(px + i);
+		sdv y = sdvLoad(py + i);
+		sdvStore(out + i, sdvSub(sdvSqrt(sdvAdd(sdvMul(x, x), sdvMul(y, y))), vr));
+	}
+#endif
+	for (; i < n; i++) out[i] = sdCircle(px[i], py[i], r);
+}
+
+void sdBoxBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by)
+{
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vbx = sdvSet(bx), vby = sdvSet(by), zero = sdvSet(0.0f);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv x = sdvSub(sdvAbs(sdvLoad(px + i)), vbx);
+		sdv y = sdvSub(sdvAbs(sdvLoad(py + i)), vby);
+		sdv dx = sdvMax(x, zero);
+		sdv dy = sdvMax(y, zero);
+		sdv od = sdvSqrt(sdvAdd(sdvMul(dx, dx), sdvMul(dy, dy)));
+		sdvStore(out + i, sdvAdd(od, sdvMin(sdvMax(x, y), zero)));
+	}
+#endif
+	for (; i < n; i++) {
+		float x = fabsf(px[i]) - bx;
+		float y = fabsf(py[i]) - by;
+		float dx = bmaxf(x, 0.0f);
+		float dy = bmaxf(y, 0.0f);
+		out[i] = sqrtf(dx*dx + dy*dy) + bminf(bmaxf(x, y), 0.0f);
+	}
+}
+
+void sdBoxLinfBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by)
+{
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vbx = sdvSet(bx), vby = sdvSet(by);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv x = sdvSub(sdvAbs(sdvLoad(px + i)), vbx);
+		sdv y = sdvSub(sdvAbs(sdvLoad(py + i)), vby);
+		sdvStore(out + i, sdvMax(x, y));
+	}
+#endif
+	for (; i < n; i++) out[i] = bmaxf(fabsf(px[i])-bx, fabsf(py[i])-by);
+}
+
+void sdRoundedBoxBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by, float rw, float rx, float ry, float rz)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x = px[i];
+		float y = py[i];
+		float rt = (x <= 0) ? ry : rw;
+		float rb = (x <= 0) ? rz : rx;
+		float rr = (y < 0) ? rb : rt;
+		float qx = fabsf(x)-bx+rr;
+		float qy = fabsf(y)-by+rr;
+		float c = sqrtf(bmaxf(qx,0.0f)*bmaxf(qx,0.0f)+bmaxf(qy,0.0f)*bmaxf(qy,0.0f));
+		out[i] = c + bminf(bmaxf(qx, qy), 0.0f) - rr;
+	}
+}
+
+void sdOrientedBoxBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ax, float ay, float bx, float by, float th)
+{
+	float bmax = bx-ax;
+	float bmay = by-ay;
+	float l = sqrtf(bmax*bmax+bmay*bmay);
+	float dx = bmax/l;
+	float dy = bmay/l;
+	float mx = (ax+bx)*0.5f;
+	float my = (ay+by)*0.5f;
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vdx = sdvSet(dx), vdy = sdvSet(dy);
+	sdv vmx = sdvSet(mx), vmy = sdvSet(my);
+	sdv vhl = sdvSet(l*0.5f), vth = sdvSet(th), zero = sdvSet(0.0f);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv cx = sdvSub(sdvLoad(px + i), vmx);
+		sdv cy = sdvSub(sdvLoad(py + i), vmy);
+		sdv qx = sdvSub(sdvAbs(sdvAdd(sdvMul(vdx, cx), sdvMul(vdy, cy))), vhl);
+		sdv qy = sdvSub(sdvAbs(sdvSub(sdvMul(vdx, cy), sdvMul(vdy, cx))), vth);
+		sdv mqx = sdvMax(qx, zero);
+		sdv mqy = sdvMax(qy, zero);
+		sdv od = sdvSqrt(sdvAdd(sdvMul(mqx, mqx), sdvMul(mqy, mqy)));
+		sdvStore(out + i, sdvAdd(od, sdvMin(sdvMax(qx, qy), zero)));
+	}
+#endif
+	for (; i < n; i++) {
+		float cx = px[i]-mx;
+		float cy = py[i]-my;
+		float qx = fabsf(dx*cx+dy*cy)-l*0.5f;
+		float qy = fabsf(-dy*cx+dx*cy)-th;
+		out[i] = sqrtf(bmaxf(qx,0.0f)*bmaxf(qx,0.0f)+bmaxf(qy,0.0f)*bmaxf(qy,0.0f)) + bminf(bmaxf(qx, qy), 0.0f);
+	}
+}
+
+void sdSegmentBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ax, float ay, float bx, float by)
+{
+	float bax = bx-ax;
+	float bay = by-ay;
+	float bb = bax*bax+bay*bay;
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vax = sdvSet(ax), vay = sdvSet(ay);
+	sdv vbax = sdvSet(bax), vbay = sdvSet(bay);
+	sdv vbb = sdvSet(bb);
+	sdv zero = sdvSet(0.0f), one = sdvSet(1.0f);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv pax = sdvSub(sdvLoad(px + i), vax);
+		sdv pay = sdvSub(sdvLoad(py + i), vay);
+		sdv h = sdvDiv(sdvAdd(sdvMul(pax, vbax), sdvMul(pay, vbay)), vbb);
+		h = sdvMax(zero, sdvMin(one, h));
+		sdv gx = sdvSub(pax, sdvMul(vbax, h));
+		sdv gy = sdvSub(pay, sdvMul(vbay, h));
+		sdvStore(out + i, sdvSqrt(sdvAdd(sdvMul(gx, gx), sdvMul(gy, gy))));
+	}
+#endif
+	for (; i < n; i++) {
+		float pax = px[i]-ax;
+		float pay = py[i]-ay;
+		float h = bmaxf(0.0f, bminf(1.0f, (pax*bax+pay*bay) / bb));
+		float gx = pax-(bax*h);
+		float gy = pay-(bay*h);
+		out[i] = sqrtf(gx*gx+gy*gy);
+	}
+}
+
+void sdSegmentLinfBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ax, float ay, float bx, float by)
+{
+	float bax = bx-ax;
+	float bay = by-ay;
+	float s = (bax*bay>0.0)?1.0f:-1.0f;
+	float den = bay+s*bax;
+	for (size_t i = 0; i < n; i++) {
+		float pax = px[i]-ax;
+		float pay = py[i]-ay;
+		float h = bmaxf(0.0f, bminf(1.0f, (pay+s*pax) / den));
+		float qx = fabsf(pax-h*bax);
+		float qy = fabsf(pay-h*bay);
+		out[i] = bmaxf(qx,qy);
+	}
+}
+
+void sdRhombusBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by)
+{
+	float bb = bx*bx+by*by;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float f1x = bx-x*2.0f;
+		float f1y = by-y*2.0f;
+		float h = bmaxf(-1.0f, bminf((f1x*bx-f1y*by) / bb, 1.0f));
+		float dvx = x-((bx*0.5f)*(1.0f-h));
+		float dvy = y-((by*0.5f)*(1.0f+h));
+		float r = x*by+y*bx-bx*by;
+		out[i] = sqrtf(dvx*dvx+dvy*dvy) * bsgnf(r);
+	}
+}
+
+void sdRhombusLinfBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i])-bx;
+		float y = fabsf(py[i]);
+		float f = bmaxf(0.0f, bminf((y-x)/(by+bx), 1.0f));
+		float qx = fabsf(x+f*bx);
+		float qy = fabsf(y-f*by);
+		out[i] = bmaxf(qx,qy)*((by*x+bx*y>0.0f)?1.0f:-1.0f);
+	}
+}
+
+void sdTrapezoidBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r1, float r2, float he)
+{
+	float k2x = r2-r1;
+	float k2y = 2.0f*he;
+	float kk = k2x*k2x+k2y*k2y;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float cax = x - bminf(x, (y < 0.0f) ? r1 : r2);
+		float cay = fabsf(y)-he;
+		float d = bmaxf(0.0f, bminf((k2x*(r2-x)+k2y*(he-y))/kk, 1.0f));
+		float cbx = x-r2+(k2x*d);
+		float cby = y-he+(k2y*d);
+		float s = (cbx < 0.0f && cay < 0.0f) ? -1.0f : 1.0f;
+		out[i] = s*sqrtf(bminf((cax*cax+cay*cay),(cbx*cbx+cby*cby)));
+	}
+}
+
+void sdParallelogramBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float wi, float he, float sk)
+{
+	float ex = sk, ey = he;
+	float dee = ex * ex + ey * ey;
+	for (size_t i = 0; i < n; i++) {
+		float x = (py[i] < 0.0f) ? -px[i] : px[i];
+		float y = (py[i] < 0.0f) ? -py[i] : py[i];
+		float wx = x - ex;
+		float wy = y - ey;
+		wx -= bmaxf(-wi, bminf(wx, wi));
+		float dx = wx * wx + wy * wy;
+		float dy = -wy;
+		float s = x * ey - y * ex;
+		float vx = ((s < 0.0f) ? -x : x) - wi;
+		float vy = (s < 0.0f) ? -y : y;
+		float c = bmaxf(-1.0f, bminf((vx * ex + vy * ey) / dee, 1.0f));
+		vx -= ex * c;
+		vy -= ey * c;
+		dx = bminf(dx, vx * vx + vy * vy);
+		dy = bminf(dy, wi * he - fabsf(s));
+		out[i] = sqrtf(dx) * bsgnf(-dy);
+	}
+}
+
+void sdTriangleBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y)
+{
+	float e0x = p1x-p0x;
+	float e0y = p1y-p0y;
+	float e1x = p2x-p1x;
+	float e1y = p2y-p1y;
+	float e2x = p0x-p2x;
+	float e2y = p0y-p2y;
+	float ee0 = e0x*e0x+e0y*e0y;
+	float ee1 = e1x*e1x+e1y*e1y;
+	float ee2 = e2x*e2x+e2y*e2y;
+	float s = bsgnf(e0x*e2y-e0y*e2x);
+	for (size_t i = 0; i < n; i++) {
+		float v0x = px[i]-p0x;
+		float v0y = py[i]-p0y;
+		float v1x = px[i]-p1x;
+		float v1y = py[i]-p1y;
+		float v2x = px[i]-p2x;
+		float v2y = py[i]-p2y;
+		float m0 = bmaxf(0.0f, bminf((v0x*e0x+v0y*e0y) / ee0, 1.0f));
+		float m1 = bmaxf(0.0f, bminf((v1x*e1x+v1y*e1y) / ee1, 1.0f));
+		float m2 = bmaxf(0.0f, bminf((v2x*e2x+v2y*e2y) / ee2, 1.0f));
+		float pq0x = v0x-e0x*m0;
+		float pq0y = v0y-e0y*m0;
+		float pq1x = v1x-e1x*m1;
+		float pq1y = v1y-e1y*m1;
+		float pq2x = v2x-e2x*m2;
+		float pq2y = v2y-e2y*m2;
+		float dx = bminf(bminf(pq0x*pq0x+pq0y*pq0y, pq1x*pq1x+pq1y*pq1y), pq2x*pq2x+pq2y*pq2y);
+		float dy = bminf(bminf(s*(v0x*e0y-v0y*e0x), s*(v1x*e1y-v1y*e1x)), s*(v2x*e2y-v2y*e2x));
+		out[i] = -sqrtf(dx)*bsgnf(dy);
+	}
+}
+
+void sdTriangleIsoscelesBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float qx, float qy)
+{
+	float qq = qx*qx+qy*qy;
+	float sq = bsgnf(qy);
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float m1 = bmaxf(0.0f, bminf((x*qx+y*qy)/qq, 1.0f));
+		float ax = x-qx*m1;
+		float ay = y-qy*m1;
+		float m2 = bmaxf(0.0f, bminf(x/qx, 1.0f));
+		float bx = x-qx*m2;
+		float by = y-qy;
+		float s = bmaxf(sq * (x*qy-y*qx), sq*(y-qy));
+		out[i] = sqrtf(bminf(ax*ax+ay*ay,bx*bx+by*by))*bsgnf(s);
+	}
+}
+
+void sdEquilateralTriangleBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r)
+{
+	float k = 1.73205f;
+	float rk = r/k;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]) - r;
+		float y = py[i] + rk;
+		int fold = (x+k*y) > 0.0f;
+		float fx = (x - k * y) / 2.0f;
+		float fy = (-k * x - y) / 2.0f;
+		x = fold ? fx : x;
+		y = fold ? fy : y;
+		x -= bmaxf(-2.0f*r, bminf(x, 0.0f));
+		out[i] = -sqrtf(x*x+y*y)*bsgnf(y);
+	}
+}
+
+void sdQuadBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float p3x, float p3y)
+{
+	float e0x = p1x-p0x;
+	float e0y = p1y-p0y;
+	float e1x = p2x-p1x;
+	float e1y = p2y-p1y;
+	float e2x = p3x-p2x;
+	float e2y = p3y-p2y;
+	float e3x = p0x-p3x;
+	float e3y = p0y-p3y;
+	float ee0 = e0x*e0x+e0y*e0y;
+	float ee1 = e1x*e1x+e1y*e1y;
+	float ee2 = e2x*e2x+e2y*e2y;
+	float ee3 = e3x*e3x+e3y*e3y;
+	for (size_t i = 0; i < n; i++) {
+		float v0x = px[i]-p0x;
+		float v0y = py[i]-p0y;
+		float v1x = px[i]-p1x;
+		float v1y = py[i]-p1y;
+		float v2x = px[i]-p2x;
+		float v2y = py[i]-p2y;
+		float v3x = px[i]-p3x;
+		float v3y = py[i]-p3y;
+		float m0 = bmaxf(0.0f, bminf((v0x*e0x+v0y*e0y) / ee0, 1.0f));
+		float m1 = bmaxf(0.0f, bminf((v1x*e1x+v1y*e1y) / ee1, 1.0f));
+		float m2 = bmaxf(0.0f, bminf((v2x*e2x+v2y*e2y) / ee2, 1.0f));
+		float m3 = bmaxf(0.0f, bminf((v3x*e3x+v3y*e3y) / ee3, 1.0f));
+		float pq0x = v0x-e0x*m0;
+		float pq0y = v0y-e0y*m0;
+		float pq1x = v1x-e1x*m1;
+		float pq1y = v1y-e1y*m1;
+		float pq2x = v2x-e2x*m2;
+		float pq2y = v2y-e2y*m2;
+		float pq3x = v3x-e3x*m3;
+		float pq3y = v3y-e3y*m3;
+		float dx = bminf(bminf(bminf(pq0x*pq0x+pq0y*pq0y, pq1x*pq1x+pq1y*pq1y), pq2x*pq2x+pq2y*pq2y), pq3x*pq3x+pq3y*pq3y);
+		float dy = bminf(bminf(bminf(v0x*e0y-v0y*e0x, v1x*e1y-v1y*e1x), v2x*e2y-v2y*e2x), v3x*e3y-v3y*e3x);
+		out[i] = -sqrtf(dx)*bsgnf(dy);
+	}
+}
+
+void sdStar5Batch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r, float rf)
+{
+	float kx = 0.809016994375f;
+	float ky = -0.587785252292f;
+	float bax = -ky*rf;
+	float bay = kx*rf-1.0f;
+	float bb = bax*bax+bay*bay;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float f1 = bmaxf((kx*x+ky*y),0.0f)*2.0f;
+		x = x-kx*f1;
+		y = y-ky*f1;
+		float f2 = bmaxf((-kx*x+ky*y),0.0f)*2.0f;
+		x = fabsf(x-(-kx*f2));
+		y = y-(ky*f2)-r;
+		float h = bmaxf(0.0f, bminf(((x*bax+y*bay)/bb), r));
+		float s = y*bax-x*bay;
+		float dx = x-bax*h;
+		float dy = y-bay*h;
+		out[i] = sqrtf(dx*dx+dy*dy) * bsgnf(s);
+	}
+}
+
+void sdPentagonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r)
+{
+	float kx = 0.809016994f;
+	float ky = 0.587785252f;
+	float kz = 0.726542528f;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float d1 = bminf(-kx * x + ky * y, 0.0f);
+		x -= 2.0f * d1 * -kx;
+		y -= 2.0f * d1 * ky;
+		float d2 = bminf(kx * x + ky * y, 0.0f);
+		x -= 2.0f * d2 * kx;
+		y -= 2.0f * d2 * ky;
+		x -= bmaxf(-r * kz, bminf(x, r * kz));
+		y -= r;
+		out[i] = sqrtf(x * x + y * y) * bsgnf(y);
+	}
+}
+
+void sdHexagonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float s)
+{
+	float kx = -0.866025404f;
+	float ky = 0.5f;
+	float kz = 0.577350269f;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float kxyp = bminf(kx*x+ky*y, 0.0f);
+		x -= kx * kxyp * 2.0f;
+		y -= ky * kxyp * 2.0f;
+		x -= bmaxf(-kz*s, bminf(x, kz*s));
+		y -= s;
+		out[i] = sqrtf(x*x+y*y) * bsgnf(y);
+	}
+}
+
+void sdOctagonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r)
+{
+	float kx = -0.9238795325f;
+	float ky = 0.3826834323f;
+	float kz = 0.4142135623f;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float d1 = bminf(kx * x + ky * y, 0.0f);
+		x -= 2.0f * d1 * kx;
+		y -= 2.0f * d1 * ky;
+		float d2 = bminf(-kx * x + ky * y, 0.0f);
+		x -= 2.0f * d2 * (-kx);
+		y -= 2.0f * d2 * ky;
+		x -= bmaxf(-kz*r, bminf(x, kz*r));
+		y -= r;
+		out[i] = sqrtf(x*x + y*y) * bsgnf(y);
+	}
+}
+
+void sdHexagramBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r)
+{
+	float kx = -0.5f;
+	float ky = 0.8660254038f;
+	float kz = 0.5773502692f;
+	float kw = 1.7320508076f;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float d1 = bminf(kx * x + ky * y, 0.0f);
+		x -= 2.0f * d1 * kx;
+		y -= 2.0f * d1 * ky;
+		float d2 = bminf(ky * x + kx * y, 0.0f);
+		x -= 2.0f * d2 * ky;
+		y -= 2.0f * d2 * kx;
+		x -= bmaxf(r * kz, bminf(x, r * kw));
+		y -= r;
+		out[i] = sqrtf(x * x + y * y) * bsgnf(y);
+	}
+}
+
+void sdPieBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float cx, float cy, float r)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float l = sqrtf(x*x + y*y) - r;
+		float cd = bmaxf(0.0f, bminf(x*cx + y*cy, r));
+		float nx = cx*cd;
+		float ny = cy*cd;
+		float m = sqrtf((x - nx) * (x - nx) + (y - ny) * (y - ny));
+		float s = (cy * x - cx * y > 0.0f) ? 1.0f : -1.0f;
+		out[i] = bmaxf(l, m * s);
+	}
+}
+
+void sdCutDiskBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r, float h)
+{
+	float w = sqrtf(r*r - h*h);
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float xx = x * x;
+		float yy = y * y;
+		float s = bmaxf((h - r) * xx + w * w * (h + r - 2.0f * y), h * x - w * y);
+		float dx = x - w;
+		float dy = y - h;
+		float dc = sqrtf(xx + yy) - r;
+		float dw = sqrtf(dx * dx + dy * dy);
+		out[i] = (s < 0.0f) ? dc : ((x < w) ? h - y : dw);
+	}
+}
+
+void sdArcBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float scx, float scy, float ra, float rb)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float dx = x - scx * ra;
+		float dy = y - scy * ra;
+		float de = sqrtf(dx * dx + dy * dy) - rb;
+		float dr = fabsf(sqrtf(x * x + y * y) - ra) - rb;
+		out[i] = (scy * x > scx * y) ? de : dr;
+	}
+}
+
+void sdRingBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float nx, float ny, float r, float th)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x0 = fabsf(px[i]);
+		float x = nx * x0 - ny * py[i];
+		float y = ny * x0 + nx * py[i];
+		float d1 = fabsf(sqrtf(x * x + y * y) - r) - th * 0.5f;
+		y = bmaxf(0.0f, fabsf(r - y) - th * 0.5f);
+		float d2 = sqrtf(x * x + y * y) * bsgnf(x);
+		out[i] = bmaxf(d1, d2);
+	}
+}
+
+void sdHorseshoeBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float cx, float cy, float r, float le, float th)
+{
+	float sc = (-cx > 0.0f) ? 1.0f : -1.0f;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = -py[i];
+		float l = sqrtf(x * x + y * y);
+		float tx = -cx * x + cy * y;
+		y = cy * x + cx * y;
+		x = tx;
+		x = (y > 0.0f || x > 0.0f) ? x : l * sc;
+		y = (x > 0.0f) ? y : l;
+		x = x - le;
+		y = fabsf(y - r) - th;
+		float mx = bmaxf(x, 0.0f);
+		float my = bmaxf(y, 0.0f);
+		out[i] = sqrtf(mx * mx + my * my) + bminf(0.0f, bmaxf(x, y));
+	}
+}
+
+void sdVesicaBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r, float d)
+{
+	float b = sqrtf(r*r-d*d);
+	float sd = bsgnf(d);
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float dy = y - b;
+		float dx = x + d;
+		float dv = sqrtf(x * x + dy * dy) * sd;
+		float dc = sqrtf(dx * dx + y * y) - r;
+		out[i] = ((y - b) * d > x * b) ? dv : dc;
+	}
+}
+
+void sdOrientedVesicaBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ax, float ay, float bx, float by, float w)
+{
+	float dx = bx - ax;
+	float dy = by - ay;
+	float r = 0.5f * sqrtf(dx * dx + dy * dy);
+	float d = 0.5f * (r * r - w * w) / w;
+	float vx = dx / r;
+	float vy = dy / r;
+	float cx = 0.5f * (bx + ax);
+	float cy = 0.5f * (by + ay);
+	for (size_t i = 0; i < n; i++) {
+		float qx = px[i] - cx;
+		float qy = py[i] - cy;
+		float mqx = 0.5f * fabsf(vy * qx + vx * qy);
+		float mqy = 0.5f * fabsf(-vx * qx + vy * qy);
+		int c = r * mqx < d * (mqy - r);
+		float hx = c ? 0.0f : -d;
+		float hy = c ? r : 0.0f;
+		float hz = c ? 0.0f : d + w;
+		float dhx = mqx - hx;
+		float dhy = mqy - hy;
+		out[i] = sqrtf(dhx * dhx + dhy * dhy) - hz;
+	}
+}
+
+void sdMoonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float d, float ra, float rb)
+{
+	float a = (ra * ra - rb * rb + d * d) / (2.0f * d);
+	float b = sqrtf(bmaxf(ra * ra - a * a, 0.0f));
+	for (size_t i = 0; i < n; i++) {
+		float x = px[i];
+		float y = fabsf(py[i]);
+		float xa = x - a;
+		float yb = y - b;
+		float xd = x - d;
+		float dt = sqrtf(xa * xa + yb * yb);
+		float l1 = sqrtf(x * x + y * y);
+		float l2 = sqrtf(xd * xd + y * y);
+		out[i] = (d * (x * b - y * a) > d * d * bmaxf(b - y, 0.0f)) ? dt : bmaxf(l1 - ra, -(l2 - rb));
+	}
+}
+
+void sdCrossBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float bx, float by, float r)
+{
+	for (size_t i = 0; i < n; i++) {
+		float ax = fabsf(px[i]);
+		float ay = fabsf(py[i]);
+		float x = (ay > ax) ? ay : ax;
+		float y = (ay > ax) ? ax : ay;
+		float qx = x - bx;
+		float qy = y - by;
+		float k = bmaxf(qx, qy);
+		float wx = (k > 0.0f) ? qx : by - x;
+		float wy = (k > 0.0f) ? qy : -k;
+		float m1 = bmaxf(wx, 0.0f);
+		float m2 = bmaxf(wy, 0.0f);
+		float d = sqrtf(m1 * m1 + m2 * m2);
+		out[i] = (k > 0.0f ? d : -d) + r;
+	}
+}
+
+void sdRoundedXBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float w, float r)
+{
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vw = sdvSet(w), vr = sdvSet(r), half = sdvSet(0.5f);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		sdv x = sdvAbs(sdvLoad(px + i));
+		sdv y = sdvAbs(sdvLoad(py + i));
+		sdv m = sdvMul(sdvMin(sdvAdd(x, y), vw), half);
+		sdv dx = sdvSub(x, m);
+		sdv dy = sdvSub(y, m);
+		sdvStore(out + i, sdvSub(sdvSqrt(sdvAdd(sdvMul(dx, dx), sdvMul(dy, dy))), vr));
+	}
+#endif
+	for (; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float m = bminf(x + y, w) * 0.5f;
+		float dx = x - m;
+		float dy = y - m;
+		out[i] = sqrtf(dx * dx + dy * dy) - r;
+	}
+}
+
+void sdParabolaBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float k)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdParabola(px[i], py[i], k);
+}
+
+void sdTunnelBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float whx, float why)
+{
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = -py[i];
+		float qx = x - whx;
+		float qy = y - why;
+		float m0 = bmaxf(qx, 0.0f);
+		float d1 = m0 * m0 + qy * qy;
+		float l = sqrtf(x * x + y * y);
+		qx = (y > 0.0f) ? qx : l - whx;
+		float m1 = bmaxf(qy, 0.0f);
+		float d2 = qx * qx + m1 * m1;
+		float d = sqrtf(bminf(d1, d2));
+		out[i] = (bmaxf(qx, qy) < 0.0f) ? -d : d;
+	}
+}
+
+void sdEllipseBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ex, float ey)
+{
+	float eiX = 1.0f / ex;
+	float eiY = 1.0f / ey;
+	float e2X = ex * ex;
+	float e2Y = ey * ey;
+	float veX = eiX * (e2X - e2Y);
+	float veY = eiY * (e2Y - e2X);
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = fabsf(py[i]);
+		float tX = 0.70710678118654752f;
+		float tY = 0.70710678118654752f;
+		for (int k = 0; k < 3; k++) {
+			float vX = veX * tX * tX * tX;
+			float vY = veY * tY * tY * tY;
+			float tmx = x - vX;
+			float tmy = y - vY;
+			float m = sqrtf(tmx * tmx + tmy * tmy);
+			float u = sqrtf((tX * ex - vX) * (tX * ex - vX) + (tY * ey - vY) * (tY * ey - vY));
+			float cx = bmaxf(0.0f, bminf(eiX * (vX + (tmx / m) * u), 1.0f));
+			float cy = bmaxf(0.0f, bminf(eiY * (vY + (tmy / m) * u), 1.0f));
+			m = sqrtf(cx * cx + cy * cy);
+			tX = cx / m;
+			tY = cy / m;
+		}
+		float nx = tX * ex;
+		float ny = tY * ey;
+		float d = sqrtf((x - nx) * (x - nx) + (y - ny) * (y - ny));
+		out[i] = (x * x + y * y < nx * nx + ny * ny) ? -d : d;
+	}
+}
+
+void sdEllipseLinfBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ex, float ey)
+{
+	float m = ex*ex+ey*ey;
+	for (size_t i = 0; i < n; i++) {
+		float ax = fabsf(px[i]);
+		float ay = fabsf(py[i]);
+		float x = bmaxf(ax, ay-ey);
+		float y = bmaxf(ay, ax-ex);
+		float d = y-x;
+		out[i] = x - (ey*sqrtf(m-d*d)-ex*d) * ex/m;
+	}
+}
+
+void sdRegularPolygonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r, int sides)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdRegularPolygon(px[i], py[i], r, sides);
+}
+
+// Blocks of points in the inner loop, so that it vectorises and the edges are loaded once per block
+#define SD_POLYGON_BLOCK 64
+
+void sdPolygonBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float vx[], float vy[], int num)
+{
+	float d[SD_POLYGON_BLOCK], s[SD_POLYGON_BLOCK];
+	for (size_t i0 = 0; i0 < n; i0 += SD_POLYGON_BLOCK) {
+		size_t m = n - i0 < SD_POLYGON_BLOCK ? n - i0 : SD_POLYGON_BLOCK;
+		const float *x = px + i0;
+		const float *y = py + i0;
+		for (size_t i = 0; i < m; i++) {
+			d[i] = (x[i] - vx[0]) * (x[i] - vx[0]) + (y[i] - vy[0]) * (y[i] - vy[0]);
+			s[i] = 1.0f;
+		}
+		for (int k = 0, j = num - 1; k < num; j = k++) {
+			float ex = vx[j] - vx[k];
+			float ey = vy[j] - vy[k];
+			float ee = ex * ex + ey * ey;
+			float ax = vx[k], ay = vy[k], by = vy[j];
+			for (size_t i = 0; i < m; i++) {
+				float wx = x[i] - ax;
+				float wy = y[i] - ay;
+				float pr = bmaxf(0.0f, bminf((wx * ex + wy * ey) / ee, 1.0f));
+				float bx = wx - ex * pr;
+				float bz = wy - ey * pr;
+				d[i] = bminf(d[i], bx * bx + bz * bz);
+				int c1 = (y[i] >= ay);
+				int c2 = (y[i] < by);
+				int c3 = (ex * wy > ey * wx);
+				s[i] = ((c1 && c2 && c3) || (!c1 && !c2 && !c3)) ? -s[i] : s[i];
+			}
+		}
+		for (size_t i = 0; i < m; i++) out[i0 + i] = s[i] * sqrtf(d[i]);
+	}
+}
+
+void sdRoundSquareBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float s, float r)
+{
+	size_t i = 0;
+#ifdef SDV_WIDTH
+	sdv vs = sdvSet(s), vr = sdvSet(r), zero = sdvSet(0.0f);
+	for (; i + SDV_WIDTH <= n; i += SDV_WIDTH) {
+		// |p| - s + r in that order, as sdRoundSquare: |p| - (s - r) rounds differently
+		sdv qx = sdvAdd(sdvSub(sdvAbs(sdvLoad(px + i)), vs), vr);
+		sdv qy = sdvAdd(sdvSub(sdvAbs(sdvLoad(py + i)), vs), vr);
+		sdv cqx = sdvMax(qx, zero);
+		sdv cqy = sdvMax(qy, zero);
+		sdv lcq = sdvSqrt(sdvAdd(sdvMul(cqx, cqx), sdvMul(cqy, cqy)));
+		sdvStore(out + i, sdvSub(sdvAdd(sdvMin(sdvMax(qx, qy), zero), lcq), vr));
+	}
+#endif
+	for (; i < n; i++) {
+		float qx = fabsf(px[i]) - s + r;
+		float qy = fabsf(py[i]) - s + r;
+		float cqx = bmaxf(qx, 0.0f);
+		float cqy = bmaxf(qy, 0.0f);
+		out[i] = bminf(bmaxf(qx, qy), 0.0f) + sqrtf(cqx * cqx + cqy * cqy) - r;
+	}
+}
+
+void sdEggBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ra, float rb)
+{
+	const float k = 1.73205f;
+	float r = ra - rb;
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float m0 = y - k * r;
+		float m1 = x + r;
+		float l1 = sqrtf(x * x + y * y) - r;
+		float l2 = sqrtf(x * x + m0 * m0);
+		float l3 = sqrtf(m1 * m1 + y * y) - 2.0f * r;
+		out[i] = ((y < 0.0f) ? l1 : ((k * (x + r) < y) ? l2 : l3)) - rb;
+	}
+}
+
+void sdUnevenCapsuleBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float r1, float r2, float h)
+{
+	float b = (r1 - r2) / h;
+	float a = sqrtf(1.0f - b * b);
+	for (size_t i = 0; i < n; i++) {
+		float x = fabsf(px[i]);
+		float y = py[i];
+		float k = (-b * x) + (a * y);
+		float d1 = sqrtf(x * x + y * y) - r1;
+		float d2 = sqrtf(x * x + (y - h) * (y - h)) - r2;
+		float ds = (a * x) + (b * y) - r1;
+		out[i] = (k < 0.0f) ? d1 : ((k > a * h) ? d2 : ds);
+	}
+}
+
+void sdBezierBatch(const float *restrict px, const float *restrict py, float *restrict out, size_t n, float ax, float ay, float bx, float by, float cx, float cy, float th)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdBezier(px[i], py[i], ax, ay, bx, by, cx, cy, th);
+}
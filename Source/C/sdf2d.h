@@ -1,6 +1,8 @@
 #ifndef SDF2D_H
 #define SDF2D_H
 
+#include <stddef.h>
+
 float sdCircle(float x, float y, float r);
 float sdBox(float px, float py, float bx, float by);
 float sdBoxLinf(float px, float py, float bx, float by);
@@ -40,5 +42,92 @@ float sdPolygon(float px, float py, float vx[], float vy[], int num);
 float sdRoundSquare(float px, float py, float s, float r);
 float sdEgg(float px, float py, float ra, float rb);
 float sdUnevenCapsule(float px, float py, float r1, float r2, float h);
+float sdBezier(float px, float py, float ax, float ay, float bx, float by, float cx, float cy, float th);
+
+// Distance and gradient in one pass: returns sdXxx(px, py, ...) and writes d/dpx, d/dpy to gx, gy.
+float sdgCircle(float px, float py, float r, float *gx, float *gy);
+float sdgBox(float px, float py, float bx, float by, float *gx, float *gy);
+float sdgBoxLinf(float px, float py, float bx, float by, float *gx, float *gy);
+float sdgRoundedBox(float px, float py, float bx, float by, float rw, float rx, float ry, float rz, float *gx, float *gy);
+float sdgOrientedBox(float px, float py, float ax, float ay, float bx, float by, float th, float *gx, float *gy);
+float sdgSegment(float px, float py, float ax, float ay, float bx, float by, float *gx, float *gy);
+float sdgSegmentLinf(float px, float py, float ax, float ay, float bx, float by, float *gx, float *gy);
+float sdgRhombus(float px, float py, float bx, float by, float *gx, float *gy);
+float sdgRhombusLinf(float px, float py, float bx, float by, float *gx, float *gy);
+float sdgTrapezoid(float px, float py, float r1, float r2, float he, float *gx, float *gy);
+float sdgParallelogram(float px, float py, float wi, float he, float sk, float *gx, float *gy);
+float sdgTriangle(float px, float py, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float *gx, float *gy);
+float sdgTriangleIsosceles(float px, float py, float qx, float qy, float *gx, float *gy);
+float sdgEquilateralTriangle(float px, float py, float r, float *gx, float *gy);
+float sdgQuad(float px, float py, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float p3x, float p3y, float *gx, float *gy);
+float sdgStar5(float px, float py, float r, float rf, float *gx, float *gy);
+float sdgPentagon(float px, float py, float r, float *gx, float *gy);
+float sdgHexagon(float px, float py, float s, float *gx, float *gy);
+float sdgOctagon(float px, float py, float r, float *gx, float *gy);
+float sdgHexagram(float px, float py, float r, float *gx, float *gy);
+float sdgPie(float px, float py, float cx, float cy, float r, float *gx, float *gy);
+float sdgCutDisk(float px, float py, float r, float h, float *gx, float *gy);
+float sdgArc(float px, float py, float scx, float scy, float ra, float rb, float *gx, float *gy);
+float sdgRing(float px, float py, float nx, float ny, float r, float th, float *gx, float *gy);
+float sdgHorseshoe(float px, float py, float cx, float cy, float r, float le, float th, float *gx, float *gy);
+float sdgVesica(float px, float py, float r, float d, float *gx, float *gy);
+float sdgOrientedVesica(float px, float py, float ax, float ay, float bx, float by, float w, float *gx, float *gy);
+float sdgMoon(float px, float py, float d, float ra, float rb, float *gx, float *gy);
+float sdgCross(float px, float py, float bx, float by, float r, float *gx, float *gy);
+float sdgRoundedX(float px, float py, float w, float r, float *gx, float *gy);
+float sdgParabola(float px, float py, float k, float *gx, float *gy);
+float sdgTunnel(float px, float py, float whx, float why, float *gx, float *gy);
+float sdgEllipse(float px, float py, float ex, float ey, float *gx, float *gy);
+float sdgEllipseLinf(float px, float py, float ex, float ey, float *gx, float *gy);
+float sdgRegularPolygon(float px, float py, float r, int n, float *gx, float *gy);
+float sdgPolygon(float px, float py, float vx[], float vy[], int num, float *gx, float *gy);
+float sdgRoundSquare(float px, float py, float s, float r, float *gx, float *gy);
+float sdgEgg(float px, float py, float ra, float rb, float *gx, float *gy);
+float sdgUnevenCapsule(float px, float py, float r1, float r2, float h, float *gx, float *gy);
+float sdgBezier(float px, float py, float ax, float ay, float bx, float by, float cx, float cy, float th, float *gx, float *gy);
+
+// Batched (SoA) variants: out[i] = sdXxx(px[i], py[i], ...) for i < n, with the shape parameters fixed.
+// Compile sdf2d.c with -fno-math-errno -fno-trapping-math for the loops to auto-vectorise, and define
+// SDF2D_SIMD to enable the explicit SSE/AVX/NEON paths.
+void sdCircleBatch(const float *px, const float *py, float *out, size_t n, float r);
+void sdBoxBatch(const float *px, const float *py, float *out, size_t n, float bx, float by);
+void sdBoxLinfBatch(const float *px, const float *py, float *out, size_t n, float bx, float by);
+void sdRoundedBoxBatch(const float *px, const float *py, float *out, size_t n, float bx, float by, float rw, float rx, float ry, float rz);
+void sdOrientedBoxBatch(const float *px, const float *py, float *out, size_t n, float ax, float ay, float bx, float by, float th);
+void sdSegmentBatch(const float *px, const float *py, float *out, size_t n, float ax, float ay, float bx, float by);
+void sdSegmentLinfBatch(const float *px, const float *py, float *out, size_t n, float ax, float ay, float bx, float by);
+void sdRhombusBatch(const float *px, const float *py, float *out, size_t n, float bx, float by);
+void sdRhombusLinfBatch(const float *px, const float *py, float *out, size_t n, float bx, float by);
+void sdTrapezoidBatch(const float *px, const float *py, float *out, size_t n, float r1, float r2, float he);
+void sdParallelogramBatch(const float *px, const float *py, float *out, size_t n, float wi, float he, float sk);
+void sdTriangleBatch(const float *px, const float *py, float *out, size_t n, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y);
+void sdTriangleIsoscelesBatch(const float *px, const float *py, float *out, size_t n, float qx, float qy);
+void sdEquilateralTriangleBatch(const float *px, const float *py, float *out, size_t n, float r);
+void sdQuadBatch(const float *px, const float *py, float *out, size_t n, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float p3x, float p3y);
+void sdStar5Batch(const float *px, const float *py, float *out, size_t n, float r, float rf);
+void sdPentagonBatch(const float *px, const float *py, float *out, size_t n, float r);
+void sdHexagonBatch(const float *px, const float *py, float *out, size_t n, float s);
+void sdOctagonBatch(const float *px, const float *py, float *out, size_t n, float r);
+void sdHexagramBatch(const float *px, const float *py, float *out, size_t n, float r);
+void sdPieBatch(const float *px, const float *py, float *out, size_t n, float cx, float cy, float r);
+void sdCutDiskBatch(const float *px, const float *py, float *out, size_t n, float r, float h);
+void sdArcBatch(const float *px, const float *py, float *out, size_t n, float scx, float scy, float ra, float rb);
+void sdRingBatch(const float *px, const float *py, float *out, size_t n, float nx, float ny, float r, float th);
+void sdHorseshoeBatch(const float *px, const float *py, float *out, size_t n, float cx, float cy, float r, float le, float th);
+void sdVesicaBatch(const float *px, const float *py, float *out, size_t n, float r, float d);
+void sdOrientedVesicaBatch(const float *px, const float *py, float *out, size_t n, float ax, float ay, float bx, float by, float w);
+void sdMoonBatch(const float *px, const float *py, float *out, size_t n, float d, float ra, float rb);
+void sdCrossBatch(const float *px, const float *py, float *out, size_t n, float bx, float by, float r);
+void sdRoundedXBatch(const float *px, const float *py, float *out, size_t n, float w, float r);
+void sdParabolaBatch(const float *px, const float *py, float *out, size_t n, float k);
+void sdTunnelBatch(const float *px, const float *py, float *out, size_t n, float whx, float why);
+void sdEllipseBatch(const float *px, const float *py, float *out, size_t n, float ex, float ey);
+void sdEllipseLinfBatch(const float *px, const float *py, float *out, size_t n, float ex, float ey);
+void sdRegularPolygonBatch(const float *px, const float *py, float *out, size_t n, float r, int sides);
+void sdPolygonBatch(const float *px, const float *py, float *out, size_t n, float vx[], float vy[], int num);
+void sdRoundSquareBatch(const float *px, const float *py, float *out, size_t n, float s, float r);
+void sdEggBatch(const float *px, const float *py, float *out, size_t n, float ra, float rb);
+void sdUnevenCapsuleBatch(const float *px, const float *py, float *out, size_t n, float r1, float r2, float h);
+void sdBezierBatch(const float *px, const float *py, float *out, size_t n, float ax, float ay, float bx, float by, float cx, float cy, float th);
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,512 @@
+// Baked assets. See sdf2d_asset.h.
+
+#define _POSIX_C_SOURCE 200809L // mmap
+
+#include "sdf2d_asset.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SD_ASSET_MMAP
+#endif
+
+#define SD_ASSET_TILE_SAMPLES ((SD_GRID_TILE + 1) * (SD_GRID_TILE + 1))
+#define SD_ASSET_CHUNK 256
+
+static const size_t sdAssetSampleSize[] = { 1, 2, 4 };
+
+static size_t sdAssetAlign(size_t n)
+{
+	return (n + SD_ASSET_ALIGN - 1) & ~(size_t)(SD_ASSET_ALIGN - 1);
+}
+
+// Bounds
+
+static void sdAssetHuge(float b[4])
+{
+	b[0] = b[1] = -SD_BOUNDS_HUGE;
+	b[2] = b[3] = SD_BOUNDS_HUGE;
+}
+
+static void sdAssetGrow(float b[4], float k)
+{
+	if (b[0] <= -SD_BOUNDS_HUGE || b[2] >= SD_BOUNDS_HUGE) return;
+	k = fabsf(k);
+	b[0] -= k;
+	b[1] -= k;
+	b[2] += k;
+	b[3] += k;
+}
+
+// World bounds of every node under id, whose parent frame maps p to R(c, s) p + (ox, oy).
+// Operators combine their children's, grown by k where the operator moves the surface.
+static void sdAssetBounds(const SDScene *scene, int id, float ox, float oy, float c, float s, SDAssetNode *out)
+{
+	const SDNode *nd = &scene->nodes[id];
+	float wx = ox + c * nd->tx - s * nd->ty;
+	float wy = oy + s * nd->tx + c * nd->ty;
+	float wc = c * nd->c - s * nd->s;
+	float ws = s * nd->c + c * nd->s;
+	float *b = out[id].bounds;
+
+	if (nd->op == kSDNodeShape) {
+		SDBounds local;
+		sdShapeBounds(&nd->shape, &local);
+		if (local.minx <= -SD_BOUNDS_HUGE || local.maxx >= SD_BOUNDS_HUGE ||
+			local.miny <= -SD_BOUNDS_HUGE || local.maxy >= SD_BOUNDS_HUGE) {
+			sdAssetHuge(b);
+			return;
+		}
+		b[0] = b[1] = SD_BOUNDS_HUGE;
+		b[2] = b[3] = -SD_BOUNDS_HUGE;
+		for (int i = 0; i < 4; i++) {
+			float x = (i & 1) ? local.maxx : local.minx;
+			float y = (i & 2) ? local.maxy : local.miny;
+			float px = wx + wc * x - ws * y;
+			float py = wy + ws * x + wc * y;
+			b[0] = fminf(b[0], px);
+			b[1] = fminf(b[1], py);
+			b[2] = fmaxf(b[2], px);
+			b[3] = fmaxf(b[3], py);
+		}
+		return;
+	}
+
+	sdAssetBounds(scene, nd->a, wx, wy, wc, ws, out);
+	memcpy(b, out[nd->a].bounds, sizeof(out[id].bounds));
+	if (nd->b >= 0) sdAssetBounds(scene, nd->b, wx, wy, wc, ws, out);
+	switch (nd->op) {
+	case kSDUnion:
+	case kSDSmoothUnion: {
+		const float *o = out[nd->b].bounds;
+		b[0] = fminf(b[0], o[0]);
+		b[1] = fminf(b[1], o[1]);
+		b[2] = fmaxf(b[2], o[2]);
+		b[3] = fmaxf(b[3], o[3]);
+		if (nd->op == kSDSmoothUnion) sdAssetGrow(b, nd->k);
+		break;
+	}
+	case kSDIntersect: {
+		const float *o = out[nd->b].bounds;
+		b[0] = fmaxf(b[0], o[0]);
+		b[1] = fmaxf(b[1], o[1]);
+		b[2] = fminf(b[2], o[2]);
+		b[3] = fminf(b[3], o[3]);
+		break;
+	}
+	case kSDOnion:
+	case kSDRound:
+		sdAssetGrow(b, nd->k);
+		break;
+	default:             // kSDSubtract: inside a
+		break;
+	}
+}
+
+// Baking
+
+static void sdAssetLevelLayout(const SDGridLayout *base, int k, SDGridLayout *l)
+{
+	int m = 1 << k;
+	*l = *base;
+	l->cell = base->cell * m;
+	l->width = (base->width - 1 + m - 1) / m + 1;
+	l->height = (base->height - 1 + m - 1) / m + 1;
+}
+
+// World position of stored sample i, in the order of grid->data
+static void sdAssetSamplePos(const SDGrid *grid, size_t i, const int *tileOf, float *px, float *py)
+{
+	const SDGridLayout *l = &grid->layout;
+	int x, y;
+	if (!grid->tiles) {
+		x = (int)(i % (size_t)l->width);
+		y = (int)(i / (size_t)l->width);
+	} else {
+		int t = tileOf[i / SD_ASSET_TILE_SAMPLES];
+		int j = (int)(i % SD_ASSET_TILE_SAMPLES);
+		x = (t % grid->tilesX) * SD_GRID_TILE + j % (SD_GRID_TILE + 1);
+		y = (t / grid->tilesX) * SD_GRID_TILE + j / (SD_GRID_TILE + 1);
+		if (x >= l->width) x = l->width - 1;
+		if (y >= l->height) y = l->height - 1;
+	}
+	*px = l->x + x * l->cell;
+	*py = l->y + y * l->cell;
+}
+
+// The scene's gradient at every sample by central differences, quantised to int8
+static int sdAssetBakeGradient(const SDScene *scene, const SDGrid *grid, signed char *out)
+{
+	size_t count = grid->bytes / sdAssetSampleSize[grid->layout.format];
+	int *tileOf = NULL;
+	if (grid->tiles) {
+		// stored tile k is the k-th tile with a sample offset, in offset order
+		tileOf = malloc((count / SD_ASSET_TILE_SAMPLES + 1) * sizeof(int));
+		if (!tileOf) return -1;
+		for (int t = 0; t < grid->tilesX * grid->tilesY; t++)
+			if (grid->tiles[t] >= 0) tileOf[grid->tiles[t] / SD_ASSET_TILE_SAMPLES] = t;
+	}
+	float e = grid->layout.cell * 0.01f;
+	float px[4 * SD_ASSET_CHUNK], py[4 * SD_ASSET_CHUNK], d[4 * SD_ASSET_CHUNK];
+	for (size_t i = 0; i < count; i += SD_ASSET_CHUNK) {
+		int n = count - i < SD_ASSET_CHUNK ? (int)(count - i) : SD_ASSET_CHUNK;
+		for (int j = 0; j < n; j++) {
+			float x, y;
+			sdAssetSamplePos(grid, i + j, tileOf, &x, &y);
+			px[j] = x + e; py[j] = y;
+			px[n + j] = x - e; py[n + j] = y;
+			px[2 * n + j] = x; py[2 * n + j] = y + e;
+			px[3 * n + j] = x; py[3 * n + j] = y - e;
+		}
+		sdSceneEvalBatch(scene, px, py, d, 4 * n);
+		for (int j = 0; j < n; j++) {
+			float gx = d[j] - d[n + j], gy = d[2 * n + j] - d[3 * n + j];
+			float len = sqrtf(gx * gx + gy * gy);
+			float inv = len > 0.0f ? 127.0f / len : 0.0f;
+			out[2 * (i + j)] = (signed char)lrintf(gx * inv);
+			out[2 * (i + j) + 1] = (signed char)lrintf(gy * inv);
+		}
+	}
+	free(tileOf);
+	return 0;
+}
+
+int sdAssetBake(const SDScene *scene, const SDAssetOptions *options, void **blob, size_t *size)
+{
+	int levels = options->levels;
+	if (scene->root < 0 || levels < 1 || levels > SD_ASSET_MAX_LEVELS) return -1;
+	SDGrid grids[SD_ASSET_MAX_LEVELS];
+	SDAssetNode *nodes = calloc(scene->numNodes, sizeof(SDAssetNode));
+	unsigned char *out = NULL;
+	int result = -1;
+	for (int k = 0; k < levels; k++) sdGridInit(&grids[k]);
+	if (!nodes) return -1;
+
+	// sections, in file order: header, then per level tiles, data and gradient, then nodes and vertices
+	size_t at = sdAssetAlign(sizeof(SDAssetHeader));
+	size_t tileAt[SD_ASSET_MAX_LEVELS], dataAt[SD_ASSET_MAX_LEVELS], gradAt[SD_ASSET_MAX_LEVELS];
+	for (int k = 0; k < levels; k++) {
+		SDGridLayout l;
+		sdAssetLevelLayout(&options->layout, k, &l);
+		if (sdGridBakeScene(&grids[k], &l, scene)) goto done;
+		size_t tiles = grids[k].tiles ? (size_t)grids[k].tilesX * grids[k].tilesY * sizeof(int32_t) : 0;
+		size_t samples = grids[k].bytes / sdAssetSampleSize[l.format];
+		tileAt[k] = tiles ? at : 0;
+		at = sdAssetAlign(at + tiles);
+		dataAt[k] = at;
+		at = sdAssetAlign(at + grids[k].bytes);
+		gradAt[k] = options->gradient ? at : 0;
+		if (options->gradient) at = sdAssetAlign(at + samples * 2);
+	}
+	size_t nodeAt = at, vertices = 0;
+	at = sdAssetAlign(at + scene->numNodes * sizeof(SDAssetNode));
+	for (int i = 0; i < scene->numNodes; i++) {
+		const SDNode *nd = &scene->nodes[i];
+		if (nd->op == kSDNodeShape && nd->shape.type == kSDPolygon) vertices += 2 * (size_t)nd->shape.n;
+	}
+	size_t vertexAt = vertices ? at : 0;
+	at = sdAssetAlign(at + vertices * sizeof(float));
+	if (at > 0xffffffffu) goto done;
+
+	out = calloc(1, at);
+	if (!out) goto done;
+	SDAssetHeader *h = (SDAssetHeader *)out;
+	h->magic = SD_ASSET_MAGIC;
+	h->version = SD_ASSET_VERSION;
+	h->bytes = (uint32_t)at;
+	h->flags = options->gradient ? kSDAssetGradient : 0;
+	h->levels = (uint32_t)levels;
+	h->nodes = (uint32_t)scene->numNodes;
+	h->root = scene->root;
+	h->nodeOffset = (uint32_t)nodeAt;
+	h->vertexOffset = (uint32_t)vertexAt;
+	h->vertices = (uint32_t)vertices;
+
+	for (int k = 0; k < levels; k++) {
+		const SDGrid *g = &grids[k];
+		SDAssetLevel *lv = &h->level[k];
+		lv->format = g->layout.format;
+		lv->width = g->layout.width;
+		lv->height = g->layout.height;
+		lv->narrow = g->layout.narrow;
+		lv->x = g->layout.x;
+		lv->y = g->layout.y;
+		lv->cell = g->layout.cell;
+		lv->range = g->layout.range;
+		lv->scale = g->scale;
+		lv->bias = g->bias;
+		lv->error = g->error;
+		lv->tilesX = g->tilesX;
+		lv->tilesY = g->tilesY;
+		lv->stride = g->stride;
+		lv->tileOffset = (uint32_t)tileAt[k];
+		lv->dataOffset = (uint32_t)dataAt[k];
+		lv->dataBytes = (uint32_t)g->bytes;
+		lv->gradientOffset = (uint32_t)gradAt[k];
+		if (g->tiles) {
+			int32_t *tiles = (int32_t *)(out + tileAt[k]);
+			for (int t = 0; t < g->tilesX * g->tilesY; t++) tiles[t] = g->tiles[t];
+		}
+		memcpy(out + dataAt[k], g->data, g->bytes);
+		if (options->gradient && sdAssetBakeGradient(scene, g, (signed char *)(out + gradAt[k]))) goto done;
+	}
+
+	for (int i = 0; i < scene->numNodes; i++) sdAssetHuge(nodes[i].bounds);
+	sdAssetBounds(scene, scene->root, 0.0f, 0.0f, 1.0f, 0.0f, nodes);
+	memcpy(h->bounds, nodes[scene->root].bounds, sizeof(h->bounds));
+	float *vertex = (float *)(out + vertexAt);
+	size_t v = 0;
+	for (int i = 0; i < scene->numNodes; i++) {
+		const SDNode *nd = &scene->nodes[i];
+		SDAssetNode *an = &nodes[i];
+		an->op = nd->op;
+		an->a = nd->a;
+		an->b = nd->b;
+		an->k = nd->k;
+		an->tx = nd->tx;
+		an->ty = nd->ty;
+		an->c = nd->c;
+		an->s = nd->s;
+		if (nd->op == kSDNodeShape) {
+			an->type = nd->shape.type;
+			an->n = nd->shape.n;
+			memcpy(an->p, nd->shape.p, sizeof(an->p));
+			if (nd->shape.type == kSDPolygon) {
+				an->vertex = (uint32_t)v;
+				memcpy(vertex + v, nd->shape.vx, nd->shape.n * sizeof(float));
+				memcpy(vertex + v + nd->shape.n, nd->shape.vy, nd->shape.n * sizeof(float));
+				v += 2 * (size_t)nd->shape.n;
+			}
+		}
+	}
+	memcpy(out + nodeAt, nodes, scene->numNodes * sizeof(SDAssetNode));
+
+	*blob = out;
+	*size = at;
+	out = NULL;
+	result = 0;
+done:
+	for (int k = 0; k < levels; k++) sdGridFree(&grids[k]);
+	free(nodes);
+	free(out);
+	return result;
+}
+
+// Loading
+
+void sdAssetInit(SDAsset *asset)
+{
+	memset(asset, 0, sizeof(SDAsset));
+}
+
+// A section of bytes at offset lies in the file and is aligned for 32-bit reads
+static int sdAssetSection(const SDAssetHeader *h, uint32_t offset, uint64_t bytes)
+{
+	return offset % 4 == 0 && offset >= sizeof(SDAssetHeader) && offset + bytes <= h->bytes;
+}
+
+static int sdAssetOpenLevel(SDAsset *asset, int k)
+{
+	const unsigned char *base = (const unsigned char *)asset->header;
+	const SDAssetLevel *lv = &asset->header->level[k];
+	SDGrid *g = &asset->grids[k];
+	if (lv->format < kSDGridInt8 || lv->format > kSDGridFloat) return -1;
+	if (lv->width < 2 || lv->height < 2 || !(lv->cell > 0.0f) || !(lv->range > 0.0f)) return -1;
+	size_t size = sdAssetSampleSize[lv->format];
+	if (lv->dataBytes % size || !sdAssetSection(asset->header, lv->dataOffset, lv->dataBytes)) return -1;
+	uint64_t samples = lv->dataBytes / size;
+
+	if (lv->narrow) {
+		if (lv->tilesX != (lv->width - 1 + SD_GRID_TILE - 1) / SD_GRID_TILE) return -1;
+		if (lv->tilesY != (lv->height - 1 + SD_GRID_TILE - 1) / SD_GRID_TILE) return -1;
+		if (lv->stride != SD_GRID_TILE + 1) return -1;
+		uint64_t count = (uint64_t)lv->tilesX * lv->tilesY;
+		if (!sdAssetSection(asset->header, lv->tileOffset, count * sizeof(int32_t))) return -1;
+		const int32_t *tiles = (const int32_t *)(base + lv->tileOffset);
+		for (uint64_t t = 0; t < count; t++)
+			if (tiles[t] < -2 || (tiles[t] >= 0 && (uint64_t)tiles[t] + SD_ASSET_TILE_SAMPLES > samples)) return -1;
+		g->tiles = (int *)tiles;
+	} else {
+		if (lv->stride != lv->width || samples != (uint64_t)lv->width * lv->height) return -1;
+	}
+	if (asset->header->flags & kSDAssetGradient) {
+		if (!sdAssetSection(asset->header, lv->gradientOffset, samples * 2)) return -1;
+		asset->gradient[k] = (const signed char *)(base + lv->gradientOffset);
+	}
+
+	SDGridLayout l = { (SDGridFormat)lv->format, lv->x, lv->y, lv->width, lv->height, lv->cell, lv->range, lv->narrow };
+	g->layout = l;
+	g->invCell = 1.0f / lv->cell;
+	g->scale = lv->scale;
+	g->bias = lv->bias;
+	g->error = lv->error;
+	g->tilesX = lv->tilesX;
+	g->tilesY = lv->tilesY;
+	g->stride = lv->stride;
+	g->data = (void *)(base + lv->dataOffset);
+	g->bytes = lv->dataBytes;
+	g->external = 1;
+	return 0;
+}
+
+static int sdAssetOpenNodes(SDAsset *asset)
+{
+	const SDAssetHeader *h = asset->header;
+	const unsigned char *base = (const unsigned char *)h;
+	if (!h->nodes || h->root < 0 || (uint32_t)h->root >= h->nodes) return -1;
+	if (!sdAssetSection(h, h->nodeOffset, (uint64_t)h->nodes * sizeof(SDAssetNode))) return -1;
+	if (h->vertices && !sdAssetSection(h, h->vertexOffset, (uint64_t)h->vertices * sizeof(float))) return -1;
+	const SDAssetNode *nodes = (const SDAssetNode *)(base + h->nodeOffset);
+	for (int i = 0; i < (int)h->nodes; i++) {
+		const SDAssetNode *an = &nodes[i];
+		if (an->op == kSDNodeShape) {
+			if (an->type < 0 || an->type >= kSDShapeCount) return -1;
+			if (an->type == kSDPolygon && (an->n < 3 || (uint64_t)an->vertex + 2 * (uint64_t)an->n > h->vertices)) return -1;
+		} else {
+			int unary = an->op == kSDOnion || an->op == kSDRound;
+			if (an->op < kSDUnion || an->op > kSDRound || an->a < 0 || an->a >= i) return -1;
+			if (unary ? an->b != -1 : (an->b < 0 || an->b >= i)) return -1;
+		}
+	}
+	asset->nodes = nodes;
+	asset->vertices = h->vertices ? (const float *)(base + h->vertexOffset) : NULL;
+	return 0;
+}
+
+int sdAssetOpen(SDAsset *asset, const void *blob, size_t size)
+{
+	const SDAssetHeader *h = blob;
+	sdAssetInit(asset);
+	if (!blob || ((uintptr_t)blob & 3) || size < sizeof(SDAssetHeader)) return -1;
+	if (h->magic != SD_ASSET_MAGIC || h->version != SD_ASSET_VERSION) return -1;
+	if (h->bytes > size || h->levels < 1 || h->levels > SD_ASSET_MAX_LEVELS || (h->flags & ~kSDAssetGradient)) return -1;
+	asset->header = h;
+	asset->size = h->bytes;
+	asset->levels = (int)h->levels;
+	for (int k = 0; k < asset->levels; k++) {
+		if (sdAssetOpenLevel(asset, k)) {
+			sdAssetInit(asset);
+			return -1;
+		}
+	}
+	if (sdAssetOpenNodes(asset)) {
+		sdAssetInit(asset);
+		return -1;
+	}
+	return 0;
+}
+
+int sdAssetMap(SDAsset *asset, const char *path)
+{
+	sdAssetInit(asset);
+#ifdef SD_ASSET_MMAP
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) return -1;
+	struct stat st;
+	if (fstat(fd, &st) || st.st_size <= 0) {
+		close(fd);
+		return -1;
+	}
+	size_t bytes = (size_t)st.st_size;
+	void *map = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) return -1;
+	if (sdAssetOpen(asset, map, bytes)) {
+		munmap(map, bytes);
+		return -1;
+	}
+	asset->map = map;
+	asset->mapBytes = bytes;
+	return 0;
+#else
+	(void)path;
+	return -1;
+#endif
+}
+
+void sdAssetClose(SDAsset *asset)
+{
+#ifdef SD_ASSET_MMAP
+	if (asset->map) munmap(asset->map, asset->mapBytes);
+#endif
+	sdAssetInit(asset);
+}
+
+// Queries
+
+int sdAssetGradient(const SDAsset *asset, int level, float px, float py, float *gx, float *gy)
+{
+	if (level < 0 || level >= asset->levels || !asset->gradient[level]) return -1;
+	const SDGrid *g = &asset->grids[level];
+	const SDGridLayout *l = &g->layout;
+	float u = fmaxf(0.0f, fminf((px - l->x) * g->invCell, (float)(l->width - 1)));
+	float v = fmaxf(0.0f, fminf((py - l->y) * g->invCell, (float)(l->height - 1)));
+	int ix = (int)u, iy = (int)v;
+	if (ix > l->width - 2) ix = l->width - 2;
+	if (iy > l->height - 2) iy = l->height - 2;
+	float fx = u - ix, fy = v - iy;
+
+	size_t i = (size_t)iy * g->stride + ix;
+	if (g->tiles) {
+		int tx = ix / SD_GRID_TILE, ty = iy / SD_GRID_TILE;
+		int t = g->tiles[ty * g->tilesX + tx];
+		if (t < 0) {
+			// far from the surface: nothing stored, as sdgGridEval
+			*gx = *gy = 0.0f;
+			return 0;
+		}
+		i = t + (size_t)(iy - ty * SD_GRID_TILE) * g->stride + (ix - tx * SD_GRID_TILE);
+	}
+	const signed char *q = asset->gradient[level] + 2 * i;
+	size_t s = 2 * (size_t)g->stride;
+	float w0 = (1.0f - fx) * (1.0f - fy), w1 = fx * (1.0f - fy), w2 = (1.0f - fx) * fy, w3 = fx * fy;
+	float x = w0 * q[0] + w1 * q[2] + w2 * q[s] + w3 * q[s + 2];
+	float y = w0 * q[1] + w1 * q[3] + w2 * q[s + 1] + w3 * q[s + 3];
+	float len = sqrtf(x * x + y * y);
+	float inv = len > 0.0f ? 1.0f / len : 0.0f;
+	*gx = x * inv;
+	*gy = y * inv;
+	return 0;
+}
+
+int sdAssetScene(const SDAsset *asset, SDScene *scene)
+{
+	const SDAssetHeader *h = asset->header;
+	sdSceneInit(scene);
+	if (!h) return -1;
+	for (int i = 0; i < (int)h->nodes; i++) {
+		const SDAssetNode *an = &asset->nodes[i];
+		int id;
+		if (an->op == kSDNodeShape) {
+			SDShape shape = { (SDShapeType)an->type, { 0 }, an->n, NULL, NULL };
+			memcpy(shape.p, an->p, sizeof(shape.p));
+			if (an->type == kSDPolygon) {
+				shape.vx = asset->vertices + an->vertex;
+				shape.vy = shape.vx + an->n;
+			}
+			id = sdSceneAddShape(scene, &shape);
+		} else {
+			id = sdSceneAddOp(scene, (SDNodeOp)an->op, an->a, an->b, an->k);
+		}
+		if (id < 0) {
+			sdSceneFree(scene);
+			return -1;
+		}
+		// the stored rotation as it was, rather than through an angle
+		SDNode *nd = &scene->nodes[id];
+		nd->tx = an->tx;
+		nd->ty = an->ty;
+		nd->c = an->c;
+		nd->s = an->s;
+	}
+	if (sdSceneCompile(scene, h->root)) {
+		sdSceneFree(scene);
+		return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,120 @@
+#ifndef SDF2D_ASSET_H
+#define SDF2D_ASSET_H
+
+// Baked assets: a scene's distance grids, an optional gradient channel, coarser mip levels and the
+// scene itself in one versioned binary file, laid out so that it is used where it lies. Loading
+// checks the header and points SDGrid views at the file: nothing is copied or baked at boot.
+//
+//	// offline, eg with Examples/Host/Bake
+//	SDAssetOptions options = { { kSDGridInt8, 0, 0, 201, 121, 2.0f, 16.0f, 1 }, 3, 1 };
+//	sdAssetBake(&terrain, &options, &blob, &size);
+//	...
+//	// at run time
+//	SDAsset asset;
+//	sdAssetInit(&asset);
+//	sdAssetMap(&asset, "terrain.sdfa");    // mmap on POSIX; on device sdAssetOpen(&asset, data, size)
+//	float d = sdGridEval(&asset.grids[0], px, py);
+//	sdAssetClose(&asset);
+//
+// The file is little endian with 32-bit fields and every section 16-byte aligned, so the same file
+// works on the host and on ARM. sdAssetOpen needs the blob 4-byte aligned, which malloc and mmap are,
+// and valid until sdAssetClose. Level k samples the level 0 area every cell * 2^k, for queries that
+// can use a coarser answer, eg the first steps of a ray march.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdf2d_grid.h"
+#include "sdf2d_scene.h"
+
+#define SD_ASSET_MAGIC 0x41464453u   // "SDFA" in file order
+#define SD_ASSET_VERSION 1
+#define SD_ASSET_MAX_LEVELS 8
+#define SD_ASSET_ALIGN 16
+
+enum {
+	kSDAssetGradient = 1     // each level has a gradient channel
+};
+
+// On disk. Offsets are from the start of the file; 0 is none.
+typedef struct {
+	int32_t format;           // SDGridFormat
+	int32_t width, height;
+	int32_t narrow;
+	float x, y, cell, range;
+	float scale, bias, error;
+	int32_t tilesX, tilesY, stride;
+	uint32_t tileOffset;      // int32 per tile for narrow bands, see SDGrid.tiles
+	uint32_t dataOffset;
+	uint32_t dataBytes;
+	uint32_t gradientOffset;  // int8 (gx, gy) * 127 per sample, in the order of the samples
+} SDAssetLevel;
+
+typedef struct {
+	int32_t op;               // SDNodeOp
+	int32_t a, b;
+	float k;
+	float tx, ty, c, s;
+	int32_t type;             // SDShapeType of a kSDNodeShape
+	int32_t n;
+	float p[8];
+	uint32_t vertex;          // sdPolygon: first x in the vertex floats, then its n y
+	float bounds[4];          // world bounds of the surface (minx, miny, maxx, maxy), conservative
+} SDAssetNode;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t bytes;           // file size
+	uint32_t flags;
+	uint32_t levels;
+	uint32_t nodes;           // the scene, in sdSceneAdd order
+	int32_t root;
+	uint32_t nodeOffset;
+	uint32_t vertexOffset;
+	uint32_t vertices;        // floats
+	float bounds[4];          // of the root
+	SDAssetLevel level[SD_ASSET_MAX_LEVELS];
+} SDAssetHeader;
+
+typedef struct {
+	SDGridLayout layout;      // level 0
+	int levels;               // 1 .. SD_ASSET_MAX_LEVELS
+	int gradient;             // add the gradient channel
+} SDAssetOptions;
+
+typedef struct {
+	const SDAssetHeader *header;   // NULL when closed
+	size_t size;
+	int levels;
+	SDGrid grids[SD_ASSET_MAX_LEVELS];              // external views (SDGrid.external), see sdf2d_grid.h
+	const signed char *gradient[SD_ASSET_MAX_LEVELS];   // NULL without the channel
+	const SDAssetNode *nodes;
+	const float *vertices;
+	void *map;                // sdAssetMap only
+	size_t mapBytes;
+} SDAsset;
+
+// Bake a compiled scene into a new blob (free it with free). Returns 0, or -1 on bad options, an
+// uncompiled scene or allocation failure. Polygon vertices are copied into the blob.
+int sdAssetBake(const SDScene *scene, const SDAssetOptions *options, void **blob, size_t *size);
+
+void sdAssetInit(SDAsset *asset);
+
+// View a blob in memory, or map a file read-only (POSIX; -1 elsewhere). Both check the magic,
+// version and that every section is aligned and inside the file, and return 0 or -1.
+int sdAssetOpen(SDAsset *asset, const void *blob, size_t size);
+int sdAssetMap(SDAsset *asset, const char *path);
+
+// Unmap, and forget the views
+void sdAssetClose(SDAsset *asset);
+
+// The stored gradient at (px, py), bilinear like sdgGridEval and normalised. Unlike sdgGridEval it
+// is the exact gradient at the samples, so it does not turn with the interpolation inside a cell.
+// Returns 0, or -1 without a gradient channel or a level out of range.
+int sdAssetGradient(const SDAsset *asset, int level, float px, float py, float *gx, float *gy);
+
+// Rebuild and compile the scene, for exact queries; polygons point at the asset's vertices.
+// Returns 0, or -1 on allocation failure.
+int sdAssetScene(const SDAsset *asset, SDScene *scene);
+
+#endif
@@ -0,0 +1,235 @@
+// Bounding volume hierarchy over placed shapes. See sdf2d_broadphase.h.
+
+#include "sdf2d_broadphase.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define SD_BVH_LEAF 4
+#define SD_BVH_STACK 64
+
+void sdBroadphaseInit(SDBroadphase *bp)
+{
+	bp->items = NULL;
+	bp->numItems = bp->capItems = 0;
+	bp->nodes = NULL;
+	bp->numNodes = 0;
+	bp->order = NULL;
+}
+
+void sdBroadphaseFree(SDBroadphase *bp)
+{
+	free(bp->items);
+	free(bp->nodes);
+	free(bp->order);
+	sdBroadphaseInit(bp);
+}
+
+static void sdBroadphaseItemBounds(SDBroadphaseItem *it)
+{
+	sdShapeBounds(&it->shape, &it->bounds);
+	it->bounds.minx += it->x;
+	it->bounds.maxx += it->x;
+	it->bounds.miny += it->y;
+	it->bounds.maxy += it->y;
+}
+
+int sdBroadphaseAdd(SDBroadphase *bp, const SDShape *shape, float x, float y)
+{
+	if (bp->numItems == bp->capItems) {
+		int cap = bp->capItems ? bp->capItems * 2 : 16;
+		SDBroadphaseItem *items = realloc(bp->items, cap * sizeof(SDBroadphaseItem));
+		if (!items) return -1;
+		bp->items = items;
+		bp->capItems = cap;
+	}
+	SDBroadphaseItem *it = &bp->items[bp->numItems];
+	it->shape = *shape;
+	it->x = x;
+	it->y = y;
+	sdBroadphaseItemBounds(it);
+	return bp->numItems++;
+}
+
+void sdBroadphaseMove(SDBroadphase *bp, int id, float x, float y)
+{
+	SDBroadphaseItem *it = &bp->items[id];
+	float dx = x - it->x;
+	float dy = y - it->y;
+	it->x = x;
+	it->y = y;
+	it->bounds.minx += dx;
+	it->bounds.maxx += dx;
+	it->bounds.miny += dy;
+	it->bounds.maxy += dy;
+}
+
+static void sdBoundsUnion(SDBounds *a, const SDBounds *b)
+{
+	a->minx = fminf(a->minx, b->minx);
+	a->miny = fminf(a->miny, b->miny);
+	a->maxx = fmaxf(a->maxx, b->maxx);
+	a->maxy = fmaxf(a->maxy, b->maxy);
+}
+
+static float sdBroadphaseCentre(const SDBroadphase *bp, int id, int axis)
+{
+	const SDBounds *b = &bp->items[id].bounds;
+	// halve first so that unbounded shapes do not overflow to inf
+	return axis ? b->miny * 0.5f + b->maxy * 0.5f : b->minx * 0.5f + b->maxx * 0.5f;
+}
+
+// Partition order[lo..hi) so that the k-th entry is in its sorted position along axis
+static void sdBroadphaseSelect(SDBroadphase *bp, int lo, int hi, int k, int axis)
+{
+	int *o = bp->order;
+	while (hi - lo > 1) {
+		float pivot = sdBroadphaseCentre(bp, o[(lo + hi) / 2], axis);
+		int i = lo, j = hi - 1;
+		while (i <= j) {
+			while (sdBroadphaseCentre(bp, o[i], axis) < pivot) i++;
+			while (sdBroadphaseCentre(bp, o[j], axis) > pivot) j--;
+			if (i <= j) {
+				int t = o[i]; o[i] = o[j]; o[j] = t;
+				i++;
+				j--;
+			}
+		}
+		if (k <= j) hi = j + 1;
+		else if (k >= i) lo = i;
+		else return;
+	}
+}
+
+static int sdBroadphaseBuildNode(SDBroadphase *bp, int first, int count)
+{
+	int id = bp->numNodes++;
+	SDBroadphaseNode *nd = &bp->nodes[id];
+	nd->bounds = bp->items[bp->order[first]].bounds;
+	for (int i = 1; i < count; i++)
+		sdBoundsUnion(&nd->bounds, &bp->items[bp->order[first + i]].bounds);
+	nd->first = first;
+	nd->right = -1;
+	if (count <= SD_BVH_LEAF) {
+		nd->count = count;
+		return id;
+	}
+	nd->count = 0;
+	int axis = (nd->bounds.maxy - nd->bounds.miny) > (nd->bounds.maxx - nd->bounds.minx);
+	int half = count / 2;
+	sdBroadphaseSelect(bp, first, first + count, first + half, axis);
+	sdBroadphaseBuildNode(bp, first, half);
+	int right = sdBroadphaseBuildNode(bp, first + half, count - half);
+	bp->nodes[id].right = right;
+	return id;
+}
+
+int sdBroadphaseBuild(SDBroadphase *bp)
+{
+	free(bp->nodes);
+	free(bp->order);
+	bp->nodes = NULL;
+	bp->order = NULL;
+	bp->numNodes = 0;
+	if (bp->numItems == 0) return 0;
+	bp->nodes = malloc(2 * bp->numItems * sizeof(SDBroadphaseNode));
+	bp->order = malloc(bp->numItems * sizeof(int));
+	if (!bp->nodes || !bp->order) {
+		sdBroadphaseFree(bp);
+		return -1;
+	}
+	for (int i = 0; i < bp->numItems; i++) bp->order[i] = i;
+	sdBroadphaseBuildNode(bp, 0, bp->numItems);
+	return 0;
+}
+
+void sdBroadphaseRefit(SDBroadphase *bp)
+{
+	// children always follow their parent, so one reverse pass updates bottom-up
+	for (int i = bp->numNodes - 1; i >= 0; i--) {
+		SDBroadphaseNode *nd = &bp->nodes[i];
+		if (nd->count) {
+			nd->bounds = bp->items[bp->order[nd->first]].bounds;
+			for (int j = 1; j < nd->count; j++)
+				sdBoundsUnion(&nd->bounds, &bp->items[bp->order[nd->first + j]].bounds);
+		} else {
+			nd->bounds = bp->nodes[i + 1].bounds;
+			sdBoundsUnion(&nd->bounds, &bp->nodes[nd->right].bounds);
+		}
+	}
+}
+
+// Lower bound of the signed distance to any shape inside b. Outside b this is the L infinity
+// distance to b, which also holds for the L infinity SDFs. Inside b a shape can be no deeper
+// than the distance to the nearest side of b.
+static float sdBoundsLowerBound(const SDBounds *b, float px, float py)
+{
+	float dx = fmaxf(b->minx - px, px - b->maxx);
+	float dy = fmaxf(b->miny - py, py - b->maxy);
+	return fmaxf(dx, dy);
+}
+
+int sdBroadphaseQueryRadius(const SDBroadphase *bp, float px, float py, float r, int *out, float *dist, int maxOut)
+{
+	int stack[SD_BVH_STACK];
+	int sp = 0;
+	int found = 0;
+	if (bp->numNodes == 0) return 0;
+	stack[sp++] = 0;
+	while (sp) {
+		const SDBroadphaseNode *nd = &bp->nodes[stack[--sp]];
+		if (sdBoundsLowerBound(&nd->bounds, px, py) > r) continue;
+		if (nd->count == 0) {
+			stack[sp++] = nd->right;
+			stack[sp++] = (int)(nd - bp->nodes) + 1;
+			continue;
+		}
+		for (int i = 0; i < nd->count; i++) {
+			int id = bp->order[nd->first + i];
+			const SDBroadphaseItem *it = &bp->items[id];
+			if (sdBoundsLowerBound(&it->bounds, px, py) > r) continue;
+			float d = sdShapeEval(&it->shape, px - it->x, py - it->y);
+			if (d > r) continue;
+			if (found < maxOut) {
+				out[found] = id;
+				if (dist) dist[found] = d;
+			}
+			found++;
+		}
+	}
+	return found;
+}
+
+int sdBroadphaseClosest(const SDBroadphase *bp, float px, float py, float *dist)
+{
+	int stack[SD_BVH_STACK];
+	int sp = 0;
+	int best = -1;
+	float bestd = SD_BOUNDS_HUGE;
+	if (bp->numNodes == 0) return -1;
+	stack[sp++] = 0;
+	while (sp) {
+		const SDBroadphaseNode *nd = &bp->nodes[stack[--sp]];
+		if (sdBoundsLowerBound(&nd->bounds, px, py) >= bestd) continue;
+		if (nd->count == 0) {
+			// visit the nearer child first so the far one is more likely to be pruned
+			int left = (int)(nd - bp->nodes) + 1;
+			float dl = sdBoundsLowerBound(&bp->nodes[left].bounds, px, py);
+			float dr = sdBoundsLowerBound(&bp->nodes[nd->right].bounds, px, py);
+			stack[sp++] = dl < dr ? nd->right : left;
+			stack[sp++] = dl < dr ? left : nd->right;
+			continue;
+		}
+		for (int i = 0; i < nd->count; i++) {
+			int id = bp->order[nd->first + i];
+			const SDBroadphaseItem *it = &bp->items[id];
+			if (sdBoundsLowerBound(&it->bounds, px, py) >= bestd) continue;
+			float d = sdShapeEval(&it->shape, px - it->x, py - it->y);
+			if (d < bestd) {
+				bestd = d;
+				best = id;
+			}
+		}
+	}
+	if (dist) *dist = bestd;
+	return best;
+}
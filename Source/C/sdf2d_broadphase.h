@@ -0,0 +1,63 @@
+#ifndef SDF2D_BROADPHASE_H
+#define SDF2D_BROADPHASE_H
+
+// Broadphase: a bounding volume hierarchy over placed shapes, so scene-wide queries only evaluate
+// the SDFs of shapes whose bounds are close to the query point.
+//
+//	SDBroadphase bp;
+//	sdBroadphaseInit(&bp);
+//	int id = sdBroadphaseAdd(&bp, &(SDShape){ kSDCircle, { 15 } }, 230, 180);
+//	...
+//	sdBroadphaseBuild(&bp);
+//	int hits[16];
+//	int n = sdBroadphaseQueryRadius(&bp, px, py, ballRadius, hits, 16);
+//
+// When shapes move, call sdBroadphaseMove for each one and then sdBroadphaseRefit, which updates
+// the node bounds in O(n) without changing the tree. Rebuild when shapes have moved far enough
+// that queries slow down.
+
+#include "sdf2d_shape.h"
+
+typedef struct {
+	SDShape shape;
+	float x, y;          // position of the shape origin: the SDF is evaluated at (px - x, py - y)
+	SDBounds bounds;     // world bounds
+} SDBroadphaseItem;
+
+typedef struct {
+	SDBounds bounds;
+	int right;           // inner node: index of the right child (the left child follows the node)
+	int first;           // leaf: first entry in order[]
+	int count;           // leaf: number of items, 0 for inner nodes
+} SDBroadphaseNode;
+
+typedef struct {
+	SDBroadphaseItem *items;
+	int numItems;
+	int capItems;
+	SDBroadphaseNode *nodes;
+	int numNodes;
+	int *order;          // item ids in leaf order
+} SDBroadphase;
+
+void sdBroadphaseInit(SDBroadphase *bp);
+void sdBroadphaseFree(SDBroadphase *bp);
+
+// Returns the item id, or -1 on allocation failure. Call sdBroadphaseBuild after adding items.
+int sdBroadphaseAdd(SDBroadphase *bp, const SDShape *shape, float x, float y);
+
+// Move an item; its bounds are updated at once, the tree by the next sdBroadphaseRefit.
+void sdBroadphaseMove(SDBroadphase *bp, int id, float x, float y);
+
+// Build the tree (median split on the longest axis). Returns 0, or -1 on allocation failure.
+int sdBroadphaseBuild(SDBroadphase *bp);
+void sdBroadphaseRefit(SDBroadphase *bp);
+
+// Ids of the shapes with distance <= r from (px, py), up to maxOut of them, and their distances
+// if dist is not NULL. Returns the number of shapes found, which may exceed maxOut.
+int sdBroadphaseQueryRadius(const SDBroadphase *bp, float px, float py, float r, int *out, float *dist, int maxOut);
+
+// Id of the shape with the smallest signed distance from (px, py), or -1 if empty.
+int sdBroadphaseClosest(const SDBroadphase *bp, float px, float py, float *dist);
+
+#endif
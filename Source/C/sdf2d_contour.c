@@ -0,0 +1,412 @@
+// Contours by marching squares along the surface. See sdf2d_contour.h.
+
+#include "sdf2d_contour.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SD_CONTOUR_BLOCK (SD_TILE_LEAF * SD_TILE_LEAF)
+
+// Cell corners 0..3 clockwise from the first sample (i, j), and edge e from corner e to corner e + 1:
+// 0 top, 1 right, 2 bottom, 3 left. A segment enters through one edge and leaves through another
+// with the inside corners on its right.
+static const signed char sdContourCornerX[4] = { 0, 1, 1, 0 };
+static const signed char sdContourCornerY[4] = { 0, 0, 1, 1 };
+static const signed char sdContourEdgeX[4] = { 0, 1, 0, -1 };
+static const signed char sdContourEdgeY[4] = { -1, 0, 1, 0 };
+
+// Per case (bit k set when corner k is inside), up to two segments as from, to. Saddles 5 and 10
+// list their corners apart; joined through the inside they are sdContourSaddle.
+static const signed char sdContourCases[16][4] = {
+	{ -1, -1, -1, -1 }, { 0, 3, -1, -1 }, { 1, 0, -1, -1 }, { 1, 3, -1, -1 },
+	{ 2, 1, -1, -1 }, { 0, 3, 2, 1 }, { 2, 0, -1, -1 }, { 2, 3, -1, -1 },
+	{ 3, 2, -1, -1 }, { 0, 2, -1, -1 }, { 1, 0, 3, 2 }, { 1, 2, -1, -1 },
+	{ 3, 1, -1, -1 }, { 0, 1, -1, -1 }, { 3, 0, -1, -1 }, { -1, -1, -1, -1 },
+};
+static const signed char sdContourSaddle[2][4] = { { 0, 1, 2, 3 }, { 3, 0, 1, 2 } };
+
+typedef struct {
+	SDContours *lines;
+	const SDContourLayout *layout;
+	SDTileSampler sample;
+	void *ctx;
+	int blocksX, blocksY;
+	long samples, cells;
+	int failed;
+} SDContourTracer;
+
+void sdContoursInit(SDContours *lines)
+{
+	memset(lines, 0, sizeof(SDContours));
+}
+
+void sdContoursFree(SDContours *lines)
+{
+	free(lines->x);
+	free(lines->y);
+	free(lines->start);
+	free(lines->closed);
+	free(lines->blocks);
+	free(lines->d);
+	free(lines->visited);
+	free(lines->stack);
+	sdContoursInit(lines);
+}
+
+// A new block in the pool for block b, or -1 on allocation failure
+static int sdContourAddBlock(SDContourTracer *t, int b)
+{
+	SDContours *c = t->lines;
+	if (c->pool == c->poolCap) {
+		int cap = c->poolCap ? c->poolCap * 2 : 64;
+		float *d = realloc(c->d, (size_t)cap * SD_CONTOUR_BLOCK * sizeof(float));
+		if (d) c->d = d;
+		unsigned char *visited = realloc(c->visited, (size_t)cap * SD_CONTOUR_BLOCK);
+		if (visited) c->visited = visited;
+		if (!d || !visited) return -1;
+		c->poolCap = cap;
+	}
+	memset(c->visited + (size_t)c->pool * SD_CONTOUR_BLOCK, 0, SD_CONTOUR_BLOCK);
+	c->blocks[b] = c->pool;
+	return c->pool++;
+}
+
+// Sample a whole block the walk did not reach
+static int sdContourSampleBlock(SDContourTracer *t, int bx, int by)
+{
+	const SDContourLayout *l = t->layout;
+	float px[SD_CONTOUR_BLOCK], py[SD_CONTOUR_BLOCK], d[SD_CONTOUR_BLOCK];
+	int x0 = bx * SD_TILE_LEAF, y0 = by * SD_TILE_LEAF;
+	int w = l->width - x0 < SD_TILE_LEAF ? l->width - x0 : SD_TILE_LEAF;
+	int h = l->height - y0 < SD_TILE_LEAF ? l->height - y0 : SD_TILE_LEAF;
+	int p = sdContourAddBlock(t, by * t->blocksX + bx);
+	if (p < 0) return -1;
+	for (int j = 0; j < h; j++) {
+		for (int i = 0; i < w; i++) {
+			px[j * w + i] = l->x + (x0 + i) * l->cell;
+			py[j * w + i] = l->y + (y0 + j) * l->cell;
+		}
+	}
+	t->sample(t->ctx, px, py, d, (size_t)w * h);
+	t->samples += w * h;
+	float *out = t->lines->d + (size_t)p * SD_CONTOUR_BLOCK;
+	for (int j = 0; j < h; j++) memcpy(out + j * SD_TILE_LEAF, d + j * w, w * sizeof(float));
+	return p;
+}
+
+static void sdContourVisit(void *ctx, const SDTile *tile, const float *d)
+{
+	SDContourTracer *t = ctx;
+	if (!d) return;
+	int p = sdContourAddBlock(t, tile->y / SD_TILE_LEAF * t->blocksX + tile->x / SD_TILE_LEAF);
+	if (p < 0) {
+		t->failed = 1;
+		return;
+	}
+	float *out = t->lines->d + (size_t)p * SD_CONTOUR_BLOCK;
+	for (int j = 0; j < tile->h; j++) memcpy(out + j * SD_TILE_LEAF, d + j * tile->w, tile->w * sizeof(float));
+}
+
+// Index of sample (i, j) in the pool, sampling its block first if needed
+static inline int sdContourIndex(SDContourTracer *t, int i, int j)
+{
+	int bx = i / SD_TILE_LEAF, by = j / SD_TILE_LEAF;
+	int p = t->lines->blocks[by * t->blocksX + bx];
+	if (p < 0 && (p = sdContourSampleBlock(t, bx, by)) < 0) {
+		t->failed = 1;
+		return -1;
+	}
+	return p * SD_CONTOUR_BLOCK + (j - by * SD_TILE_LEAF) * SD_TILE_LEAF + (i - bx * SD_TILE_LEAF);
+}
+
+static inline float sdContourSample(SDContourTracer *t, int i, int j)
+{
+	int k = sdContourIndex(t, i, j);
+	return k < 0 ? t->layout->level + 1.0f : t->lines->d[k];
+}
+
+// The segments of cell (i, j), as from, to pairs ending in -1
+static const signed char *sdContourCell(SDContourTracer *t, int i, int j)
+{
+	float d[4];
+	int m = 0;
+	for (int k = 0; k < 4; k++) {
+		d[k] = sdContourSample(t, i + sdContourCornerX[k], j + sdContourCornerY[k]);
+		m |= (d[k] <= t->layout->level) << k;
+	}
+	if ((m == 5 || m == 10) && 0.25f * (d[0] + d[1] + d[2] + d[3]) <= t->layout->level) return sdContourSaddle[m == 10];
+	return sdContourCases[m];
+}
+
+// The segment of cell (i, j) that enters (side 0) or leaves (side 1) through edge e, or -1
+static int sdContourFind(SDContourTracer *t, int i, int j, int e, int side)
+{
+	const signed char *s = sdContourCell(t, i, j);
+	if (s[side] == e) return 0;
+	if (s[2] >= 0 && s[2 + side] == e) return 1;
+	return -1;
+}
+
+// Whether the corners of cell (i, j) are all sampled: cells with a corner outside the blocks the
+// walk sampled are at least two cells from the contour, and not worth sampling to seed from
+static inline int sdContourSampled(const SDContourTracer *t, int i, int j)
+{
+	const int *b = t->lines->blocks;
+	int bx = i / SD_TILE_LEAF, by = j / SD_TILE_LEAF;
+	int nx = (i + 1) / SD_TILE_LEAF, ny = (j + 1) / SD_TILE_LEAF;
+	return b[by * t->blocksX + nx] >= 0 && b[ny * t->blocksX + bx] >= 0 && b[ny * t->blocksX + nx] >= 0;
+}
+
+static inline int sdContourInside(const SDContourTracer *t, int i, int j)
+{
+	return i >= 0 && j >= 0 && i < t->layout->width - 1 && j < t->layout->height - 1;
+}
+
+static int sdContourPush(SDContours *c, float x, float y)
+{
+	if (c->vertices == c->vertexCap) {
+		int cap = c->vertexCap ? c->vertexCap * 2 : 256;
+		float *nx = realloc(c->x, cap * sizeof(float));
+		if (nx) c->x = nx;
+		float *ny = realloc(c->y, cap * sizeof(float));
+		if (ny) c->y = ny;
+		if (!nx || !ny) return -1;
+		c->vertexCap = cap;
+	}
+	c->x[c->vertices] = x;
+	c->y[c->vertices] = y;
+	c->vertices++;
+	return 0;
+}
+
+// The vertex on edge e of cell (i, j), interpolated from the lower sample so that both cells of the
+// edge give the same point
+static int sdContourVertex(SDContourTracer *t, int i, int j, int e)
+{
+	const SDContourLayout *l = t->layout;
+	int ia = i + sdContourCornerX[e], ja = j + sdContourCornerY[e];
+	int ib = i + sdContourCornerX[(e + 1) & 3], jb = j + sdContourCornerY[(e + 1) & 3];
+	if (ib < ia || jb < ja) {
+		int k = ia; ia = ib; ib = k;
+		k = ja; ja = jb; jb = k;
+	}
+	float da = sdContourSample(t, ia, ja), db = sdContourSample(t, ib, jb);
+	float f = (l->level - da) / (db - da);
+	return sdContourPush(t->lines, l->x + (ia + f * (ib - ia)) * l->cell, l->y + (ja + f * (jb - ja)) * l->cell);
+}
+
+// Douglas-Peucker over vertices first .. last, in place; returns the new vertex count. Kept vertices
+// come out in order, each written before any range still to do reads it.
+static int sdContourSimplify(SDContours *c, int first, int last, int split, float tolerance)
+{
+	int n = last - first + 1;
+	if (c->stackCap < 2 * n) {
+		int *stack = realloc(c->stack, 2 * n * sizeof(int));
+		if (!stack) return n;
+		c->stack = stack;
+		c->stackCap = 2 * n;
+	}
+	float *x = c->x, *y = c->y;
+	int top = 0, out = first;
+	c->stack[top++] = split;
+	c->stack[top++] = last;
+	if (split > first) {
+		c->stack[top++] = first;
+		c->stack[top++] = split;
+	}
+	while (top) {
+		int b = c->stack[--top], a = c->stack[--top];
+		float ex = x[b] - x[a], ey = y[b] - y[a];
+		float len = sqrtf(ex * ex + ey * ey);
+		float best = tolerance;
+		int k = -1;
+		for (int v = a + 1; v < b; v++) {
+			float dx = x[v] - x[a], dy = y[v] - y[a];
+			float dist = len > 0.0f ? fabsf(dx * ey - dy * ex) / len : sqrtf(dx * dx + dy * dy);
+			if (dist > best) {
+				best = dist;
+				k = v;
+			}
+		}
+		if (k >= 0) {
+			c->stack[top++] = k;
+			c->stack[top++] = b;
+			c->stack[top++] = a;
+			c->stack[top++] = k;
+			continue;
+		}
+		x[out] = x[a];
+		y[out] = y[a];
+		out++;
+	}
+	x[out] = x[last];
+	y[out] = y[last];
+	return out + 1 - first;
+}
+
+// Follow the contour through segment s of cell (i, j) and append it as one polyline
+static int sdContourFollow(SDContourTracer *t, int i, int j, int s)
+{
+	SDContours *c = t->lines;
+	const int cells = (t->layout->width - 1) * (t->layout->height - 1);
+	int closed = 0;
+
+	// back up to where an open line enters the lattice
+	int si = i, sj = j, ss = s;
+	for (int n = 0; n < cells; n++) {
+		int e = sdContourCell(t, si, sj)[2 * ss];
+		int ni = si + sdContourEdgeX[e], nj = sj + sdContourEdgeY[e];
+		if (!sdContourInside(t, ni, nj)) break;
+		int ns = sdContourFind(t, ni, nj, (e + 2) & 3, 1);
+		if (ns < 0) break;
+		if (ni == i && nj == j && ns == s) {
+			closed = 1;
+			break;
+		}
+		si = ni;
+		sj = nj;
+		ss = ns;
+	}
+
+	if (c->count + 2 > c->lineCap) {
+		int cap = c->lineCap * 2 > c->count + 2 ? c->lineCap * 2 : c->count + 16;
+		int *start = realloc(c->start, cap * sizeof(int));
+		if (start) c->start = start;
+		unsigned char *loop = realloc(c->closed, cap);
+		if (loop) c->closed = loop;
+		if (!start || !loop) return -1;
+		c->lineCap = cap;
+	}
+	int first = c->vertices;
+	if (sdContourVertex(t, si, sj, sdContourCell(t, si, sj)[2 * ss])) return -1;
+	for (;;) {
+		const signed char *seg = sdContourCell(t, si, sj);
+		int e = seg[2 * ss + 1];
+		int k = sdContourIndex(t, si, sj);
+		if (k < 0) return -1;
+		c->visited[k] |= 1 << ss;
+		t->cells++;
+		if (sdContourVertex(t, si, sj, e)) return -1;
+		int ni = si + sdContourEdgeX[e], nj = sj + sdContourEdgeY[e];
+		if (!sdContourInside(t, ni, nj)) break;
+		int ns = sdContourFind(t, ni, nj, (e + 2) & 3, 0);
+		if (ns < 0) break;
+		if ((k = sdContourIndex(t, ni, nj)) < 0) return -1;
+		if (c->visited[k] & (1 << ns)) {
+			c->vertices--;   // back at the first vertex
+			break;
+		}
+		si = ni;
+		sj = nj;
+		ss = ns;
+	}
+
+	int n = c->vertices - first;
+	if (t->layout->tolerance > 0.0f && n > 2) {
+		if (closed) {
+			// split the loop at the vertex furthest from the first, then simplify both halves
+			int far = first;
+			float best = -1.0f;
+			for (int v = first + 1; v < c->vertices; v++) {
+				float dx = c->x[v] - c->x[first], dy = c->y[v] - c->y[first];
+				if (dx * dx + dy * dy > best) {
+					best = dx * dx + dy * dy;
+					far = v;
+				}
+			}
+			if (sdContourPush(c, c->x[first], c->y[first])) return -1;
+			n = sdContourSimplify(c, first, c->vertices - 1, far, t->layout->tolerance) - 1;
+		} else {
+			n = sdContourSimplify(c, first, c->vertices - 1, first, t->layout->tolerance);
+		}
+		c->vertices = first + n;
+	}
+	c->closed[c->count] = (unsigned char)closed;
+	c->start[++c->count] = c->vertices;
+	return 0;
+}
+
+static int sdContourRun(SDContours *lines, const SDContourLayout *l, SDTileSampler sample, void *ctx,
+	SDContourStats *stats, int dense)
+{
+	if (!lines || !l || !sample || l->width < 2 || l->height < 2 || !(l->cell > 0.0f) || !(l->tolerance >= 0.0f))
+		return -1;
+	SDContourTracer t = { lines, l, sample, ctx };
+	t.blocksX = (l->width + SD_TILE_LEAF - 1) / SD_TILE_LEAF;
+	t.blocksY = (l->height + SD_TILE_LEAF - 1) / SD_TILE_LEAF;
+	int blocks = t.blocksX * t.blocksY;
+	if (lines->blockCap < blocks) {
+		int *b = realloc(lines->blocks, blocks * sizeof(int));
+		if (!b) return -1;
+		lines->blocks = b;
+		lines->blockCap = blocks;
+	}
+	for (int b = 0; b < blocks; b++) lines->blocks[b] = -1;
+	lines->pool = 0;
+	lines->vertices = 0;
+	lines->count = 0;
+	if (!lines->start) {
+		lines->start = malloc(16 * sizeof(int));
+		lines->closed = malloc(16);
+		if (!lines->start || !lines->closed) return -1;
+		lines->lineCap = 16;
+	}
+	lines->start[0] = 0;
+
+	if (dense) {
+		for (int by = 0; by < t.blocksY && !t.failed; by++)
+			for (int bx = 0; bx < t.blocksX && !t.failed; bx++)
+				if (sdContourSampleBlock(&t, bx, by) < 0) t.failed = 1;
+	} else {
+		// every corner of a crossed cell is within two cells of the contour
+		SDTileLayout walk = { l->x, l->y, l->width, l->height, l->cell, l->level - 2.0f * l->cell, l->level + 2.0f * l->cell };
+		SDTileStats tiles = { 0 };
+		sdTileWalk(&walk, sample, ctx, sdContourVisit, &t, &tiles);
+		t.samples += tiles.samples;
+	}
+
+	// seed in block order, so that the polylines do not depend on which blocks were sampled
+	for (int b = 0; b < blocks && !t.failed; b++) {
+		if (lines->blocks[b] < 0) continue;
+		int x0 = b % t.blocksX * SD_TILE_LEAF, y0 = b / t.blocksX * SD_TILE_LEAF;
+		for (int j = y0; j < y0 + SD_TILE_LEAF && j < l->height - 1 && !t.failed; j++) {
+			for (int i = x0; i < x0 + SD_TILE_LEAF && i < l->width - 1 && !t.failed; i++) {
+				if (!sdContourSampled(&t, i, j)) continue;
+				const signed char *seg = sdContourCell(&t, i, j);
+				for (int s = 0; s < 2 && seg[2 * s] >= 0; s++) {
+					int k = sdContourIndex(&t, i, j);
+					if (k >= 0 && !(lines->visited[k] & (1 << s)) && sdContourFollow(&t, i, j, s)) t.failed = 1;
+				}
+			}
+		}
+	}
+	if (stats) {
+		stats->samples += t.samples;
+		stats->cells += t.cells;
+	}
+	return t.failed ? -1 : 0;
+}
+
+int sdContourTrace(SDContours *lines, const SDContourLayout *layout, SDTileSampler sample, void *ctx,
+	SDContourStats *stats)
+{
+	return sdContourRun(lines, layout, sample, ctx, stats, 0);
+}
+
+int sdContourTraceDense(SDContours *lines, const SDContourLayout *layout, SDTileSampler sample, void *ctx,
+	SDContourStats *stats)
+{
+	return sdContourRun(lines, layout, sample, ctx, stats, 1);
+}
+
+int sdContourShape(SDContours *lines, const SDContourLayout *layout, const SDShape *shape, float ox, float oy,
+	SDContourStats *stats)
+{
+	SDTileShape placed = { shape, ox, oy };
+	return sdContourRun(lines, layout, sdTileSampleShape, &placed, stats, 0);
+}
+
+int sdContourScene(SDContours *lines, const SDContourLayout *layout, const SDScene *scene, SDContourStats *stats)
+{
+	return sdContourRun(lines, layout, sdTileSampleScene, (void *)scene, stats, 0);
+}
@@ -0,0 +1,80 @@
+#ifndef SDF2D_CONTOUR_H
+#define SDF2D_CONTOUR_H
+
+// Contours: the surface of any shape or scene as connected polylines with subpixel vertices, to draw
+// outlines with drawLine or fillPolygon, or to build playdate.geometry polygons and collide rects,
+// instead of an outline pass over every pixel or a hand-written draw function per shape.
+//
+// Marching squares over a lattice of samples, but only over the cells the surface crosses: a tile
+// walk (sdf2d_tiles.h) evaluates the leaves within two cells of the surface, and each contour is
+// then followed from cell to cell. Cells away from the surface are never sampled or scanned.
+//
+//	SDContourLayout layout = { 0, 0, 401, 241, 1.0f, 0.0f, 0.25f };
+//	SDContours lines;
+//	sdContoursInit(&lines);
+//	sdContourScene(&lines, &layout, &scene, NULL);
+//	for (int i = 0; i < lines.count; i++)
+//		for (int v = lines.start[i]; v < lines.start[i + 1] - 1; v++)
+//			pd->graphics->drawLine(lines.x[v], lines.y[v], lines.x[v + 1], lines.y[v + 1], 1, kColorBlack);
+//	sdContoursFree(&lines);
+//
+// Polylines keep the inside on their right, so on screen (y down) loops run clockwise around solids
+// and counter-clockwise around holes. A loop's last vertex joins its first and is not repeated.
+// Contours that leave the lattice are cut there into open polylines. Saddle cells are joined
+// through the inside when the mean of their corners is.
+
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+#include "sdf2d_tiles.h"
+
+typedef struct {
+	float x, y;          // world position of sample (0, 0)
+	int width, height;   // samples per row and column, at least 2
+	float cell;          // sample spacing in world units
+	float level;         // distance of the contour: 0 for the surface, r for an outline r outside it
+	float tolerance;     // drop vertices closer than this to the simplified line (Douglas-Peucker), 0 keeps all
+} SDContourLayout;
+
+typedef struct {
+	float *x, *y;        // vertices of every polyline, back to back
+	int vertices;
+	int *start;          // polyline i is vertices start[i] .. start[i + 1] - 1
+	unsigned char *closed;   // 1 if polyline i is a loop
+	int count;           // polylines
+	int vertexCap, lineCap;
+
+	// sample cache, kept between calls: SD_TILE_LEAF square blocks of samples where the walk went
+	int *blocks;         // per block, its index in the pool or -1
+	int blockCap;
+	float *d;            // pool: SD_TILE_LEAF * SD_TILE_LEAF distances per block
+	unsigned char *visited;  // pool: per cell with its first sample in the block, segments traced
+	int pool, poolCap;
+	int *stack;          // simplification
+	int stackCap;
+} SDContours;
+
+typedef struct {
+	long samples;        // SDF evaluations, including tile centers
+	long cells;          // cells the contours cross
+} SDContourStats;
+
+void sdContoursInit(SDContours *lines);
+void sdContoursFree(SDContours *lines);
+
+// Trace the contours of the sampler (see SDTileSampler), replacing what lines held. The sampler must
+// not change faster than the distance moved, as for sdTileWalk. stats (may be NULL) is added to.
+// Returns 0, or -1 on a bad layout or allocation failure.
+int sdContourTrace(SDContours *lines, const SDContourLayout *layout, SDTileSampler sample, void *ctx,
+	SDContourStats *stats);
+
+// The same polylines by full-grid marching squares: samples every point and scans every cell. For
+// comparison, and for fields whose contours fill the lattice.
+int sdContourTraceDense(SDContours *lines, const SDContourLayout *layout, SDTileSampler sample, void *ctx,
+	SDContourStats *stats);
+
+// sdContourTrace of a shape placed with its origin at (ox, oy), or of a compiled scene
+int sdContourShape(SDContours *lines, const SDContourLayout *layout, const SDShape *shape, float ox, float oy,
+	SDContourStats *stats);
+int sdContourScene(SDContours *lines, const SDContourLayout *layout, const SDScene *scene, SDContourStats *stats);
+
+#endif
@@ -0,0 +1,122 @@
+// Dirty regions of moving shapes. See sdf2d_dirty.h.
+
+#include "sdf2d_dirty.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+void sdDirtyInit(SDDirty *dirty)
+{
+	memset(dirty, 0, sizeof(SDDirty));
+}
+
+void sdDirtyFree(SDDirty *dirty)
+{
+	free(dirty->rects);
+	sdDirtyInit(dirty);
+}
+
+void sdDirtyClear(SDDirty *dirty)
+{
+	dirty->count = 0;
+}
+
+int sdDirtyAddRect(SDDirty *dirty, const SDBounds *rect)
+{
+	if (!(rect->minx <= rect->maxx && rect->miny <= rect->maxy)) return 0;
+	SDBounds r = *rect;
+	// a merged rect is larger, and may reach rects it did not before: scan again until none overlap
+	for (int i = 0; i < dirty->count;) {
+		const SDBounds *e = &dirty->rects[i];
+		if (r.minx > e->maxx || e->minx > r.maxx || r.miny > e->maxy || e->miny > r.maxy) {
+			i++;
+			continue;
+		}
+		r.minx = fminf(r.minx, e->minx);
+		r.miny = fminf(r.miny, e->miny);
+		r.maxx = fmaxf(r.maxx, e->maxx);
+		r.maxy = fmaxf(r.maxy, e->maxy);
+		dirty->rects[i] = dirty->rects[--dirty->count];
+		i = 0;
+	}
+	if (dirty->count == dirty->cap) {
+		int cap = dirty->cap ? dirty->cap * 2 : 16;
+		SDBounds *rects = realloc(dirty->rects, cap * sizeof(SDBounds));
+		if (!rects) return -1;
+		dirty->rects = rects;
+		dirty->cap = cap;
+	}
+	dirty->rects[dirty->count++] = r;
+	return 0;
+}
+
+int sdDirtyAddShape(SDDirty *dirty, const SDShape *shape, float x, float y, float angle, float margin)
+{
+	SDBounds b;
+	sdShapeBounds(shape, &b);
+	// the rotated box around the rotated center of the local bounds
+	float c = cosf(angle), s = sinf(angle);
+	float cx = 0.5f * (b.minx + b.maxx), cy = 0.5f * (b.miny + b.maxy);
+	float hx = 0.5f * (b.maxx - b.minx), hy = 0.5f * (b.maxy - b.miny);
+	float wx = x + c * cx - s * cy, wy = y + s * cx + c * cy;
+	float ex = fabsf(c) * hx + fabsf(s) * hy + margin;
+	float ey = fabsf(s) * hx + fabsf(c) * hy + margin;
+	SDBounds r = { wx - ex, wy - ey, wx + ex, wy + ey };
+	return sdDirtyAddRect(dirty, &r);
+}
+
+int sdDirtyAddMove(SDDirty *dirty, const SDShape *shape, float x0, float y0, float x1, float y1, float angle, float margin)
+{
+	if (sdDirtyAddShape(dirty, shape, x0, y0, angle, margin) < 0) return -1;
+	return sdDirtyAddShape(dirty, shape, x1, y1, angle, margin);
+}
+
+// v rounded down or up, clamped to lo .. hi before the conversion: bounds may be +/-SD_BOUNDS_HUGE
+static int sdDirtyFloor(float v, int lo, int hi)
+{
+	return (int)floorf(fmaxf((float)lo, fminf(v, (float)hi)));
+}
+
+static int sdDirtyCeil(float v, int lo, int hi)
+{
+	return (int)ceilf(fmaxf((float)lo, fminf(v, (float)hi)));
+}
+
+int sdDirtyUpdateGrid(const SDDirty *dirty, SDGrid *grid, SDGridSampler sample, void *ctx, SDDirtyStats *stats)
+{
+	if (!dirty || !grid || !sample) return -1;
+	const SDGridLayout *l = &grid->layout;
+	for (int i = 0; i < dirty->count; i++) {
+		const SDBounds *r = &dirty->rects[i];
+		// rounded outwards: samples on the edge of a rect are re-sampled rather than missed
+		int x0 = sdDirtyFloor((r->minx - l->x) * grid->invCell, -1, l->width);
+		int y0 = sdDirtyFloor((r->miny - l->y) * grid->invCell, -1, l->height);
+		int x1 = sdDirtyCeil((r->maxx - l->x) * grid->invCell, -1, l->width);
+		int y1 = sdDirtyCeil((r->maxy - l->y) * grid->invCell, -1, l->height);
+		long n = sdGridResample(grid, x0, y0, x1 - x0 + 1, y1 - y0 + 1, sample, ctx);
+		if (n < 0) return -1;
+		if (stats && n > 0) {
+			stats->rects++;
+			stats->cells += n;
+		}
+	}
+	return 0;
+}
+
+int sdDirtyUpdateBitmap(const SDDirty *dirty, const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style,
+	SDDirtyStats *stats)
+{
+	if (!dirty || !bm || !scene || !style || style->mode == kSDRasterContour) return -1;
+	for (int i = 0; i < dirty->count; i++) {
+		const SDBounds *r = &dirty->rects[i];
+		int x0 = sdDirtyFloor(r->minx, 0, bm->width), y0 = sdDirtyFloor(r->miny, 0, bm->height);
+		int x1 = sdDirtyCeil(r->maxx, -1, bm->width - 1), y1 = sdDirtyCeil(r->maxy, -1, bm->height - 1);
+		if (x0 > x1 || y0 > y1) continue;
+		if (sdRasterSceneRect(bm, scene, style, x0, y0, x1 - x0 + 1, y1 - y0 + 1) < 0) return -1;
+		if (stats) {
+			stats->rects++;
+			stats->cells += (long)(x1 - x0 + 1) * (y1 - y0 + 1);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef SDF2D_DIRTY_H
+#define SDF2D_DIRTY_H
+
+// Dirty regions: when a shape of a scene moves, the field only changes near where it was and where
+// it is now. An SDDirty collects those places as world rects, merging rects that overlap, and then
+// re-evaluates only the grid samples (sdf2d_grid.h) or bitmap pixels (sdf2d_raster.h) inside them
+// instead of rebaking or redrawing everything.
+//
+//	SDDirty dirty;
+//	sdDirtyInit(&dirty);
+//	...
+//	// every frame, for each sprite that moved
+//	sdDirtyAddMove(&dirty, &ellipse, x, y, nx, ny, 0, grid.layout.range + k);
+//	sdSceneSetTransform(&scene, node, nx, ny, 0);
+//	...
+//	sdSceneCompile(&scene, root);
+//	sdDirtyUpdateGrid(&dirty, &grid, sdTileSampleScene, &scene, &stats);
+//	sdDirtyClear(&dirty);
+//
+// The margin grows the bounds of a shape to everything its move can change. Distances more than
+// range outside the bounds clamp to range before and after, so a grid needs range; a filled bitmap
+// needs 0 and an outline its width. Add the blend radius k of every kSDSmoothUnion, kSDRound and
+// kSDOnion above the shape. That covers shapes combined by union and subtraction: an intersection
+// changes wherever the other operand is inside, and contour lines change everywhere.
+
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+#include "sdf2d_grid.h"
+#include "sdf2d_raster.h"
+
+typedef struct {
+	SDBounds *rects;     // world rects, none overlapping another
+	int count;
+	int cap;
+} SDDirty;
+
+typedef struct {
+	long rects;          // rects updated
+	long cells;          // grid samples or pixels evaluated
+} SDDirtyStats;
+
+void sdDirtyInit(SDDirty *dirty);
+void sdDirtyFree(SDDirty *dirty);
+void sdDirtyClear(SDDirty *dirty);
+
+// Add a world rect, merged with every rect it overlaps or touches into their bounds. The shape
+// variants add the bounds of the shape placed at (x, y) rotated by angle, grown by margin; a move
+// adds the old and the new place. Each returns 0, or -1 on allocation failure.
+int sdDirtyAddRect(SDDirty *dirty, const SDBounds *rect);
+int sdDirtyAddShape(SDDirty *dirty, const SDShape *shape, float x, float y, float angle, float margin);
+int sdDirtyAddMove(SDDirty *dirty, const SDShape *shape, float x0, float y0, float x1, float y1, float angle, float margin);
+
+// Re-sample the grid samples in the rects (see sdGridResample), or re-render the bitmap pixels in
+// them with sdRasterSceneRect; pixel (x, y) is at (x, y). The rects are kept. stats (may be NULL)
+// is added to. Return 0, or -1 on bad arguments, allocation failure or kSDRasterContour.
+int sdDirtyUpdateGrid(const SDDirty *dirty, SDGrid *grid, SDGridSampler sample, void *ctx, SDDirtyStats *stats);
+int sdDirtyUpdateBitmap(const SDDirty *dirty, const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style,
+	SDDirtyStats *stats);
+
+#endif
@@ -0,0 +1,213 @@
+// Distance transforms of 1-bit masks. See sdf2d_edt.h.
+
+#include "sdf2d_edt.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define SD_EDT_FAR 1e20f
+
+static inline int sdEdtInside(const SDBitmap *mask, int inside, int x, int y)
+{
+	return ((mask->data[(size_t)y * mask->rowbytes + (x >> 3)] >> (7 - (x & 7))) & 1) == inside;
+}
+
+// Squared distance transform of f (0 on the set, SD_EDT_FAR elsewhere) along one line of n samples:
+// the lower envelope of the parabolas (q - v)^2 + f(v), with v and z of n and n + 1 entries.
+static void sdEdtLine(const float *f, int n, float *out, int *v, float *z)
+{
+	int k = 0;
+	v[0] = 0;
+	z[0] = -HUGE_VALF;
+	z[1] = HUGE_VALF;
+	for (int q = 1; q < n; q++) {
+		float s;
+		for (;;) {
+			int p = v[k];
+			s = ((f[q] + (float)q * q) - (f[p] + (float)p * p)) / (2.0f * (q - p));
+			if (s > z[k]) break;
+			k--;
+		}
+		k++;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = HUGE_VALF;
+	}
+	k = 0;
+	for (int q = 0; q < n; q++) {
+		while (z[k + 1] < q) k++;
+		float dq = (float)(q - v[k]);
+		out[q] = dq * dq + f[v[k]];
+	}
+}
+
+// Squared distances from every pixel to the nearest pixel whose inside test equals want, columns then rows
+static int sdEdtExact(const SDBitmap *mask, int inside, int want, float *d)
+{
+	int w = mask->width, h = mask->height, n = w > h ? w : h;
+	float *f = malloc((size_t)(3 * n + 1) * sizeof(float));
+	int *v = malloc((size_t)n * sizeof(int));
+	if (!f || !v) {
+		free(f);
+		free(v);
+		return -1;
+	}
+	float *line = f + n, *z = f + 2 * n;
+	for (int x = 0; x < w; x++) {
+		for (int y = 0; y < h; y++) f[y] = sdEdtInside(mask, inside, x, y) == want ? 0.0f : SD_EDT_FAR;
+		sdEdtLine(f, h, line, v, z);
+		for (int y = 0; y < h; y++) d[(size_t)y * w + x] = line[y];
+	}
+	for (int y = 0; y < h; y++) {
+		float *row = d + (size_t)y * w;
+		for (int x = 0; x < w; x++) f[x] = row[x];
+		sdEdtLine(f, w, row, v, z);
+	}
+	free(f);
+	free(v);
+	return 0;
+}
+
+// Jump flooding: sx, sy is the nearest pixel of the set found so far, or SD_EDT_NONE. maxd (in
+// pixels) is the distance that matters: strides start at the power of two at or above it, or above
+// half the bitmap if that is smaller.
+#define SD_EDT_NONE (-32768)
+
+static int sdEdtJumpFlood(const SDBitmap *mask, int inside, int want, float maxd, float *d)
+{
+	int w = mask->width, h = mask->height;
+	size_t count = (size_t)w * h;
+	short *seed = malloc(count * 4 * sizeof(short));
+	if (!seed) return -1;
+	short *next = seed + 2 * count;
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			int in = sdEdtInside(mask, inside, x, y) == want;
+			seed[2 * ((size_t)y * w + x)] = in ? (short)x : SD_EDT_NONE;
+			seed[2 * ((size_t)y * w + x) + 1] = in ? (short)y : SD_EDT_NONE;
+		}
+	}
+
+	int n = w > h ? w : h, step = 1;
+	while (step * 2 < n && step < maxd) step *= 2;
+	// strides step, step / 2, ..., 1, and 1 again to mend the few pixels the halving misses
+	int passes = 1;
+	for (int s = step; s >= 1; s /= 2) passes++;
+	for (int pass = 0; pass < passes; pass++) {
+		int stride = step >> pass > 1 ? step >> pass : 1;
+		for (int y = 0; y < h; y++) {
+			for (int x = 0; x < w; x++) {
+				const short *own = seed + 2 * ((size_t)y * w + x);
+				int bx = own[0], by = own[1];
+				float bestd = SD_EDT_FAR;
+				if (bx != SD_EDT_NONE) bestd = (float)((bx - x) * (bx - x) + (by - y) * (by - y));
+				for (int j = -1; j <= 1; j++) {
+					int qy = y + j * stride;
+					if (qy < 0 || qy >= h) continue;
+					const short *row = seed + 2 * (size_t)qy * w;
+					for (int i = -1; i <= 1; i++) {
+						int qx = x + i * stride;
+						if (qx < 0 || qx >= w || (i == 0 && j == 0)) continue;
+						int sx = row[2 * qx], sy = row[2 * qx + 1];
+						if (sx == SD_EDT_NONE) continue;
+						float dd = (float)((sx - x) * (sx - x) + (sy - y) * (sy - y));
+						if (dd < bestd) {
+							bestd = dd;
+							bx = sx;
+							by = sy;
+						}
+					}
+				}
+				next[2 * ((size_t)y * w + x)] = (short)bx;
+				next[2 * ((size_t)y * w + x) + 1] = (short)by;
+				d[(size_t)y * w + x] = bestd;
+			}
+		}
+		short *t = seed;
+		seed = next;
+		next = t;
+	}
+	free(seed < next ? seed : next);
+	return 0;
+}
+
+// The field, where only distances up to maxd pixels need be right: larger ones may come out larger still
+static int sdEdtFieldRange(const SDBitmap *mask, int inside, SDEdtMode mode, float maxd, float *out)
+{
+	if (!mask || !mask->data || !out || mask->width <= 0 || mask->height <= 0 || mask->rowbytes * 8 < mask->width) return -1;
+	if ((unsigned)mode > kSDEdtJumpFlood || mask->width > 32767 || mask->height > 32767) return -1;
+	int w = mask->width, h = mask->height;
+	size_t count = (size_t)w * h;
+	float *din = malloc(count * sizeof(float));
+	if (!din) return -1;
+	inside = inside ? 1 : 0;
+	// out: squared distance to the nearest inside pixel; din: to the nearest outside one
+	int r = mode == kSDEdtExact ? sdEdtExact(mask, inside, 1, out) : sdEdtJumpFlood(mask, inside, 1, maxd, out);
+	if (r == 0) r = mode == kSDEdtExact ? sdEdtExact(mask, inside, 0, din) : sdEdtJumpFlood(mask, inside, 0, maxd, din);
+	if (r < 0) {
+		free(din);
+		return -1;
+	}
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			size_t i = (size_t)y * w + x;
+			if (out[i] == 0.0f) {
+				// beyond the bitmap is outside too
+				int e = x + 1;
+				if (w - x < e) e = w - x;
+				if (y + 1 < e) e = y + 1;
+				if (h - y < e) e = h - y;
+				float dd = (float)e * e < din[i] ? (float)e * e : din[i];
+				out[i] = 0.5f - sqrtf(dd);
+			} else {
+				out[i] = sqrtf(out[i]) - 0.5f;
+			}
+		}
+	}
+	free(din);
+	return 0;
+}
+
+int sdEdtField(const SDBitmap *mask, int inside, SDEdtMode mode, float *out)
+{
+	return sdEdtFieldRange(mask, inside, mode, HUGE_VALF, out);
+}
+
+typedef struct {
+	const float *field;
+	int width, height;
+	float x, y, invCell, cell;
+} SDEdtSampler;
+
+// Bilinear in the field, which the grid bake samples at pixel centers (and at tile centers to cull)
+static void sdEdtSample(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	const SDEdtSampler *s = ctx;
+	for (size_t k = 0; k < n; k++) {
+		float u = fmaxf(0.0f, fminf((px[k] - s->x) * s->invCell, (float)(s->width - 1)));
+		float v = fmaxf(0.0f, fminf((py[k] - s->y) * s->invCell, (float)(s->height - 1)));
+		int i = (int)u, j = (int)v;
+		if (i > s->width - 2) i = s->width - 2;
+		if (j > s->height - 2) j = s->height - 2;
+		float fx = u - i, fy = v - j;
+		const float *c = s->field + (size_t)j * s->width + i;
+		float top = c[0] + (c[1] - c[0]) * fx;
+		float bottom = c[s->width] + (c[s->width + 1] - c[s->width]) * fx;
+		out[k] = (top + (bottom - top) * fy) * s->cell;
+	}
+}
+
+int sdEdtBake(SDGrid *grid, const SDGridLayout *layout, const SDBitmap *mask, int inside, SDEdtMode mode)
+{
+	if (!layout || !mask || layout->width != mask->width || layout->height != mask->height || !(layout->cell > 0.0f)) return -1;
+	if (layout->width < 2 || layout->height < 2) return -1;
+	float *field = malloc((size_t)mask->width * mask->height * sizeof(float));
+	if (!field) return -1;
+	// past range every distance clamps, so jump flooding can start at a stride of range
+	int r = sdEdtFieldRange(mask, inside, mode, layout->range / layout->cell + 1.0f, field);
+	if (r == 0) {
+		SDEdtSampler s = { field, mask->width, mask->height, layout->x, layout->y, 1.0f / layout->cell, layout->cell };
+		r = sdGridBake(grid, layout, sdEdtSample, &s);
+	}
+	free(field);
+	return r;
+}
@@ -0,0 +1,45 @@
+#ifndef SDF2D_EDT_H
+#define SDF2D_EDT_H
+
+// Distance transforms of 1-bit masks: turns a sprite image into a signed distance field, so any
+// silhouette an artist draws can collide like the built-in shapes. The field is baked into an
+// SDGrid (sdf2d_grid.h) with one sample per pixel, and queried with sdGridEval and sdgGridEval at
+// the cost of any other grid lookup.
+//
+//	int w, h, rowbytes;
+//	uint8_t *data, *mask;
+//	pd->graphics->getBitmapData(img, &w, &h, &rowbytes, &mask, &data);
+//	SDGridLayout layout = { kSDGridInt8, x, y, w, h, 1.0f, 16.0f, 0 };
+//	sdEdtBake(&grid, &layout, &(SDBitmap){ mask, w, h, rowbytes }, 1, kSDEdtExact);
+//
+// Pixel (i, j) is sampled at (x + i * cell, y + j * cell). Pixels are inside where their bit equals
+// inside: 0 for the black pixels of an image, 1 for the opaque pixels of its mask. Everything beyond
+// the bitmap is outside. A pixel's distance is that from its center to the nearest center across the
+// boundary, less half a pixel: +0.5 and -0.5 either side of an edge, so the surface lies between the
+// two, where sdRaster* with kSDRasterFill would draw it.
+//
+// kSDEdtExact is the linear time transform of Felzenszwalb and Huttenlocher: exact Euclidean
+// distances between pixel centers, a column pass then a row pass of lower envelopes of parabolas.
+// kSDEdtJumpFlood propagates nearest pixels in passes over 9 neighbours at halving strides, plus a
+// last stride 1 pass; sdEdtBake starts the strides at range, as larger distances clamp. It is never
+// nearer the surface than exact, and rarely more than a pixel further, but on one core it is several
+// times slower than kSDEdtExact: each pass touches every pixel. It is there for targets that run the
+// passes in parallel (SIMD, GPU) and as a reference.
+
+#include "sdf2d_grid.h"
+#include "sdf2d_raster.h"
+
+typedef enum {
+	kSDEdtExact,
+	kSDEdtJumpFlood,
+} SDEdtMode;
+
+// Signed distances in pixels, width * height floats row by row. Returns 0, or -1 on bad arguments
+// or allocation failure.
+int sdEdtField(const SDBitmap *mask, int inside, SDEdtMode mode, float *out);
+
+// Bake the field into a grid. layout->width and height must be those of the mask; distances are
+// scaled by layout->cell. Returns 0, or -1 on a bad layout or allocation failure.
+int sdEdtBake(SDGrid *grid, const SDGridLayout *layout, const SDBitmap *mask, int inside, SDEdtMode mode);
+
+#endif
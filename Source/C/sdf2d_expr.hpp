@@ -0,0 +1,271 @@
+#ifndef SDF2D_EXPR_HPP
+#define SDF2D_EXPR_HPP
+
+// C++17 expression templates over sdf2d.h: a composite shape is a type, so the compiler sees the
+// whole tree and inlines it into one function, with no instruction stream, switch or function
+// pointer per node as in sdf2d_scene.h. Header only; the C library is unchanged.
+//
+//	using namespace sdf2d;
+//	constexpr auto dpad = box(24, 0).round(8) | box(0, 24).round(8);
+//	constexpr auto level = translate(dpad, 130, 200) | translate(circle(15), 230, 180);
+//	float d = level(px, py);
+//	evalBatch(level, px, py, out, n);
+//
+// Leaves: circle, box, segment, hexagon and roundedX are inline ports of the sdf2d.c functions, and
+// give the same results. Any other sdf2d.h function joins through fn<sdXxx>(params...), a direct
+// call to it, and an SDShape through shape(), a call to sdShapeEval.
+//
+// Transforms place the subtree in a frame as sdSceneSetTransform does: translate(s, x, y) evaluates
+// s at p - (x, y), rotate(s, angle) at p rotated by -angle, mirrorX and mirrorY at |px| and |py|.
+// Operators are those of SDNodeOp: a | b union, a & b intersect, a - b subtract, smoothUnion(a, b, k),
+// and the members .onion(k) and .round(k).
+//
+// Everything but shape() and rotate(s, angle) is constexpr; cos and sin are not in C++17, so pass
+// them to rotate(s, c, s) for a constexpr rotation. A scene declared constexpr has its parameters folded
+// into the code.
+
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+extern "C" {
+#include "sdf2d.h"
+#include "sdf2d_shape.h"
+}
+
+namespace sdf2d {
+
+template <class A> struct Onion;
+template <class A> struct Round;
+
+// Base of every node, for the operators and the members shared by all
+template <class Self>
+struct Expr {
+	constexpr Onion<Self> onion(float k) const { return { static_cast<const Self &>(*this), k }; }
+	constexpr Round<Self> round(float k) const { return { static_cast<const Self &>(*this), k }; }
+};
+
+template <class T>
+constexpr bool isExpr = std::is_base_of_v<Expr<T>, T>;
+
+// Leaves
+
+struct Circle : Expr<Circle> {
+	float r;
+	constexpr Circle(float r) : r(r) {}
+	float operator()(float px, float py) const { return std::sqrt(px * px + py * py) - r; }
+};
+
+struct Box : Expr<Box> {
+	float bx, by;
+	constexpr Box(float bx, float by) : bx(bx), by(by) {}
+	float operator()(float px, float py) const
+	{
+		px = std::fabs(px) - bx;
+		py = std::fabs(py) - by;
+		float dx = std::fmax(px, 0.0f);
+		float dy = std::fmax(py, 0.0f);
+		return std::sqrt(dx * dx + dy * dy) + std::fmin(std::fmax(px, py), 0.0f);
+	}
+};
+
+struct Segment : Expr<Segment> {
+	float ax, ay, bx, by;
+	constexpr Segment(float ax, float ay, float bx, float by) : ax(ax), ay(ay), bx(bx), by(by) {}
+	float operator()(float px, float py) const
+	{
+		float pax = px - ax, pay = py - ay;
+		float bax = bx - ax, bay = by - ay;
+		float h = std::fmax(0.0f, std::fmin(1.0f, (pax * bax + pay * bay) / (bax * bax + bay * bay)));
+		float gx = pax - bax * h, gy = pay - bay * h;
+		return std::sqrt(gx * gx + gy * gy);
+	}
+};
+
+struct Hexagon : Expr<Hexagon> {
+	float s;             // apothem
+	constexpr Hexagon(float s) : s(s) {}
+	float operator()(float px, float py) const
+	{
+		const float kx = -0.866025404f, ky = 0.5f, kz = 0.577350269f;
+		px = std::fabs(px);
+		py = std::fabs(py);
+		float k = std::fmin(kx * px + ky * py, 0.0f) * 2.0f;
+		px -= kx * k;
+		py -= ky * k;
+		px -= std::fmax(-kz * s, std::fmin(px, kz * s));
+		py -= s;
+		return std::sqrt(px * px + py * py) * (float)((py > 0) - (py < 0));
+	}
+};
+
+struct RoundedX : Expr<RoundedX> {
+	float w, r;
+	constexpr RoundedX(float w, float r) : w(w), r(r) {}
+	float operator()(float px, float py) const
+	{
+		px = std::fabs(px);
+		py = std::fabs(py);
+		float m = std::fmin(px + py, w) * 0.5f;
+		float dx = px - m, dy = py - m;
+		return std::sqrt(dx * dx + dy * dy) - r;
+	}
+};
+
+// Any sdf2d.h function, eg fn<sdEllipse>(40.0f, 20.0f): the parameters after px, py
+template <auto F, class... P>
+struct Fn : Expr<Fn<F, P...>> {
+	std::tuple<P...> p;
+	constexpr Fn(P... p) : p(p...) {}
+	float operator()(float px, float py) const
+	{
+		return std::apply([px, py](P... q) { return F(px, py, q...); }, p);
+	}
+};
+
+// A shape from sdf2d_shape.h, dispatched at run time
+struct ShapeLeaf : Expr<ShapeLeaf> {
+	SDShape s;
+	constexpr ShapeLeaf(const SDShape &s) : s(s) {}
+	float operator()(float px, float py) const { return sdShapeEval(&s, px, py); }
+};
+
+// Transforms
+
+template <class A>
+struct Translate : Expr<Translate<A>> {
+	A a;
+	float x, y;
+	constexpr Translate(const A &a, float x, float y) : a(a), x(x), y(y) {}
+	float operator()(float px, float py) const { return a(px - x, py - y); }
+};
+
+template <class A>
+struct Rotate : Expr<Rotate<A>> {
+	A a;
+	float c, s;
+	constexpr Rotate(const A &a, float c, float s) : a(a), c(c), s(s) {}
+	float operator()(float px, float py) const { return a(c * px + s * py, -s * px + c * py); }
+};
+
+template <class A>
+struct MirrorX : Expr<MirrorX<A>> {
+	A a;
+	constexpr MirrorX(const A &a) : a(a) {}
+	float operator()(float px, float py) const { return a(std::fabs(px), py); }
+};
+
+template <class A>
+struct MirrorY : Expr<MirrorY<A>> {
+	A a;
+	constexpr MirrorY(const A &a) : a(a) {}
+	float operator()(float px, float py) const { return a(px, std::fabs(py)); }
+};
+
+// Operators
+
+template <class A, class B>
+struct Union : Expr<Union<A, B>> {
+	A a;
+	B b;
+	constexpr Union(const A &a, const B &b) : a(a), b(b) {}
+	float operator()(float px, float py) const { return std::fmin(a(px, py), b(px, py)); }
+};
+
+template <class A, class B>
+struct Intersect : Expr<Intersect<A, B>> {
+	A a;
+	B b;
+	constexpr Intersect(const A &a, const B &b) : a(a), b(b) {}
+	float operator()(float px, float py) const { return std::fmax(a(px, py), b(px, py)); }
+};
+
+template <class A, class B>
+struct Subtract : Expr<Subtract<A, B>> {
+	A a;
+	B b;
+	constexpr Subtract(const A &a, const B &b) : a(a), b(b) {}
+	float operator()(float px, float py) const { return std::fmax(a(px, py), -b(px, py)); }
+};
+
+template <class A, class B>
+struct SmoothUnion : Expr<SmoothUnion<A, B>> {
+	A a;
+	B b;
+	float k;             // blend radius; <= 0 is a plain union
+	constexpr SmoothUnion(const A &a, const B &b, float k) : a(a), b(b), k(k) {}
+	float operator()(float px, float py) const
+	{
+		float da = a(px, py), db = b(px, py);
+		if (k <= 0.0f) return std::fmin(da, db);
+		float h = std::fmax(k - std::fabs(da - db), 0.0f) / k;
+		return std::fmin(da, db) - h * h * k * 0.25f;
+	}
+};
+
+template <class A>
+struct Onion : Expr<Onion<A>> {
+	A a;
+	float k;
+	constexpr Onion(const A &a, float k) : a(a), k(k) {}
+	float operator()(float px, float py) const { return std::fabs(a(px, py)) - k; }
+};
+
+template <class A>
+struct Round : Expr<Round<A>> {
+	A a;
+	float k;
+	constexpr Round(const A &a, float k) : a(a), k(k) {}
+	float operator()(float px, float py) const { return a(px, py) - k; }
+};
+
+// Builders
+
+constexpr Circle circle(float r) { return { r }; }
+constexpr Box box(float bx, float by) { return { bx, by }; }
+constexpr Segment segment(float ax, float ay, float bx, float by) { return { ax, ay, bx, by }; }
+constexpr Hexagon hexagon(float s) { return { s }; }
+constexpr RoundedX roundedX(float w, float r) { return { w, r }; }
+inline ShapeLeaf shape(const SDShape &s) { return { s }; }
+
+template <auto F, class... P>
+constexpr Fn<F, P...> fn(P... p) { return Fn<F, P...>(p...); }
+
+template <class A, class = std::enable_if_t<isExpr<A>>>
+constexpr Translate<A> translate(const A &a, float x, float y) { return { a, x, y }; }
+
+template <class A, class = std::enable_if_t<isExpr<A>>>
+constexpr Rotate<A> rotate(const A &a, float c, float s) { return { a, c, s }; }
+
+template <class A, class = std::enable_if_t<isExpr<A>>>
+inline Rotate<A> rotate(const A &a, float angle) { return { a, std::cos(angle), std::sin(angle) }; }
+
+template <class A, class = std::enable_if_t<isExpr<A>>>
+constexpr MirrorX<A> mirrorX(const A &a) { return { a }; }
+
+template <class A, class = std::enable_if_t<isExpr<A>>>
+constexpr MirrorY<A> mirrorY(const A &a) { return { a }; }
+
+template <class A, class B, class = std::enable_if_t<isExpr<A> && isExpr<B>>>
+constexpr Union<A, B> operator|(const A &a, const B &b) { return { a, b }; }
+
+template <class A, class B, class = std::enable_if_t<isExpr<A> && isExpr<B>>>
+constexpr Intersect<A, B> operator&(const A &a, const B &b) { return { a, b }; }
+
+template <class A, class B, class = std::enable_if_t<isExpr<A> && isExpr<B>>>
+constexpr Subtract<A, B> operator-(const A &a, const B &b) { return { a, b }; }
+
+template <class A, class B, class = std::enable_if_t<isExpr<A> && isExpr<B>>>
+constexpr SmoothUnion<A, B> smoothUnion(const A &a, const B &b, float k) { return { a, b, k }; }
+
+// out[i] = e(px[i], py[i]) for i < n, as sdSceneEvalBatch
+template <class E, class = std::enable_if_t<isExpr<E>>>
+inline void evalBatch(const E &e, const float *px, const float *py, float *out, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = e(px[i], py[i]);
+}
+
+} // namespace sdf2d
+
+#endif
@@ -0,0 +1,180 @@
+// Fast-math SDFs. See sdf2d_fast.h.
+
+#include "sdf2d_fast.h"
+#include <math.h>
+
+#define PI_F 3.14159274f
+#define HALF_PI_F 1.57079637f
+
+static inline float fastRsqrt(float x)
+{
+#if SDF2D_FAST_RSQRT_STEPS > 0
+	union { float f; uint32_t i; } u = { x };
+	u.i = 0x5f375a86u - (u.i >> 1);
+	float y = u.f;
+	for (int i = 0; i < SDF2D_FAST_RSQRT_STEPS; i++) y *= 1.5f - 0.5f * x * y * y;
+	return y;
+#else
+	return 1.0f / sqrtf(x);
+#endif
+}
+
+// sqrt(x) for x >= 0, also 0 at 0
+static inline float fastSqrt(float x)
+{
+#if SDF2D_FAST_RSQRT_STEPS > 0
+	return x * fastRsqrt(x);
+#else
+	return sqrtf(x);
+#endif
+}
+
+// Reciprocal cube root by the same bit trick, then cbrt(x) = x / cbrt(x)^2
+static inline float fastCbrt(float x)
+{
+	union { float f; uint32_t i; } u = { x };
+	u.i = 0x54a2fa8cu - u.i / 3;
+	float r = u.f;
+	for (int i = 0; i < 3; i++) r *= 1.33333333f - 0.33333333f * x * r * r * r;
+	return x * r * r;
+}
+
+// atan on [0, 1], minimax polynomial
+static inline float fastAtan01(float a)
+{
+	float s = a * a;
+	return a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+}
+
+static inline float fastAtan2(float y, float x)
+{
+	float ax = fabsf(x), ay = fabsf(y);
+	float mx = fmaxf(ax, ay), mn = fminf(ax, ay);
+	float r = fastAtan01(mx > 0.0f ? mn / mx : 0.0f);
+	if (ay > ax) r = HALF_PI_F - r;
+	if (x < 0.0f) r = PI_F - r;
+	return y < 0.0f ? -r : r;
+}
+
+// Taylor series, for |x| <= pi/3
+static inline float fastCos(float x)
+{
+	float s = x * x;
+	return 1.0f + s * (-0.5f + s * (1.0f / 24.0f + s * (-1.0f / 720.0f + s * (1.0f / 40320.0f))));
+}
+
+static inline float fastSin(float x)
+{
+	float s = x * x;
+	return x * (1.0f + s * (-1.0f / 6.0f + s * (1.0f / 120.0f + s * (-1.0f / 5040.0f + s * (1.0f / 362880.0f)))));
+}
+
+float sdFastRsqrt(float x) { return fastRsqrt(x); }
+float sdFastCbrt(float x) { return fastCbrt(x); }
+float sdFastAtan2(float y, float x) { return fastAtan2(y, x); }
+
+float sdEllipseFast(float px, float py, float ex, float ey)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	float de = fabsf(ex - ey);
+	// a near circle is within de / 2 of the circle of mean radius
+	if (de <= 2.0f * SDF2D_FAST_ELLIPSE_TOL) {
+		return fastSqrt(px * px + py * py) - 0.5f * (ex + ey);
+	}
+	// two iterations are off by about de / 200 (measured on the fast suite grid), three by 1e-3 px
+	int iters = de <= 200.0f * SDF2D_FAST_ELLIPSE_TOL ? 2 : SDF2D_FAST_ELLIPSE_ITERS;
+	float eiX = 1.0f / ex;
+	float eiY = 1.0f / ey;
+	float veX = eiX * (ex * ex - ey * ey);
+	float veY = eiY * (ey * ey - ex * ex);
+	float tX = 0.70710678f;
+	float tY = 0.70710678f;
+	for (int i = 0; i < iters; i++) {
+		float vX = veX * tX * tX * tX;
+		float vY = veY * tY * tY * tY;
+		float tmx = px - vX;
+		float tmy = py - vY;
+		float ax = tX * ex - vX;
+		float ay = tY * ey - vY;
+		// |a| / |tm| with one reciprocal square root instead of two roots and a divide
+		float a2 = ax * ax + ay * ay;
+		float ratio = a2 * fastRsqrt(a2 * (tmx * tmx + tmy * tmy));
+		float cx = fmaxf(0.0f, fminf(eiX * (vX + tmx * ratio), 1.0f));
+		float cy = fmaxf(0.0f, fminf(eiY * (vY + tmy * ratio), 1.0f));
+		float in = fastRsqrt(cx * cx + cy * cy);
+		tX = cx * in;
+		tY = cy * in;
+	}
+	float nx = tX * ex;
+	float ny = tY * ey;
+	float d = fastSqrt((px - nx) * (px - nx) + (py - ny) * (py - ny));
+	// inside test on the implicit equation, so the sign does not depend on the approximations
+	float qx = px * eiX, qy = py * eiY;
+	return qx * qx + qy * qy < 1.0f ? -d : d;
+}
+
+float sdParabolaFast(float px, float py, float k)
+{
+	px = fabsf(px);
+	float ik = 1.0f / k;
+	float p = ik * (py - 0.5f * ik) * (1.0f / 3.0f);
+	float q = 0.25f * ik * ik * px;
+	float h = q * q - p * p * p;
+	float r = sqrtf(fabsf(h));
+	float x;
+	if (h > 0.0f)
+		x = fastCbrt(q + r) + fastCbrt(fabsf(q - r)) * ((p > 0) - (p < 0));
+	else
+		x = 2.0f * fastCos(fastAtan2(r, q) * (1.0f / 3.0f)) * sqrtf(p);
+	float dx = px - x;
+	float dy = py - k * x * x;
+	float d = sqrtf(dx * dx + dy * dy);
+	return ((py - k * px * px) * k > 0.0f) ? -d : d;
+}
+
+float sdRegularPolygonFast(float px, float py, float r, int n)
+{
+	float an = PI_F / n;
+	// fold into the sector around the positive x axis: bn in [-an, an)
+	float a = fastAtan2(py, px);
+	float bn = a - (2.0f * floorf(a * (n * (0.5f / PI_F))) + 1.0f) * an;
+	float mag = sqrtf(px * px + py * py);
+	px = fastCos(bn) * mag - fastCos(an) * r;
+	py = fabsf(fastSin(bn)) * mag;
+	float sy = fastSin(an) * r;
+	py -= sy;
+	py += fmaxf(0.0f, fminf(-py, sy));
+	return sqrtf(px * px + py * py) * ((px > 0.0f) - (px < 0.0f));
+}
+
+float sdPolygonFast(float px, float py, const float vx[], const float vy[], int n)
+{
+	// closest squared distance so far, as num / den
+	float num = (px - vx[0]) * (px - vx[0]) + (py - vy[0]) * (py - vy[0]);
+	float den = 1.0f;
+	float s = 1.0f;
+	for (int i = 0, j = n - 1; i < n; j = i++) {
+		float ex = vx[j] - vx[i];
+		float ey = vy[j] - vy[i];
+		float wx = px - vx[i];
+		float wy = py - vy[i];
+		float dot = wx * ex + wy * ey;
+		float len2 = ex * ex + ey * ey;
+		float cr = ex * wy - ey * wx;
+		float bx = wx - ex, by = wy - ey;
+		// past either end the closest point is a vertex, else the foot of the perpendicular
+		float en = dot <= 0.0f ? wx * wx + wy * wy : dot >= len2 ? bx * bx + by * by : cr * cr;
+		float ed = (dot > 0.0f && dot < len2) ? len2 : 1.0f;
+		if (en * den < num * ed) {
+			num = en;
+			den = ed;
+		}
+		int c1 = (py >= vy[i]);
+		int c2 = (py < vy[j]);
+		int c3 = (cr > 0.0f);
+		if ((c1 && c2 && c3) || (!c1 && !c2 && !c3))
+			s = -s;
+	}
+	return s * sqrtf(num / den);
+}
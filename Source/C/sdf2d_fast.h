@@ -0,0 +1,53 @@
+#ifndef SDF2D_FAST_H
+#define SDF2D_FAST_H
+
+// Fast-math variants of the four slowest SDFs in sdf2d.h, with the same arguments:
+// - sdEllipseFast: one reciprocal square root per iteration instead of two roots and two divides,
+//   and fewer iterations for ellipses close to a circle
+// - sdParabolaFast: polynomial cube root, atan2 and cos instead of cbrtf, atan2f and cosf
+// - sdRegularPolygonFast: polynomial atan2 and sin/cos of the folded angle, no fmodf
+// - sdPolygonFast: compares squared edge distances as fractions, so one divide per call instead of
+//   one per edge
+//
+// They trade a little accuracy for speed. The knobs below are compile-time; the host benchmark's
+// fast suite measures the largest error of each against its exact version over a dense grid, so
+// rebuild with different values and compare. With the defaults the errors stay below 0.01 px for
+// shapes up to a few hundred px across.
+//
+// Call them directly, or build sdf2d_shape.c with SDF2D_FAST_MATH defined to use them in
+// sdShapeEval and sdShapeEvalBatch, and so in scenes, grids and the rasterizer.
+
+#include <stdint.h>
+
+// Newton steps after the bit trick in the reciprocal square root: 2 is ~5e-6 relative, 1 (~2e-3) is
+// too coarse for sdEllipseFast. 0 uses 1 / sqrtf, which is faster where the FPU has a quick square
+// root and divide, as on desktops; the Cortex-M7 takes 14 cycles for each.
+#ifndef SDF2D_FAST_RSQRT_STEPS
+#ifdef TARGET_PLAYDATE
+#define SDF2D_FAST_RSQRT_STEPS 2
+#else
+#define SDF2D_FAST_RSQRT_STEPS 0
+#endif
+#endif
+
+// Ellipse iterations, as in sdEllipse. Fewer are used for ellipses close to a circle, where they are
+// enough to stay within about SDF2D_FAST_ELLIPSE_TOL px, and none within 2 * tol of one.
+#ifndef SDF2D_FAST_ELLIPSE_ITERS
+#define SDF2D_FAST_ELLIPSE_ITERS 3
+#endif
+
+#ifndef SDF2D_FAST_ELLIPSE_TOL
+#define SDF2D_FAST_ELLIPSE_TOL 0.01f
+#endif
+
+float sdEllipseFast(float px, float py, float ex, float ey);
+float sdParabolaFast(float px, float py, float k);
+float sdRegularPolygonFast(float px, float py, float r, int n);
+float sdPolygonFast(float px, float py, const float vx[], const float vy[], int n);
+
+// The approximations themselves, for use elsewhere
+float sdFastRsqrt(float x);          // 1/sqrt(x) for x > 0; sdFastRsqrt(0) is large but finite
+float sdFastCbrt(float x);           // x >= 0
+float sdFastAtan2(float y, float x); // |error| < 1e-5 rad
+
+#endif
@@ -0,0 +1,752 @@
+// Fixed-point ports of the SDFs in sdf2d.c. See sdf2d_fixed.h.
+//
+// Each function follows its float version line by line. SDFixed values carry S fractional bits;
+// products of two values are kept 64 bit ("wide", 2S fractional bits) until they are compared,
+// square rooted or divided, which keeps squared lengths exact and avoids overflow.
+
+#include "sdf2d_fixed.h"
+
+#define S SDF2D_FIXED_SHIFT
+#define ONE SD_FIXED_ONE
+#define K(x) sdFixedConst(x)
+#define FIXED_MAX INT32_MAX
+
+// CORDIC works in Q2.30 regardless of S
+#define CORDIC_SHIFT 30
+#define CORDIC_STEPS 30
+#define CORDIC_PI INT64_C(3373259426)
+#define CORDIC_HALF_PI INT64_C(1686629713)
+#define CORDIC_GAIN INT64_C(652032874)      // 1 / prod(sqrt(1 + 2^-2i))
+
+static const int32_t cordicAngles[CORDIC_STEPS] = {
+	843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437, 4194283, 2097149,
+	1048576, 524288, 262144, 131072, 65536, 32768, 16384, 8192, 4096, 2048,
+	1024, 512, 256, 128, 64, 32, 16, 8, 4, 2
+};
+
+static inline SDFixed fxMin(SDFixed a, SDFixed b) { return a < b ? a : b; }
+static inline SDFixed fxMax(SDFixed a, SDFixed b) { return a > b ? a : b; }
+static inline SDFixed fxAbs(SDFixed a) { return a < 0 ? -a : a; }
+static inline SDFixed fxClamp(SDFixed a, SDFixed lo, SDFixed hi) { return a < lo ? lo : (a > hi ? hi : a); }
+static inline int fxSign(int64_t a) { return (a > 0) - (a < 0); }
+
+static inline SDFixed fxMul(SDFixed a, SDFixed b)
+{
+	return (SDFixed)(((int64_t)a * b) >> S);
+}
+
+static inline int64_t fxDot(SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by)
+{
+	return (int64_t)ax * bx + (int64_t)ay * by;
+}
+
+// sqrt of a wide value, as an SDFixed
+static inline SDFixed fxSqrtWide(int64_t w)
+{
+	return w > 0 ? (SDFixed)sdFixedIsqrt64((uint64_t)w) : 0;
+}
+
+static inline SDFixed fxLength(SDFixed x, SDFixed y)
+{
+	return fxSqrtWide(fxDot(x, y, x, y));
+}
+
+// num / den as an SDFixed, for num and den of the same scale (eg both wide), saturating
+static SDFixed fxQuot(int64_t num, int64_t den)
+{
+	if (den < 0) {
+		num = -num;
+		den = -den;
+	}
+	if (den == 0) return num < 0 ? -FIXED_MAX : FIXED_MAX;
+	int64_t q = num / den;
+	int64_t r = num % den;
+	if (q >= ((int64_t)1 << (31 - S))) return FIXED_MAX;
+	if (q <= -((int64_t)1 << (31 - S))) return -FIXED_MAX;
+	// keep r * ONE in range
+	while (den >= ((int64_t)1 << (62 - S))) {
+		den >>= 1;
+		r /= 2;
+	}
+	return (SDFixed)(q * ONE + r * ONE / den);
+}
+
+// clamp(num / den, 0, 1) for den > 0
+static inline SDFixed fxRatio(int64_t num, int64_t den)
+{
+	if (num <= 0) return 0;
+	if (num >= den) return ONE;
+	return fxQuot(num, den);
+}
+
+SDFixed sdFixedMul(SDFixed a, SDFixed b)
+{
+	return fxMul(a, b);
+}
+
+SDFixed sdFixedDiv(SDFixed a, SDFixed b)
+{
+	return fxQuot(a, b);
+}
+
+uint32_t sdFixedIsqrt64(uint64_t x)
+{
+	uint64_t r = 0;
+	uint64_t bit;
+#if defined(__GNUC__)
+	if (x == 0) return 0;
+	bit = (uint64_t)1 << ((63 - __builtin_clzll(x)) & ~1);
+#else
+	bit = (uint64_t)1 << 62;
+	while (bit > x) bit >>= 2;
+#endif
+	// branchless: the digits are data dependent, so a branch here mispredicts half the time
+	while (bit) {
+		uint64_t t = r + bit;
+		uint64_t m = -(uint64_t)(x >= t);
+		x -= t & m;
+		r = (r >> 1) + (bit & m);
+		bit >>= 2;
+	}
+	return (uint32_t)r;
+}
+
+SDFixed sdFixedSqrt(SDFixed a)
+{
+	return a > 0 ? (SDFixed)sdFixedIsqrt64((uint64_t)a << S) : 0;
+}
+
+SDFixed sdFixedAtan2(SDFixed y, SDFixed x)
+{
+	if (x == 0 && y == 0) return 0;
+	// vectoring mode on 64 bit values scaled to 30 bits, after rotating into the right half plane
+	int64_t vx = x, vy = y, a = 0;
+	if (vx < 0) {
+		a = vy >= 0 ? CORDIC_PI : -CORDIC_PI;
+		vx = -vx;
+		vy = -vy;
+	}
+	int64_t m = vx > (vy < 0 ? -vy : vy) ? vx : (vy < 0 ? -vy : vy);
+	while (m < ((int64_t)1 << 29)) {
+		m *= 2;
+		vx *= 2;
+		vy *= 2;
+	}
+	for (int i = 0; i < CORDIC_STEPS; i++) {
+		int64_t tx = vx;
+		if (vy > 0) {
+			vx += vy >> i;
+			vy -= tx >> i;
+			a += cordicAngles[i];
+		} else {
+			vx -= vy >> i;
+			vy += tx >> i;
+			a -= cordicAngles[i];
+		}
+	}
+	return (SDFixed)(a >> (CORDIC_SHIFT - S));
+}
+
+void sdFixedSinCos(SDFixed angle, SDFixed *s, SDFixed *c)
+{
+	// rotation mode on an angle reduced to [-pi/2, pi/2]
+	int64_t a = (int64_t)angle * ((int64_t)1 << (CORDIC_SHIFT - S));
+	a %= 2 * CORDIC_PI;
+	if (a > CORDIC_PI) a -= 2 * CORDIC_PI;
+	if (a < -CORDIC_PI) a += 2 * CORDIC_PI;
+	int flip = 0;
+	if (a > CORDIC_HALF_PI) { a -= CORDIC_PI; flip = 1; }
+	else if (a < -CORDIC_HALF_PI) { a += CORDIC_PI; flip = 1; }
+	int64_t vx = CORDIC_GAIN, vy = 0;
+	for (int i = 0; i < CORDIC_STEPS; i++) {
+		int64_t tx = vx;
+		if (a >= 0) {
+			vx -= vy >> i;
+			vy += tx >> i;
+			a -= cordicAngles[i];
+		} else {
+			vx += vy >> i;
+			vy -= tx >> i;
+			a += cordicAngles[i];
+		}
+	}
+	if (flip) {
+		vx = -vx;
+		vy = -vy;
+	}
+	*c = (SDFixed)(vx >> (CORDIC_SHIFT - S));
+	*s = (SDFixed)(vy >> (CORDIC_SHIFT - S));
+}
+
+SDFixed sdqCircle(SDFixed px, SDFixed py, SDFixed r)
+{
+	return fxLength(px, py) - r;
+}
+
+SDFixed sdqSegment(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by)
+{
+	SDFixed pax = px-ax;
+	SDFixed pay = py-ay;
+	SDFixed bax = bx-ax;
+	SDFixed bay = by-ay;
+	SDFixed h = fxRatio(fxDot(pax, pay, bax, bay), fxDot(bax, bay, bax, bay));
+	return fxLength(pax-fxMul(bax, h), pay-fxMul(bay, h));
+}
+
+SDFixed sdqSegmentLinf(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by)
+{
+	SDFixed pax = px-ax;
+	SDFixed pay = py-ay;
+	SDFixed bax = bx-ax;
+	SDFixed bay = by-ay;
+	SDFixed s = ((int64_t)bax*bay > 0) ? 1 : -1;
+	SDFixed h = fxClamp(fxQuot(pay+s*pax, bay+s*bax), 0, ONE);
+	SDFixed qx = fxAbs(pax-fxMul(h, bax));
+	SDFixed qy = fxAbs(pay-fxMul(h, bay));
+	return fxMax(qx, qy);
+}
+
+// length(max(q, 0)) + min(max(qx, qy), 0)
+static inline SDFixed fxBoxTail(SDFixed qx, SDFixed qy)
+{
+	return fxLength(fxMax(qx, 0), fxMax(qy, 0)) + fxMin(fxMax(qx, qy), 0);
+}
+
+SDFixed sdqBox(SDFixed px, SDFixed py, SDFixed bx, SDFixed by)
+{
+	return fxBoxTail(fxAbs(px)-bx, fxAbs(py)-by);
+}
+
+SDFixed sdqBoxLinf(SDFixed px, SDFixed py, SDFixed bx, SDFixed by)
+{
+	return fxMax(fxAbs(px)-bx, fxAbs(py)-by);
+}
+
+SDFixed sdqOrientedBox(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by, SDFixed th)
+{
+	SDFixed bmax = bx-ax;
+	SDFixed bmay = by-ay;
+	SDFixed l = fxLength(bmax, bmay);
+	SDFixed dx = fxQuot(bmax, l);
+	SDFixed dy = fxQuot(bmay, l);
+	SDFixed cx = px-(ax+bx)/2;
+	SDFixed cy = py-(ay+by)/2;
+	SDFixed qx = fxAbs((SDFixed)(fxDot(dx, dy, cx, cy) >> S))-l/2;
+	SDFixed qy = fxAbs((SDFixed)(fxDot(-dy, dx, cx, cy) >> S))-th;
+	return fxBoxTail(qx, qy);
+}
+
+SDFixed sdqRoundedBox(SDFixed px, SDFixed py, SDFixed bx, SDFixed by, SDFixed rw, SDFixed rx, SDFixed ry, SDFixed rz)
+{
+	if (px <= 0) { rw=ry; rx=rz; }
+	if (py < 0) { rw=rx; }
+	return fxBoxTail(fxAbs(px)-bx+rw, fxAbs(py)-by+rw) - rw;
+}
+
+SDFixed sdqRoundSquare(SDFixed px, SDFixed py, SDFixed s, SDFixed r)
+{
+	return fxBoxTail(fxAbs(px)-s+r, fxAbs(py)-s+r) - r;
+}
+
+SDFixed sdqRhombus(SDFixed px, SDFixed py, SDFixed bx, SDFixed by)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	SDFixed f1x = bx-px*2;
+	SDFixed f1y = by-py*2;
+	SDFixed f = fxQuot((int64_t)f1x*bx-(int64_t)f1y*by, fxDot(bx, by, bx, by));
+	SDFixed h = fxClamp(f, -ONE, ONE);
+	SDFixed dvx = px-fxMul(bx/2, ONE-h);
+	SDFixed dvy = py-fxMul(by/2, ONE+h);
+	int64_t r = (int64_t)px*by+(int64_t)py*bx-(int64_t)bx*by;
+	return fxLength(dvx, dvy) * fxSign(r);
+}
+
+SDFixed sdqRhombusLinf(SDFixed px, SDFixed py, SDFixed w, SDFixed h)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	px -= w;
+	SDFixed f = fxClamp(fxQuot(py-px, h+w), 0, ONE);
+	SDFixed qx = fxAbs(px+fxMul(f, w));
+	SDFixed qy = fxAbs(py-fxMul(f, h));
+	return fxMax(qx, qy) * (((int64_t)h*px+(int64_t)w*py > 0) ? 1 : -1);
+}
+
+SDFixed sdqTrapezoid(SDFixed px, SDFixed py, SDFixed r1, SDFixed r2, SDFixed he)
+{
+	px = fxAbs(px);
+	SDFixed k2x = r2-r1;
+	SDFixed k2y = 2*he;
+	SDFixed cax = px - fxMin(px, (py < 0) ? r1 : r2);
+	SDFixed cay = fxAbs(py)-he;
+	SDFixed d = fxRatio(fxDot(k2x, k2y, r2-px, he-py), fxDot(k2x, k2y, k2x, k2y));
+	SDFixed cbx = px-r2+fxMul(k2x, d);
+	SDFixed cby = py-he+fxMul(k2y, d);
+	int s = (cbx < 0 && cay < 0) ? -1 : 1;
+	int64_t da = fxDot(cax, cay, cax, cay);
+	int64_t db = fxDot(cbx, cby, cbx, cby);
+	return s*fxSqrtWide(da < db ? da : db);
+}
+
+SDFixed sdqParallelogram(SDFixed px, SDFixed py, SDFixed wi, SDFixed he, SDFixed sk)
+{
+	SDFixed ex = sk, ey = he;
+	if (py < 0) { px = -px; py = -py; }
+	SDFixed wx = px - ex;
+	SDFixed wy = py - ey;
+	wx -= fxClamp(wx, -wi, wi);
+	int64_t dx = fxDot(wx, wy, wx, wy);
+	int64_t dy = -(int64_t)wy*ONE;
+	int64_t s = (int64_t)px*ey - (int64_t)py*ex;
+	if (s < 0) { px = -px; py = -py; }
+	SDFixed vx = px - wi;
+	SDFixed vy = py;
+	SDFixed c = fxClamp(fxQuot(fxDot(vx, vy, ex, ey), fxDot(ex, ey, ex, ey)), -ONE, ONE);
+	vx -= fxMul(ex, c);
+	vy -= fxMul(ey, c);
+	int64_t dv = fxDot(vx, vy, vx, vy);
+	if (dv < dx) dx = dv;
+	int64_t e = (int64_t)wi*he - (s < 0 ? -s : s);
+	if (e < dy) dy = e;
+	return fxSqrtWide(dx) * fxSign(-dy);
+}
+
+SDFixed sdqEquilateralTriangle(SDFixed px, SDFixed py, SDFixed r)
+{
+	const SDFixed k = K(1.73205);
+	const SDFixed ik = K(1.0/1.73205);
+	px = fxAbs(px) - r;
+	py = py + fxMul(r, ik);
+	if (px+fxMul(k, py) > 0) {
+		SDFixed ppx = (px - fxMul(k, py)) / 2;
+		SDFixed ppy = (-fxMul(k, px) - py) / 2;
+		px = ppx;
+		py = ppy;
+	}
+	px -= fxClamp(px, -2*r, 0);
+	return -fxLength(px, py) * fxSign(py);
+}
+
+SDFixed sdqTriangleIsosceles(SDFixed px, SDFixed py, SDFixed qx, SDFixed qy)
+{
+	px = fxAbs(px);
+	SDFixed m1 = fxRatio(fxDot(px, py, qx, qy), fxDot(qx, qy, qx, qy));
+	SDFixed ax = px-fxMul(qx, m1);
+	SDFixed ay = py-fxMul(qy, m1);
+	SDFixed n = fxRatio(px, qx);
+	SDFixed bx = px-fxMul(qx, n);
+	SDFixed by = py-qy;
+	int sq = fxSign(qy);
+	int64_t s1 = sq * ((int64_t)px*qy-(int64_t)py*qx);
+	int64_t s2 = sq * (int64_t)(py-qy) * ONE;
+	int64_t da = fxDot(ax, ay, ax, ay);
+	int64_t db = fxDot(bx, by, bx, by);
+	return fxSqrtWide(da < db ? da : db) * fxSign(s1 > s2 ? s1 : s2);
+}
+
+// Shared by sdqTriangle, sdqQuad and sdqPolygon: squared distance to edge e from vertex offset v
+static inline int64_t fxEdgeDistance(SDFixed vx, SDFixed vy, SDFixed ex, SDFixed ey)
+{
+	SDFixed m = fxRatio(fxDot(vx, vy, ex, ey), fxDot(ex, ey, ex, ey));
+	SDFixed qx = vx-fxMul(ex, m);
+	SDFixed qy = vy-fxMul(ey, m);
+	return fxDot(qx, qy, qx, qy);
+}
+
+SDFixed sdqTriangle(SDFixed px, SDFixed py, SDFixed p0x, SDFixed p0y, SDFixed p1x, SDFixed p1y, SDFixed p2x, SDFixed p2y)
+{
+	SDFixed ex[3] = { p1x-p0x, p2x-p1x, p0x-p2x };
+	SDFixed ey[3] = { p1y-p0y, p2y-p1y, p0y-p2y };
+	SDFixed vx[3] = { px-p0x, px-p1x, px-p2x };
+	SDFixed vy[3] = { py-p0y, py-p1y, py-p2y };
+	int s = fxSign((int64_t)ex[0]*ey[2]-(int64_t)ey[0]*ex[2]);
+	int64_t dx = INT64_MAX, dy = INT64_MAX;
+	for (int i = 0; i < 3; i++) {
+		int64_t d = fxEdgeDistance(vx[i], vy[i], ex[i], ey[i]);
+		int64_t c = s*((int64_t)vx[i]*ey[i]-(int64_t)vy[i]*ex[i]);
+		if (d < dx) dx = d;
+		if (c < dy) dy = c;
+	}
+	return -fxSqrtWide(dx)*fxSign(dy);
+}
+
+SDFixed sdqQuad(SDFixed px, SDFixed py, SDFixed p0x, SDFixed p0y, SDFixed p1x, SDFixed p1y, SDFixed p2x, SDFixed p2y, SDFixed p3x, SDFixed p3y)
+{
+	SDFixed ex[4] = { p1x-p0x, p2x-p1x, p3x-p2x, p0x-p3x };
+	SDFixed ey[4] = { p1y-p0y, p2y-p1y, p3y-p2y, p0y-p3y };
+	SDFixed vx[4] = { px-p0x, px-p1x, px-p2x, px-p3x };
+	SDFixed vy[4] = { py-p0y, py-p1y, py-p2y, py-p3y };
+	int64_t dx = INT64_MAX, dy = INT64_MAX;
+	for (int i = 0; i < 4; i++) {
+		int64_t d = fxEdgeDistance(vx[i], vy[i], ex[i], ey[i]);
+		int64_t c = (int64_t)vx[i]*ey[i]-(int64_t)vy[i]*ex[i];
+		if (d < dx) dx = d;
+		if (c < dy) dy = c;
+	}
+	return -fxSqrtWide(dx)*fxSign(dy);
+}
+
+SDFixed sdqUnevenCapsule(SDFixed px, SDFixed py, SDFixed r1, SDFixed r2, SDFixed h)
+{
+	px = fxAbs(px);
+	SDFixed b = fxQuot(r1 - r2, h);
+	SDFixed a = sdFixedSqrt(ONE - fxMul(b, b));
+	int64_t k = -(int64_t)b*px + (int64_t)a*py;
+	if (k < 0) return fxLength(px, py) - r1;
+	if (k > (int64_t)a*h) return fxLength(px, py - h) - r2;
+	return (SDFixed)(fxDot(a, b, px, py) >> S) - r1;
+}
+
+SDFixed sdqEgg(SDFixed px, SDFixed py, SDFixed ra, SDFixed rb)
+{
+	const SDFixed k = K(1.73205);
+	px = fxAbs(px);
+	SDFixed r = ra - rb;
+	if (py < 0)
+		return fxLength(px, py) - r - rb;
+	if (fxMul(k, px + r) < py)
+		return fxLength(px, py - fxMul(k, r)) - rb;
+	return fxLength(px + r, py) - 2*r - rb;
+}
+
+SDFixed sdqPie(SDFixed px, SDFixed py, SDFixed cx, SDFixed cy, SDFixed r)
+{
+	px = fxAbs(px);
+	SDFixed l = fxLength(px, py) - r;
+	SDFixed cd = fxClamp((SDFixed)(fxDot(px, py, cx, cy) >> S), 0, r);
+	SDFixed m = fxLength(px - fxMul(cx, cd), py - fxMul(cy, cd));
+	int s = ((int64_t)cy*px - (int64_t)cx*py > 0) ? 1 : -1;
+	return fxMax(l, m*s);
+}
+
+SDFixed sdqCutDisk(SDFixed px, SDFixed py, SDFixed r, SDFixed h)
+{
+	SDFixed w = fxSqrtWide((int64_t)r*r - (int64_t)h*h);
+	px = fxAbs(px);
+	int64_t s1 = (((int64_t)(h - r) * px) >> S) * px + (((int64_t)w * w) >> S) * (h + r - 2*py);
+	int64_t s2 = (int64_t)h*px - (int64_t)w*py;
+	if ((s1 > s2 ? s1 : s2) < 0)
+		return fxLength(px, py) - r;
+	if (px < w)
+		return h - py;
+	return fxLength(px - w, py - h);
+}
+
+SDFixed sdqMoon(SDFixed px, SDFixed py, SDFixed d, SDFixed ra, SDFixed rb)
+{
+	py = fxAbs(py);
+	SDFixed a = fxQuot((int64_t)ra*ra - (int64_t)rb*rb + (int64_t)d*d, (int64_t)2*d*ONE);
+	SDFixed b = fxSqrtWide((int64_t)ra*ra - (int64_t)a*a);
+	SDFixed t = (SDFixed)(((int64_t)px*b - (int64_t)py*a) >> S);
+	if ((int64_t)d*t > (int64_t)fxMul(d, d) * fxMax(b - py, 0))
+		return fxLength(px - a, py - b);
+	SDFixed l1 = fxLength(px, py) - ra;
+	SDFixed l2 = fxLength(px - d, py) - rb;
+	return fxMax(l1, -l2);
+}
+
+SDFixed sdqVesica(SDFixed px, SDFixed py, SDFixed r, SDFixed d)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	SDFixed b = fxSqrtWide((int64_t)r*r - (int64_t)d*d);
+	if ((int64_t)(py - b) * d > (int64_t)px * b)
+		return fxLength(px, py - b) * fxSign(d);
+	return fxLength(px + d, py) - r;
+}
+
+SDFixed sdqOrientedVesica(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by, SDFixed w)
+{
+	SDFixed dx = bx - ax;
+	SDFixed dy = by - ay;
+	SDFixed r = fxLength(dx, dy) / 2;
+	SDFixed d = fxQuot((int64_t)r*r - (int64_t)w*w, (int64_t)2*w*ONE);
+	SDFixed vx = fxQuot(dx, r);
+	SDFixed vy = fxQuot(dy, r);
+	SDFixed qx = px - (bx + ax) / 2;
+	SDFixed qy = py - (by + ay) / 2;
+	SDFixed mqx = fxAbs((SDFixed)(fxDot(vy, vx, qx, qy) >> (S + 1)));
+	SDFixed mqy = fxAbs((SDFixed)(fxDot(-vx, vy, qx, qy) >> (S + 1)));
+	if ((int64_t)r*mqx < (int64_t)d*(mqy - r))
+		return fxLength(mqx, mqy - r);
+	return fxLength(mqx + d, mqy) - (d + w);
+}
+
+SDFixed sdqTunnel(SDFixed px, SDFixed py, SDFixed whx, SDFixed why)
+{
+	px = fxAbs(px);
+	py = -py;
+	SDFixed qx = px - whx;
+	SDFixed qy = py - why;
+	SDFixed m0 = fxMax(qx, 0);
+	int64_t d1 = fxDot(m0, qy, m0, qy);
+	if (py <= 0) qx = fxLength(px, py) - whx;
+	SDFixed m1 = fxMax(qy, 0);
+	int64_t d2 = fxDot(qx, m1, qx, m1);
+	SDFixed d = fxSqrtWide(d1 < d2 ? d1 : d2);
+	return (fxMax(qx, qy) < 0) ? -d : d;
+}
+
+SDFixed sdqArc(SDFixed px, SDFixed py, SDFixed scx, SDFixed scy, SDFixed ra, SDFixed rb)
+{
+	px = fxAbs(px);
+	if ((int64_t)scy * px > (int64_t)scx * py)
+		return fxLength(px - fxMul(scx, ra), py - fxMul(scy, ra)) - rb;
+	return fxAbs(fxLength(px, py) - ra) - rb;
+}
+
+SDFixed sdqRing(SDFixed px, SDFixed py, SDFixed nx, SDFixed ny, SDFixed r, SDFixed th)
+{
+	px = fxAbs(px);
+	SDFixed rx = (SDFixed)(fxDot(nx, -ny, px, py) >> S);
+	py = (SDFixed)(fxDot(ny, nx, px, py) >> S);
+	px = rx;
+	SDFixed d1 = fxAbs(fxLength(px, py) - r) - th / 2;
+	py = fxMax(0, fxAbs(r - py) - th / 2);
+	SDFixed d2 = fxLength(px, py) * fxSign(px);
+	return fxMax(d1, d2);
+}
+
+SDFixed sdqHorseshoe(SDFixed px, SDFixed py, SDFixed cx, SDFixed cy, SDFixed r, SDFixed le, SDFixed th)
+{
+	px = fxAbs(px);
+	py = -py;
+	SDFixed l = fxLength(px, py);
+	SDFixed tx = (SDFixed)(fxDot(-cx, cy, px, py) >> S);
+	py = (SDFixed)(fxDot(cy, cx, px, py) >> S);
+	px = tx;
+	if (!(py > 0 || px > 0)) px = (-cx > 0) ? l : -l;
+	if (!(px > 0)) py = l;
+	px = px - le;
+	py = fxAbs(py - r) - th;
+	return fxBoxTail(px, py);
+}
+
+// x - px + 2kx(kx^2 - py), rounded to nearest, with kx kept wide: k is small and kx is all fraction
+static inline SDFixed fxParabolaRoot(SDFixed x, SDFixed px, SDFixed py, SDFixed k, SDFixed *y)
+{
+	const int64_t half = (int64_t)1 << (2*S - 1);
+	int64_t t = (int64_t)k * x;
+	*y = (SDFixed)((t * x + half) >> (2*S));
+	return x - px + (SDFixed)((2 * t * (*y - py) + half) >> (2*S));
+}
+
+SDFixed sdqParabola(SDFixed px, SDFixed py, SDFixed k)
+{
+	// The closest point (x, kx^2) solves f(x) = x - px + 2kx(kx^2 - py) = 0. The closed form used by
+	// sdParabola needs cbrt, acos and intermediates far outside the fixed-point range, so instead run
+	// Newton's method from a point right of every root: f is convex for x > 0, so the iterates fall
+	// monotonically onto the largest root, which is the closest point.
+	px = fxAbs(px);
+	// start where kx^2 - py has the sign of k, so both terms of f are >= 0
+	int64_t x2 = (py > 0) == (k > 0) ? (int64_t)py * ONE / k : 0;
+	if (x2 > (INT64_MAX >> S)) x2 = INT64_MAX >> S;
+	SDFixed x = fxMax(px, fxSqrtWide(x2 * ONE));
+	SDFixed y;
+	for (int i = 0; i < 24; i++) {
+		SDFixed f = fxParabolaRoot(x, px, py, k, &y);
+		SDFixed df = ONE + 2*fxMul(k, 3*y - py);
+		SDFixed step = fxQuot(f, df);
+		if (step <= 0) break;
+		x -= step;
+	}
+	// rounding stops Newton a few ulps short; finish on the smallest x with f(x) >= 0
+	for (int i = 0; i < 8 && fxParabolaRoot(x - 1, px, py, k, &y) >= 0; i++) x--;
+	fxParabolaRoot(x, px, py, k, &y);
+	SDFixed d = fxLength(px - x, py - y);
+	// inside is on the concave side: py - kpx^2 has the sign of k
+	int64_t e = (int64_t)py * ONE - (((int64_t)px * px) >> S) * k;
+	return (k > 0 ? e > 0 : e < 0) ? -d : d;
+}
+
+SDFixed sdqCross(SDFixed px, SDFixed py, SDFixed bx, SDFixed by, SDFixed r)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	if (py > px) {
+		SDFixed temp = px;
+		px = py;
+		py = temp;
+	}
+	SDFixed qx = px - bx;
+	SDFixed qy = py - by;
+	SDFixed k = fxMax(qx, qy);
+	SDFixed wx, wy;
+	if (k > 0) {
+		wx = qx;
+		wy = qy;
+	} else {
+		wx = by - px;
+		wy = -k;
+	}
+	SDFixed d = fxLength(fxMax(wx, 0), fxMax(wy, 0));
+	return (k > 0 ? d : -d) + r;
+}
+
+SDFixed sdqRoundedX(SDFixed px, SDFixed py, SDFixed w, SDFixed r)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	SDFixed m = fxMin(px + py, w) / 2;
+	return fxLength(px - m, py - m) - r;
+}
+
+SDFixed sdqEllipse(SDFixed px, SDFixed py, SDFixed ex, SDFixed ey)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	int64_t e2 = (int64_t)ex*ex - (int64_t)ey*ey;
+	SDFixed veX = fxQuot(e2, (int64_t)ex*ONE);
+	SDFixed veY = fxQuot(-e2, (int64_t)ey*ONE);
+	SDFixed tX = K(0.70710678118654752);
+	SDFixed tY = K(0.70710678118654752);
+	for (int i = 0; i < 3; i++) {
+		SDFixed vX = fxMul(veX, fxMul(tX, fxMul(tX, tX)));
+		SDFixed vY = fxMul(veY, fxMul(tY, fxMul(tY, tY)));
+		SDFixed tmx = px - vX;
+		SDFixed tmy = py - vY;
+		SDFixed n = fxLength(tmx, tmy);
+		SDFixed u = fxLength(fxMul(tX, ex) - vX, fxMul(tY, ey) - vY);
+		SDFixed uX = fxQuot((int64_t)tmx*u, (int64_t)n*ONE);
+		SDFixed uY = fxQuot((int64_t)tmy*u, (int64_t)n*ONE);
+		SDFixed cx = fxClamp(fxQuot(vX + uX, ex), 0, ONE);
+		SDFixed cy = fxClamp(fxQuot(vY + uY, ey), 0, ONE);
+		n = fxLength(cx, cy);
+		tX = fxQuot(cx, n);
+		tY = fxQuot(cy, n);
+	}
+	SDFixed nx = fxMul(tX, ex);
+	SDFixed ny = fxMul(tY, ey);
+	SDFixed d = fxLength(px - nx, py - ny);
+	return fxDot(px, py, px, py) < fxDot(nx, ny, nx, ny) ? -d : d;
+}
+
+SDFixed sdqEllipseLinf(SDFixed px, SDFixed py, SDFixed ex, SDFixed ey)
+{
+	px = fxAbs(px);
+	py = fxAbs(py);
+	SDFixed ay = px-ex;
+	SDFixed ax = py-ey;
+	px = fxMax(px, ax);
+	py = fxMax(py, ay);
+	int64_t m = fxDot(ex, ey, ex, ey);
+	SDFixed d = py-px;
+	SDFixed sq = fxSqrtWide(m - (int64_t)d*d);
+	return px - fxQuot((int64_t)(fxMul(ey, sq) - fxMul(ex, d)) * ex, m);
+}
+
+// p -= 2 * min(dot(k, p), 0) * k, for a unit vector k
+static inline void fxReflect(SDFixed kx, SDFixed ky, SDFixed *px, SDFixed *py)
+{
+	SDFixed d = fxMin((SDFixed)(fxDot(kx, ky, *px, *py) >> S), 0);
+	*px -= 2 * fxMul(d, kx);
+	*py -= 2 * fxMul(d, ky);
+}
+
+SDFixed sdqStar5(SDFixed px, SDFixed py, SDFixed r, SDFixed rf)
+{
+	const SDFixed kx = K(0.809016994375);
+	const SDFixed ky = K(-0.587785252292);
+	px = fxAbs(px);
+	fxReflect(-kx, -ky, &px, &py);   // the float version reflects on max(dot(k, p), 0)
+	fxReflect(kx, -ky, &px, &py);
+	px = fxAbs(px);
+	py = py - r;
+	SDFixed bax = fxMul(-ky, rf);
+	SDFixed bay = fxMul(kx, rf) - ONE;
+	SDFixed h = fxClamp(fxQuot(fxDot(px, py, bax, bay), fxDot(bax, bay, bax, bay)), 0, r);
+	int64_t s = (int64_t)py*bax - (int64_t)px*bay;
+	return fxLength(px - fxMul(bax, h), py - fxMul(bay, h)) * fxSign(s);
+}
+
+SDFixed sdqHexagram(SDFixed px, SDFixed py, SDFixed r)
+{
+	const SDFixed kx = K(-0.5);
+	const SDFixed ky = K(0.8660254038);
+	const SDFixed kz = K(0.5773502692);
+	const SDFixed kw = K(1.7320508076);
+	px = fxAbs(px);
+	py = fxAbs(py);
+	fxReflect(kx, ky, &px, &py);
+	fxReflect(ky, kx, &px, &py);
+	px -= fxClamp(px, fxMul(r, kz), fxMul(r, kw));
+	py -= r;
+	return fxLength(px, py) * fxSign(py);
+}
+
+SDFixed sdqPentagon(SDFixed px, SDFixed py, SDFixed r)
+{
+	const SDFixed kx = K(0.809016994);
+	const SDFixed ky = K(0.587785252);
+	const SDFixed kz = K(0.726542528);
+	px = fxAbs(px);
+	fxReflect(-kx, ky, &px, &py);
+	fxReflect(kx, ky, &px, &py);
+	px -= fxClamp(px, -fxMul(r, kz), fxMul(r, kz));
+	py -= r;
+	return fxLength(px, py) * fxSign(py);
+}
+
+SDFixed sdqHexagon(SDFixed px, SDFixed py, SDFixed s)
+{
+	const SDFixed kx = K(-0.866025404);
+	const SDFixed ky = K(0.5);
+	const SDFixed kz = K(0.577350269);
+	px = fxAbs(px);
+	py = fxAbs(py);
+	fxReflect(kx, ky, &px, &py);
+	px -= fxClamp(px, -fxMul(kz, s), fxMul(kz, s));
+	py -= s;
+	return fxLength(px, py) * fxSign(py);
+}
+
+SDFixed sdqOctagon(SDFixed px, SDFixed py, SDFixed r)
+{
+	const SDFixed kx = K(-0.9238795325);
+	const SDFixed ky = K(0.3826834323);
+	const SDFixed kz = K(0.4142135623);
+	px = fxAbs(px);
+	py = fxAbs(py);
+	fxReflect(kx, ky, &px, &py);
+	fxReflect(-kx, ky, &px, &py);
+	px -= fxClamp(px, -fxMul(kz, r), fxMul(kz, r));
+	py -= r;
+	return fxLength(px, py) * fxSign(py);
+}
+
+SDFixed sdqRegularPolygon(SDFixed px, SDFixed py, SDFixed r, int n)
+{
+	SDFixed an = K(3.141593) / n;
+	SDFixed acsX, acsY;
+	sdFixedSinCos(an, &acsY, &acsX);
+	SDFixed fm = sdFixedAtan2(py, px) % (2 * an);
+	if (fm < 0) fm += 2 * an;
+	SDFixed cb, sb;
+	sdFixedSinCos(fm - an, &sb, &cb);
+	SDFixed pMag = fxLength(px, py);
+	px = fxMul(cb, pMag) - fxMul(acsX, r);
+	py = fxMul(fxAbs(sb), pMag) - fxMul(acsY, r);
+	py += fxClamp(-py, 0, fxMul(acsY, r));
+	return fxLength(px, py) * fxSign(px);
+}
+
+SDFixed sdqPolygon(SDFixed px, SDFixed py, const SDFixed vx[], const SDFixed vy[], int n)
+{
+	int64_t d = fxDot(px - vx[0], py - vy[0], px - vx[0], py - vy[0]);
+	int s = 1;
+	for (int i = 0, j = n - 1; i < n; j = i++) {
+		SDFixed ex = vx[j] - vx[i];
+		SDFixed ey = vy[j] - vy[i];
+		SDFixed wx = px - vx[i];
+		SDFixed wy = py - vy[i];
+		int64_t dc = fxEdgeDistance(wx, wy, ex, ey);
+		if (dc < d) d = dc;
+		int c1 = (py >= vy[i]);
+		int c2 = (py < vy[j]);
+		int c3 = ((int64_t)ex * wy > (int64_t)ey * wx);
+		if ((c1 && c2 && c3) || (!c1 && !c2 && !c3))
+			s = -s;
+	}
+	return s * fxSqrtWide(d);
+}
@@ -0,0 +1,94 @@
+#ifndef SDF2D_FIXED_H
+#define SDF2D_FIXED_H
+
+// Fixed-point build of the SDFs in sdf2d.h for CPUs without an FPU, where every float operation
+// is a soft-float library call. sdqXxx takes and returns SDFixed values with SDF2D_FIXED_SHIFT
+// fractional bits (default 16, ie Q16.16) and uses no floating point at all: square roots are
+// integer, the trig in sdqRegularPolygon is CORDIC, and sdqParabola finds its closest point by
+// Newton iteration instead of the cube roots and acos of sdParabola.
+//
+// Values are 32 bit; products and squared lengths are 64 bit, so coordinates and shape sizes up to
+// +/-2^(30-SDF2D_FIXED_SHIFT) are safe (16384 at Q16.16). Build with -DSDF2D_FIXED_SHIFT=8 for a
+// 24.8 format with a much larger range and 1/256 precision; expect errors of a pixel or two on
+// shapes a few hundred pixels across, where Q16.16 stays within 0.01.
+//
+//	SDFixed d = sdqCircle(sdFixedFromInt(x) - cx, sdFixedFromInt(y) - cy, radius);
+//	if (d < 0) ...
+
+#include <stdint.h>
+
+#ifndef SDF2D_FIXED_SHIFT
+#define SDF2D_FIXED_SHIFT 16
+#endif
+
+typedef int32_t SDFixed;
+
+#define SD_FIXED_ONE ((SDFixed)1 << SDF2D_FIXED_SHIFT)
+
+// Conversions. sdFixedConst is for literals, so that constants cost nothing at run time. The float
+// conversions are inline so that sdf2d_fixed.c itself has no float code.
+#define sdFixedConst(x) ((SDFixed)((x) * (double)SD_FIXED_ONE + ((x) < 0 ? -0.5 : 0.5)))
+#define sdFixedFromInt(i) ((SDFixed)((i) * SD_FIXED_ONE))
+#define sdFixedToInt(a) ((a) >> SDF2D_FIXED_SHIFT)
+
+static inline SDFixed sdFixedFromFloat(float f)
+{
+	float s = f * (float)SD_FIXED_ONE;
+	return (SDFixed)(s < 0.0f ? s - 0.5f : s + 0.5f);
+}
+
+static inline float sdFixedToFloat(SDFixed a)
+{
+	return (float)a * (1.0f / (float)SD_FIXED_ONE);
+}
+
+// Arithmetic
+SDFixed sdFixedMul(SDFixed a, SDFixed b);
+SDFixed sdFixedDiv(SDFixed a, SDFixed b);          // saturates on overflow and division by 0
+uint32_t sdFixedIsqrt64(uint64_t x);                // floor(sqrt(x))
+SDFixed sdFixedSqrt(SDFixed a);                     // 0 for a <= 0
+SDFixed sdFixedAtan2(SDFixed y, SDFixed x);         // radians, CORDIC
+void sdFixedSinCos(SDFixed angle, SDFixed *s, SDFixed *c);
+
+// SDFs, with the same arguments as in sdf2d.h
+SDFixed sdqCircle(SDFixed px, SDFixed py, SDFixed r);
+SDFixed sdqBox(SDFixed px, SDFixed py, SDFixed bx, SDFixed by);
+SDFixed sdqBoxLinf(SDFixed px, SDFixed py, SDFixed bx, SDFixed by);
+SDFixed sdqRoundedBox(SDFixed px, SDFixed py, SDFixed bx, SDFixed by, SDFixed rw, SDFixed rx, SDFixed ry, SDFixed rz);
+SDFixed sdqOrientedBox(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by, SDFixed th);
+SDFixed sdqSegment(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by);
+SDFixed sdqSegmentLinf(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by);
+SDFixed sdqRhombus(SDFixed px, SDFixed py, SDFixed bx, SDFixed by);
+SDFixed sdqRhombusLinf(SDFixed px, SDFixed py, SDFixed bx, SDFixed by);
+SDFixed sdqTrapezoid(SDFixed px, SDFixed py, SDFixed r1, SDFixed r2, SDFixed he);
+SDFixed sdqParallelogram(SDFixed px, SDFixed py, SDFixed wi, SDFixed he, SDFixed sk);
+SDFixed sdqTriangle(SDFixed px, SDFixed py, SDFixed p0x, SDFixed p0y, SDFixed p1x, SDFixed p1y, SDFixed p2x, SDFixed p2y);
+SDFixed sdqTriangleIsosceles(SDFixed px, SDFixed py, SDFixed qx, SDFixed qy);
+SDFixed sdqEquilateralTriangle(SDFixed px, SDFixed py, SDFixed r);
+SDFixed sdqQuad(SDFixed px, SDFixed py, SDFixed p0x, SDFixed p0y, SDFixed p1x, SDFixed p1y, SDFixed p2x, SDFixed p2y, SDFixed p3x, SDFixed p3y);
+SDFixed sdqStar5(SDFixed px, SDFixed py, SDFixed r, SDFixed rf);
+SDFixed sdqPentagon(SDFixed px, SDFixed py, SDFixed r);
+SDFixed sdqHexagon(SDFixed px, SDFixed py, SDFixed s);
+SDFixed sdqOctagon(SDFixed px, SDFixed py, SDFixed r);
+SDFixed sdqHexagram(SDFixed px, SDFixed py, SDFixed r);
+SDFixed sdqPie(SDFixed px, SDFixed py, SDFixed cx, SDFixed cy, SDFixed r);
+SDFixed sdqCutDisk(SDFixed px, SDFixed py, SDFixed r, SDFixed h);
+SDFixed sdqArc(SDFixed px, SDFixed py, SDFixed scx, SDFixed scy, SDFixed ra, SDFixed rb);
+SDFixed sdqRing(SDFixed px, SDFixed py, SDFixed nx, SDFixed ny, SDFixed r, SDFixed th);
+SDFixed sdqHorseshoe(SDFixed px, SDFixed py, SDFixed cx, SDFixed cy, SDFixed r, SDFixed le, SDFixed th);
+SDFixed sdqVesica(SDFixed px, SDFixed py, SDFixed r, SDFixed d);
+SDFixed sdqOrientedVesica(SDFixed px, SDFixed py, SDFixed ax, SDFixed ay, SDFixed bx, SDFixed by, SDFixed w);
+SDFixed sdqMoon(SDFixed px, SDFixed py, SDFixed d, SDFixed ra, SDFixed rb);
+SDFixed sdqCross(SDFixed px, SDFixed py, SDFixed bx, SDFixed by, SDFixed r);
+SDFixed sdqRoundedX(SDFixed px, SDFixed py, SDFixed w, SDFixed r);
+SDFixed sdqParabola(SDFixed px, SDFixed py, SDFixed k);
+SDFixed sdqTunnel(SDFixed px, SDFixed py, SDFixed whx, SDFixed why);
+SDFixed sdqEllipse(SDFixed px, SDFixed py, SDFixed ex, SDFixed ey);
+SDFixed sdqEllipseLinf(SDFixed px, SDFixed py, SDFixed ex, SDFixed ey);
+SDFixed sdqRegularPolygon(SDFixed px, SDFixed py, SDFixed r, int n);
+SDFixed sdqPolygon(SDFixed px, SDFixed py, const SDFixed vx[], const SDFixed vy[], int num);
+SDFixed sdqRoundSquare(SDFixed px, SDFixed py, SDFixed s, SDFixed r);
+SDFixed sdqEgg(SDFixed px, SDFixed py, SDFixed ra, SDFixed rb);
+SDFixed sdqUnevenCapsule(SDFixed px, SDFixed py, SDFixed r1, SDFixed r2, SDFixed h);
+
+#endif
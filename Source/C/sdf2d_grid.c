@@ -0,0 +1,390 @@
+// Baked distance grids. See sdf2d_grid.h.
+
+#include "sdf2d_grid.h"
+#include "sdf2d_tiles.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SD_GRID_TILE_SAMPLES ((SD_GRID_TILE + 1) * (SD_GRID_TILE + 1))
+#define SD_GRID_CHUNK 64
+
+enum {
+	kGridFarOutside = -1,
+	kGridFarInside = -2
+};
+
+static const size_t sdGridSampleSize[] = { 1, 2, 4 };
+
+void sdGridInit(SDGrid *grid)
+{
+	memset(grid, 0, sizeof(SDGrid));
+}
+
+void sdGridFree(SDGrid *grid)
+{
+	if (!grid->external) {
+		free(grid->tiles);
+		free(grid->data);
+	}
+	sdGridInit(grid);
+}
+
+// Quantise a distance into sample i of data
+static void sdGridEncode(const SDGrid *grid, void *data, size_t i, float d)
+{
+	float r = grid->layout.range;
+	d = fmaxf(-r, fminf(d, r));
+	switch (grid->layout.format) {
+	case kSDGridInt8: ((signed char *)data)[i] = (signed char)lrintf(d / grid->scale); break;
+	case kSDGridUInt16: ((unsigned short *)data)[i] = (unsigned short)lrintf((d - grid->bias) / grid->scale); break;
+	default: ((float *)data)[i] = d; break;
+	}
+}
+
+static int sdGridSetup(SDGrid *grid, const SDGridLayout *layout)
+{
+	sdGridFree(grid);
+	if (layout->width < 2 || layout->height < 2 || !(layout->cell > 0.0f) || !(layout->range > 0.0f)) return -1;
+	if ((unsigned)layout->format > kSDGridFloat) return -1;
+	grid->layout = *layout;
+	grid->invCell = 1.0f / layout->cell;
+	switch (layout->format) {
+	case kSDGridInt8: grid->scale = layout->range / 127.0f; grid->bias = 0.0f; break;
+	case kSDGridUInt16: grid->scale = 2.0f * layout->range / 65535.0f; grid->bias = -layout->range; break;
+	default: grid->scale = 1.0f; grid->bias = 0.0f; break;
+	}
+	float step = layout->format == kSDGridFloat ? 0.0f : grid->scale;
+	grid->error = layout->cell * 0.70710678f + step * 0.5f;
+	return 0;
+}
+
+static void sdGridDenseVisit(void *ctx, const SDTile *tile, const float *d)
+{
+	SDGrid *grid = ctx;
+	for (int j = 0; j < tile->h; j++) {
+		size_t row = (size_t)(tile->y + j) * grid->layout.width + tile->x;
+		for (int i = 0; i < tile->w; i++) sdGridEncode(grid, grid->data, row + i, d ? d[j * tile->w + i] : tile->d);
+	}
+}
+
+// Row-major samples. Tiles that clamp to +/-range throughout are filled without sampling them.
+static int sdGridBakeDense(SDGrid *grid, SDGridSampler sample, void *ctx)
+{
+	const SDGridLayout *l = &grid->layout;
+	grid->bytes = (size_t)l->width * l->height * sdGridSampleSize[l->format];
+	grid->data = malloc(grid->bytes);
+	if (!grid->data) return -1;
+	SDTileLayout tiles = { l->x, l->y, l->width, l->height, l->cell, -l->range, l->range };
+	sdTileWalk(&tiles, sample, ctx, sdGridDenseVisit, grid, NULL);
+	grid->stride = l->width;
+	return 0;
+}
+
+// Sample every point of tile (tx, ty) into tile. Samples past the last row or column repeat the
+// edge. Returns kGridFarOutside or kGridFarInside if all of them clamp to that side, else 0.
+static int sdGridSampleTile(const SDGrid *grid, int tx, int ty, SDGridSampler sample, void *ctx, unsigned char *tile)
+{
+	const SDGridLayout *l = &grid->layout;
+	size_t size = sdGridSampleSize[l->format];
+	float px[SD_GRID_TILE_SAMPLES], py[SD_GRID_TILE_SAMPLES], out[SD_GRID_TILE_SAMPLES];
+	unsigned char far[2][4];
+	sdGridEncode(grid, far[0], 0, l->range);
+	sdGridEncode(grid, far[1], 0, -l->range);
+
+	for (int j = 0; j <= SD_GRID_TILE; j++) {
+		int y = ty * SD_GRID_TILE + j;
+		if (y >= l->height) y = l->height - 1;
+		for (int i = 0; i <= SD_GRID_TILE; i++) {
+			int x = tx * SD_GRID_TILE + i;
+			if (x >= l->width) x = l->width - 1;
+			px[j * grid->stride + i] = l->x + x * l->cell;
+			py[j * grid->stride + i] = l->y + y * l->cell;
+		}
+	}
+	sample(ctx, px, py, out, SD_GRID_TILE_SAMPLES);
+	int far0 = 1, far1 = 1;
+	for (int i = 0; i < SD_GRID_TILE_SAMPLES; i++) {
+		sdGridEncode(grid, tile, i, out[i]);
+		far0 &= memcmp(tile + i * size, far[0], size) == 0;
+		far1 &= memcmp(tile + i * size, far[1], size) == 0;
+	}
+	return far0 ? kGridFarOutside : far1 ? kGridFarInside : 0;
+}
+
+// Tiles of (SD_GRID_TILE + 1)^2 samples, so that every cell can be interpolated from one tile.
+static int sdGridBakeTiles(SDGrid *grid, SDGridSampler sample, void *ctx)
+{
+	const SDGridLayout *l = &grid->layout;
+	size_t size = sdGridSampleSize[l->format];
+	unsigned char tile[SD_GRID_TILE_SAMPLES * 4];
+	size_t cap = 0;
+
+	grid->tilesX = (l->width - 1 + SD_GRID_TILE - 1) / SD_GRID_TILE;
+	grid->tilesY = (l->height - 1 + SD_GRID_TILE - 1) / SD_GRID_TILE;
+	grid->tiles = malloc(grid->tilesX * grid->tilesY * sizeof(int));
+	if (!grid->tiles) return -1;
+	grid->stride = SD_GRID_TILE + 1;
+
+	// every sample of a tile is within r of its center
+	float r = l->cell * SD_GRID_TILE * 0.70710678f;
+	for (int ty = 0; ty < grid->tilesY; ty++) {
+		for (int tx = 0; tx < grid->tilesX; tx++) {
+			int *t = &grid->tiles[ty * grid->tilesX + tx];
+			float cx = l->x + (tx + 0.5f) * SD_GRID_TILE * l->cell;
+			float cy = l->y + (ty + 0.5f) * SD_GRID_TILE * l->cell;
+			float dc;
+			sample(ctx, &cx, &cy, &dc, 1);
+			if (fabsf(dc) - r >= l->range) {
+				*t = dc > 0.0f ? kGridFarOutside : kGridFarInside;
+				continue;
+			}
+			int far = sdGridSampleTile(grid, tx, ty, sample, ctx, tile);
+			if (far) {
+				*t = far;
+				continue;
+			}
+			if (grid->bytes + sizeof(tile) > cap) {
+				size_t c = cap ? cap * 2 : 16 * SD_GRID_TILE_SAMPLES * size;
+				void *data = realloc(grid->data, c);
+				if (!data) return -1;
+				grid->data = data;
+				cap = c;
+			}
+			*t = (int)(grid->bytes / size);
+			memcpy((unsigned char *)grid->data + grid->bytes, tile, SD_GRID_TILE_SAMPLES * size);
+			grid->bytes += SD_GRID_TILE_SAMPLES * size;
+		}
+	}
+	return 0;
+}
+
+int sdGridBake(SDGrid *grid, const SDGridLayout *layout, SDGridSampler sample, void *ctx)
+{
+	if (sdGridSetup(grid, layout) < 0) return -1;
+	int r = layout->narrow ? sdGridBakeTiles(grid, sample, ctx) : sdGridBakeDense(grid, sample, ctx);
+	if (r < 0) sdGridFree(grid);
+	return r;
+}
+
+typedef struct {
+	const SDShape *shape;
+	float x, y;
+} SDGridShapeContext;
+
+static void sdGridShapeSampler(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	const SDGridShapeContext *c = ctx;
+	float lx[SD_GRID_CHUNK], ly[SD_GRID_CHUNK];
+	for (size_t i = 0; i < n; i += SD_GRID_CHUNK) {
+		size_t m = (n - i < SD_GRID_CHUNK) ? n - i : SD_GRID_CHUNK;
+		for (size_t j = 0; j < m; j++) {
+			lx[j] = px[i + j] - c->x;
+			ly[j] = py[i + j] - c->y;
+		}
+		sdShapeEvalBatch(c->shape, lx, ly, out + i, m);
+	}
+}
+
+int sdGridBakeShape(SDGrid *grid, const SDGridLayout *layout, const SDShape *shape, float x, float y)
+{
+	SDGridShapeContext c = { shape, x, y };
+	return sdGridBake(grid, layout, sdGridShapeSampler, &c);
+}
+
+static void sdGridSceneSampler(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	sdSceneEvalBatch(ctx, px, py, out, n);
+}
+
+int sdGridBakeScene(SDGrid *grid, const SDGridLayout *layout, const SDScene *scene)
+{
+	return sdGridBake(grid, layout, sdGridSceneSampler, (void *)scene);
+}
+
+// Row spans of the rect, a chunk at a time
+static long sdGridResampleDense(SDGrid *grid, int x0, int y0, int x1, int y1, SDGridSampler sample, void *ctx)
+{
+	const SDGridLayout *l = &grid->layout;
+	float px[SD_GRID_CHUNK], py[SD_GRID_CHUNK], out[SD_GRID_CHUNK];
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x += SD_GRID_CHUNK) {
+			int m = (x1 + 1 - x < SD_GRID_CHUNK) ? x1 + 1 - x : SD_GRID_CHUNK;
+			for (int i = 0; i < m; i++) {
+				px[i] = l->x + (x + i) * l->cell;
+				py[i] = l->y + y * l->cell;
+			}
+			sample(ctx, px, py, out, m);
+			size_t row = (size_t)y * grid->stride + x;
+			for (int i = 0; i < m; i++) sdGridEncode(grid, grid->data, row + i, out[i]);
+		}
+	}
+	return (long)(x1 - x0 + 1) * (y1 - y0 + 1);
+}
+
+// Stored tiles re-sample their samples in the rect (the shared edges of neighbouring tiles and the
+// repeated last row and column included). Unstored tiles are sampled in full and appended if they
+// now reach the surface.
+static long sdGridResampleTiles(SDGrid *grid, int x0, int y0, int x1, int y1, SDGridSampler sample, void *ctx)
+{
+	const SDGridLayout *l = &grid->layout;
+	size_t size = sdGridSampleSize[l->format];
+	float px[SD_GRID_TILE_SAMPLES], py[SD_GRID_TILE_SAMPLES], out[SD_GRID_TILE_SAMPLES];
+	int offset[SD_GRID_TILE_SAMPLES];
+	unsigned char tile[SD_GRID_TILE_SAMPLES * 4];
+	long count = 0;
+
+	// tile t holds samples t * SD_GRID_TILE .. (t + 1) * SD_GRID_TILE of a row or column
+	int tx0 = x0 > 0 ? (x0 - 1) / SD_GRID_TILE : 0;
+	int ty0 = y0 > 0 ? (y0 - 1) / SD_GRID_TILE : 0;
+	int tx1 = x1 / SD_GRID_TILE < grid->tilesX ? x1 / SD_GRID_TILE : grid->tilesX - 1;
+	int ty1 = y1 / SD_GRID_TILE < grid->tilesY ? y1 / SD_GRID_TILE : grid->tilesY - 1;
+	for (int ty = ty0; ty <= ty1; ty++) {
+		for (int tx = tx0; tx <= tx1; tx++) {
+			int *t = &grid->tiles[ty * grid->tilesX + tx];
+			if (*t < 0) {
+				int far = sdGridSampleTile(grid, tx, ty, sample, ctx, tile);
+				count += SD_GRID_TILE_SAMPLES;
+				if (far) {
+					*t = far;
+					continue;
+				}
+				void *data = realloc(grid->data, grid->bytes + SD_GRID_TILE_SAMPLES * size);
+				if (!data) return -1;
+				grid->data = data;
+				*t = (int)(grid->bytes / size);
+				memcpy((unsigned char *)grid->data + grid->bytes, tile, SD_GRID_TILE_SAMPLES * size);
+				grid->bytes += SD_GRID_TILE_SAMPLES * size;
+				continue;
+			}
+			int n = 0;
+			for (int j = 0; j <= SD_GRID_TILE; j++) {
+				int y = ty * SD_GRID_TILE + j;
+				if (y >= l->height) y = l->height - 1;
+				if (y < y0 || y > y1) continue;
+				for (int i = 0; i <= SD_GRID_TILE; i++) {
+					int x = tx * SD_GRID_TILE + i;
+					if (x >= l->width) x = l->width - 1;
+					if (x < x0 || x > x1) continue;
+					offset[n] = j * grid->stride + i;
+					px[n] = l->x + x * l->cell;
+					py[n] = l->y + y * l->cell;
+					n++;
+				}
+			}
+			if (n == 0) continue;
+			sample(ctx, px, py, out, n);
+			for (int k = 0; k < n; k++) sdGridEncode(grid, grid->data, (size_t)*t + offset[k], out[k]);
+			count += n;
+		}
+	}
+	return count;
+}
+
+long sdGridResample(SDGrid *grid, int x, int y, int w, int h, SDGridSampler sample, void *ctx)
+{
+	if ((!grid->data && !grid->tiles) || grid->external) return -1;
+	int x0 = x > 0 ? x : 0, y0 = y > 0 ? y : 0;
+	int x1 = x + w - 1 < grid->layout.width - 1 ? x + w - 1 : grid->layout.width - 1;
+	int y1 = y + h - 1 < grid->layout.height - 1 ? y + h - 1 : grid->layout.height - 1;
+	if (x0 > x1 || y0 > y1) return 0;
+	if (grid->layout.narrow) return sdGridResampleTiles(grid, x0, y0, x1, y1, sample, ctx);
+	return sdGridResampleDense(grid, x0, y0, x1, y1, sample, ctx);
+}
+
+// Corner distances c (x0y0, x1y0, x0y1, x1y1) and bilinear weights of the cell at (px, py), with the
+// point clamped to the grid. (ox, oy) is the part of p outside the grid, in cells.
+static inline void sdGridCell(const SDGrid *grid, float px, float py, float c[4], float *fx, float *fy, float *ox, float *oy)
+{
+	const SDGridLayout *l = &grid->layout;
+	float u = (px - l->x) * grid->invCell;
+	float v = (py - l->y) * grid->invCell;
+	float cu = fmaxf(0.0f, fminf(u, (float)(l->width - 1)));
+	float cv = fmaxf(0.0f, fminf(v, (float)(l->height - 1)));
+	*ox = u - cu;
+	*oy = v - cv;
+	int ix = (int)cu;
+	int iy = (int)cv;
+	if (ix > l->width - 2) ix = l->width - 2;
+	if (iy > l->height - 2) iy = l->height - 2;
+	*fx = cu - ix;
+	*fy = cv - iy;
+
+	size_t i = (size_t)iy * grid->stride + ix;
+	if (grid->tiles) {
+		unsigned tx = (unsigned)ix / SD_GRID_TILE, ty = (unsigned)iy / SD_GRID_TILE;
+		int t = grid->tiles[ty * grid->tilesX + tx];
+		if (t < 0) {
+			c[0] = c[1] = c[2] = c[3] = (t == kGridFarOutside) ? l->range : -l->range;
+			return;
+		}
+		i = t + ((unsigned)iy - ty * SD_GRID_TILE) * grid->stride + ((unsigned)ix - tx * SD_GRID_TILE);
+	}
+	size_t s = grid->stride;
+	switch (l->format) {
+	case kSDGridInt8: {
+		const signed char *q = (const signed char *)grid->data + i;
+		c[0] = q[0] * grid->scale;
+		c[1] = q[1] * grid->scale;
+		c[2] = q[s] * grid->scale;
+		c[3] = q[s + 1] * grid->scale;
+		break;
+	}
+	case kSDGridUInt16: {
+		const unsigned short *q = (const unsigned short *)grid->data + i;
+		c[0] = q[0] * grid->scale + grid->bias;
+		c[1] = q[1] * grid->scale + grid->bias;
+		c[2] = q[s] * grid->scale + grid->bias;
+		c[3] = q[s + 1] * grid->scale + grid->bias;
+		break;
+	}
+	default: {
+		const float *q = (const float *)grid->data + i;
+		c[0] = q[0];
+		c[1] = q[1];
+		c[2] = q[s];
+		c[3] = q[s + 1];
+		break;
+	}
+	}
+}
+
+float sdGridEval(const SDGrid *grid, float px, float py)
+{
+	float c[4], fx, fy, ox, oy;
+	if (!grid->data && !grid->tiles) return SD_BOUNDS_HUGE;
+	sdGridCell(grid, px, py, c, &fx, &fy, &ox, &oy);
+	float a = c[0] + (c[1] - c[0]) * fx;
+	float b = c[2] + (c[3] - c[2]) * fx;
+	float d = a + (b - a) * fy;
+	if (ox != 0.0f || oy != 0.0f) d += sqrtf(ox * ox + oy * oy) * grid->layout.cell;
+	return d;
+}
+
+float sdgGridEval(const SDGrid *grid, float px, float py, float *gx, float *gy)
+{
+	float c[4], fx, fy, ox, oy;
+	if (!grid->data && !grid->tiles) {
+		*gx = *gy = 0.0f;
+		return SD_BOUNDS_HUGE;
+	}
+	sdGridCell(grid, px, py, c, &fx, &fy, &ox, &oy);
+	float a = c[0] + (c[1] - c[0]) * fx;
+	float b = c[2] + (c[3] - c[2]) * fx;
+	float d = a + (b - a) * fy;
+	*gx = ((c[1] - c[0]) + ((c[3] - c[2]) - (c[1] - c[0])) * fy) * grid->invCell;
+	*gy = (b - a) * grid->invCell;
+	if (ox != 0.0f || oy != 0.0f) {
+		// clamped axes do not vary with p; the distance to the grid does
+		float o = sqrtf(ox * ox + oy * oy);
+		d += o * grid->layout.cell;
+		if (ox != 0.0f) *gx = ox / o;
+		if (oy != 0.0f) *gy = oy / o;
+	}
+	return d;
+}
+
+void sdGridEvalBatch(const SDGrid *grid, const float *px, const float *py, float *out, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdGridEval(grid, px[i], py[i]);
+}
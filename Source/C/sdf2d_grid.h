@@ -0,0 +1,86 @@
+#ifndef SDF2D_GRID_H
+#define SDF2D_GRID_H
+
+// Baked distance grids: static geometry sampled once into a grid, then looked up with bilinear
+// interpolation in a handful of multiply-adds instead of evaluating the SDFs every frame.
+//
+//	SDGridLayout layout = { kSDGridInt8, 0, 0, 101, 61, 4.0f, 32.0f, 1 };
+//	SDGrid grid;
+//	sdGridInit(&grid);
+//	sdGridBakeScene(&grid, &layout, &terrain);
+//	...
+//	float gx, gy;
+//	float d = sdgGridEval(&grid, px, py, &gx, &gy);
+//	sdGridFree(&grid);
+//
+// Distances are clamped to +/-range, which also sets the int8/uint16 quantisation step. Error bound:
+// inside the grid and where the exact distance is within range, |sdGridEval - d| <= grid.error,
+// where error = cell/sqrt(2) + step/2. The cell term is the worst case for a 1-Lipschitz SDF (at
+// kinks and the medial axis); on smooth stretches of surface it is closer to cell^2*curvature/8.
+// The gradient is that of the bilinear interpolant, so it is smooth within a cell and may turn
+// across a kink.
+//
+// Narrow band: the grid is stored as SD_GRID_TILE x SD_GRID_TILE cell tiles, and tiles whose samples
+// all clamp to +range or -range are not stored at all, so memory is proportional to the length of
+// the surface instead of the area. Lookups in those tiles return +/-range with a zero gradient, the
+// same as a dense grid would.
+
+#include <stddef.h>
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+
+#define SD_GRID_TILE 8
+
+typedef enum {
+	kSDGridInt8,         // 1 byte per sample, step range/127
+	kSDGridUInt16,       // 2 bytes per sample, step 2*range/65535
+	kSDGridFloat         // 4 bytes per sample, no quantisation
+} SDGridFormat;
+
+typedef struct {
+	SDGridFormat format;
+	float x, y;          // world position of sample (0, 0)
+	int width, height;   // samples per row and column, at least 2
+	float cell;          // sample spacing in world units
+	float range;         // distances are clamped to +/-range
+	int narrow;          // store only the tiles near the surface
+} SDGridLayout;
+
+typedef struct {
+	SDGridLayout layout;
+	float invCell;
+	float scale, bias;   // distance = sample * scale + bias
+	float error;         // see above
+	int tilesX, tilesY;
+	int *tiles;          // narrow band: sample offset of each tile, -1 if unstored at +range, -2 at -range
+	int stride;          // samples per stored row: width, or SD_GRID_TILE + 1 for tiles
+	void *data;
+	size_t bytes;        // size of data
+	int external;        // tiles and data belong to an asset (sdf2d_asset.h): not freed or resampled
+} SDGrid;
+
+// Samples n points: out[i] = distance at (px[i], py[i]).
+typedef void (*SDGridSampler)(void *ctx, const float *px, const float *py, float *out, size_t n);
+
+void sdGridInit(SDGrid *grid);
+void sdGridFree(SDGrid *grid);
+
+// Bake a grid, replacing any previous contents. Each returns 0, or -1 on a bad layout or allocation failure.
+// Regions that clamp to +/-range are found with tile culling (sdf2d_tiles.h) and never sampled, so
+// a custom sampler must be a distance: it may not change faster than the point moves.
+int sdGridBake(SDGrid *grid, const SDGridLayout *layout, SDGridSampler sample, void *ctx);
+int sdGridBakeShape(SDGrid *grid, const SDGridLayout *layout, const SDShape *shape, float x, float y);
+int sdGridBakeScene(SDGrid *grid, const SDGridLayout *layout, const SDScene *scene);
+
+// Re-sample columns x .. x + w - 1 and rows y .. y + h - 1 (clipped to the grid) after the geometry
+// changed there; sdf2d_dirty.h finds those rects for moving shapes. Narrow band tiles that were not
+// stored are sampled in full, and appended if they now reach the surface; stored tiles stay stored.
+// Returns the number of samples evaluated, or -1 on an unbaked or external grid or allocation failure.
+long sdGridResample(SDGrid *grid, int x, int y, int w, int h, SDGridSampler sample, void *ctx);
+
+// Bilinear lookup. Outside the grid the distance is the edge value plus the distance to the grid.
+float sdGridEval(const SDGrid *grid, float px, float py);
+float sdgGridEval(const SDGrid *grid, float px, float py, float *gx, float *gy);
+void sdGridEvalBatch(const SDGrid *grid, const float *px, const float *py, float *out, size_t n);
+
+#endif
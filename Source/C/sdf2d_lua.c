@@ -0,0 +1,3021 @@
+// Generated by Source/Tools/gen_lua_bindings.py from sdf2d.h: do not edit, run
+//	python3 Source/Tools/gen_lua_bindings.py
+// instead.
+
+#include "sdf2d_lua.h"
+#include "sdf2d.h"
+#include "sdf2d_contour.h"
+#include "sdf2d_raster.h"
+
+#include <math.h>
+#include <string.h>
+
+static PlaydateAPI *pd = NULL;
+
+static const SDRasterStyle fill = { kSDRasterFill, 0.0f, 0.0f };
+
+// One buffer for the arrays of a call, kept between calls.
+static float *scratch = NULL;
+static size_t scratchCap = 0;
+
+static float *scratchFloats(size_t n)
+{
+	if (n > scratchCap) {
+		float *p = pd->system->realloc(scratch, n * sizeof(float));
+		if (!p) return NULL;
+		scratch = p;
+		scratchCap = n;
+	}
+	return scratch ? scratch : scratchFloats(1);
+}
+
+// Floats in the packed string at pos, 0 if it is not a string.
+static size_t floatCount(int pos)
+{
+	size_t len = 0;
+	return pd->lua->getArgBytes(pos, &len) ? len / sizeof(float) : 0;
+}
+
+static size_t pointCount(int xpos, int ypos)
+{
+	size_t nx = floatCount(xpos), ny = floatCount(ypos);
+	return nx < ny ? nx : ny;
+}
+
+static int vertexCount(int xpos, int ypos, int count)
+{
+	size_t n = pointCount(xpos, ypos);
+	return count < 0 ? 0 : (size_t)count > n ? (int)n : count;
+}
+
+// Lua strings need not be aligned for floats, so they are copied out.
+static void copyFloats(int pos, float *dst, size_t n)
+{
+	size_t len = 0;
+	const char *bytes = pd->lua->getArgBytes(pos, &len);
+	if (n) memcpy(dst, bytes, n * sizeof(float));
+}
+
+static int argBitmap(int pos, SDBitmap *bm)
+{
+	LCDBitmap *img = pd->lua->getBitmap(pos);
+	if (!img) return 0;
+	uint8_t *mask = NULL;
+	pd->graphics->getBitmapData(img, &bm->width, &bm->height, &bm->rowbytes, &mask, &bm->data);
+	return bm->data != NULL;
+}
+
+
+static int lua_sdCircle(lua_State *L)
+{
+	pd->lua->pushFloat(sdCircle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgCircle(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgCircle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdCircleBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	sdCircleBatch(xs, ys, dist, count, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCircleGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdCircleBatch(xs, ys, dist + (size_t)j * cols, cols, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCircleBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDCircle, { r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdBox(lua_State *L)
+{
+	pd->lua->pushFloat(sdBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgBox(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdBoxBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	sdBoxBatch(xs, ys, dist, count, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBoxGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdBoxBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBoxBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDBox, { bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdBoxLinf(lua_State *L)
+{
+	pd->lua->pushFloat(sdBoxLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgBoxLinf(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgBoxLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdBoxLinfBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	sdBoxLinfBatch(xs, ys, dist, count, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBoxLinfGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdBoxLinfBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBoxLinfBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDBoxLinf, { bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRoundedBox(lua_State *L)
+{
+	pd->lua->pushFloat(sdRoundedBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8)));
+	return 1;
+}
+
+static int lua_sdgRoundedBox(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRoundedBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRoundedBoxBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	float rw = pd->lua->getArgFloat(5);
+	float rx = pd->lua->getArgFloat(6);
+	float ry = pd->lua->getArgFloat(7);
+	float rz = pd->lua->getArgFloat(8);
+	sdRoundedBoxBatch(xs, ys, dist, count, bx, by, rw, rx, ry, rz);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundedBoxGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	float rw = pd->lua->getArgFloat(8);
+	float rx = pd->lua->getArgFloat(9);
+	float ry = pd->lua->getArgFloat(10);
+	float rz = pd->lua->getArgFloat(11);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRoundedBoxBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by, rw, rx, ry, rz);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundedBoxBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	float rw = pd->lua->getArgFloat(6);
+	float rx = pd->lua->getArgFloat(7);
+	float ry = pd->lua->getArgFloat(8);
+	float rz = pd->lua->getArgFloat(9);
+	SDShape shape = { kSDRoundedBox, { bx, by, rw, rx, ry, rz } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdOrientedBox(lua_State *L)
+{
+	pd->lua->pushFloat(sdOrientedBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7)));
+	return 1;
+}
+
+static int lua_sdgOrientedBox(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgOrientedBox(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdOrientedBoxBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ax = pd->lua->getArgFloat(3);
+	float ay = pd->lua->getArgFloat(4);
+	float bx = pd->lua->getArgFloat(5);
+	float by = pd->lua->getArgFloat(6);
+	float th = pd->lua->getArgFloat(7);
+	sdOrientedBoxBatch(xs, ys, dist, count, ax, ay, bx, by, th);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOrientedBoxGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ax = pd->lua->getArgFloat(6);
+	float ay = pd->lua->getArgFloat(7);
+	float bx = pd->lua->getArgFloat(8);
+	float by = pd->lua->getArgFloat(9);
+	float th = pd->lua->getArgFloat(10);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdOrientedBoxBatch(xs, ys, dist + (size_t)j * cols, cols, ax, ay, bx, by, th);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOrientedBoxBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ax = pd->lua->getArgFloat(4);
+	float ay = pd->lua->getArgFloat(5);
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	float th = pd->lua->getArgFloat(8);
+	SDShape shape = { kSDOrientedBox, { ax, ay, bx, by, th } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdSegment(lua_State *L)
+{
+	pd->lua->pushFloat(sdSegment(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6)));
+	return 1;
+}
+
+static int lua_sdgSegment(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgSegment(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdSegmentBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ax = pd->lua->getArgFloat(3);
+	float ay = pd->lua->getArgFloat(4);
+	float bx = pd->lua->getArgFloat(5);
+	float by = pd->lua->getArgFloat(6);
+	sdSegmentBatch(xs, ys, dist, count, ax, ay, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdSegmentGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ax = pd->lua->getArgFloat(6);
+	float ay = pd->lua->getArgFloat(7);
+	float bx = pd->lua->getArgFloat(8);
+	float by = pd->lua->getArgFloat(9);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdSegmentBatch(xs, ys, dist + (size_t)j * cols, cols, ax, ay, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdSegmentBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ax = pd->lua->getArgFloat(4);
+	float ay = pd->lua->getArgFloat(5);
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	SDShape shape = { kSDSegment, { ax, ay, bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdSegmentLinf(lua_State *L)
+{
+	pd->lua->pushFloat(sdSegmentLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6)));
+	return 1;
+}
+
+static int lua_sdgSegmentLinf(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgSegmentLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdSegmentLinfBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ax = pd->lua->getArgFloat(3);
+	float ay = pd->lua->getArgFloat(4);
+	float bx = pd->lua->getArgFloat(5);
+	float by = pd->lua->getArgFloat(6);
+	sdSegmentLinfBatch(xs, ys, dist, count, ax, ay, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdSegmentLinfGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ax = pd->lua->getArgFloat(6);
+	float ay = pd->lua->getArgFloat(7);
+	float bx = pd->lua->getArgFloat(8);
+	float by = pd->lua->getArgFloat(9);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdSegmentLinfBatch(xs, ys, dist + (size_t)j * cols, cols, ax, ay, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdSegmentLinfBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ax = pd->lua->getArgFloat(4);
+	float ay = pd->lua->getArgFloat(5);
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	SDShape shape = { kSDSegmentLinf, { ax, ay, bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRhombus(lua_State *L)
+{
+	pd->lua->pushFloat(sdRhombus(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgRhombus(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRhombus(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRhombusBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	sdRhombusBatch(xs, ys, dist, count, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRhombusGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRhombusBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRhombusBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDRhombus, { bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRhombusLinf(lua_State *L)
+{
+	pd->lua->pushFloat(sdRhombusLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgRhombusLinf(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRhombusLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRhombusLinfBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	sdRhombusLinfBatch(xs, ys, dist, count, bx, by);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRhombusLinfGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRhombusLinfBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRhombusLinfBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDRhombusLinf, { bx, by } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdTrapezoid(lua_State *L)
+{
+	pd->lua->pushFloat(sdTrapezoid(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgTrapezoid(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgTrapezoid(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdTrapezoidBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r1 = pd->lua->getArgFloat(3);
+	float r2 = pd->lua->getArgFloat(4);
+	float he = pd->lua->getArgFloat(5);
+	sdTrapezoidBatch(xs, ys, dist, count, r1, r2, he);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTrapezoidGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r1 = pd->lua->getArgFloat(6);
+	float r2 = pd->lua->getArgFloat(7);
+	float he = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdTrapezoidBatch(xs, ys, dist + (size_t)j * cols, cols, r1, r2, he);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTrapezoidBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r1 = pd->lua->getArgFloat(4);
+	float r2 = pd->lua->getArgFloat(5);
+	float he = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDTrapezoid, { r1, r2, he } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdParallelogram(lua_State *L)
+{
+	pd->lua->pushFloat(sdParallelogram(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgParallelogram(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgParallelogram(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdParallelogramBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float wi = pd->lua->getArgFloat(3);
+	float he = pd->lua->getArgFloat(4);
+	float sk = pd->lua->getArgFloat(5);
+	sdParallelogramBatch(xs, ys, dist, count, wi, he, sk);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdParallelogramGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float wi = pd->lua->getArgFloat(6);
+	float he = pd->lua->getArgFloat(7);
+	float sk = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdParallelogramBatch(xs, ys, dist + (size_t)j * cols, cols, wi, he, sk);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdParallelogramBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float wi = pd->lua->getArgFloat(4);
+	float he = pd->lua->getArgFloat(5);
+	float sk = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDParallelogram, { wi, he, sk } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdTriangle(lua_State *L)
+{
+	pd->lua->pushFloat(sdTriangle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8)));
+	return 1;
+}
+
+static int lua_sdgTriangle(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgTriangle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdTriangleBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float p0x = pd->lua->getArgFloat(3);
+	float p0y = pd->lua->getArgFloat(4);
+	float p1x = pd->lua->getArgFloat(5);
+	float p1y = pd->lua->getArgFloat(6);
+	float p2x = pd->lua->getArgFloat(7);
+	float p2y = pd->lua->getArgFloat(8);
+	sdTriangleBatch(xs, ys, dist, count, p0x, p0y, p1x, p1y, p2x, p2y);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTriangleGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float p0x = pd->lua->getArgFloat(6);
+	float p0y = pd->lua->getArgFloat(7);
+	float p1x = pd->lua->getArgFloat(8);
+	float p1y = pd->lua->getArgFloat(9);
+	float p2x = pd->lua->getArgFloat(10);
+	float p2y = pd->lua->getArgFloat(11);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdTriangleBatch(xs, ys, dist + (size_t)j * cols, cols, p0x, p0y, p1x, p1y, p2x, p2y);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTriangleBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float p0x = pd->lua->getArgFloat(4);
+	float p0y = pd->lua->getArgFloat(5);
+	float p1x = pd->lua->getArgFloat(6);
+	float p1y = pd->lua->getArgFloat(7);
+	float p2x = pd->lua->getArgFloat(8);
+	float p2y = pd->lua->getArgFloat(9);
+	SDShape shape = { kSDTriangle, { p0x, p0y, p1x, p1y, p2x, p2y } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdTriangleIsosceles(lua_State *L)
+{
+	pd->lua->pushFloat(sdTriangleIsosceles(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgTriangleIsosceles(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgTriangleIsosceles(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdTriangleIsoscelesBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float qx = pd->lua->getArgFloat(3);
+	float qy = pd->lua->getArgFloat(4);
+	sdTriangleIsoscelesBatch(xs, ys, dist, count, qx, qy);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTriangleIsoscelesGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float qx = pd->lua->getArgFloat(6);
+	float qy = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdTriangleIsoscelesBatch(xs, ys, dist + (size_t)j * cols, cols, qx, qy);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTriangleIsoscelesBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float qx = pd->lua->getArgFloat(4);
+	float qy = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDTriangleIsosceles, { qx, qy } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdEquilateralTriangle(lua_State *L)
+{
+	pd->lua->pushFloat(sdEquilateralTriangle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgEquilateralTriangle(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgEquilateralTriangle(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdEquilateralTriangleBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	sdEquilateralTriangleBatch(xs, ys, dist, count, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEquilateralTriangleGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdEquilateralTriangleBatch(xs, ys, dist + (size_t)j * cols, cols, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEquilateralTriangleBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDEquilateralTriangle, { r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdQuad(lua_State *L)
+{
+	pd->lua->pushFloat(sdQuad(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), pd->lua->getArgFloat(9), pd->lua->getArgFloat(10)));
+	return 1;
+}
+
+static int lua_sdgQuad(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgQuad(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), pd->lua->getArgFloat(9), pd->lua->getArgFloat(10), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdQuadBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float p0x = pd->lua->getArgFloat(3);
+	float p0y = pd->lua->getArgFloat(4);
+	float p1x = pd->lua->getArgFloat(5);
+	float p1y = pd->lua->getArgFloat(6);
+	float p2x = pd->lua->getArgFloat(7);
+	float p2y = pd->lua->getArgFloat(8);
+	float p3x = pd->lua->getArgFloat(9);
+	float p3y = pd->lua->getArgFloat(10);
+	sdQuadBatch(xs, ys, dist, count, p0x, p0y, p1x, p1y, p2x, p2y, p3x, p3y);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdQuadGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float p0x = pd->lua->getArgFloat(6);
+	float p0y = pd->lua->getArgFloat(7);
+	float p1x = pd->lua->getArgFloat(8);
+	float p1y = pd->lua->getArgFloat(9);
+	float p2x = pd->lua->getArgFloat(10);
+	float p2y = pd->lua->getArgFloat(11);
+	float p3x = pd->lua->getArgFloat(12);
+	float p3y = pd->lua->getArgFloat(13);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdQuadBatch(xs, ys, dist + (size_t)j * cols, cols, p0x, p0y, p1x, p1y, p2x, p2y, p3x, p3y);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdQuadBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float p0x = pd->lua->getArgFloat(4);
+	float p0y = pd->lua->getArgFloat(5);
+	float p1x = pd->lua->getArgFloat(6);
+	float p1y = pd->lua->getArgFloat(7);
+	float p2x = pd->lua->getArgFloat(8);
+	float p2y = pd->lua->getArgFloat(9);
+	float p3x = pd->lua->getArgFloat(10);
+	float p3y = pd->lua->getArgFloat(11);
+	SDShape shape = { kSDQuad, { p0x, p0y, p1x, p1y, p2x, p2y, p3x, p3y } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdStar5(lua_State *L)
+{
+	pd->lua->pushFloat(sdStar5(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgStar5(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgStar5(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdStar5Batch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	float rf = pd->lua->getArgFloat(4);
+	sdStar5Batch(xs, ys, dist, count, r, rf);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdStar5Grid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	float rf = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdStar5Batch(xs, ys, dist + (size_t)j * cols, cols, r, rf);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdStar5Bitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	float rf = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDStar5, { r, rf } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdPentagon(lua_State *L)
+{
+	pd->lua->pushFloat(sdPentagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgPentagon(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgPentagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdPentagonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	sdPentagonBatch(xs, ys, dist, count, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPentagonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdPentagonBatch(xs, ys, dist + (size_t)j * cols, cols, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPentagonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDPentagon, { r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdHexagon(lua_State *L)
+{
+	pd->lua->pushFloat(sdHexagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgHexagon(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgHexagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdHexagonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float s = pd->lua->getArgFloat(3);
+	sdHexagonBatch(xs, ys, dist, count, s);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHexagonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float s = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdHexagonBatch(xs, ys, dist + (size_t)j * cols, cols, s);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHexagonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float s = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDHexagon, { s } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdOctagon(lua_State *L)
+{
+	pd->lua->pushFloat(sdOctagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgOctagon(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgOctagon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdOctagonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	sdOctagonBatch(xs, ys, dist, count, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOctagonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdOctagonBatch(xs, ys, dist + (size_t)j * cols, cols, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOctagonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDOctagon, { r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdHexagram(lua_State *L)
+{
+	pd->lua->pushFloat(sdHexagram(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgHexagram(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgHexagram(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdHexagramBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	sdHexagramBatch(xs, ys, dist, count, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHexagramGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdHexagramBatch(xs, ys, dist + (size_t)j * cols, cols, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHexagramBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDHexagram, { r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdPie(lua_State *L)
+{
+	pd->lua->pushFloat(sdPie(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgPie(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgPie(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdPieBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float cx = pd->lua->getArgFloat(3);
+	float cy = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	sdPieBatch(xs, ys, dist, count, cx, cy, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPieGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float cx = pd->lua->getArgFloat(6);
+	float cy = pd->lua->getArgFloat(7);
+	float r = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdPieBatch(xs, ys, dist + (size_t)j * cols, cols, cx, cy, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPieBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float cx = pd->lua->getArgFloat(4);
+	float cy = pd->lua->getArgFloat(5);
+	float r = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDPie, { cx, cy, r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdCutDisk(lua_State *L)
+{
+	pd->lua->pushFloat(sdCutDisk(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgCutDisk(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgCutDisk(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdCutDiskBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	float h = pd->lua->getArgFloat(4);
+	sdCutDiskBatch(xs, ys, dist, count, r, h);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCutDiskGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	float h = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdCutDiskBatch(xs, ys, dist + (size_t)j * cols, cols, r, h);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCutDiskBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	float h = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDCutDisk, { r, h } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdArc(lua_State *L)
+{
+	pd->lua->pushFloat(sdArc(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6)));
+	return 1;
+}
+
+static int lua_sdgArc(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgArc(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdArcBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float scx = pd->lua->getArgFloat(3);
+	float scy = pd->lua->getArgFloat(4);
+	float ra = pd->lua->getArgFloat(5);
+	float rb = pd->lua->getArgFloat(6);
+	sdArcBatch(xs, ys, dist, count, scx, scy, ra, rb);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdArcGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float scx = pd->lua->getArgFloat(6);
+	float scy = pd->lua->getArgFloat(7);
+	float ra = pd->lua->getArgFloat(8);
+	float rb = pd->lua->getArgFloat(9);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdArcBatch(xs, ys, dist + (size_t)j * cols, cols, scx, scy, ra, rb);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdArcBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float scx = pd->lua->getArgFloat(4);
+	float scy = pd->lua->getArgFloat(5);
+	float ra = pd->lua->getArgFloat(6);
+	float rb = pd->lua->getArgFloat(7);
+	SDShape shape = { kSDArc, { scx, scy, ra, rb } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRing(lua_State *L)
+{
+	pd->lua->pushFloat(sdRing(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6)));
+	return 1;
+}
+
+static int lua_sdgRing(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRing(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRingBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float nx = pd->lua->getArgFloat(3);
+	float ny = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	float th = pd->lua->getArgFloat(6);
+	sdRingBatch(xs, ys, dist, count, nx, ny, r, th);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRingGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float nx = pd->lua->getArgFloat(6);
+	float ny = pd->lua->getArgFloat(7);
+	float r = pd->lua->getArgFloat(8);
+	float th = pd->lua->getArgFloat(9);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRingBatch(xs, ys, dist + (size_t)j * cols, cols, nx, ny, r, th);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRingBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float nx = pd->lua->getArgFloat(4);
+	float ny = pd->lua->getArgFloat(5);
+	float r = pd->lua->getArgFloat(6);
+	float th = pd->lua->getArgFloat(7);
+	SDShape shape = { kSDRing, { nx, ny, r, th } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdHorseshoe(lua_State *L)
+{
+	pd->lua->pushFloat(sdHorseshoe(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7)));
+	return 1;
+}
+
+static int lua_sdgHorseshoe(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgHorseshoe(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdHorseshoeBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float cx = pd->lua->getArgFloat(3);
+	float cy = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	float le = pd->lua->getArgFloat(6);
+	float th = pd->lua->getArgFloat(7);
+	sdHorseshoeBatch(xs, ys, dist, count, cx, cy, r, le, th);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHorseshoeGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float cx = pd->lua->getArgFloat(6);
+	float cy = pd->lua->getArgFloat(7);
+	float r = pd->lua->getArgFloat(8);
+	float le = pd->lua->getArgFloat(9);
+	float th = pd->lua->getArgFloat(10);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdHorseshoeBatch(xs, ys, dist + (size_t)j * cols, cols, cx, cy, r, le, th);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdHorseshoeBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float cx = pd->lua->getArgFloat(4);
+	float cy = pd->lua->getArgFloat(5);
+	float r = pd->lua->getArgFloat(6);
+	float le = pd->lua->getArgFloat(7);
+	float th = pd->lua->getArgFloat(8);
+	SDShape shape = { kSDHorseshoe, { cx, cy, r, le, th } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdVesica(lua_State *L)
+{
+	pd->lua->pushFloat(sdVesica(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgVesica(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgVesica(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdVesicaBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	float d = pd->lua->getArgFloat(4);
+	sdVesicaBatch(xs, ys, dist, count, r, d);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdVesicaGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	float d = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdVesicaBatch(xs, ys, dist + (size_t)j * cols, cols, r, d);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdVesicaBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	float d = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDVesica, { r, d } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdOrientedVesica(lua_State *L)
+{
+	pd->lua->pushFloat(sdOrientedVesica(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7)));
+	return 1;
+}
+
+static int lua_sdgOrientedVesica(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgOrientedVesica(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdOrientedVesicaBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ax = pd->lua->getArgFloat(3);
+	float ay = pd->lua->getArgFloat(4);
+	float bx = pd->lua->getArgFloat(5);
+	float by = pd->lua->getArgFloat(6);
+	float w = pd->lua->getArgFloat(7);
+	sdOrientedVesicaBatch(xs, ys, dist, count, ax, ay, bx, by, w);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOrientedVesicaGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ax = pd->lua->getArgFloat(6);
+	float ay = pd->lua->getArgFloat(7);
+	float bx = pd->lua->getArgFloat(8);
+	float by = pd->lua->getArgFloat(9);
+	float w = pd->lua->getArgFloat(10);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdOrientedVesicaBatch(xs, ys, dist + (size_t)j * cols, cols, ax, ay, bx, by, w);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdOrientedVesicaBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ax = pd->lua->getArgFloat(4);
+	float ay = pd->lua->getArgFloat(5);
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	float w = pd->lua->getArgFloat(8);
+	SDShape shape = { kSDOrientedVesica, { ax, ay, bx, by, w } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdMoon(lua_State *L)
+{
+	pd->lua->pushFloat(sdMoon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgMoon(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgMoon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdMoonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float d = pd->lua->getArgFloat(3);
+	float ra = pd->lua->getArgFloat(4);
+	float rb = pd->lua->getArgFloat(5);
+	sdMoonBatch(xs, ys, dist, count, d, ra, rb);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdMoonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float d = pd->lua->getArgFloat(6);
+	float ra = pd->lua->getArgFloat(7);
+	float rb = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdMoonBatch(xs, ys, dist + (size_t)j * cols, cols, d, ra, rb);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdMoonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float d = pd->lua->getArgFloat(4);
+	float ra = pd->lua->getArgFloat(5);
+	float rb = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDMoon, { d, ra, rb } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdCross(lua_State *L)
+{
+	pd->lua->pushFloat(sdCross(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgCross(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgCross(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdCrossBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float bx = pd->lua->getArgFloat(3);
+	float by = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	sdCrossBatch(xs, ys, dist, count, bx, by, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCrossGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	float r = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdCrossBatch(xs, ys, dist + (size_t)j * cols, cols, bx, by, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdCrossBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float bx = pd->lua->getArgFloat(4);
+	float by = pd->lua->getArgFloat(5);
+	float r = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDCross, { bx, by, r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRoundedX(lua_State *L)
+{
+	pd->lua->pushFloat(sdRoundedX(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgRoundedX(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRoundedX(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRoundedXBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float w = pd->lua->getArgFloat(3);
+	float r = pd->lua->getArgFloat(4);
+	sdRoundedXBatch(xs, ys, dist, count, w, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundedXGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float w = pd->lua->getArgFloat(6);
+	float r = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRoundedXBatch(xs, ys, dist + (size_t)j * cols, cols, w, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundedXBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float w = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDRoundedX, { w, r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdParabola(lua_State *L)
+{
+	pd->lua->pushFloat(sdParabola(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3)));
+	return 1;
+}
+
+static int lua_sdgParabola(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgParabola(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdParabolaBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float k = pd->lua->getArgFloat(3);
+	sdParabolaBatch(xs, ys, dist, count, k);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdParabolaGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float k = pd->lua->getArgFloat(6);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdParabolaBatch(xs, ys, dist + (size_t)j * cols, cols, k);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdParabolaBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float k = pd->lua->getArgFloat(4);
+	SDShape shape = { kSDParabola, { k } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdTunnel(lua_State *L)
+{
+	pd->lua->pushFloat(sdTunnel(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgTunnel(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgTunnel(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdTunnelBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float whx = pd->lua->getArgFloat(3);
+	float why = pd->lua->getArgFloat(4);
+	sdTunnelBatch(xs, ys, dist, count, whx, why);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTunnelGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float whx = pd->lua->getArgFloat(6);
+	float why = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdTunnelBatch(xs, ys, dist + (size_t)j * cols, cols, whx, why);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdTunnelBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float whx = pd->lua->getArgFloat(4);
+	float why = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDTunnel, { whx, why } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdEllipse(lua_State *L)
+{
+	pd->lua->pushFloat(sdEllipse(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgEllipse(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgEllipse(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdEllipseBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ex = pd->lua->getArgFloat(3);
+	float ey = pd->lua->getArgFloat(4);
+	sdEllipseBatch(xs, ys, dist, count, ex, ey);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEllipseGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ex = pd->lua->getArgFloat(6);
+	float ey = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdEllipseBatch(xs, ys, dist + (size_t)j * cols, cols, ex, ey);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEllipseBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ex = pd->lua->getArgFloat(4);
+	float ey = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDEllipse, { ex, ey } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdEllipseLinf(lua_State *L)
+{
+	pd->lua->pushFloat(sdEllipseLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgEllipseLinf(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgEllipseLinf(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdEllipseLinfBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ex = pd->lua->getArgFloat(3);
+	float ey = pd->lua->getArgFloat(4);
+	sdEllipseLinfBatch(xs, ys, dist, count, ex, ey);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEllipseLinfGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ex = pd->lua->getArgFloat(6);
+	float ey = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdEllipseLinfBatch(xs, ys, dist + (size_t)j * cols, cols, ex, ey);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEllipseLinfBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ex = pd->lua->getArgFloat(4);
+	float ey = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDEllipseLinf, { ex, ey } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRegularPolygon(lua_State *L)
+{
+	pd->lua->pushFloat(sdRegularPolygon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgInt(4)));
+	return 1;
+}
+
+static int lua_sdgRegularPolygon(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRegularPolygon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgInt(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRegularPolygonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r = pd->lua->getArgFloat(3);
+	int sides = pd->lua->getArgInt(4);
+	sdRegularPolygonBatch(xs, ys, dist, count, r, sides);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRegularPolygonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r = pd->lua->getArgFloat(6);
+	int sides = pd->lua->getArgInt(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRegularPolygonBatch(xs, ys, dist + (size_t)j * cols, cols, r, sides);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRegularPolygonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r = pd->lua->getArgFloat(4);
+	int n = pd->lua->getArgInt(5);
+	SDShape shape = { kSDRegularPolygon, { r }, n };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdPolygon(lua_State *L)
+{
+	int num = vertexCount(3, 4, pd->lua->getArgInt(5));
+	if (num < 1) return 0;
+	float *vertices = scratchFloats(2 * (size_t)num);
+	if (!vertices) return 0;
+	float *vx = vertices, *vy = vx + num;
+	copyFloats(3, vx, num);
+	copyFloats(4, vy, num);
+	pd->lua->pushFloat(sdPolygon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), vx, vy, num));
+	return 1;
+}
+
+static int lua_sdgPolygon(lua_State *L)
+{
+	int num = vertexCount(3, 4, pd->lua->getArgInt(5));
+	if (num < 1) return 0;
+	float *vertices = scratchFloats(2 * (size_t)num);
+	if (!vertices) return 0;
+	float *vx = vertices, *vy = vx + num;
+	copyFloats(3, vx, num);
+	copyFloats(4, vy, num);
+	float gx, gy;
+	pd->lua->pushFloat(sdgPolygon(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), vx, vy, num, &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdPolygonBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	int num = vertexCount(3, 4, pd->lua->getArgInt(5));
+	if (num < 1) return 0;
+	float *xs = scratchFloats(3 * count + 2 * (size_t)num);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float *vx = dist + count, *vy = vx + num;
+	copyFloats(3, vx, num);
+	copyFloats(4, vy, num);
+	sdPolygonBatch(xs, ys, dist, count, vx, vy, num);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPolygonGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	int num = vertexCount(6, 7, pd->lua->getArgInt(8));
+	if (num < 1) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2) + 2 * (size_t)num);
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float *vx = dist + (size_t)cols * rows, *vy = vx + num;
+	copyFloats(6, vx, num);
+	copyFloats(7, vy, num);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdPolygonBatch(xs, ys, dist + (size_t)j * cols, cols, vx, vy, num);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdPolygonBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	int num = vertexCount(4, 5, pd->lua->getArgInt(6));
+	if (num < 1) return 0;
+	float *vertices = scratchFloats(2 * (size_t)num);
+	if (!vertices) return 0;
+	float *vx = vertices, *vy = vx + num;
+	copyFloats(4, vx, num);
+	copyFloats(5, vy, num);
+	SDShape shape = { kSDPolygon, { 0 }, num, vx, vy };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdRoundSquare(lua_State *L)
+{
+	pd->lua->pushFloat(sdRoundSquare(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgRoundSquare(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgRoundSquare(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdRoundSquareBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float s = pd->lua->getArgFloat(3);
+	float r = pd->lua->getArgFloat(4);
+	sdRoundSquareBatch(xs, ys, dist, count, s, r);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundSquareGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float s = pd->lua->getArgFloat(6);
+	float r = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdRoundSquareBatch(xs, ys, dist + (size_t)j * cols, cols, s, r);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdRoundSquareBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float s = pd->lua->getArgFloat(4);
+	float r = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDRoundSquare, { s, r } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdEgg(lua_State *L)
+{
+	pd->lua->pushFloat(sdEgg(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4)));
+	return 1;
+}
+
+static int lua_sdgEgg(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgEgg(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdEggBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ra = pd->lua->getArgFloat(3);
+	float rb = pd->lua->getArgFloat(4);
+	sdEggBatch(xs, ys, dist, count, ra, rb);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEggGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ra = pd->lua->getArgFloat(6);
+	float rb = pd->lua->getArgFloat(7);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdEggBatch(xs, ys, dist + (size_t)j * cols, cols, ra, rb);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdEggBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ra = pd->lua->getArgFloat(4);
+	float rb = pd->lua->getArgFloat(5);
+	SDShape shape = { kSDEgg, { ra, rb } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdUnevenCapsule(lua_State *L)
+{
+	pd->lua->pushFloat(sdUnevenCapsule(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5)));
+	return 1;
+}
+
+static int lua_sdgUnevenCapsule(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgUnevenCapsule(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdUnevenCapsuleBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float r1 = pd->lua->getArgFloat(3);
+	float r2 = pd->lua->getArgFloat(4);
+	float h = pd->lua->getArgFloat(5);
+	sdUnevenCapsuleBatch(xs, ys, dist, count, r1, r2, h);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdUnevenCapsuleGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float r1 = pd->lua->getArgFloat(6);
+	float r2 = pd->lua->getArgFloat(7);
+	float h = pd->lua->getArgFloat(8);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdUnevenCapsuleBatch(xs, ys, dist + (size_t)j * cols, cols, r1, r2, h);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdUnevenCapsuleBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float r1 = pd->lua->getArgFloat(4);
+	float r2 = pd->lua->getArgFloat(5);
+	float h = pd->lua->getArgFloat(6);
+	SDShape shape = { kSDUnevenCapsule, { r1, r2, h } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+static int lua_sdBezier(lua_State *L)
+{
+	pd->lua->pushFloat(sdBezier(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), pd->lua->getArgFloat(9)));
+	return 1;
+}
+
+static int lua_sdgBezier(lua_State *L)
+{
+	float gx, gy;
+	pd->lua->pushFloat(sdgBezier(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgFloat(4), pd->lua->getArgFloat(5), pd->lua->getArgFloat(6), pd->lua->getArgFloat(7), pd->lua->getArgFloat(8), pd->lua->getArgFloat(9), &gx, &gy));
+	pd->lua->pushFloat(gx);
+	pd->lua->pushFloat(gy);
+	return 3;
+}
+
+static int lua_sdBezierBatch(lua_State *L)
+{
+	size_t count = pointCount(1, 2);
+	float *xs = scratchFloats(3 * count);
+	if (!xs) return 0;
+	float *ys = xs + count, *dist = ys + count;
+	copyFloats(1, xs, count);
+	copyFloats(2, ys, count);
+	float ax = pd->lua->getArgFloat(3);
+	float ay = pd->lua->getArgFloat(4);
+	float bx = pd->lua->getArgFloat(5);
+	float by = pd->lua->getArgFloat(6);
+	float cx = pd->lua->getArgFloat(7);
+	float cy = pd->lua->getArgFloat(8);
+	float th = pd->lua->getArgFloat(9);
+	sdBezierBatch(xs, ys, dist, count, ax, ay, bx, by, cx, cy, th);
+	pd->lua->pushBytes((const char *)dist, count * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBezierGrid(lua_State *L)
+{
+	float x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);
+	int cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);
+	if (cols <= 0 || rows <= 0) return 0;
+	float *xs = scratchFloats((size_t)cols * ((size_t)rows + 2));
+	if (!xs) return 0;
+	float *ys = xs + cols, *dist = ys + cols;
+	float ax = pd->lua->getArgFloat(6);
+	float ay = pd->lua->getArgFloat(7);
+	float bx = pd->lua->getArgFloat(8);
+	float by = pd->lua->getArgFloat(9);
+	float cx = pd->lua->getArgFloat(10);
+	float cy = pd->lua->getArgFloat(11);
+	float th = pd->lua->getArgFloat(12);
+	for (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;
+	for (int j = 0; j < rows; j++) {
+		for (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;
+		sdBezierBatch(xs, ys, dist + (size_t)j * cols, cols, ax, ay, bx, by, cx, cy, th);
+	}
+	pd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));
+	return 1;
+}
+
+static int lua_sdBezierBitmap(lua_State *L)
+{
+	SDBitmap bm;
+	if (!argBitmap(1, &bm)) return 0;
+	float ax = pd->lua->getArgFloat(4);
+	float ay = pd->lua->getArgFloat(5);
+	float bx = pd->lua->getArgFloat(6);
+	float by = pd->lua->getArgFloat(7);
+	float cx = pd->lua->getArgFloat(8);
+	float cy = pd->lua->getArgFloat(9);
+	float th = pd->lua->getArgFloat(10);
+	SDShape shape = { kSDBezier, { ax, ay, bx, by, cx, cy, th } };
+	sdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);
+	return 0;
+}
+
+// sdf2d.h parameters of each shape: f a float, i an int, a an array of floats
+static const struct {
+	const char *name;
+	SDShapeType type;
+	const char *params;
+} shapeTypes[] = {
+	{ "sdCircle", kSDCircle, "f" },
+	{ "sdBox", kSDBox, "ff" },
+	{ "sdBoxLinf", kSDBoxLinf, "ff" },
+	{ "sdRoundedBox", kSDRoundedBox, "ffffff" },
+	{ "sdOrientedBox", kSDOrientedBox, "fffff" },
+	{ "sdSegment", kSDSegment, "ffff" },
+	{ "sdSegmentLinf", kSDSegmentLinf, "ffff" },
+	{ "sdRhombus", kSDRhombus, "ff" },
+	{ "sdRhombusLinf", kSDRhombusLinf, "ff" },
+	{ "sdTrapezoid", kSDTrapezoid, "fff" },
+	{ "sdParallelogram", kSDParallelogram, "fff" },
+	{ "sdTriangle", kSDTriangle, "ffffff" },
+	{ "sdTriangleIsosceles", kSDTriangleIsosceles, "ff" },
+	{ "sdEquilateralTriangle", kSDEquilateralTriangle, "f" },
+	{ "sdQuad", kSDQuad, "ffffffff" },
+	{ "sdStar5", kSDStar5, "ff" },
+	{ "sdPentagon", kSDPentagon, "f" },
+	{ "sdHexagon", kSDHexagon, "f" },
+	{ "sdOctagon", kSDOctagon, "f" },
+	{ "sdHexagram", kSDHexagram, "f" },
+	{ "sdPie", kSDPie, "fff" },
+	{ "sdCutDisk", kSDCutDisk, "ff" },
+	{ "sdArc", kSDArc, "ffff" },
+	{ "sdRing", kSDRing, "ffff" },
+	{ "sdHorseshoe", kSDHorseshoe, "fffff" },
+	{ "sdVesica", kSDVesica, "ff" },
+	{ "sdOrientedVesica", kSDOrientedVesica, "fffff" },
+	{ "sdMoon", kSDMoon, "fff" },
+	{ "sdCross", kSDCross, "fff" },
+	{ "sdRoundedX", kSDRoundedX, "ff" },
+	{ "sdParabola", kSDParabola, "f" },
+	{ "sdTunnel", kSDTunnel, "ff" },
+	{ "sdEllipse", kSDEllipse, "ff" },
+	{ "sdEllipseLinf", kSDEllipseLinf, "ff" },
+	{ "sdRegularPolygon", kSDRegularPolygon, "fi" },
+	{ "sdPolygon", kSDPolygon, "aai" },
+	{ "sdRoundSquare", kSDRoundSquare, "ff" },
+	{ "sdEgg", kSDEgg, "ff" },
+	{ "sdUnevenCapsule", kSDUnevenCapsule, "fff" },
+	{ "sdBezier", kSDBezier, "fffffff" },
+};
+
+#define SHAPE_CLASS "SDShapeC"
+
+typedef struct {
+	SDShape shape;
+	float x, y;
+	float vertices[];          // sdPolygon: vx, then vy
+} LuaShape;
+
+// SDShapeC.new(name, x, y, ...): the sdf2d.h shape name (eg "sdBox") placed at x, y, with the
+// parameters of that function
+static int shapeNew(lua_State *L)
+{
+	const char *name = pd->lua->getArgString(1);
+	size_t t = 0, types = sizeof(shapeTypes) / sizeof(shapeTypes[0]);
+	while (t < types && !(name && strcmp(name, shapeTypes[t].name) == 0)) t++;
+	if (t == types) return 0;
+	const char *params = shapeTypes[t].params, *array = strchr(params, 'a');
+	int count = 0, apos = array ? 4 + (int)(array - params) : 0;
+	if (array) {
+		count = vertexCount(apos, apos + 1, pd->lua->getArgInt(apos + 2));
+		if (count < 1) return 0;
+	}
+	LuaShape *s = pd->system->realloc(NULL, sizeof(LuaShape) + 2 * (size_t)count * sizeof(float));
+	if (!s) return 0;
+	memset(s, 0, sizeof(LuaShape));
+	s->shape.type = shapeTypes[t].type;
+	s->x = pd->lua->getArgFloat(2);
+	s->y = pd->lua->getArgFloat(3);
+	for (int k = 0, floats = 0; params[k]; k++) {
+		if (params[k] == 'f') s->shape.p[floats++] = pd->lua->getArgFloat(4 + k);
+		else if (params[k] == 'i') s->shape.n = array ? count : pd->lua->getArgInt(4 + k);
+	}
+	if (array) {
+		copyFloats(apos, s->vertices, count);
+		copyFloats(apos + 1, s->vertices + count, count);
+		s->shape.vx = s->vertices;
+		s->shape.vy = s->vertices + count;
+	}
+	pd->lua->pushObject(s, SHAPE_CLASS, 0);
+	return 1;
+}
+
+static LuaShape *argShape(void)
+{
+	return pd->lua->getArgObject(1, SHAPE_CLASS, NULL);
+}
+
+static int shapeGC(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (s) pd->system->realloc(s, 0);
+	return 0;
+}
+
+// shape:moveTo(x, y)
+static int shapeMoveTo(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	s->x = pd->lua->getArgFloat(2);
+	s->y = pd->lua->getArgFloat(3);
+	return 0;
+}
+
+// shape:distance(x, y) -> d
+static int shapeDistance(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	pd->lua->pushFloat(sdShapeEval(&s->shape, pd->lua->getArgFloat(2) - s->x, pd->lua->getArgFloat(3) - s->y));
+	return 1;
+}
+
+// The distance at the point of arguments 2 and 3, and the unit gradient there: the direction of the
+// shortest way out.
+static float shapeNormal(const LuaShape *s, float *nx, float *ny)
+{
+	float d = sdShapeEvalGrad(&s->shape, pd->lua->getArgFloat(2) - s->x, pd->lua->getArgFloat(3) - s->y, nx, ny);
+	float len = sqrtf(*nx * *nx + *ny * *ny);
+	if (len > 0.0f) {
+		*nx /= len;
+		*ny /= len;
+	}
+	return d;
+}
+
+// shape:gradient(x, y) -> nx, ny
+static int shapeGradient(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	float nx, ny;
+	shapeNormal(s, &nx, &ny);
+	pd->lua->pushFloat(nx);
+	pd->lua->pushFloat(ny);
+	return 2;
+}
+
+// shape:distanceGradient(x, y) -> d, nx, ny
+static int shapeDistanceGradient(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	float nx, ny;
+	pd->lua->pushFloat(shapeNormal(s, &nx, &ny));
+	pd->lua->pushFloat(nx);
+	pd->lua->pushFloat(ny);
+	return 3;
+}
+
+// shape:contour(x, y, width, height, cell, tolerance) -> xy, starts: the surface traced by
+// sdContourShape on width x height samples from x, y, cell apart (1 if left out). xy is the vertices
+// as packed floats x1, y1, x2, y2, ...; starts packed ints, polyline i running from vertex starts[i]
+// up to starts[i + 1], as in SDContours. The contours are kept between calls.
+static SDContours contours;
+static int contoursReady = 0;
+
+static int shapeContour(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	if (!contoursReady) {
+		sdContoursInit(&contours);
+		contoursReady = 1;
+	}
+	float cell = pd->lua->getArgFloat(6);
+	SDContourLayout layout = { pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgInt(4),
+		pd->lua->getArgInt(5), cell > 0.0f ? cell : 1.0f, 0.0f, pd->lua->getArgFloat(7) };
+	if (sdContourShape(&contours, &layout, &s->shape, s->x, s->y, NULL) < 0) return 0;
+	float *xy = scratchFloats(2 * (size_t)contours.vertices);
+	if (!xy) return 0;
+	for (int v = 0; v < contours.vertices; v++) {
+		xy[2 * v] = contours.x[v];
+		xy[2 * v + 1] = contours.y[v];
+	}
+	pd->lua->pushBytes((const char *)xy, 2 * (size_t)contours.vertices * sizeof(float));
+	pd->lua->pushBytes((const char *)contours.start, ((size_t)contours.count + 1) * sizeof(int));
+	return 2;
+}
+
+static const lua_reg shapeClass[] = {
+	{ "new", shapeNew },
+	{ "__gc", shapeGC },
+	{ "moveTo", shapeMoveTo },
+	{ "distance", shapeDistance },
+	{ "gradient", shapeGradient },
+	{ "distanceGradient", shapeDistanceGradient },
+	{ "contour", shapeContour },
+	{ NULL, NULL },
+};
+
+
+static const struct {
+	lua_CFunction func;
+	const char *name;
+} functions[] = {
+	{ lua_sdCircle, "sdCircle" },
+	{ lua_sdgCircle, "sdgCircle" },
+	{ lua_sdCircleBatch, "sdCircleBatch" },
+	{ lua_sdCircleGrid, "sdCircleGrid" },
+	{ lua_sdCircleBitmap, "sdCircleBitmap" },
+	{ lua_sdBox, "sdBox" },
+	{ lua_sdgBox, "sdgBox" },
+	{ lua_sdBoxBatch, "sdBoxBatch" },
+	{ lua_sdBoxGrid, "sdBoxGrid" },
+	{ lua_sdBoxBitmap, "sdBoxBitmap" },
+	{ lua_sdBoxLinf, "sdBoxLinf" },
+	{ lua_sdgBoxLinf, "sdgBoxLinf" },
+	{ lua_sdBoxLinfBatch, "sdBoxLinfBatch" },
+	{ lua_sdBoxLinfGrid, "sdBoxLinfGrid" },
+	{ lua_sdBoxLinfBitmap, "sdBoxLinfBitmap" },
+	{ lua_sdRoundedBox, "sdRoundedBox" },
+	{ lua_sdgRoundedBox, "sdgRoundedBox" },
+	{ lua_sdRoundedBoxBatch, "sdRoundedBoxBatch" },
+	{ lua_sdRoundedBoxGrid, "sdRoundedBoxGrid" },
+	{ lua_sdRoundedBoxBitmap, "sdRoundedBoxBitmap" },
+	{ lua_sdOrientedBox, "sdOrientedBox" },
+	{ lua_sdgOrientedBox, "sdgOrientedBox" },
+	{ lua_sdOrientedBoxBatch, "sdOrientedBoxBatch" },
+	{ lua_sdOrientedBoxGrid, "sdOrientedBoxGrid" },
+	{ lua_sdOrientedBoxBitmap, "sdOrientedBoxBitmap" },
+	{ lua_sdSegment, "sdSegment" },
+	{ lua_sdgSegment, "sdgSegment" },
+	{ lua_sdSegmentBatch, "sdSegmentBatch" },
+	{ lua_sdSegmentGrid, "sdSegmentGrid" },
+	{ lua_sdSegmentBitmap, "sdSegmentBitmap" },
+	{ lua_sdSegmentLinf, "sdSegmentLinf" },
+	{ lua_sdgSegmentLinf, "sdgSegmentLinf" },
+	{ lua_sdSegmentLinfBatch, "sdSegmentLinfBatch" },
+	{ lua_sdSegmentLinfGrid, "sdSegmentLinfGrid" },
+	{ lua_sdSegmentLinfBitmap, "sdSegmentLinfBitmap" },
+	{ lua_sdRhombus, "sdRhombus" },
+	{ lua_sdgRhombus, "sdgRhombus" },
+	{ lua_sdRhombusBatch, "sdRhombusBatch" },
+	{ lua_sdRhombusGrid, "sdRhombusGrid" },
+	{ lua_sdRhombusBitmap, "sdRhombusBitmap" },
+	{ lua_sdRhombusLinf, "sdRhombusLinf" },
+	{ lua_sdgRhombusLinf, "sdgRhombusLinf" },
+	{ lua_sdRhombusLinfBatch, "sdRhombusLinfBatch" },
+	{ lua_sdRhombusLinfGrid, "sdRhombusLinfGrid" },
+	{ lua_sdRhombusLinfBitmap, "sdRhombusLinfBitmap" },
+	{ lua_sdTrapezoid, "sdTrapezoid" },
+	{ lua_sdgTrapezoid, "sdgTrapezoid" },
+	{ lua_sdTrapezoidBatch, "sdTrapezoidBatch" },
+	{ lua_sdTrapezoidGrid, "sdTrapezoidGrid" },
+	{ lua_sdTrapezoidBitmap, "sdTrapezoidBitmap" },
+	{ lua_sdParallelogram, "sdParallelogram" },
+	{ lua_sdgParallelogram, "sdgParallelogram" },
+	{ lua_sdParallelogramBatch, "sdParallelogramBatch" },
+	{ lua_sdParallelogramGrid, "sdParallelogramGrid" },
+	{ lua_sdParallelogramBitmap, "sdParallelogramBitmap" },
+	{ lua_sdTriangle, "sdTriangle" },
+	{ lua_sdgTriangle, "sdgTriangle" },
+	{ lua_sdTriangleBatch, "sdTriangleBatch" },
+	{ lua_sdTriangleGrid, "sdTriangleGrid" },
+	{ lua_sdTriangleBitmap, "sdTriangleBitmap" },
+	{ lua_sdTriangleIsosceles, "sdTriangleIsosceles" },
+	{ lua_sdgTriangleIsosceles, "sdgTriangleIsosceles" },
+	{ lua_sdTriangleIsoscelesBatch, "sdTriangleIsoscelesBatch" },
+	{ lua_sdTriangleIsoscelesGrid, "sdTriangleIsoscelesGrid" },
+	{ lua_sdTriangleIsoscelesBitmap, "sdTriangleIsoscelesBitmap" },
+	{ lua_sdEquilateralTriangle, "sdEquilateralTriangle" },
+	{ lua_sdgEquilateralTriangle, "sdgEquilateralTriangle" },
+	{ lua_sdEquilateralTriangleBatch, "sdEquilateralTriangleBatch" },
+	{ lua_sdEquilateralTriangleGrid, "sdEquilateralTriangleGrid" },
+	{ lua_sdEquilateralTriangleBitmap, "sdEquilateralTriangleBitmap" },
+	{ lua_sdQuad, "sdQuad" },
+	{ lua_sdgQuad, "sdgQuad" },
+	{ lua_sdQuadBatch, "sdQuadBatch" },
+	{ lua_sdQuadGrid, "sdQuadGrid" },
+	{ lua_sdQuadBitmap, "sdQuadBitmap" },
+	{ lua_sdStar5, "sdStar5" },
+	{ lua_sdgStar5, "sdgStar5" },
+	{ lua_sdStar5Batch, "sdStar5Batch" },
+	{ lua_sdStar5Grid, "sdStar5Grid" },
+	{ lua_sdStar5Bitmap, "sdStar5Bitmap" },
+	{ lua_sdPentagon, "sdPentagon" },
+	{ lua_sdgPentagon, "sdgPentagon" },
+	{ lua_sdPentagonBatch, "sdPentagonBatch" },
+	{ lua_sdPentagonGrid, "sdPentagonGrid" },
+	{ lua_sdPentagonBitmap, "sdPentagonBitmap" },
+	{ lua_sdHexagon, "sdHexagon" },
+	{ lua_sdgHexagon, "sdgHexagon" },
+	{ lua_sdHexagonBatch, "sdHexagonBatch" },
+	{ lua_sdHexagonGrid, "sdHexagonGrid" },
+	{ lua_sdHexagonBitmap, "sdHexagonBitmap" },
+	{ lua_sdOctagon, "sdOctagon" },
+	{ lua_sdgOctagon, "sdgOctagon" },
+	{ lua_sdOctagonBatch, "sdOctagonBatch" },
+	{ lua_sdOctagonGrid, "sdOctagonGrid" },
+	{ lua_sdOctagonBitmap, "sdOctagonBitmap" },
+	{ lua_sdHexagram, "sdHexagram" },
+	{ lua_sdgHexagram, "sdgHexagram" },
+	{ lua_sdHexagramBatch, "sdHexagramBatch" },
+	{ lua_sdHexagramGrid, "sdHexagramGrid" },
+	{ lua_sdHexagramBitmap, "sdHexagramBitmap" },
+	{ lua_sdPie, "sdPie" },
+	{ lua_sdgPie, "sdgPie" },
+	{ lua_sdPieBatch, "sdPieBatch" },
+	{ lua_sdPieGrid, "sdPieGrid" },
+	{ lua_sdPieBitmap, "sdPieBitmap" },
+	{ lua_sdCutDisk, "sdCutDisk" },
+	{ lua_sdgCutDisk, "sdgCutDisk" },
+	{ lua_sdCutDiskBatch, "sdCutDiskBatch" },
+	{ lua_sdCutDiskGrid, "sdCutDiskGrid" },
+	{ lua_sdCutDiskBitmap, "sdCutDiskBitmap" },
+	{ lua_sdArc, "sdArc" },
+	{ lua_sdgArc, "sdgArc" },
+	{ lua_sdArcBatch, "sdArcBatch" },
+	{ lua_sdArcGrid, "sdArcGrid" },
+	{ lua_sdArcBitmap, "sdArcBitmap" },
+	{ lua_sdRing, "sdRing" },
+	{ lua_sdgRing, "sdgRing" },
+	{ lua_sdRingBatch, "sdRingBatch" },
+	{ lua_sdRingGrid, "sdRingGrid" },
+	{ lua_sdRingBitmap, "sdRingBitmap" },
+	{ lua_sdHorseshoe, "sdHorseshoe" },
+	{ lua_sdgHorseshoe, "sdgHorseshoe" },
+	{ lua_sdHorseshoeBatch, "sdHorseshoeBatch" },
+	{ lua_sdHorseshoeGrid, "sdHorseshoeGrid" },
+	{ lua_sdHorseshoeBitmap, "sdHorseshoeBitmap" },
+	{ lua_sdVesica, "sdVesica" },
+	{ lua_sdgVesica, "sdgVesica" },
+	{ lua_sdVesicaBatch, "sdVesicaBatch" },
+	{ lua_sdVesicaGrid, "sdVesicaGrid" },
+	{ lua_sdVesicaBitmap, "sdVesicaBitmap" },
+	{ lua_sdOrientedVesica, "sdOrientedVesica" },
+	{ lua_sdgOrientedVesica, "sdgOrientedVesica" },
+	{ lua_sdOrientedVesicaBatch, "sdOrientedVesicaBatch" },
+	{ lua_sdOrientedVesicaGrid, "sdOrientedVesicaGrid" },
+	{ lua_sdOrientedVesicaBitmap, "sdOrientedVesicaBitmap" },
+	{ lua_sdMoon, "sdMoon" },
+	{ lua_sdgMoon, "sdgMoon" },
+	{ lua_sdMoonBatch, "sdMoonBatch" },
+	{ lua_sdMoonGrid, "sdMoonGrid" },
+	{ lua_sdMoonBitmap, "sdMoonBitmap" },
+	{ lua_sdCross, "sdCross" },
+	{ lua_sdgCross, "sdgCross" },
+	{ lua_sdCrossBatch, "sdCrossBatch" },
+	{ lua_sdCrossGrid, "sdCrossGrid" },
+	{ lua_sdCrossBitmap, "sdCrossBitmap" },
+	{ lua_sdRoundedX, "sdRoundedX" },
+	{ lua_sdgRoundedX, "sdgRoundedX" },
+	{ lua_sdRoundedXBatch, "sdRoundedXBatch" },
+	{ lua_sdRoundedXGrid, "sdRoundedXGrid" },
+	{ lua_sdRoundedXBitmap, "sdRoundedXBitmap" },
+	{ lua_sdParabola, "sdParabola" },
+	{ lua_sdgParabola, "sdgParabola" },
+	{ lua_sdParabolaBatch, "sdParabolaBatch" },
+	{ lua_sdParabolaGrid, "sdParabolaGrid" },
+	{ lua_sdParabolaBitmap, "sdParabolaBitmap" },
+	{ lua_sdTunnel, "sdTunnel" },
+	{ lua_sdgTunnel, "sdgTunnel" },
+	{ lua_sdTunnelBatch, "sdTunnelBatch" },
+	{ lua_sdTunnelGrid, "sdTunnelGrid" },
+	{ lua_sdTunnelBitmap, "sdTunnelBitmap" },
+	{ lua_sdEllipse, "sdEllipse" },
+	{ lua_sdgEllipse, "sdgEllipse" },
+	{ lua_sdEllipseBatch, "sdEllipseBatch" },
+	{ lua_sdEllipseGrid, "sdEllipseGrid" },
+	{ lua_sdEllipseBitmap, "sdEllipseBitmap" },
+	{ lua_sdEllipseLinf, "sdEllipseLinf" },
+	{ lua_sdgEllipseLinf, "sdgEllipseLinf" },
+	{ lua_sdEllipseLinfBatch, "sdEllipseLinfBatch" },
+	{ lua_sdEllipseLinfGrid, "sdEllipseLinfGrid" },
+	{ lua_sdEllipseLinfBitmap, "sdEllipseLinfBitmap" },
+	{ lua_sdRegularPolygon, "sdRegularPolygon" },
+	{ lua_sdgRegularPolygon, "sdgRegularPolygon" },
+	{ lua_sdRegularPolygonBatch, "sdRegularPolygonBatch" },
+	{ lua_sdRegularPolygonGrid, "sdRegularPolygonGrid" },
+	{ lua_sdRegularPolygonBitmap, "sdRegularPolygonBitmap" },
+	{ lua_sdPolygon, "sdPolygon" },
+	{ lua_sdgPolygon, "sdgPolygon" },
+	{ lua_sdPolygonBatch, "sdPolygonBatch" },
+	{ lua_sdPolygonGrid, "sdPolygonGrid" },
+	{ lua_sdPolygonBitmap, "sdPolygonBitmap" },
+	{ lua_sdRoundSquare, "sdRoundSquare" },
+	{ lua_sdgRoundSquare, "sdgRoundSquare" },
+	{ lua_sdRoundSquareBatch, "sdRoundSquareBatch" },
+	{ lua_sdRoundSquareGrid, "sdRoundSquareGrid" },
+	{ lua_sdRoundSquareBitmap, "sdRoundSquareBitmap" },
+	{ lua_sdEgg, "sdEgg" },
+	{ lua_sdgEgg, "sdgEgg" },
+	{ lua_sdEggBatch, "sdEggBatch" },
+	{ lua_sdEggGrid, "sdEggGrid" },
+	{ lua_sdEggBitmap, "sdEggBitmap" },
+	{ lua_sdUnevenCapsule, "sdUnevenCapsule" },
+	{ lua_sdgUnevenCapsule, "sdgUnevenCapsule" },
+	{ lua_sdUnevenCapsuleBatch, "sdUnevenCapsuleBatch" },
+	{ lua_sdUnevenCapsuleGrid, "sdUnevenCapsuleGrid" },
+	{ lua_sdUnevenCapsuleBitmap, "sdUnevenCapsuleBitmap" },
+	{ lua_sdBezier, "sdBezier" },
+	{ lua_sdgBezier, "sdgBezier" },
+	{ lua_sdBezierBatch, "sdBezierBatch" },
+	{ lua_sdBezierGrid, "sdBezierGrid" },
+	{ lua_sdBezierBitmap, "sdBezierBitmap" },
+};
+
+int sdLuaRegister(PlaydateAPI *playdate)
+{
+	const char *err;
+	int result = 0;
+	pd = playdate;
+	for (size_t i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {
+		if (!pd->lua->addFunction(functions[i].func, functions[i].name, &err)) {
+			pd->system->logToConsole("sdLuaRegister: %s: %s", functions[i].name, err);
+			result = -1;
+		}
+	}
+	if (!pd->lua->registerClass(SHAPE_CLASS, shapeClass, NULL, 0, &err)) {
+		pd->system->logToConsole("sdLuaRegister: %s: %s", SHAPE_CLASS, err);
+		result = -1;
+	}
+	return result;
+}
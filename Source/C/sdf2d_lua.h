@@ -0,0 +1,46 @@
+#ifndef SDF2D_LUA_H
+#define SDF2D_LUA_H
+
+// Playdate Lua bindings of every function in sdf2d.h, generated into sdf2d_lua.c by
+// Source/Tools/gen_lua_bindings.py. Each shape sdXxx gets five global Lua functions:
+//
+//	d = sdXxx(px, py, ...)                  as in SDF2D.lua, but in C
+//	d, gx, gy = sdgXxx(px, py, ...)         distance and gradient
+//	ds = sdXxxBatch(pxs, pys, ...)          distances at many points in one call
+//	ds = sdXxxGrid(x, y, w, h, cell, ...)   distances at w x h points (x + i * cell, y + j * cell), row by row
+//	sdXxxBitmap(image, ox, oy, ...)         the shape at (ox, oy) filled black into a 1-bit image
+//
+// where ... are the shape parameters of sdXxx. Arrays of points and distances are strings of packed
+// floats, so a whole array crosses between Lua and C in one argument:
+//
+//	local pxs = string.pack("fff", 10, 20, 30)
+//	local ds = sdCircleBatch(pxs, string.pack("fff", 0, 0, 0), 15)
+//	local d2 = string.unpack("f", ds, 4 + 1)        -- the second distance
+//
+// Batches are as long as the shorter of pxs and pys. sdPolygon and its variants take vx and vy as
+// packed floats too, cut to the shorter, and return nothing without vertices.
+//
+// The SDShapeC class keeps a shape's parameters in C, so that collision queries pass only the point:
+//
+//	local box = SDShapeC.new("sdBox", 200, 120, 40, 20)   -- sdBox placed at 200, 120
+//	local d, nx, ny = box:distanceGradient(x, y)          -- also box:distance(x, y), box:gradient(x, y)
+//	box:moveTo(210, 120)
+//	local xy, starts = box:contour(0, 0, 401, 241, 1, 0.25)   -- its outline on the screen, as polylines
+//
+// The normal is the sdShapeEvalGrad gradient, normalized. contour traces the shape with
+// sdContourShape and returns its vertices as packed floats x, y and the first vertex of each polyline
+// (0 based, then the vertex count) as packed ints, string.unpack("i4", starts, 4 * i + 1). SDShape.new
+// in SDF2D.lua returns these objects when the bindings are registered.
+//
+// sdXxxBitmap renders as sdRasterShapeCulled with kSDRasterFill, so besides sdf2d.c the build needs
+// sdf2d_shape.c, sdf2d_scene.c, sdf2d_tiles.c, sdf2d_raster.c and, for contour, sdf2d_contour.c.
+//
+// Call sdLuaRegister from the kEventInitLua event. Examples/Host/LuaBindings runs the bindings on
+// Linux against stock Lua 5.4 through a stand-in for pd_api.h.
+
+#include "pd_api.h"
+
+// Returns 0, or -1 if a function or the class could not be added (the error is logged to the console).
+int sdLuaRegister(PlaydateAPI *pd);
+
+#endif
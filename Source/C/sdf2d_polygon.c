@@ -0,0 +1,337 @@
+// Large polygons with an edge hierarchy. See sdf2d_polygon.h.
+
+#include "sdf2d_polygon.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SD_POLYGON_LEAF 4
+#define SD_POLYGON_STACK 64
+
+void sdPolygonIndexInit(SDPolygonIndex *poly)
+{
+	memset(poly, 0, sizeof(SDPolygonIndex));
+}
+
+void sdPolygonIndexFree(SDPolygonIndex *poly)
+{
+	free(poly->ax);
+	free(poly->nodes);
+	free(poly->cells);
+	sdPolygonIndexInit(poly);
+}
+
+typedef struct {
+	const float *vx, *vy;
+	int n;               // vertices
+	float *cx, *cy;      // edge midpoints, by edge id
+	int *order;          // edge ids in leaf order
+	SDPolygonIndex *poly;
+} SDPolygonBuild;
+
+static void sdPolygonEdgeBounds(const SDPolygonBuild *b, int i, SDBounds *e)
+{
+	int j = i ? i - 1 : b->n - 1;
+	e->minx = fminf(b->vx[i], b->vx[j]);
+	e->maxx = fmaxf(b->vx[i], b->vx[j]);
+	e->miny = fminf(b->vy[i], b->vy[j]);
+	e->maxy = fmaxf(b->vy[i], b->vy[j]);
+}
+
+// Partition order[lo..hi) so that the k-th entry is in its sorted position along c
+static void sdPolygonSelect(const float *c, int *o, int lo, int hi, int k)
+{
+	while (hi - lo > 1) {
+		float pivot = c[o[(lo + hi) / 2]];
+		int i = lo, j = hi - 1;
+		while (i <= j) {
+			while (c[o[i]] < pivot) i++;
+			while (c[o[j]] > pivot) j--;
+			if (i <= j) {
+				int t = o[i]; o[i] = o[j]; o[j] = t;
+				i++;
+				j--;
+			}
+		}
+		if (k <= j) hi = j + 1;
+		else if (k >= i) lo = i;
+		else return;
+	}
+}
+
+static int sdPolygonBuildNode(SDPolygonBuild *b, int first, int count)
+{
+	SDPolygonIndex *poly = b->poly;
+	int id = poly->numNodes++;
+	SDPolygonNode *nd = &poly->nodes[id];
+	SDBounds e;
+	sdPolygonEdgeBounds(b, b->order[first], &nd->bounds);
+	for (int i = 1; i < count; i++) {
+		sdPolygonEdgeBounds(b, b->order[first + i], &e);
+		nd->bounds.minx = fminf(nd->bounds.minx, e.minx);
+		nd->bounds.miny = fminf(nd->bounds.miny, e.miny);
+		nd->bounds.maxx = fmaxf(nd->bounds.maxx, e.maxx);
+		nd->bounds.maxy = fmaxf(nd->bounds.maxy, e.maxy);
+	}
+	nd->first = first;
+	nd->right = -1;
+	if (count <= SD_POLYGON_LEAF) {
+		nd->count = count;
+		return id;
+	}
+	nd->count = 0;
+	int axis = (nd->bounds.maxy - nd->bounds.miny) > (nd->bounds.maxx - nd->bounds.minx);
+	int half = count / 2;
+	sdPolygonSelect(axis ? b->cy : b->cx, b->order, first, first + count, first + half);
+	sdPolygonBuildNode(b, first, half);
+	int right = sdPolygonBuildNode(b, first + half, count - half);
+	poly->nodes[id].right = right;
+	return id;
+}
+
+// Parity of the crossings of the ray from (px, py) to +x, with the tests of sdPolygon. Only nodes
+// that straddle the row and reach px can hold a crossing edge.
+static int sdPolygonCrossings(const SDPolygonIndex *poly, float px, float py)
+{
+	int stack[SD_POLYGON_STACK];
+	int sp = 0, odd = 0;
+	stack[sp++] = 0;
+	while (sp) {
+		const SDPolygonNode *nd = &poly->nodes[stack[--sp]];
+		if (py < nd->bounds.miny || py >= nd->bounds.maxy || px > nd->bounds.maxx) continue;
+		if (nd->count == 0) {
+			stack[sp++] = nd->right;
+			stack[sp++] = (int)(nd - poly->nodes) + 1;
+			continue;
+		}
+		for (int k = nd->first; k < nd->first + nd->count; k++) {
+			float wx = px - poly->ax[k], wy = py - poly->ay[k];
+			int c1 = (py >= poly->ay[k]);
+			int c2 = (py < poly->by[k]);
+			int c3 = (poly->ex[k] * wy > poly->ey[k] * wx);
+			if ((c1 && c2 && c3) || (!c1 && !c2 && !c3)) odd ^= 1;
+		}
+	}
+	return odd;
+}
+
+// Whether the edge from (ax, ay) along (ex, ey) may touch the box: not all corners strictly on one side
+static int sdPolygonEdgeTouches(float ax, float ay, float ex, float ey, float x0, float y0, float x1, float y1)
+{
+	float c0 = ex * (y0 - ay) - ey * (x0 - ax), c1 = ex * (y0 - ay) - ey * (x1 - ax);
+	float c2 = ex * (y1 - ay) - ey * (x0 - ax), c3 = ex * (y1 - ay) - ey * (x1 - ax);
+	return !((c0 > 0.0f && c1 > 0.0f && c2 > 0.0f && c3 > 0.0f) || (c0 < 0.0f && c1 < 0.0f && c2 < 0.0f && c3 < 0.0f));
+}
+
+// About one cell per edge over the bounds. Cells touched by an edge (grown by a sliver, so that
+// rounding in the cell lookup cannot step over an edge) are kSDCellEdge, the others take the
+// parity at their center.
+static int sdPolygonBuildCells(SDPolygonIndex *poly)
+{
+	const SDBounds *b = &poly->bounds;
+	float w = b->maxx - b->minx, h = b->maxy - b->miny, size = fmaxf(w, h);
+	float s = sqrtf(fmaxf(w * h, size * size * 1e-4f) / poly->n);
+	s = fmaxf(s, size / SD_POLYGON_MAX_CELLS);
+	if (!(s > 0.0f)) s = 1.0f;
+	poly->cellsX = (int)(w / s) + 1;
+	poly->cellsY = (int)(h / s) + 1;
+	if (poly->cellsX > SD_POLYGON_MAX_CELLS) poly->cellsX = SD_POLYGON_MAX_CELLS;
+	if (poly->cellsY > SD_POLYGON_MAX_CELLS) poly->cellsY = SD_POLYGON_MAX_CELLS;
+	float cw = w > 0.0f ? w / poly->cellsX : 1.0f, ch = h > 0.0f ? h / poly->cellsY : 1.0f;
+	poly->invCellW = 1.0f / cw;
+	poly->invCellH = 1.0f / ch;
+	poly->cells = malloc((size_t)poly->cellsX * poly->cellsY);
+	if (!poly->cells) return -1;
+	memset(poly->cells, kSDCellOutside, (size_t)poly->cellsX * poly->cellsY);
+
+	float gx = cw * 1e-3f, gy = ch * 1e-3f;
+	for (int k = 0; k < poly->n; k++) {
+		float ax = poly->ax[k], ay = poly->ay[k], ex = poly->ex[k], ey = poly->ey[k];
+		int i0 = (int)((fminf(ax, ax + ex) - b->minx) * poly->invCellW) - 1;
+		int i1 = (int)((fmaxf(ax, ax + ex) - b->minx) * poly->invCellW) + 1;
+		int j0 = (int)((fminf(ay, ay + ey) - b->miny) * poly->invCellH) - 1;
+		int j1 = (int)((fmaxf(ay, ay + ey) - b->miny) * poly->invCellH) + 1;
+		if (i0 < 0) i0 = 0;
+		if (j0 < 0) j0 = 0;
+		if (i1 >= poly->cellsX) i1 = poly->cellsX - 1;
+		if (j1 >= poly->cellsY) j1 = poly->cellsY - 1;
+		for (int j = j0; j <= j1; j++) {
+			float y0 = b->miny + j * ch - gy, y1 = b->miny + (j + 1) * ch + gy;
+			if (fminf(ay, ay + ey) > y1 || fmaxf(ay, ay + ey) < y0) continue;
+			for (int i = i0; i <= i1; i++) {
+				float x0 = b->minx + i * cw - gx, x1 = b->minx + (i + 1) * cw + gx;
+				if (fminf(ax, ax + ex) > x1 || fmaxf(ax, ax + ex) < x0) continue;
+				if (sdPolygonEdgeTouches(ax, ay, ex, ey, x0, y0, x1, y1)) poly->cells[j * poly->cellsX + i] = kSDCellEdge;
+			}
+		}
+	}
+	for (int j = 0; j < poly->cellsY; j++) {
+		for (int i = 0; i < poly->cellsX; i++) {
+			unsigned char *c = &poly->cells[j * poly->cellsX + i];
+			if (*c == kSDCellEdge) continue;
+			*c = sdPolygonCrossings(poly, b->minx + (i + 0.5f) * cw, b->miny + (j + 0.5f) * ch) ? kSDCellInside : kSDCellOutside;
+		}
+	}
+	return 0;
+}
+
+// The edges from vertex i to i - 1 for i >= first: 0 closes the outline, 1 leaves a chain open
+static int sdPolygonIndexEdges(SDPolygonIndex *poly, const float vx[], const float vy[], int num, int first)
+{
+	sdPolygonIndexFree(poly);
+	if (num < 1 + first || !vx || !vy) return -1;
+	size_t n = num - first;
+	SDPolygonBuild b = { vx, vy, num, malloc(2 * (size_t)num * sizeof(float)), NULL, malloc(n * sizeof(int)), poly };
+	poly->ax = malloc(6 * n * sizeof(float));
+	poly->nodes = malloc(2 * n * sizeof(SDPolygonNode));
+	if (!b.cx || !b.order || !poly->ax || !poly->nodes) {
+		free(b.cx);
+		free(b.order);
+		sdPolygonIndexFree(poly);
+		return -1;
+	}
+	poly->n = (int)n;
+	poly->ay = poly->ax + n;
+	poly->ex = poly->ax + 2 * n;
+	poly->ey = poly->ax + 3 * n;
+	poly->by = poly->ax + 4 * n;
+	poly->inv = poly->ax + 5 * n;
+	b.cy = b.cx + num;
+	for (int i = first, j = i ? i - 1 : num - 1; i < num; j = i++) {
+		b.cx[i] = vx[i] * 0.5f + vx[j] * 0.5f;
+		b.cy[i] = vy[i] * 0.5f + vy[j] * 0.5f;
+		b.order[i - first] = i;
+	}
+	sdPolygonBuildNode(&b, 0, (int)n);
+
+	// edges in leaf order, so that a leaf reads consecutive floats
+	for (size_t k = 0; k < n; k++) {
+		int i = b.order[k], j = i ? i - 1 : num - 1;
+		float ex = vx[j] - vx[i], ey = vy[j] - vy[i];
+		float len2 = ex * ex + ey * ey;
+		poly->ax[k] = vx[i];
+		poly->ay[k] = vy[i];
+		poly->ex[k] = ex;
+		poly->ey[k] = ey;
+		poly->by[k] = vy[j];
+		poly->inv[k] = len2 > 0.0f ? 1.0f / len2 : 0.0f;
+	}
+	free(b.cx);
+	free(b.order);
+	poly->bounds = poly->nodes[0].bounds;
+	return 0;
+}
+
+int sdPolygonIndexBuild(SDPolygonIndex *poly, const float vx[], const float vy[], int num)
+{
+	if (sdPolygonIndexEdges(poly, vx, vy, num, 0) < 0) return -1;
+	if (sdPolygonBuildCells(poly) < 0) {
+		sdPolygonIndexFree(poly);
+		return -1;
+	}
+	return 0;
+}
+
+int sdPolylineIndexBuild(SDPolygonIndex *line, const float vx[], const float vy[], int num)
+{
+	return sdPolygonIndexEdges(line, vx, vy, num, 1);
+}
+
+static inline float sdPolygonBoxDistance2(const SDBounds *b, float px, float py)
+{
+	float dx = fmaxf(fmaxf(b->minx - px, px - b->maxx), 0.0f);
+	float dy = fmaxf(fmaxf(b->miny - py, py - b->maxy), 0.0f);
+	return dx * dx + dy * dy;
+}
+
+// Squared distance to the nearest edge, and the vector from its closest point to p
+static float sdPolygonNearest(const SDPolygonIndex *poly, float px, float py, float *vx, float *vy)
+{
+	int stack[SD_POLYGON_STACK];
+	int sp = 0;
+	float best = HUGE_VALF, bx = 0.0f, by = 0.0f;
+	stack[sp++] = 0;
+	while (sp) {
+		const SDPolygonNode *nd = &poly->nodes[stack[--sp]];
+		if (sdPolygonBoxDistance2(&nd->bounds, px, py) >= best) continue;
+		if (nd->count == 0) {
+			// the nearer child first, so that the far one is more likely to be pruned
+			int left = (int)(nd - poly->nodes) + 1;
+			float dl = sdPolygonBoxDistance2(&poly->nodes[left].bounds, px, py);
+			float dr = sdPolygonBoxDistance2(&poly->nodes[nd->right].bounds, px, py);
+			stack[sp++] = dl < dr ? nd->right : left;
+			stack[sp++] = dl < dr ? left : nd->right;
+			continue;
+		}
+		for (int k = nd->first; k < nd->first + nd->count; k++) {
+			float wx = px - poly->ax[k], wy = py - poly->ay[k];
+			float pr = fmaxf(0.0f, fminf((wx * poly->ex[k] + wy * poly->ey[k]) * poly->inv[k], 1.0f));
+			float cx = wx - poly->ex[k] * pr, cy = wy - poly->ey[k] * pr;
+			float d = cx * cx + cy * cy;
+			if (d < best) {
+				best = d;
+				bx = cx;
+				by = cy;
+			}
+		}
+	}
+	*vx = bx;
+	*vy = by;
+	return best;
+}
+
+int sdPolygonIndexInside(const SDPolygonIndex *poly, float px, float py)
+{
+	const SDBounds *b = &poly->bounds;
+	if (!poly->cells || !(px >= b->minx && px <= b->maxx && py >= b->miny && py <= b->maxy)) return 0;
+	int i = (int)((px - b->minx) * poly->invCellW), j = (int)((py - b->miny) * poly->invCellH);
+	if (i >= poly->cellsX) i = poly->cellsX - 1;
+	if (j >= poly->cellsY) j = poly->cellsY - 1;
+	unsigned char c = poly->cells[j * poly->cellsX + i];
+	if (c != kSDCellEdge) return c == kSDCellInside;
+	return sdPolygonCrossings(poly, px, py);
+}
+
+float sdPolygonIndexEval(const SDPolygonIndex *poly, float px, float py)
+{
+	float vx, vy;
+	float d = sqrtf(sdPolygonNearest(poly, px, py, &vx, &vy));
+	return sdPolygonIndexInside(poly, px, py) ? -d : d;
+}
+
+float sdgPolygonIndexEval(const SDPolygonIndex *poly, float px, float py, float *gx, float *gy)
+{
+	float vx, vy;
+	float d = sqrtf(sdPolygonNearest(poly, px, py, &vx, &vy));
+	float s = sdPolygonIndexInside(poly, px, py) ? -1.0f : 1.0f;
+	float il = d > 0.0f ? s / d : 0.0f;
+	*gx = vx * il;
+	*gy = vy * il;
+	return s * d;
+}
+
+void sdPolygonIndexEvalBatch(const SDPolygonIndex *poly, const float *px, const float *py, float *out, size_t n)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdPolygonIndexEval(poly, px[i], py[i]);
+}
+
+float sdPolylineIndexEval(const SDPolygonIndex *line, float px, float py, float th)
+{
+	float vx, vy;
+	return sqrtf(sdPolygonNearest(line, px, py, &vx, &vy)) - th;
+}
+
+float sdgPolylineIndexEval(const SDPolygonIndex *line, float px, float py, float th, float *gx, float *gy)
+{
+	float vx, vy;
+	float d = sqrtf(sdPolygonNearest(line, px, py, &vx, &vy));
+	float il = d > 0.0f ? 1.0f / d : 0.0f;
+	*gx = vx * il;
+	*gy = vy * il;
+	return d - th;
+}
+
+void sdPolylineIndexEvalBatch(const SDPolygonIndex *line, const float *px, const float *py, float *out, size_t n, float th)
+{
+	for (size_t i = 0; i < n; i++) out[i] = sdPolylineIndexEval(line, px[i], py[i], th);
+}
@@ -0,0 +1,77 @@
+#ifndef SDF2D_POLYGON_H
+#define SDF2D_POLYGON_H
+
+// Large polygons: sdPolygon (and sdPolygonEval in sdf2d_prep.h) visit every edge per point, which is
+// fine for a handful of vertices but not for level outlines with thousands. An SDPolygonIndex keeps
+// the edges as structure-of-arrays in the leaf order of a bounding volume hierarchy, with their
+// reciprocal squared lengths, so a query only visits the edges near the point.
+//
+//	SDPolygonIndex level;
+//	sdPolygonIndexInit(&level);
+//	sdPolygonIndexBuild(&level, vx, vy, 2000);
+//	float d = sdPolygonIndexEval(&level, px, py);
+//	sdPolygonIndexFree(&level);
+//
+// The distance is found by branch and bound, nearer children first, pruning nodes whose box is
+// further than the best edge so far. The sign is that of sdPolygon (even-odd): a grid of cells over
+// the polygon caches whether each cell no edge crosses is inside or outside, and only points in
+// cells crossed by an edge count the crossings of a ray to +x, visiting just the nodes that straddle
+// the row of the point. Results match sdPolygon to within float rounding.
+
+#include <stddef.h>
+#include "sdf2d_shape.h"
+
+#define SD_POLYGON_MAX_CELLS 256   // cells per side of the inside cache
+
+typedef enum {
+	kSDCellOutside,
+	kSDCellInside,
+	kSDCellEdge,         // crossed by an edge: count crossings
+} SDPolygonCell;
+
+typedef struct {
+	SDBounds bounds;
+	int right;           // inner node: index of the right child (the left child follows the node)
+	int first;           // leaf: first edge
+	int count;           // leaf: number of edges, 0 for inner nodes
+} SDPolygonNode;
+
+typedef struct {
+	int n;               // edges, one per vertex
+	float *ax, *ay;      // edge start: vertex i
+	float *ex, *ey;      // edge vector, to vertex i - 1 as in sdPolygon
+	float *by;           // y of vertex i - 1, for the same crossing test as sdPolygon
+	float *inv;          // 1 / |e|^2, 0 for repeated vertices
+	SDPolygonNode *nodes;
+	int numNodes;
+	unsigned char *cells;        // SDPolygonCell per cell, row by row over bounds; NULL for a polyline
+	int cellsX, cellsY;
+	float invCellW, invCellH;
+	SDBounds bounds;
+} SDPolygonIndex;
+
+void sdPolygonIndexInit(SDPolygonIndex *poly);
+void sdPolygonIndexFree(SDPolygonIndex *poly);
+
+// Build from num vertices, as sdPolygon takes them; the arrays are copied. Returns 0, or -1 if num
+// < 1 or allocation fails.
+int sdPolygonIndexBuild(SDPolygonIndex *poly, const float vx[], const float vy[], int num);
+
+float sdPolygonIndexEval(const SDPolygonIndex *poly, float px, float py);
+float sdgPolygonIndexEval(const SDPolygonIndex *poly, float px, float py, float *gx, float *gy);   // see sdgPolygon
+void sdPolygonIndexEvalBatch(const SDPolygonIndex *poly, const float *px, const float *py, float *out, size_t n);
+
+// 1 where sdPolygonIndexEval is negative, without the distance: a cache lookup away from the edges
+int sdPolygonIndexInside(const SDPolygonIndex *poly, float px, float py);
+
+// Open chains of segments (tracks, ropes, wires) in the same hierarchy: num vertices, num - 1
+// segments, no closing edge and no inside cache. The distance is unsigned less th, a thick line with
+// round ends and joints. As for polygons, a query only visits the segments near the point.
+// Returns 0, or -1 if num < 2 or allocation fails.
+int sdPolylineIndexBuild(SDPolygonIndex *line, const float vx[], const float vy[], int num);
+
+float sdPolylineIndexEval(const SDPolygonIndex *line, float px, float py, float th);
+float sdgPolylineIndexEval(const SDPolygonIndex *line, float px, float py, float th, float *gx, float *gy);
+void sdPolylineIndexEvalBatch(const SDPolygonIndex *line, const float *px, const float *py, float *out, size_t n, float th);
+
+#endif
@@ -0,0 +1,881 @@
+// Prepared shapes. See sdf2d_prep.h. Each Eval follows its sdXxx in sdf2d.c with the
+// point-independent terms read from the struct.
+
+#include "sdf2d_prep.h"
+#include <math.h>
+
+static inline float sgn(float x)
+{
+	return (float)((x > 0.0f) - (x < 0.0f));
+}
+
+static inline float clampf(float x, float lo, float hi)
+{
+	return fmaxf(lo, fminf(x, hi));
+}
+
+// length(max(q, 0)) + min(max(qx, qy), 0)
+static inline float boxTail(float qx, float qy)
+{
+	float mx = fmaxf(qx, 0.0f);
+	float my = fmaxf(qy, 0.0f);
+	return sqrtf(mx*mx + my*my) + fminf(fmaxf(qx, qy), 0.0f);
+}
+
+void sdCirclePrepare(SDCirclePrep *s, float r)
+{
+	s->r = r;
+}
+
+float sdCircleEval(const SDCirclePrep *s, float px, float py)
+{
+	return sqrtf(px*px + py*py) - s->r;
+}
+
+void sdBoxPrepare(SDBoxPrep *s, float bx, float by)
+{
+	s->bx = bx;
+	s->by = by;
+}
+
+float sdBoxEval(const SDBoxPrep *s, float px, float py)
+{
+	return boxTail(fabsf(px) - s->bx, fabsf(py) - s->by);
+}
+
+void sdBoxLinfPrepare(SDBoxLinfPrep *s, float bx, float by)
+{
+	s->bx = bx;
+	s->by = by;
+}
+
+float sdBoxLinfEval(const SDBoxLinfPrep *s, float px, float py)
+{
+	return fmaxf(fabsf(px) - s->bx, fabsf(py) - s->by);
+}
+
+void sdRoundedBoxPrepare(SDRoundedBoxPrep *s, float bx, float by, float rw, float rx, float ry, float rz)
+{
+	s->bx = bx;
+	s->by = by;
+	s->rw = rw;
+	s->rx = rx;
+	s->ry = ry;
+	s->rz = rz;
+}
+
+float sdRoundedBoxEval(const SDRoundedBoxPrep *s, float px, float py)
+{
+	// load all four radii so that the quadrant picks compile to selects, not branches
+	float rw = s->rw, rx = s->rx, ry = s->ry, rz = s->rz;
+	rw = (px <= 0) ? ry : rw;
+	rx = (px <= 0) ? rz : rx;
+	rw = (py < 0) ? rx : rw;
+	return boxTail(fabsf(px) - s->bx + rw, fabsf(py) - s->by + rw) - rw;
+}
+
+void sdOrientedBoxPrepare(SDOrientedBoxPrep *s, float ax, float ay, float bx, float by, float th)
+{
+	float l = sqrtf((bx-ax)*(bx-ax) + (by-ay)*(by-ay));
+	s->cx = (ax+bx)*0.5f;
+	s->cy = (ay+by)*0.5f;
+	s->dx = (bx-ax)/l;
+	s->dy = (by-ay)/l;
+	s->hl = l*0.5f;
+	s->th = th;
+}
+
+float sdOrientedBoxEval(const SDOrientedBoxPrep *s, float px, float py)
+{
+	float cx = px - s->cx;
+	float cy = py - s->cy;
+	float qx = fabsf(s->dx*cx + s->dy*cy) - s->hl;
+	float qy = fabsf(-s->dy*cx + s->dx*cy) - s->th;
+	return boxTail(qx, qy);
+}
+
+void sdSegmentPrepare(SDSegmentPrep *s, float ax, float ay, float bx, float by)
+{
+	s->ax = ax;
+	s->ay = ay;
+	s->bax = bx-ax;
+	s->bay = by-ay;
+	s->bb = s->bax*s->bax + s->bay*s->bay;
+}
+
+float sdSegmentEval(const SDSegmentPrep *s, float px, float py)
+{
+	float pax = px - s->ax;
+	float pay = py - s->ay;
+	float h = clampf((pax*s->bax + pay*s->bay) / s->bb, 0.0f, 1.0f);
+	float gx = pax - s->bax*h;
+	float gy = pay - s->bay*h;
+	return sqrtf(gx*gx + gy*gy);
+}
+
+void sdSegmentLinfPrepare(SDSegmentLinfPrep *s, float ax, float ay, float bx, float by)
+{
+	s->ax = ax;
+	s->ay = ay;
+	s->bax = bx-ax;
+	s->bay = by-ay;
+	s->s = (s->bax*s->bay > 0.0f) ? 1.0f : -1.0f;
+	s->inv = 1.0f / (s->bay + s->s*s->bax);
+}
+
+float sdSegmentLinfEval(const SDSegmentLinfPrep *s, float px, float py)
+{
+	float pax = px - s->ax;
+	float pay = py - s->ay;
+	float h = clampf((pay + s->s*pax) * s->inv, 0.0f, 1.0f);
+	return fmaxf(fabsf(pax - h*s->bax), fabsf(pay - h*s->bay));
+}
+
+void sdRhombusPrepare(SDRhombusPrep *s, float bx, float by)
+{
+	s->bx = bx;
+	s->by = by;
+	s->hx = bx*0.5f;
+	s->hy = by*0.5f;
+	s->bxby = bx*by;
+	s->inv = 1.0f / (bx*bx + by*by);
+}
+
+float sdRhombusEval(const SDRhombusPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	float f1x = s->bx - px*2.0f;
+	float f1y = s->by - py*2.0f;
+	float h = clampf((f1x*s->bx - f1y*s->by) * s->inv, -1.0f, 1.0f);
+	float dvx = px - s->hx*(1.0f-h);
+	float dvy = py - s->hy*(1.0f+h);
+	return sqrtf(dvx*dvx + dvy*dvy) * sgn(px*s->by + py*s->bx - s->bxby);
+}
+
+void sdRhombusLinfPrepare(SDRhombusLinfPrep *s, float bx, float by)
+{
+	s->w = bx;
+	s->h = by;
+	s->inv = 1.0f / (bx + by);
+}
+
+float sdRhombusLinfEval(const SDRhombusLinfPrep *s, float px, float py)
+{
+	px = fabsf(px) - s->w;
+	py = fabsf(py);
+	float f = clampf((py-px) * s->inv, 0.0f, 1.0f);
+	float qx = fabsf(px + f*s->w);
+	float qy = fabsf(py - f*s->h);
+	return fmaxf(qx, qy) * ((s->h*px + s->w*py > 0.0f) ? 1.0f : -1.0f);
+}
+
+void sdTrapezoidPrepare(SDTrapezoidPrep *s, float r1, float r2, float he)
+{
+	s->r1 = r1;
+	s->r2 = r2;
+	s->he = he;
+	s->k2x = r2-r1;
+	s->k2y = 2.0f*he;
+	s->inv = 1.0f / (s->k2x*s->k2x + s->k2y*s->k2y);
+}
+
+float sdTrapezoidEval(const SDTrapezoidPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float r1 = s->r1, r2 = s->r2;
+	float cax = px - fminf(px, (py < 0.0f) ? r1 : r2);
+	float cay = fabsf(py) - s->he;
+	float d = clampf((s->k2x*(r2-px) + s->k2y*(s->he-py)) * s->inv, 0.0f, 1.0f);
+	float cbx = px - r2 + s->k2x*d;
+	float cby = py - s->he + s->k2y*d;
+	float sg = (cbx < 0.0f && cay < 0.0f) ? -1.0f : 1.0f;
+	return sg*sqrtf(fminf(cax*cax + cay*cay, cbx*cbx + cby*cby));
+}
+
+void sdParallelogramPrepare(SDParallelogramPrep *s, float wi, float he, float sk)
+{
+	s->wi = wi;
+	s->he = he;
+	s->sk = sk;
+	s->wihe = wi*he;
+	s->ee = sk*sk + he*he;
+}
+
+float sdParallelogramEval(const SDParallelogramPrep *s, float px, float py)
+{
+	float ex = s->sk, ey = s->he;
+	if (py < 0.0f) { px = -px; py = -py; }
+	float wx = px - ex;
+	float wy = py - ey;
+	wx -= clampf(wx, -s->wi, s->wi);
+	float dx = wx*wx + wy*wy;
+	float dy = -wy;
+	float c = px*ey - py*ex;
+	if (c < 0.0f) { px = -px; py = -py; }
+	float vx = px - s->wi;
+	float vy = py;
+	float m = clampf((vx*ex + vy*ey) / s->ee, -1.0f, 1.0f);
+	vx -= ex*m;
+	vy -= ey*m;
+	dx = fminf(dx, vx*vx + vy*vy);
+	dy = fminf(dy, s->wihe - fabsf(c));
+	return sqrtf(dx) * sgn(-dy);
+}
+
+// Shared by triangles and quads: edge i runs from vertex i to vertex i+1
+static inline void prepareEdges(float *ex, float *ey, float *ee, const float *vx, const float *vy, int n)
+{
+	for (int i = 0; i < n; i++) {
+		int j = (i + 1) % n;
+		ex[i] = vx[j] - vx[i];
+		ey[i] = vy[j] - vy[i];
+		ee[i] = ex[i]*ex[i] + ey[i]*ey[i];
+	}
+}
+
+// Squared distance to edge i and s times the side of the point. The callers unroll the edges and
+// start their mins from edge 0 as sdTriangle and sdQuad do: a loop from INFINITY cost two more fminf
+// calls per point, and made them slower than the plain functions.
+static inline void edgeTerms(const float *vx, const float *vy, const float *ex, const float *ey, const float *ee,
+	int i, float s, float px, float py, float *d, float *c)
+{
+	float wx = px - vx[i];
+	float wy = py - vy[i];
+	float m = clampf((wx*ex[i] + wy*ey[i]) / ee[i], 0.0f, 1.0f);
+	float qx = wx - ex[i]*m;
+	float qy = wy - ey[i]*m;
+	*d = qx*qx + qy*qy;
+	*c = s*(wx*ey[i] - wy*ex[i]);
+}
+
+void sdTrianglePrepare(SDTrianglePrep *s, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y)
+{
+	s->px[0] = p0x; s->px[1] = p1x; s->px[2] = p2x;
+	s->py[0] = p0y; s->py[1] = p1y; s->py[2] = p2y;
+	prepareEdges(s->ex, s->ey, s->ee, s->px, s->py, 3);
+	s->s = sgn(s->ex[0]*s->ey[2] - s->ey[0]*s->ex[2]);
+}
+
+float sdTriangleEval(const SDTrianglePrep *s, float px, float py)
+{
+	float d0, c0, d1, c1, d2, c2;
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 0, s->s, px, py, &d0, &c0);
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 1, s->s, px, py, &d1, &c1);
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 2, s->s, px, py, &d2, &c2);
+	float dx = fminf(fminf(d0, d1), d2);
+	float dy = fminf(fminf(c0, c1), c2);
+	return -sqrtf(dx)*sgn(dy);
+}
+
+void sdTriangleIsoscelesPrepare(SDTriangleIsoscelesPrep *s, float qx, float qy)
+{
+	s->qx = qx;
+	s->qy = qy;
+	s->invqq = 1.0f / (qx*qx + qy*qy);
+	s->invqx = 1.0f / qx;
+	s->sq = sgn(qy);
+}
+
+float sdTriangleIsoscelesEval(const SDTriangleIsoscelesPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float m1 = clampf((px*s->qx + py*s->qy) * s->invqq, 0.0f, 1.0f);
+	float ax = px - s->qx*m1;
+	float ay = py - s->qy*m1;
+	float n = clampf(px * s->invqx, 0.0f, 1.0f);
+	float bx = px - s->qx*n;
+	float by = py - s->qy;
+	float c = fmaxf(s->sq*(px*s->qy - py*s->qx), s->sq*(py - s->qy));
+	return sqrtf(fminf(ax*ax + ay*ay, bx*bx + by*by)) * sgn(c);
+}
+
+void sdEquilateralTrianglePrepare(SDEquilateralTrianglePrep *s, float r)
+{
+	s->r = r;
+	s->rk = r / 1.73205f;
+}
+
+float sdEquilateralTriangleEval(const SDEquilateralTrianglePrep *s, float px, float py)
+{
+	const float k = 1.73205f;
+	px = fabsf(px) - s->r;
+	py = py + s->rk;
+	if (px + k*py > 0.0f) {
+		float ppx = (px - k*py) * 0.5f;
+		float ppy = (-k*px - py) * 0.5f;
+		px = ppx;
+		py = ppy;
+	}
+	px -= clampf(px, -2.0f*s->r, 0.0f);
+	return -sqrtf(px*px + py*py) * sgn(py);
+}
+
+void sdQuadPrepare(SDQuadPrep *s, float p0x, float p0y, float p1x, float p1y, float p2x, float p2y, float p3x, float p3y)
+{
+	s->px[0] = p0x; s->px[1] = p1x; s->px[2] = p2x; s->px[3] = p3x;
+	s->py[0] = p0y; s->py[1] = p1y; s->py[2] = p2y; s->py[3] = p3y;
+	prepareEdges(s->ex, s->ey, s->ee, s->px, s->py, 4);
+}
+
+float sdQuadEval(const SDQuadPrep *s, float px, float py)
+{
+	float d0, c0, d1, c1, d2, c2, d3, c3;
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 0, 1.0f, px, py, &d0, &c0);
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 1, 1.0f, px, py, &d1, &c1);
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 2, 1.0f, px, py, &d2, &c2);
+	edgeTerms(s->px, s->py, s->ex, s->ey, s->ee, 3, 1.0f, px, py, &d3, &c3);
+	float dx = fminf(fminf(fminf(d0, d1), d2), d3);
+	float dy = fminf(fminf(fminf(c0, c1), c2), c3);
+	return -sqrtf(dx)*sgn(dy);
+}
+
+void sdStar5Prepare(SDStar5Prep *s, float r, float rf)
+{
+	s->r = r;
+	s->bax = 0.587785252292f*rf;
+	s->bay = 0.809016994375f*rf - 1.0f;
+	s->inv = 1.0f / (s->bax*s->bax + s->bay*s->bay);
+}
+
+float sdStar5Eval(const SDStar5Prep *s, float px, float py)
+{
+	const float kx = 0.809016994375f;
+	const float ky = -0.587785252292f;
+	px = fabsf(px);
+	float f1 = fmaxf(kx*px + ky*py, 0.0f)*2.0f;
+	px -= kx*f1;
+	py -= ky*f1;
+	float f2 = fmaxf(-kx*px + ky*py, 0.0f)*2.0f;
+	px = fabsf(px + kx*f2);
+	py -= ky*f2 + s->r;
+	float h = clampf((px*s->bax + py*s->bay) * s->inv, 0.0f, s->r);
+	float dx = px - s->bax*h;
+	float dy = py - s->bay*h;
+	return sqrtf(dx*dx + dy*dy) * sgn(py*s->bax - px*s->bay);
+}
+
+void sdPentagonPrepare(SDPentagonPrep *s, float r)
+{
+	s->r = r;
+	s->rkz = r*0.726542528f;
+}
+
+float sdPentagonEval(const SDPentagonPrep *s, float px, float py)
+{
+	const float kx = 0.809016994f;
+	const float ky = 0.587785252f;
+	px = fabsf(px);
+	float d1 = 2.0f*fminf(-kx*px + ky*py, 0.0f);
+	px += d1*kx;
+	py -= d1*ky;
+	float d2 = 2.0f*fminf(kx*px + ky*py, 0.0f);
+	px -= d2*kx;
+	py -= d2*ky;
+	px -= clampf(px, -s->rkz, s->rkz);
+	py -= s->r;
+	return sqrtf(px*px + py*py) * sgn(py);
+}
+
+void sdHexagonPrepare(SDHexagonPrep *s, float r)
+{
+	s->r = r;
+	s->rkz = r*0.577350269f;
+}
+
+float sdHexagonEval(const SDHexagonPrep *s, float px, float py)
+{
+	const float kx = -0.866025404f;
+	const float ky = 0.5f;
+	px = fabsf(px);
+	py = fabsf(py);
+	float d = 2.0f*fminf(kx*px + ky*py, 0.0f);
+	px -= kx*d;
+	py -= ky*d;
+	px -= clampf(px, -s->rkz, s->rkz);
+	py -= s->r;
+	return sqrtf(px*px + py*py) * sgn(py);
+}
+
+void sdOctagonPrepare(SDOctagonPrep *s, float r)
+{
+	s->r = r;
+	s->rkz = r*0.4142135623f;
+}
+
+float sdOctagonEval(const SDOctagonPrep *s, float px, float py)
+{
+	const float kx = -0.9238795325f;
+	const float ky = 0.3826834323f;
+	px = fabsf(px);
+	py = fabsf(py);
+	float d1 = 2.0f*fminf(kx*px + ky*py, 0.0f);
+	px -= d1*kx;
+	py -= d1*ky;
+	float d2 = 2.0f*fminf(-kx*px + ky*py, 0.0f);
+	px += d2*kx;
+	py -= d2*ky;
+	px -= clampf(px, -s->rkz, s->rkz);
+	py -= s->r;
+	return sqrtf(px*px + py*py) * sgn(py);
+}
+
+void sdHexagramPrepare(SDHexagramPrep *s, float r)
+{
+	s->r = r;
+	s->rkz = r*0.5773502692f;
+	s->rkw = r*1.7320508076f;
+}
+
+float sdHexagramEval(const SDHexagramPrep *s, float px, float py)
+{
+	const float kx = -0.5f;
+	const float ky = 0.8660254038f;
+	px = fabsf(px);
+	py = fabsf(py);
+	float d1 = 2.0f*fminf(kx*px + ky*py, 0.0f);
+	px -= d1*kx;
+	py -= d1*ky;
+	float d2 = 2.0f*fminf(ky*px + kx*py, 0.0f);
+	px -= d2*ky;
+	py -= d2*kx;
+	px -= clampf(px, s->rkz, s->rkw);
+	py -= s->r;
+	return sqrtf(px*px + py*py) * sgn(py);
+}
+
+void sdPiePrepare(SDPiePrep *s, float cx, float cy, float r)
+{
+	s->cx = cx;
+	s->cy = cy;
+	s->r = r;
+}
+
+float sdPieEval(const SDPiePrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float l = sqrtf(px*px + py*py) - s->r;
+	float cd = clampf(px*s->cx + py*s->cy, 0.0f, s->r);
+	float dx = px - s->cx*cd;
+	float dy = py - s->cy*cd;
+	float m = sqrtf(dx*dx + dy*dy);
+	return fmaxf(l, (s->cy*px - s->cx*py > 0.0f) ? m : -m);
+}
+
+void sdCutDiskPrepare(SDCutDiskPrep *s, float r, float h)
+{
+	s->r = r;
+	s->h = h;
+	s->w = sqrtf(r*r - h*h);
+	s->hr = h - r;
+	s->hpr = h + r;
+	s->ww = s->w*s->w;
+}
+
+float sdCutDiskEval(const SDCutDiskPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float c = fmaxf(s->hr*px*px + s->ww*(s->hpr - 2.0f*py), s->h*px - s->w*py);
+	if (c < 0.0f)
+		return sqrtf(px*px + py*py) - s->r;
+	if (px < s->w)
+		return s->h - py;
+	float dx = px - s->w;
+	float dy = py - s->h;
+	return sqrtf(dx*dx + dy*dy);
+}
+
+void sdArcPrepare(SDArcPrep *s, float scx, float scy, float ra, float rb)
+{
+	s->scx = scx;
+	s->scy = scy;
+	s->ra = ra;
+	s->rb = rb;
+	s->ex = scx*ra;
+	s->ey = scy*ra;
+}
+
+float sdArcEval(const SDArcPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	if (s->scy*px > s->scx*py) {
+		float dx = px - s->ex;
+		float dy = py - s->ey;
+		return sqrtf(dx*dx + dy*dy) - s->rb;
+	}
+	return fabsf(sqrtf(px*px + py*py) - s->ra) - s->rb;
+}
+
+void sdRingPrepare(SDRingPrep *s, float nx, float ny, float r, float th)
+{
+	s->nx = nx;
+	s->ny = ny;
+	s->r = r;
+	s->hth = th*0.5f;
+}
+
+float sdRingEval(const SDRingPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float rx = s->nx*px - s->ny*py;
+	py = s->ny*px + s->nx*py;
+	px = rx;
+	float d1 = fabsf(sqrtf(px*px + py*py) - s->r) - s->hth;
+	py = fmaxf(0.0f, fabsf(s->r - py) - s->hth);
+	float d2 = sqrtf(px*px + py*py) * sgn(px);
+	return fmaxf(d1, d2);
+}
+
+void sdHorseshoePrepare(SDHorseshoePrep *s, float cx, float cy, float r, float le, float th)
+{
+	s->cx = cx;
+	s->cy = cy;
+	s->r = r;
+	s->le = le;
+	s->th = th;
+}
+
+float sdHorseshoeEval(const SDHorseshoePrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = -py;
+	float l = sqrtf(px*px + py*py);
+	float tx = -s->cx*px + s->cy*py;
+	py = s->cy*px + s->cx*py;
+	px = tx;
+	px = (py > 0.0f || px > 0.0f) ? px : l * ((-s->cx > 0.0f) ? 1.0f : -1.0f);
+	py = (px > 0.0f) ? py : l;
+	return boxTail(px - s->le, fabsf(py - s->r) - s->th);
+}
+
+void sdVesicaPrepare(SDVesicaPrep *s, float r, float d)
+{
+	s->r = r;
+	s->d = d;
+	s->b = sqrtf(r*r - d*d);
+	s->sd = sgn(d);
+}
+
+float sdVesicaEval(const SDVesicaPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	if ((py - s->b)*s->d > px*s->b) {
+		float dy = py - s->b;
+		return sqrtf(px*px + dy*dy) * s->sd;
+	}
+	float dx = px + s->d;
+	return sqrtf(dx*dx + py*py) - s->r;
+}
+
+void sdOrientedVesicaPrepare(SDOrientedVesicaPrep *s, float ax, float ay, float bx, float by, float w)
+{
+	float dx = bx - ax;
+	float dy = by - ay;
+	s->r = 0.5f*sqrtf(dx*dx + dy*dy);
+	s->d = 0.5f*(s->r*s->r - w*w) / w;
+	s->dw = s->d + w;
+	s->cx = 0.5f*(bx + ax);
+	s->cy = 0.5f*(by + ay);
+	s->vx = 0.5f*dx / s->r;   // the 0.5 of mq folded in
+	s->vy = 0.5f*dy / s->r;
+}
+
+float sdOrientedVesicaEval(const SDOrientedVesicaPrep *s, float px, float py)
+{
+	float qx = px - s->cx;
+	float qy = py - s->cy;
+	float mqx = fabsf(s->vy*qx + s->vx*qy);
+	float mqy = fabsf(-s->vx*qx + s->vy*qy);
+	if (s->r*mqx < s->d*(mqy - s->r)) {
+		float dy = mqy - s->r;
+		return sqrtf(mqx*mqx + dy*dy);
+	}
+	float dx = mqx + s->d;
+	return sqrtf(dx*dx + mqy*mqy) - s->dw;
+}
+
+void sdMoonPrepare(SDMoonPrep *s, float d, float ra, float rb)
+{
+	s->d = d;
+	s->ra = ra;
+	s->rb = rb;
+	s->a = (ra*ra - rb*rb + d*d) / (2.0f*d);
+	s->b = sqrtf(fmaxf(ra*ra - s->a*s->a, 0.0f));
+	s->dd = d*d;
+}
+
+float sdMoonEval(const SDMoonPrep *s, float px, float py)
+{
+	py = fabsf(py);
+	if (s->d*(px*s->b - py*s->a) > s->dd*fmaxf(s->b - py, 0.0f)) {
+		float dx = px - s->a;
+		float dy = py - s->b;
+		return sqrtf(dx*dx + dy*dy);
+	}
+	float pdx = px - s->d;
+	float l1 = sqrtf(px*px + py*py);
+	float l2 = sqrtf(pdx*pdx + py*py);
+	return fmaxf(l1 - s->ra, -(l2 - s->rb));
+}
+
+void sdCrossPrepare(SDCrossPrep *s, float bx, float by, float r)
+{
+	s->bx = bx;
+	s->by = by;
+	s->r = r;
+}
+
+float sdCrossEval(const SDCrossPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	if (py > px) {
+		float t = px;
+		px = py;
+		py = t;
+	}
+	float qx = px - s->bx;
+	float qy = py - s->by;
+	float k = fmaxf(qx, qy);
+	float wx = qx, wy = qy;
+	if (k <= 0.0f) {
+		wx = s->by - px;
+		wy = -k;
+	}
+	wx = fmaxf(wx, 0.0f);
+	wy = fmaxf(wy, 0.0f);
+	float d = sqrtf(wx*wx + wy*wy);
+	return (k > 0.0f ? d : -d) + s->r;
+}
+
+void sdRoundedXPrepare(SDRoundedXPrep *s, float w, float r)
+{
+	s->w = w;
+	s->r = r;
+}
+
+float sdRoundedXEval(const SDRoundedXPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	float m = fminf(px + py, s->w)*0.5f;
+	return sqrtf((px-m)*(px-m) + (py-m)*(py-m)) - s->r;
+}
+
+void sdParabolaPrepare(SDParabolaPrep *s, float k)
+{
+	float ik = 1.0f / k;
+	s->k = k;
+	s->ik3 = ik / 3.0f;       // p = ik3*py - p0
+	s->p0 = s->ik3*0.5f*ik;
+	s->q0 = 0.25f*ik*ik;      // q = q0*px
+}
+
+float sdParabolaEval(const SDParabolaPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float p = s->ik3*py - s->p0;
+	float q = s->q0*px;
+	float h = q*q - p*p*p;
+	float r = sqrtf(fabsf(h));
+	float x;
+	if (h > 0.0f)
+		x = cbrtf(q + r) + cbrtf(fabsf(q - r))*sgn(p);
+	else
+		x = 2.0f*cosf(atan2f(r, q) / 3.0f)*sqrtf(p);
+	float dx = px - x;
+	float dy = py - s->k*x*x;
+	float d = sqrtf(dx*dx + dy*dy);
+	return ((py - s->k*px*px)*s->k > 0.0f) ? -d : d;
+}
+
+void sdTunnelPrepare(SDTunnelPrep *s, float whx, float why)
+{
+	s->whx = whx;
+	s->why = why;
+}
+
+float sdTunnelEval(const SDTunnelPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = -py;
+	float qx = px - s->whx;
+	float qy = py - s->why;
+	float m0 = fmaxf(qx, 0.0f);
+	float d1 = m0*m0 + qy*qy;
+	if (py <= 0.0f) qx = sqrtf(px*px + py*py) - s->whx;
+	float m1 = fmaxf(qy, 0.0f);
+	float d = sqrtf(fminf(d1, qx*qx + m1*m1));
+	return (fmaxf(qx, qy) < 0.0f) ? -d : d;
+}
+
+void sdEllipsePrepare(SDEllipsePrep *s, float ex, float ey)
+{
+	s->ex = ex;
+	s->ey = ey;
+	s->eiX = 1.0f / ex;
+	s->eiY = 1.0f / ey;
+	s->veX = s->eiX*(ex*ex - ey*ey);
+	s->veY = s->eiY*(ey*ey - ex*ex);
+}
+
+float sdEllipseEval(const SDEllipsePrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	float tX = 0.70710678118654752f;
+	float tY = 0.70710678118654752f;
+	for (int i = 0; i < 3; i++) {
+		float vX = s->veX*tX*tX*tX;
+		float vY = s->veY*tY*tY*tY;
+		float tmx = px - vX;
+		float tmy = py - vY;
+		float ux = tX*s->ex - vX;
+		float uy = tY*s->ey - vY;
+		float u = sqrtf((ux*ux + uy*uy) / (tmx*tmx + tmy*tmy));
+		float cx = clampf(s->eiX*(vX + tmx*u), 0.0f, 1.0f);
+		float cy = clampf(s->eiY*(vY + tmy*u), 0.0f, 1.0f);
+		float n = 1.0f / sqrtf(cx*cx + cy*cy);
+		tX = cx*n;
+		tY = cy*n;
+	}
+	float nx = tX*s->ex;
+	float ny = tY*s->ey;
+	float d = sqrtf((px-nx)*(px-nx) + (py-ny)*(py-ny));
+	return (px*px + py*py < nx*nx + ny*ny) ? -d : d;
+}
+
+void sdEllipseLinfPrepare(SDEllipseLinfPrep *s, float ex, float ey)
+{
+	s->ex = ex;
+	s->ey = ey;
+	s->m = ex*ex + ey*ey;
+	s->exm = ex / s->m;
+}
+
+float sdEllipseLinfEval(const SDEllipseLinfPrep *s, float px, float py)
+{
+	px = fabsf(px);
+	py = fabsf(py);
+	float ay = px - s->ex;
+	float ax = py - s->ey;
+	px = fmaxf(px, ax);
+	py = fmaxf(py, ay);
+	float d = py - px;
+	return px - (s->ey*sqrtf(s->m - d*d) - s->ex*d)*s->exm;
+}
+
+void sdRegularPolygonPrepare(SDRegularPolygonPrep *s, float r, int n)
+{
+	s->an = 3.141593f / n;
+	s->an2 = 2.0f*s->an;
+	s->ian2 = 1.0f / s->an2;
+	s->cx = cosf(s->an)*r;
+	s->cy = sinf(s->an)*r;
+}
+
+float sdRegularPolygonEval(const SDRegularPolygonPrep *s, float px, float py)
+{
+	float a = atan2f(py, px);
+	float bn = a - s->an2*floorf(a*s->ian2) - s->an;   // fmod into the sector, then centre it
+	float mag = sqrtf(px*px + py*py);
+	px = cosf(bn)*mag - s->cx;
+	py = fabsf(sinf(bn))*mag - s->cy;
+	py += clampf(-py, 0.0f, s->cy);
+	return sqrtf(px*px + py*py) * sgn(px);
+}
+
+void sdPolygonPrepare(SDPolygonPrep *s, const float vx[], const float vy[], int num, float *edges)
+{
+	s->vx = vx;
+	s->vy = vy;
+	s->n = num;
+	s->edges = edges;
+	// edge i runs from vertex i to the previous vertex, as in sdPolygon
+	for (int i = 0, j = num - 1; i < num; j = i++) {
+		float ex = vx[j] - vx[i];
+		float ey = vy[j] - vy[i];
+		edges[3*i] = ex;
+		edges[3*i + 1] = ey;
+		edges[3*i + 2] = 1.0f / (ex*ex + ey*ey);
+	}
+}
+
+float sdPolygonEval(const SDPolygonPrep *s, float px, float py)
+{
+	const float *vx = s->vx, *vy = s->vy, *e = s->edges;
+	float d = (px - vx[0])*(px - vx[0]) + (py - vy[0])*(py - vy[0]);
+	float sg = 1.0f;
+	for (int i = 0, j = s->n - 1; i < s->n; j = i++, e += 3) {
+		float wx = px - vx[i];
+		float wy = py - vy[i];
+		float pr = clampf((wx*e[0] + wy*e[1]) * e[2], 0.0f, 1.0f);
+		float bx = wx - e[0]*pr;
+		float by = wy - e[1]*pr;
+		d = fminf(d, bx*bx + by*by);
+		int c1 = (py >= vy[i]);
+		int c2 = (py < vy[j]);
+		int c3 = (e[0]*wy > e[1]*wx);
+		if ((c1 && c2 && c3) || (!c1 && !c2 && !c3))
+			sg = -sg;
+	}
+	return sg*sqrtf(d);
+}
+
+void sdRoundSquarePrepare(SDRoundSquarePrep *s, float size, float r)
+{
+	s->r = r;
+	s->sr = size - r;
+}
+
+float sdRoundSquareEval(const SDRoundSquarePrep *s, float px, float py)
+{
+	return boxTail(fabsf(px) - s->sr, fabsf(py) - s->sr) - s->r;
+}
+
+void sdEggPrepare(SDEggPrep *s, float ra, float rb)
+{
+	s->r = ra - rb;
+	s->rb = rb;
+	s->kr = 1.73205f*s->r;
+	s->ra = ra;
+	s->rr = 2.0f*s->r + rb;
+}
+
+float sdEggEval(const SDEggPrep *s, float px, float py)
+{
+	const float k = 1.73205f;
+	px = fabsf(px);
+	if (py < 0.0f)
+		return sqrtf(px*px + py*py) - s->ra;
+	if (k*(px + s->r) < py) {
+		float dy = py - s->kr;
+		return sqrtf(px*px + dy*dy) - s->rb;
+	}
+	float dx = px + s->r;
+	return sqrtf(dx*dx + py*py) - s->rr;
+}
+
+void sdUnevenCapsulePrepare(SDUnevenCapsulePrep *s, float r1, float r2, float h)
+{
+	s->r1 = r1;
+	s->r2 = r2;
+	s->h = h;
+	s->b = (r1 - r2) / h;
+	s->a = sqrtf(1.0f - s->b*s->b);
+	s->ah = s->a*h;
+}
+
+float sdUnevenCapsuleEval(const SDUnevenCapsulePrep *s, float px, float py)
+{
+	px = fabsf(px);
+	float k = -s->b*px + s->a*py;
+	if (k < 0.0f)
+		return sqrtf(px*px + py*py) - s->r1;
+	if (k > s->ah) {
+		float dy = py - s->h;
+		return sqrtf(px*px + dy*dy) - s->r2;
+	}
+	return s->a*px + s->b*py - s->r1;
+}
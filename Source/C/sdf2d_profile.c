@@ -0,0 +1,348 @@
+// Profiling counters. See sdf2d_profile.h.
+
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+
+#include "sdf2d_profile.h"
+
+#ifdef SDF2D_PROFILE
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#define SD_PROFILE_POSIX
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define kNotSampled (~0ULL)
+
+static const char *const sdProfileOpNames[] = {
+	"shape", "union", "intersect", "subtract", "smooth union", "onion", "round"
+};
+
+// What each counter has seen in the frame so far; folded into SDProfileCounter by sdProfileFrame
+typedef struct {
+	unsigned tick;               // calls, for picking the sampled ones
+	long long calls;
+	long long sampledPoints;
+	long long sampledTicks;
+} FrameCounter;
+
+typedef struct {
+	const SDScene *scene;
+	int base;
+	int count;
+} ProfileScene;
+
+static struct {
+	SDProfileClock clock;
+	double rate;                 // ticks per second, 0 if unknown
+	unsigned mask;               // a call is timed when (tick & mask) == 0
+	int count;
+	int started;
+	unsigned long long frameStart;
+	SDProfileCounter counters[SD_PROFILE_MAX_COUNTERS];
+	FrameCounter frame[SD_PROFILE_MAX_COUNTERS];
+	long long sampledPoints[SD_PROFILE_MAX_COUNTERS];   // over all frames, for frames with no sample
+	long long sampledTicks[SD_PROFILE_MAX_COUNTERS];
+	ProfileScene scenes[SD_PROFILE_MAX_SCENES];
+	int numScenes;
+
+	// the last frames, oldest at traceNext once the ring is full
+	unsigned long long traceStart[SD_PROFILE_TRACE_FRAMES];
+	unsigned long long traceEnd[SD_PROFILE_TRACE_FRAMES];
+	unsigned traceTicks[SD_PROFILE_TRACE_FRAMES][SD_PROFILE_MAX_COUNTERS];
+	int traceNext;
+	int traceCount;
+} prof;
+
+#ifdef SD_PROFILE_POSIX
+static unsigned long long sdProfileClockNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+#endif
+
+// Shape type names on first use, so the state needs no initializer
+static void sdProfileInit(void)
+{
+	if (prof.count) return;
+	for (int i = 0; i < kSDShapeCount; i++) {
+		snprintf(prof.counters[i].name, sizeof(prof.counters[i].name), "%s", sdShapeTypeName(i));
+	}
+	prof.count = kSDShapeCount;
+	prof.mask = 15;
+	if (!prof.clock) sdProfileSetClock(NULL, 0.0);
+}
+
+void sdProfileSetClock(SDProfileClock clock, double ticksPerSecond)
+{
+	prof.clock = clock;
+	prof.rate = ticksPerSecond;
+#ifdef SD_PROFILE_POSIX
+	if (!clock) {
+		prof.clock = sdProfileClockNs;
+		prof.rate = 1e9;
+	}
+#endif
+	prof.started = 0;
+}
+
+void sdProfileSetSampling(int every)
+{
+	sdProfileInit();
+	unsigned m = 1;
+	while ((int)m < every && m < (1u << 30)) m <<= 1;
+	prof.mask = m - 1;
+}
+
+unsigned long long sdProfileCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+int sdProfileScene(const SDScene *scene, const char *name)
+{
+	sdProfileInit();
+	for (int i = 0; i < prof.numScenes; i++)
+		if (prof.scenes[i].scene == scene) return 0;
+	if (prof.numScenes == SD_PROFILE_MAX_SCENES) return -1;
+	if (prof.count + scene->numNodes > SD_PROFILE_MAX_COUNTERS) return -1;
+	ProfileScene *s = &prof.scenes[prof.numScenes++];
+	s->scene = scene;
+	s->base = prof.count;
+	s->count = scene->numNodes;
+	for (int i = 0; i < scene->numNodes; i++) {
+		const SDNode *nd = &scene->nodes[i];
+		const char *type = nd->op == kSDNodeShape ? sdShapeTypeName(nd->shape.type) : sdProfileOpNames[nd->op];
+		snprintf(prof.counters[s->base + i].name, sizeof(prof.counters[0].name), "%s #%d %s", name, i, type);
+	}
+	prof.count += scene->numNodes;
+	return 0;
+}
+
+int sdProfileSceneBase(const SDScene *scene, int *count)
+{
+	for (int i = 0; i < prof.numScenes; i++) {
+		if (prof.scenes[i].scene == scene) {
+			*count = prof.scenes[i].count;
+			return prof.scenes[i].base;
+		}
+	}
+	*count = 0;
+	return -1;
+}
+
+unsigned long long sdProfileBegin(int counter)
+{
+	if (!prof.count) sdProfileInit();
+	if (counter < 0 || !prof.clock) return kNotSampled;
+	if (prof.frame[counter].tick++ & prof.mask) return kNotSampled;
+	return prof.clock();
+}
+
+void sdProfileEnd(int counter, long points, unsigned long long start)
+{
+	if (counter < 0) return;
+	FrameCounter *f = &prof.frame[counter];
+	f->calls += points;
+	if (start != kNotSampled) {
+		f->sampledTicks += (long long)(prof.clock() - start);
+		f->sampledPoints += points;
+	}
+}
+
+void sdProfileReset(void)
+{
+	sdProfileInit();
+	for (int i = 0; i < prof.count; i++) {
+		SDProfileCounter *c = &prof.counters[i];
+		c->calls = c->ticks = c->frames = c->maxFrame = 0;
+		memset(c->hist, 0, sizeof(c->hist));
+		prof.sampledPoints[i] = prof.sampledTicks[i] = 0;
+	}
+	memset(prof.frame, 0, sizeof(prof.frame));
+	prof.traceNext = prof.traceCount = 0;
+	prof.started = 0;
+}
+
+// Histogram bucket of a frame cost: by us, or by thousands of ticks when the rate is unknown
+static int sdProfileBucket(long long ticks)
+{
+	double us = prof.rate > 0.0 ? ticks * 1e6 / prof.rate : ticks * 1e-3;
+	int b = 0;
+	while (b < SD_PROFILE_BUCKETS - 1 && us >= (double)(1LL << b)) b++;
+	return b;
+}
+
+void sdProfileFrame(void)
+{
+	sdProfileInit();
+	unsigned long long now = prof.clock ? prof.clock() : 0;
+	int t = prof.traceNext;
+	long long total = 0;
+	for (int i = 0; i < prof.count; i++) {
+		FrameCounter *f = &prof.frame[i];
+		long long ticks = 0;
+		if (f->calls) {
+			// the frame's own samples, or those of earlier frames if none fell in this one
+			prof.sampledPoints[i] += f->sampledPoints;
+			prof.sampledTicks[i] += f->sampledTicks;
+			if (f->sampledPoints)
+				ticks = (long long)((double)f->sampledTicks * f->calls / f->sampledPoints);
+			else if (prof.sampledPoints[i])
+				ticks = (long long)((double)prof.sampledTicks[i] * f->calls / prof.sampledPoints[i]);
+			SDProfileCounter *c = &prof.counters[i];
+			c->calls += f->calls;
+			c->ticks += ticks;
+			c->frames++;
+			if (ticks > c->maxFrame) c->maxFrame = ticks;
+			c->hist[sdProfileBucket(ticks)]++;
+			if (i < kSDShapeCount) total += ticks;
+		}
+		prof.traceTicks[t][i] = ticks > 0xffffffffLL ? 0xffffffffu : (unsigned)ticks;
+		f->calls = f->sampledPoints = f->sampledTicks = 0;
+	}
+	// without a previous frame, the frame starts where its shape costs would have
+	prof.traceStart[t] = prof.started ? prof.frameStart : now - (unsigned long long)total;
+	prof.traceEnd[t] = now;
+	prof.traceNext = (t + 1) % SD_PROFILE_TRACE_FRAMES;
+	if (prof.traceCount < SD_PROFILE_TRACE_FRAMES) prof.traceCount++;
+	prof.frameStart = now;
+	prof.started = 1;
+}
+
+int sdProfileCounterCount(void)
+{
+	sdProfileInit();
+	return prof.count;
+}
+
+const SDProfileCounter *sdProfileCounterGet(int i)
+{
+	sdProfileInit();
+	return (i >= 0 && i < prof.count) ? &prof.counters[i] : NULL;
+}
+
+static void sdProfilePrint(SDProfileWrite write, void *ctx, const char *fmt, ...)
+{
+	char line[256];
+	va_list ap;
+	va_start(ap, fmt);
+	int len = vsnprintf(line, sizeof(line), fmt, ap);
+	va_end(ap);
+	if (len > (int)sizeof(line) - 1) len = sizeof(line) - 1;
+	if (len > 0) write(ctx, line, (size_t)len);
+}
+
+static int sdProfileCompare(const void *a, const void *b)
+{
+	long long ta = prof.counters[*(const int *)a].ticks;
+	long long tb = prof.counters[*(const int *)b].ticks;
+	return (ta < tb) - (ta > tb);
+}
+
+// Bound of the bucket holding fraction q of the frames, eg "<8"
+static void sdProfilePercentile(const SDProfileCounter *c, double q, char *text, size_t size)
+{
+	long long need = (long long)(q * c->frames + 0.5), seen = 0;
+	if (need < 1) need = 1;
+	for (int b = 0; b < SD_PROFILE_BUCKETS - 1; b++) {
+		seen += c->hist[b];
+		if (seen >= need) {
+			snprintf(text, size, "<%ld", 1L << b);
+			return;
+		}
+	}
+	snprintf(text, size, ">=%ld", 1L << (SD_PROFILE_BUCKETS - 2));
+}
+
+void sdProfileReport(SDProfileWrite write, void *ctx)
+{
+	sdProfileInit();
+	int order[SD_PROFILE_MAX_COUNTERS], n = 0;
+	long long total = 0;
+	for (int i = 0; i < prof.count; i++) {
+		if (!prof.counters[i].calls) continue;
+		order[n++] = i;
+		if (i < kSDShapeCount) total += prof.counters[i].ticks;
+	}
+	qsort(order, n, sizeof(int), sdProfileCompare);
+
+	// ns when the clock rate is known, raw ticks otherwise
+	double scale = prof.rate > 0.0 ? 1e9 / prof.rate : 1.0;
+	const char *unit = prof.rate > 0.0 ? "ns" : "ticks";
+	const char *frameUnit = prof.rate > 0.0 ? "us" : "kticks";
+	sdProfilePrint(write, ctx, "%-36s %12s %10s/call %12s %6s %8s %8s %10s  per frame (%s)\n",
+		"counter", "calls", unit, "total ms", "%", "p50", "p95", "max", frameUnit);
+	for (int k = 0; k < n; k++) {
+		const SDProfileCounter *c = &prof.counters[order[k]];
+		double share = total > 0 ? 100.0 * c->ticks / total : 0.0;
+		char p50[16], p95[16];
+		sdProfilePercentile(c, 0.5, p50, sizeof(p50));
+		sdProfilePercentile(c, 0.95, p95, sizeof(p95));
+		sdProfilePrint(write, ctx, "%-36s %12lld %15.2f %12.3f %6.1f %8s %8s %10.1f\n",
+			c->name, c->calls, c->ticks * scale / c->calls, c->ticks * scale * 1e-6, share,
+			p50, p95, c->maxFrame * scale * 1e-3);
+	}
+	sdProfilePrint(write, ctx, "%lld frames; shares are of the shape type total, scene nodes are part of it\n",
+		n ? prof.counters[order[0]].frames : 0LL);
+}
+
+void sdProfileTrace(SDProfileWrite write, void *ctx)
+{
+	sdProfileInit();
+	// Chrome traces are in us; with an unknown clock rate the ticks are shown as us
+	double scale = prof.rate > 0.0 ? 1e6 / prof.rate : 1.0;
+	sdProfilePrint(write, ctx, "{\"traceEvents\":[\n");
+	sdProfilePrint(write, ctx, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"frames\"}},\n");
+	sdProfilePrint(write, ctx, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"shapes\"}},\n");
+	sdProfilePrint(write, ctx, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"scene nodes\"}}");
+	int first = (prof.traceNext - prof.traceCount + SD_PROFILE_TRACE_FRAMES) % SD_PROFILE_TRACE_FRAMES;
+	unsigned long long origin = prof.traceCount ? prof.traceStart[first] : 0;
+	for (int k = 0; k < prof.traceCount; k++) {
+		int t = (first + k) % SD_PROFILE_TRACE_FRAMES;
+		double start = (double)(prof.traceStart[t] - origin) * scale;
+		sdProfilePrint(write, ctx, ",\n{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+			start, (double)(prof.traceEnd[t] - prof.traceStart[t]) * scale);
+		// costs laid end to end from the frame start, as they are totals and not single calls
+		double at[2] = { start, start };
+		for (int i = 0; i < prof.count; i++) {
+			if (!prof.traceTicks[t][i]) continue;
+			int scene = i >= kSDShapeCount;
+			double dur = prof.traceTicks[t][i] * scale;
+			sdProfilePrint(write, ctx, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				prof.counters[i].name, 2 + scene, at[scene], dur);
+			at[scene] += dur;
+		}
+	}
+	sdProfilePrint(write, ctx, "\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+#else
+
+// Without SDF2D_PROFILE: nothing is counted and there is nothing to report
+
+void sdProfileSetClock(SDProfileClock clock, double ticksPerSecond) { (void)clock; (void)ticksPerSecond; }
+void sdProfileSetSampling(int every) { (void)every; }
+unsigned long long sdProfileCycles(void) { return 0; }
+int sdProfileScene(const SDScene *scene, const char *name) { (void)scene; (void)name; return 0; }
+void sdProfileReset(void) {}
+void sdProfileFrame(void) {}
+int sdProfileCounterCount(void) { return 0; }
+const SDProfileCounter *sdProfileCounterGet(int i) { (void)i; return NULL; }
+void sdProfileReport(SDProfileWrite write, void *ctx) { (void)write; (void)ctx; }
+void sdProfileTrace(SDProfileWrite write, void *ctx) { (void)write; (void)ctx; }
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef SDF2D_PROFILE_H
+#define SDF2D_PROFILE_H
+
+// Profiling counters, to find the shapes that eat the frame budget in a real level. Build the
+// library with SDF2D_PROFILE defined to turn them on; without it the hooks in sdf2d_shape.c and
+// sdf2d_scene.c compile to nothing and the functions below do nothing.
+//
+//	sdProfileScene(&scene, "level");       // also count the leaves of this scene, per node
+//	...
+//	// every frame
+//	sdSceneEvalBatch(&scene, px, py, out, n);
+//	sdProfileFrame();
+//	...
+//	sdProfileReport(write, ctx);           // table sorted by cost
+//	sdProfileTrace(write, ctx);            // Chrome trace JSON of the last frames
+//
+// There is one counter per shape type, for every sdShapeEval, sdShapeEvalGrad and sdShapeEvalBatch,
+// and one per leaf node of each registered scene. Calls are counted exactly, in points for batches.
+// Time is sampled: one call in every sdProfileSetSampling is timed and the cost of the rest is
+// estimated from it, so a clock read does not cost more than the sdCircle it measures.
+//
+// The clock is clock_gettime (ns) on POSIX, sdProfileCycles (rdtsc) on request, or any function
+// through sdProfileSetClock. On the Playdate, pass one around pd->system->getElapsedTime:
+//
+//	static unsigned long long elapsedUs(void) { return (unsigned long long)(pd->system->getElapsedTime() * 1e6f); }
+//	sdProfileSetClock(elapsedUs, 1e6);
+//
+// sdProfileFrame folds each counter's cost for the frame into a histogram and keeps the last
+// SD_PROFILE_TRACE_FRAMES frames for the trace. The counters are global and not locked: with
+// SDF2D_THREADS the counts of concurrent workers are approximate.
+
+#include <stddef.h>
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+
+#define SD_PROFILE_MAX_COUNTERS 512   // shape types first, then the nodes of registered scenes
+#define SD_PROFILE_MAX_SCENES 8
+#define SD_PROFILE_BUCKETS 16         // cost per frame: bucket 0 < 1 us, bucket b < 2^b us, the last the rest
+#define SD_PROFILE_TRACE_FRAMES 32
+
+typedef unsigned long long (*SDProfileClock)(void);
+
+// Receives the report and the trace a piece at a time, eg fwrite to a file or pd->file->write
+typedef void (*SDProfileWrite)(void *ctx, const char *text, size_t len);
+
+typedef struct {
+	char name[40];
+	long long calls;          // points evaluated
+	long long ticks;          // estimated cost, in clock ticks
+	long long frames;         // frames it ran in
+	long long maxFrame;       // ticks of its most expensive frame
+	long hist[SD_PROFILE_BUCKETS];
+} SDProfileCounter;
+
+void sdProfileSetClock(SDProfileClock clock, double ticksPerSecond);   // NULL: the default clock
+void sdProfileSetSampling(int every);   // time one call in every (a power of 2, default 16; 1 times all)
+unsigned long long sdProfileCycles(void);   // rdtsc on x86, 0 elsewhere; pass ticksPerSecond 0
+
+// Count the leaves of a scene per node, as "name #node type". Nodes added later are not counted.
+// Returns 0, or -1 when SD_PROFILE_MAX_SCENES or SD_PROFILE_MAX_COUNTERS are used up.
+int sdProfileScene(const SDScene *scene, const char *name);
+
+void sdProfileReset(void);     // zero the counters; registered scenes stay
+void sdProfileFrame(void);     // end of a frame
+
+// Counters in use, and their totals over the frames ended so far (NULL if i is out of range)
+int sdProfileCounterCount(void);
+const SDProfileCounter *sdProfileCounterGet(int i);
+
+// The counters that ran, most expensive first: calls, cost per call, total, share, and the median,
+// 95th percentile and worst cost per frame. In ns, or in ticks when the clock rate is 0.
+void sdProfileReport(SDProfileWrite write, void *ctx);
+
+// The last frames in the Chrome trace event format (chrome://tracing, Perfetto): a span per frame
+// and, under it, one per counter with its cost in that frame.
+void sdProfileTrace(SDProfileWrite write, void *ctx);
+
+// Hooks for the evaluators: SD_PROFILE_BEGIN starts timing the call if it is sampled, and
+// SD_PROFILE_END counts points against counter. Negative counters are not counted.
+// SD_PROFILE_SCENE is the counter of node 0 of a registered scene, -1 otherwise, and sets count to
+// the nodes it has counters for.
+#ifdef SDF2D_PROFILE
+unsigned long long sdProfileBegin(int counter);
+void sdProfileEnd(int counter, long points, unsigned long long start);
+int sdProfileSceneBase(const SDScene *scene, int *count);
+#define SD_PROFILE_BEGIN(var, counter) unsigned long long var = sdProfileBegin(counter)
+#define SD_PROFILE_END(var, counter, points) sdProfileEnd((counter), (points), var)
+#define SD_PROFILE_SCENE(scene, count) sdProfileSceneBase((scene), &(count))
+#else
+#define SD_PROFILE_BEGIN(var, counter)
+#define SD_PROFILE_END(var, counter, points)
+#define SD_PROFILE_SCENE(scene, count) ((count) = 0, -1)
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+#include "sdf2d_raster.h"
+
+#include <math.h>
+#include <string.h>
+
+#define RASTER_SPAN 256     // pixels evaluated per batch call, a multiple of 32
+
+typedef struct {
+	const SDShape *shape;
+	const SDScene *scene;
+	float ox, oy;
+} RasterSource;
+
+// white[i] = 1 where pixel i is white
+static void classify(const SDRasterStyle *style, const float *d, uint8_t *white, int n)
+{
+	float w = style->width;
+	switch (style->mode) {
+	case kSDRasterFill:
+		for (int i = 0; i < n; i++) white[i] = d[i] > 0.0f;
+		break;
+	case kSDRasterOutline:
+		for (int i = 0; i < n; i++) white[i] = fabsf(d[i]) > w;
+		break;
+	case kSDRasterContour: {
+		// fmodf(|d|, spacing) without the library call
+		float s = style->spacing, inv = 1.0f / s;
+		for (int i = 0; i < n; i++) {
+			float a = fabsf(d[i]);
+			float m = a - s * floorf(a * inv);
+			int line = (m <= w) | (s - m <= w);
+			white[i] = line != (d[i] > 0.0f);
+		}
+		break;
+	}
+	}
+}
+
+static void storeWord(uint8_t *row, int bx, uint32_t bits, uint32_t mask)
+{
+	for (int b = 0; b < 4; b++) {
+		int shift = 24 - 8 * b;
+		uint8_t m = (uint8_t)(mask >> shift), v = (uint8_t)(bits >> shift);
+		if (m == 0xff) row[bx + b] = v;
+		else if (m) row[bx + b] = (uint8_t)((row[bx + b] & ~m) | (v & m));
+	}
+}
+
+// Pixels a to b - 1 of row from white[0 .. b - a - 1], a 32 pixel word at a time
+static void writeSpan(uint8_t *row, int a, int b, const uint8_t *white)
+{
+	for (int wx = a & ~31; wx < b; wx += 32) {
+		uint32_t bits = 0, mask = 0xffffffffu;
+		if (wx >= a && wx + 32 <= b) {
+			const uint8_t *c = white + (wx - a);
+			for (int k = 0; k < 32; k++) bits |= (uint32_t)c[k] << (31 - k);
+		} else {
+			mask = 0;
+			for (int k = 0; k < 32; k++) {
+				if (wx + k < a || wx + k >= b) continue;
+				bits |= (uint32_t)white[wx + k - a] << (31 - k);
+				mask |= 1u << (31 - k);
+			}
+		}
+		storeWord(row, wx >> 3, bits, mask);
+	}
+}
+
+// Pixels a to b - 1 of row set to one colour
+static void fillSpan(uint8_t *row, int a, int b, int white)
+{
+	uint8_t v = white ? 0xff : 0x00;
+	int ba = a >> 3, bb = (b - 1) >> 3;
+	uint8_t first = (uint8_t)(0xff >> (a & 7)), last = (uint8_t)(0xff << (7 - ((b - 1) & 7)));
+	if (ba == bb) {
+		uint8_t m = first & last;
+		row[ba] = (uint8_t)((row[ba] & ~m) | (v & m));
+		return;
+	}
+	row[ba] = (uint8_t)((row[ba] & ~first) | (v & first));
+	if (bb > ba + 1) memset(row + ba + 1, v, bb - ba - 1);
+	row[bb] = (uint8_t)((row[bb] & ~last) | (v & last));
+}
+
+static int rasterRect(const SDBitmap *bm, const RasterSource *src, const SDRasterStyle *style, int x, int y, int w, int h)
+{
+	if (!bm || !bm->data || !style || bm->rowbytes * 8 < bm->width) return -1;
+	if (style->mode == kSDRasterContour && !(style->spacing > 0.0f)) return -1;
+	int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+	int x1 = x + w > bm->width ? bm->width : x + w;
+	int y1 = y + h > bm->height ? bm->height : y + h;
+
+	float px[RASTER_SPAN], py[RASTER_SPAN], d[RASTER_SPAN];
+	uint8_t white[RASTER_SPAN];
+	for (int yy = y0; yy < y1; yy++) {
+		uint8_t *row = bm->data + (size_t)yy * bm->rowbytes;
+		for (int sx = x0 & ~31; sx < x1; sx += RASTER_SPAN) {
+			int a = sx > x0 ? sx : x0;
+			int b = sx + RASTER_SPAN < x1 ? sx + RASTER_SPAN : x1;
+			int n = b - a, o = a - sx;
+			for (int i = 0; i < n; i++) {
+				px[o + i] = (float)(a + i) - src->ox;
+				py[o + i] = (float)yy - src->oy;
+			}
+			if (src->scene) sdSceneEvalBatch(src->scene, px + o, py + o, d + o, n);
+			else sdShapeEvalBatch(src->shape, px + o, py + o, d + o, n);
+			classify(style, d + o, white + o, n);
+			writeSpan(row, a, b, white + o);
+		}
+	}
+	return 0;
+}
+
+int sdRasterShapeRect(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style,
+	int x, int y, int w, int h)
+{
+	if (!shape) return -1;
+	RasterSource src = { shape, NULL, ox, oy };
+	return rasterRect(bm, &src, style, x, y, w, h);
+}
+
+int sdRasterSceneRect(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style, int x, int y, int w, int h)
+{
+	if (!scene) return -1;
+	RasterSource src = { NULL, scene, 0.0f, 0.0f };
+	return rasterRect(bm, &src, style, x, y, w, h);
+}
+
+int sdRasterShape(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style)
+{
+	return sdRasterShapeRect(bm, shape, ox, oy, style, 0, 0, bm ? bm->width : 0, bm ? bm->height : 0);
+}
+
+int sdRasterScene(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style)
+{
+	return sdRasterSceneRect(bm, scene, style, 0, 0, bm ? bm->width : 0, bm ? bm->height : 0);
+}
+
+typedef struct {
+	const SDBitmap *bm;
+	const SDRasterStyle *style;
+} RasterTiles;
+
+static void rasterTileVisit(void *ctx, const SDTile *tile, const float *d)
+{
+	const RasterTiles *t = ctx;
+	uint8_t white[SD_TILE_LEAF];
+	if (!d) classify(t->style, &tile->d, white, 1);
+	for (int j = 0; j < tile->h; j++) {
+		uint8_t *row = t->bm->data + (size_t)(tile->y + j) * t->bm->rowbytes;
+		if (!d) {
+			fillSpan(row, tile->x, tile->x + tile->w, white[0]);
+			continue;
+		}
+		classify(t->style, d + j * tile->w, white, tile->w);
+		writeSpan(row, tile->x, tile->x + tile->w, white);
+	}
+}
+
+static int rasterCulled(const SDBitmap *bm, SDTileSampler sample, void *ctx, const SDRasterStyle *style, SDTileStats *stats)
+{
+	if (!bm || !bm->data || !style || bm->rowbytes * 8 < bm->width) return -1;
+	SDTileLayout layout = { 0.0f, 0.0f, bm->width, bm->height, 1.0f, 0.0f, 0.0f };
+	if (style->mode == kSDRasterOutline) {
+		layout.lo = -style->width;
+		layout.hi = style->width;
+	}
+	RasterTiles t = { bm, style };
+	return sdTileWalk(&layout, sample, ctx, rasterTileVisit, &t, stats);
+}
+
+int sdRasterShapeCulled(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style,
+	SDTileStats *stats)
+{
+	if (!shape || !style) return -1;
+	if (style->mode == kSDRasterContour) {
+		if (stats && bm) stats->samples += (long)bm->width * bm->height;
+		return sdRasterShape(bm, shape, ox, oy, style);
+	}
+	SDTileShape placed = { shape, ox, oy };
+	return rasterCulled(bm, sdTileSampleShape, &placed, style, stats);
+}
+
+int sdRasterSceneCulled(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style, SDTileStats *stats)
+{
+	if (!scene || !style) return -1;
+	if (style->mode == kSDRasterContour) {
+		if (stats && bm) stats->samples += (long)bm->width * bm->height;
+		return sdRasterScene(bm, scene, style);
+	}
+	return rasterCulled(bm, sdTileSampleScene, (void *)scene, style, stats);
+}
@@ -0,0 +1,61 @@
+#ifndef SDF2D_RASTER_H
+#define SDF2D_RASTER_H
+
+// 1-bit rasterizer: renders a shape or a scene straight into a packed bitmap in the Playdate
+// LCDBitmap layout (row-major, rowbytes per row, most significant bit first, 1 = white, 0 = black).
+// Distances are evaluated a row span at a time with the batch functions, classified into a 32 bit
+// word per 32 pixels and stored a byte at a time, so there is no read-modify-write per pixel; only
+// the bytes cut by the edges of a rect are merged with what is already there.
+//
+//	int w, h, rowbytes;
+//	uint8_t *data, *mask;
+//	pd->graphics->getBitmapData(img, &w, &h, &rowbytes, &mask, &data);
+//	SDBitmap bm = { data, w, h, rowbytes };
+//	SDRasterStyle style = { kSDRasterContour, 0.9f, 10.0f };
+//	sdRasterShape(&bm, &(SDShape){ kSDCircle, { 110 } }, 200, 120, &style);
+//
+// Pixel (x, y) is sampled at (x, y). Every pixel of the rect is written, black or white.
+
+#include <stdint.h>
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+#include "sdf2d_tiles.h"
+
+typedef struct {
+	uint8_t *data;
+	int width, height;
+	int rowbytes;
+} SDBitmap;
+
+typedef enum {
+	kSDRasterFill,       // black inside (d <= 0)
+	kSDRasterOutline,    // black within width of the surface (|d| <= width)
+	kSDRasterContour,    // lines width either side of every multiple of spacing, black outside and
+	                     // white on a black fill inside, as in the Playdate C benchmark
+} SDRasterMode;
+
+typedef struct {
+	SDRasterMode mode;
+	float width;         // outline and contour: half width of the lines
+	float spacing;       // contour: distance between lines
+} SDRasterStyle;
+
+// Render the whole bitmap. The shape is placed with its origin at (ox, oy). Return 0, or -1 on bad
+// arguments.
+int sdRasterShape(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style);
+int sdRasterScene(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style);
+
+// Render only the pixels in the rect at (x, y) of size w x h, clipped to the bitmap.
+int sdRasterShapeRect(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style,
+	int x, int y, int w, int h);
+int sdRasterSceneRect(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style, int x, int y, int w, int h);
+
+// Render the whole bitmap with tile culling (sdf2d_tiles.h): tiles that are all inside or all
+// outside the fill or outline are filled without evaluating their pixels. Same pixels as
+// sdRasterShape. Contour lines are everywhere, so contour mode renders every pixel. stats (may be
+// NULL) is added to.
+int sdRasterShapeCulled(const SDBitmap *bm, const SDShape *shape, float ox, float oy, const SDRasterStyle *style,
+	SDTileStats *stats);
+int sdRasterSceneCulled(const SDBitmap *bm, const SDScene *scene, const SDRasterStyle *style, SDTileStats *stats);
+
+#endif
@@ -0,0 +1,204 @@
+#include "sdf2d_ray.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#define SHADE_DARK 0.002f   // penumbra below this is stored as 0, so the ray can stop
+
+static int validParams(const SDScene *scene, const SDRayParams *params)
+{
+	return scene && params && params->epsilon > 0.0f && params->maxSteps > 0 && params->maxDistance > 0.0f
+		&& params->relax >= 1.0f && params->relax < 2.0f;
+}
+
+// March up to SD_RAY_PACKET rays. tmax is per ray, or NULL for params->maxDistance. With shade
+// non-NULL it also tracks the penumbra min(k * d / t) and stops rays once it is fully dark.
+static int marchPacket(const SDScene *scene, const SDRayParams *params, const float *ox, const float *oy,
+	const float *dx, const float *dy, const float *tmax, float k, float *t, unsigned char *hit, float *shade,
+	int n, SDRayStats *stats)
+{
+	float tt[SD_RAY_PACKET], step[SD_RAY_PACKET], prev[SD_RAY_PACKET], omega[SD_RAY_PACKET], res[SD_RAY_PACKET];
+	float qx[SD_RAY_PACKET], qy[SD_RAY_PACKET], d[SD_RAY_PACKET];
+	int active[SD_RAY_PACKET];
+	int numActive = n, hits = 0;
+	long steps = 0;
+
+	for (int i = 0; i < n; i++) {
+		tt[i] = 0.0f;
+		step[i] = 0.0f;
+		prev[i] = 0.0f;
+		omega[i] = params->relax;
+		res[i] = 1.0f;
+		active[i] = i;
+	}
+
+	for (int s = 0; s < params->maxSteps && numActive > 0; s++) {
+		for (int j = 0; j < numActive; j++) {
+			int i = active[j];
+			qx[j] = ox[i] + dx[i] * tt[i];
+			qy[j] = oy[i] + dy[i] * tt[i];
+		}
+		sdSceneEvalBatch(scene, qx, qy, d, numActive);
+		steps += numActive;
+
+		int kept = 0;
+		for (int j = 0; j < numActive; j++) {
+			int i = active[j];
+			float r = d[j], radius = fabsf(r);
+			float limit = tmax ? tmax[i] : params->maxDistance;
+			if (radius + prev[i] < step[i]) {
+				// The relaxed step overshot the safe circle: back to its edge and march unrelaxed
+				tt[i] += prev[i] - step[i];
+				step[i] = 0.0f;
+				omega[i] = 1.0f;
+				active[kept++] = i;
+				continue;
+			}
+			if (r < params->epsilon) {
+				hit[i] = 1;
+				hits++;
+				continue;
+			}
+			if (shade && tt[i] > 0.0f) {
+				res[i] = fminf(res[i], k * r / tt[i]);
+				if (res[i] < SHADE_DARK) {
+					hit[i] = 1;
+					hits++;
+					continue;
+				}
+			}
+			if (tt[i] + radius >= limit) {
+				tt[i] = limit;
+				hit[i] = 0;
+				continue;
+			}
+			step[i] = fminf(omega[i] * r, limit - tt[i]);
+			prev[i] = radius;
+			tt[i] += step[i];
+			active[kept++] = i;
+		}
+		numActive = kept;
+	}
+
+	// Out of steps: grazing rays, counted as hits
+	for (int j = 0; j < numActive; j++) hit[active[j]] = 1;
+	hits += numActive;
+
+	for (int i = 0; i < n; i++) {
+		t[i] = tt[i];
+		if (shade) shade[i] = hit[i] ? 0.0f : res[i];
+	}
+	if (stats) {
+		stats->rays += n;
+		stats->steps += steps;
+		stats->hits += hits;
+	}
+	return hits;
+}
+
+int sdRayMarch(const SDScene *scene, const SDRayParams *params, const float *ox, const float *oy,
+	const float *dx, const float *dy, float *t, unsigned char *hit, size_t n, SDRayStats *stats)
+{
+	if (!validParams(scene, params) || !ox || !oy || !dx || !dy || !t) return -1;
+	unsigned char h[SD_RAY_PACKET];
+	int hits = 0;
+	for (size_t i = 0; i < n; i += SD_RAY_PACKET) {
+		int m = (n - i < SD_RAY_PACKET) ? (int)(n - i) : SD_RAY_PACKET;
+		hits += marchPacket(scene, params, ox + i, oy + i, dx + i, dy + i, NULL, 0.0f, t + i, hit ? hit + i : h, NULL, m, stats);
+	}
+	return hits;
+}
+
+void sdVisibilityInit(SDVisibility *vis)
+{
+	vis->x = vis->y = 0.0f;
+	vis->rays = 0;
+	vis->dist = NULL;
+	vis->scale = 0.0f;
+}
+
+void sdVisibilityFree(SDVisibility *vis)
+{
+	free(vis->dist);
+	sdVisibilityInit(vis);
+}
+
+int sdVisibilityBuild(SDVisibility *vis, const SDScene *scene, const SDRayParams *params, float lx, float ly, int rays,
+	SDRayStats *stats)
+{
+	if (!validParams(scene, params) || rays < 3) return -1;
+	if (rays != vis->rays) {
+		float *dist = realloc(vis->dist, rays * sizeof(float));
+		if (!dist) return -1;
+		vis->dist = dist;
+		vis->rays = rays;
+	}
+	vis->x = lx;
+	vis->y = ly;
+	vis->scale = (float)rays / 6.283185f;
+
+	float ox[SD_RAY_PACKET], oy[SD_RAY_PACKET], dx[SD_RAY_PACKET], dy[SD_RAY_PACKET];
+	unsigned char hit[SD_RAY_PACKET];
+	for (int i = 0; i < SD_RAY_PACKET; i++) {
+		ox[i] = lx;
+		oy[i] = ly;
+	}
+	for (int i = 0; i < rays; i += SD_RAY_PACKET) {
+		int m = (rays - i < SD_RAY_PACKET) ? rays - i : SD_RAY_PACKET;
+		for (int j = 0; j < m; j++) {
+			float a = (float)(i + j) / vis->scale;
+			dx[j] = cosf(a);
+			dy[j] = sinf(a);
+		}
+		marchPacket(scene, params, ox, oy, dx, dy, NULL, 0.0f, vis->dist + i, hit, NULL, m, stats);
+	}
+	return 0;
+}
+
+int sdVisibilityLit(const SDVisibility *vis, float px, float py)
+{
+	float dx = px - vis->x, dy = py - vis->y;
+	float a = atan2f(dy, dx);
+	int i = (int)floorf(a * vis->scale + 0.5f);
+	if (i < 0) i += vis->rays;
+	if (i >= vis->rays) i -= vis->rays;
+	float r = vis->dist[i];
+	return dx * dx + dy * dy <= r * r;
+}
+
+void sdVisibilityRaster(const SDVisibility *vis, unsigned char *out, int width, int height, float cell)
+{
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+			out[y * width + x] = sdVisibilityLit(vis, x * cell, y * cell) ? 255 : 0;
+}
+
+int sdShadowMap(const SDScene *scene, const SDRayParams *params, float lx, float ly, float k,
+	unsigned char *out, int width, int height, float cell, SDRayStats *stats)
+{
+	if (!validParams(scene, params) || !out || width <= 0 || height <= 0 || k <= 0.0f) return -1;
+	float ox[SD_RAY_PACKET], oy[SD_RAY_PACKET], dx[SD_RAY_PACKET], dy[SD_RAY_PACKET], tmax[SD_RAY_PACKET];
+	float t[SD_RAY_PACKET], shade[SD_RAY_PACKET];
+	unsigned char hit[SD_RAY_PACKET];
+	int count = width * height;
+	for (int i = 0; i < count; i += SD_RAY_PACKET) {
+		int m = (count - i < SD_RAY_PACKET) ? count - i : SD_RAY_PACKET;
+		for (int j = 0; j < m; j++) {
+			int x = (i + j) % width, y = (i + j) / width;
+			ox[j] = x * cell;
+			oy[j] = y * cell;
+			float vx = lx - ox[j], vy = ly - oy[j];
+			float l = sqrtf(vx * vx + vy * vy);
+			float inv = l > 0.0f ? 1.0f / l : 0.0f;
+			dx[j] = vx * inv;
+			dy[j] = vy * inv;
+			tmax[j] = l;
+		}
+		marchPacket(scene, params, ox, oy, dx, dy, tmax, k, t, hit, shade, m, stats);
+		for (int j = 0; j < m; j++) {
+			float s = fminf(shade[j], 1.0f);
+			out[i + j] = (unsigned char)(s * s * (3.0f - 2.0f * s) * 255.0f + 0.5f);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,245 @@
+#include "sdf2d_render.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SDF2D_THREADS
+#include <pthread.h>
+#endif
+
+// Tiles next .. end - 1 of a worker's band are still to render: the owner takes from the front,
+// thieves from the back, so they only meet on the last tile.
+typedef struct {
+	int next, end;
+	SDRenderStats stats;
+#ifdef SDF2D_THREADS
+	pthread_mutex_t lock;
+#endif
+} RenderQueue;
+
+struct SDRenderWorkers;
+
+typedef struct {
+	struct SDRenderWorkers *workers;
+	int self;
+} WorkerArg;
+
+struct SDRenderWorkers {
+	RenderQueue queues[SD_RENDER_MAX_THREADS];
+	int threads;
+
+	// the frame being rendered
+	const SDRenderTarget *target;
+	SDTileSampler sample;
+	void *ctx;
+	int tilesX;
+	int steal;
+
+#ifdef SDF2D_THREADS
+	pthread_t ids[SD_RENDER_MAX_THREADS];
+	WorkerArg args[SD_RENDER_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t start, done;
+	int generation;            // frames started
+	int running;               // worker threads still on the current frame
+	int quit;
+#endif
+};
+
+static void renderTile(const struct SDRenderWorkers *w, int tile, SDRenderStats *stats)
+{
+	const SDRenderTarget *t = w->target;
+	float px[SD_RENDER_TILE], py[SD_RENDER_TILE], d[SD_RENDER_TILE];
+	int x0 = (tile % w->tilesX) * SD_RENDER_TILE, y0 = (tile / w->tilesX) * SD_RENDER_TILE;
+	int tw = t->width - x0 < SD_RENDER_TILE ? t->width - x0 : SD_RENDER_TILE;
+	int th = t->height - y0 < SD_RENDER_TILE ? t->height - y0 : SD_RENDER_TILE;
+	float inv = 1.0f / t->cell;
+
+	for (int i = 0; i < tw; i++) px[i] = t->x + (x0 + i) * t->cell;
+	for (int j = 0; j < th; j++) {
+		float sy = t->y + (y0 + j) * t->cell;
+		for (int i = 0; i < tw; i++) py[i] = sy;
+		w->sample(w->ctx, px, py, d, tw);
+		uint8_t *row = (uint8_t *)t->data + (size_t)(y0 + j) * t->stride;
+
+		switch (t->format) {
+		case kSDRenderDistance:
+			memcpy((float *)row + x0, d, tw * sizeof(float));
+			break;
+		case kSDRenderCoverage:
+			for (int i = 0; i < tw; i++) {
+				float c = fmaxf(0.0f, fminf(0.5f - d[i] * inv, 1.0f));
+				row[x0 + i] = (uint8_t)(c * 255.0f + 0.5f);
+			}
+			break;
+		case kSDRenderBitmap:
+			// x0 is a multiple of 8, so every byte but a partial last one belongs to this tile alone
+			for (int i = 0; i < tw; i += 8) {
+				uint8_t bits = 0, mask = 0;
+				for (int k = 0; k < 8 && i + k < tw; k++) {
+					bits |= (uint8_t)((d[i + k] > 0.0f) << (7 - k));
+					mask |= (uint8_t)(0x80 >> k);
+				}
+				uint8_t *b = row + ((x0 + i) >> 3);
+				*b = (uint8_t)((*b & ~mask) | bits);
+			}
+			break;
+		}
+	}
+	stats->tiles++;
+	stats->samples += (long)tw * th;
+}
+
+static int takeTile(RenderQueue *q, int back)
+{
+#ifdef SDF2D_THREADS
+	pthread_mutex_lock(&q->lock);
+#endif
+	int tile = -1;
+	if (q->next < q->end) tile = back ? --q->end : q->next++;
+#ifdef SDF2D_THREADS
+	pthread_mutex_unlock(&q->lock);
+#endif
+	return tile;
+}
+
+static void renderWork(struct SDRenderWorkers *w, int self)
+{
+	RenderQueue *own = &w->queues[self];
+	int tile;
+	while ((tile = takeTile(own, 0)) >= 0) renderTile(w, tile, &own->stats);
+	if (!w->steal) return;
+	// bands only shrink, so one pass over the others finds every tile left
+	for (int k = 1; k < w->threads; k++) {
+		RenderQueue *victim = &w->queues[(self + k) % w->threads];
+		while ((tile = takeTile(victim, 1)) >= 0) {
+			renderTile(w, tile, &own->stats);
+			own->stats.stolen++;
+		}
+	}
+}
+
+#ifdef SDF2D_THREADS
+static void *workerMain(void *arg)
+{
+	struct SDRenderWorkers *w = ((WorkerArg *)arg)->workers;
+	int self = ((WorkerArg *)arg)->self;
+	int seen = 0;
+	for (;;) {
+		pthread_mutex_lock(&w->lock);
+		while (w->generation == seen && !w->quit) pthread_cond_wait(&w->start, &w->lock);
+		if (w->quit) {
+			pthread_mutex_unlock(&w->lock);
+			return NULL;
+		}
+		seen = w->generation;
+		pthread_mutex_unlock(&w->lock);
+
+		renderWork(w, self);
+
+		pthread_mutex_lock(&w->lock);
+		if (--w->running == 0) pthread_cond_signal(&w->done);
+		pthread_mutex_unlock(&w->lock);
+	}
+}
+#endif
+
+int sdRenderPoolInit(SDRenderPool *pool, int threads)
+{
+	pool->threads = 0;
+	pool->steal = 1;
+	pool->workers = NULL;
+	if (threads < 1 || threads > SD_RENDER_MAX_THREADS) return -1;
+#ifndef SDF2D_THREADS
+	threads = 1;
+#endif
+	struct SDRenderWorkers *w = calloc(1, sizeof(struct SDRenderWorkers));
+	if (!w) return -1;
+	w->threads = threads;
+#ifdef SDF2D_THREADS
+	pthread_mutex_init(&w->lock, NULL);
+	pthread_cond_init(&w->start, NULL);
+	pthread_cond_init(&w->done, NULL);
+	for (int t = 0; t < SD_RENDER_MAX_THREADS; t++) pthread_mutex_init(&w->queues[t].lock, NULL);
+	pool->workers = w;
+	for (int t = 1; t < threads; t++) {
+		w->args[t] = (WorkerArg){ w, t };
+		if (pthread_create(&w->ids[t], NULL, workerMain, &w->args[t]) != 0) {
+			w->threads = t;
+			pool->threads = t;
+			sdRenderPoolFree(pool);
+			return -1;
+		}
+	}
+#endif
+	pool->workers = w;
+	pool->threads = threads;
+	return 0;
+}
+
+void sdRenderPoolFree(SDRenderPool *pool)
+{
+	struct SDRenderWorkers *w = pool->workers;
+	if (w) {
+#ifdef SDF2D_THREADS
+		pthread_mutex_lock(&w->lock);
+		w->quit = 1;
+		pthread_cond_broadcast(&w->start);
+		pthread_mutex_unlock(&w->lock);
+		for (int t = 1; t < w->threads; t++) pthread_join(w->ids[t], NULL);
+		for (int t = 0; t < SD_RENDER_MAX_THREADS; t++) pthread_mutex_destroy(&w->queues[t].lock);
+		pthread_cond_destroy(&w->start);
+		pthread_cond_destroy(&w->done);
+		pthread_mutex_destroy(&w->lock);
+#endif
+		free(w);
+	}
+	pool->threads = 0;
+	pool->workers = NULL;
+}
+
+int sdRender(SDRenderPool *pool, const SDRenderTarget *target, SDTileSampler sample, void *ctx, SDRenderStats *stats)
+{
+	struct SDRenderWorkers *w = pool->workers;
+	if (!w || !target || !target->data || !sample || target->width <= 0 || target->height <= 0 || !(target->cell > 0.0f))
+		return -1;
+	int rowBytes = target->format == kSDRenderDistance ? target->width * (int)sizeof(float)
+		: target->format == kSDRenderCoverage ? target->width : (target->width + 7) >> 3;
+	if (target->stride < rowBytes) return -1;
+
+	w->target = target;
+	w->sample = sample;
+	w->ctx = ctx;
+	w->steal = pool->steal;
+	w->tilesX = (target->width + SD_RENDER_TILE - 1) / SD_RENDER_TILE;
+	int tiles = w->tilesX * ((target->height + SD_RENDER_TILE - 1) / SD_RENDER_TILE);
+	for (int t = 0; t < w->threads; t++) {
+		w->queues[t].next = (int)((long)tiles * t / w->threads);
+		w->queues[t].end = (int)((long)tiles * (t + 1) / w->threads);
+		w->queues[t].stats = (SDRenderStats){ 0 };
+	}
+
+#ifdef SDF2D_THREADS
+	pthread_mutex_lock(&w->lock);
+	w->generation++;
+	w->running = w->threads - 1;
+	pthread_cond_broadcast(&w->start);
+	pthread_mutex_unlock(&w->lock);
+	renderWork(w, 0);
+	pthread_mutex_lock(&w->lock);
+	while (w->running > 0) pthread_cond_wait(&w->done, &w->lock);
+	pthread_mutex_unlock(&w->lock);
+#else
+	renderWork(w, 0);
+#endif
+
+	if (stats) {
+		for (int t = 0; t < w->threads; t++) {
+			stats->tiles += w->queues[t].stats.tiles;
+			stats->stolen += w->queues[t].stats.stolen;
+			stats->samples += w->queues[t].stats.samples;
+		}
+	}
+	return 0;
+}
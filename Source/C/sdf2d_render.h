@@ -0,0 +1,67 @@
+#ifndef SDF2D_RENDER_H
+#define SDF2D_RENDER_H
+
+// Frame renderer for large targets (eg 1920 x 1080 on desktop builds): the frame is cut into
+// SD_RENDER_TILE square tiles, spread over a pool of worker threads, and rendered as distances,
+// antialiased coverage or a 1-bit mask.
+//
+//	SDRenderPool pool;
+//	sdRenderPoolInit(&pool, 8);
+//	SDRenderTarget target = { kSDRenderCoverage, pixels, 1920, 1080, 1920, 0, 0, 1 };
+//	sdRender(&pool, &target, sdTileSampleScene, &scene, NULL);   // every frame
+//	sdRenderPoolFree(&pool);
+//
+// Each worker starts on its own contiguous run of tiles (a band of the frame) and, once that is
+// done, steals single tiles from the far end of the other workers' runs. A band full of complex
+// geometry is then shared out instead of keeping the frame waiting on one worker. Every pixel is
+// computed the same way whoever renders its tile, so frames do not depend on the thread count.
+//
+// Threads need SDF2D_THREADS (POSIX threads); without it the pool renders on the calling thread.
+// The workers are started once by sdRenderPoolInit and sleep between frames.
+
+#include <stdint.h>
+#include "sdf2d_tiles.h"
+
+#define SD_RENDER_TILE 64          // tile side in pixels, a multiple of 8 so tiles share no bitmap byte
+#define SD_RENDER_MAX_THREADS 64
+
+typedef enum {
+	kSDRenderDistance,         // float per pixel: the distance
+	kSDRenderCoverage,         // uint8_t per pixel: 255 inside, 0 outside, a one pixel ramp across the surface
+	kSDRenderBitmap,           // packed bits, most significant bit first: 0 (black) inside, 1 (white) outside,
+	                           // as kSDRasterFill in sdf2d_raster.h
+} SDRenderFormat;
+
+typedef struct {
+	SDRenderFormat format;
+	void *data;
+	int width, height;
+	int stride;                // bytes per row
+	float x, y;                // where pixel (0, 0) is sampled
+	float cell;                // distance between samples; pixel (i, j) is sampled at (x + i * cell, y + j * cell)
+} SDRenderTarget;
+
+typedef struct {
+	long tiles;
+	long stolen;               // tiles rendered by another worker than the one they started on
+	long samples;
+} SDRenderStats;
+
+struct SDRenderWorkers;
+
+typedef struct {
+	int threads;               // workers, the calling thread included
+	int steal;                 // 1 (the default) to steal tiles; 0 keeps each band on its worker
+	struct SDRenderWorkers *workers;
+} SDRenderPool;
+
+// Start threads - 1 worker threads (1 without SDF2D_THREADS). Returns 0, or -1 on bad arguments or
+// if the threads cannot be started.
+int sdRenderPoolInit(SDRenderPool *pool, int threads);
+void sdRenderPoolFree(SDRenderPool *pool);
+
+// Render the whole target. sample must be safe to call from several threads at once, as the
+// sdTileSample* samplers are. stats (may be NULL) is added to. Returns 0, or -1 on bad arguments.
+int sdRender(SDRenderPool *pool, const SDRenderTarget *target, SDTileSampler sample, void *ctx, SDRenderStats *stats);
+
+#endif
@@ -0,0 +1,341 @@
+// Scene compiler and evaluator. See sdf2d_scene.h.
+
+#include "sdf2d_scene.h"
+#include "sdf2d_profile.h"
+#include <math.h>
+#include <stdlib.h>
+
+enum {
+	kOpShape,            // push shape(p)
+	kOpShapeAt,          // push shape(p - t): a leaf with a translation only
+	kOpUnion,
+	kOpIntersect,
+	kOpSubtract,         // stack: a, b
+	kOpSubtractRev,      // stack: b, a (b was deeper, so it was evaluated first)
+	kOpSmoothUnion,
+	kOpOnion,
+	kOpRound,
+	kOpTranslate,        // push frame, p -= t
+	kOpTransform,        // push frame, p = R^-1 (p - t)
+	kOpPop               // pop frame
+};
+
+void sdSceneInit(SDScene *scene)
+{
+	scene->nodes = NULL;
+	scene->numNodes = scene->capNodes = 0;
+	scene->code = NULL;
+	scene->codeLength = scene->capCode = 0;
+	scene->root = -1;
+}
+
+void sdSceneFree(SDScene *scene)
+{
+	free(scene->nodes);
+	free(scene->code);
+	sdSceneInit(scene);
+}
+
+static int sdSceneNewNode(SDScene *scene)
+{
+	if (scene->numNodes >= 65535) return -1;
+	if (scene->numNodes == scene->capNodes) {
+		int cap = scene->capNodes ? scene->capNodes * 2 : 16;
+		SDNode *nodes = realloc(scene->nodes, cap * sizeof(SDNode));
+		if (!nodes) return -1;
+		scene->nodes = nodes;
+		scene->capNodes = cap;
+	}
+	SDNode *nd = &scene->nodes[scene->numNodes];
+	nd->op = kSDNodeShape;
+	nd->a = nd->b = -1;
+	nd->k = 0.0f;
+	nd->tx = nd->ty = 0.0f;
+	nd->c = 1.0f;
+	nd->s = 0.0f;
+	return scene->numNodes++;
+}
+
+int sdSceneAddShape(SDScene *scene, const SDShape *shape)
+{
+	int id = sdSceneNewNode(scene);
+	if (id >= 0) scene->nodes[id].shape = *shape;
+	return id;
+}
+
+int sdSceneAddOp(SDScene *scene, SDNodeOp op, int a, int b, float k)
+{
+	int unary = (op == kSDOnion || op == kSDRound);
+	if (op == kSDNodeShape || a < 0 || a >= scene->numNodes) return -1;
+	if (!unary && (b < 0 || b >= scene->numNodes)) return -1;
+	int id = sdSceneNewNode(scene);
+	if (id < 0) return -1;
+	SDNode *nd = &scene->nodes[id];
+	nd->op = op;
+	nd->a = a;
+	nd->b = unary ? -1 : b;
+	nd->k = k;
+	return id;
+}
+
+void sdSceneSetTransform(SDScene *scene, int node, float tx, float ty, float angle)
+{
+	SDNode *nd = &scene->nodes[node];
+	nd->tx = tx;
+	nd->ty = ty;
+	nd->c = cosf(angle);
+	nd->s = sinf(angle);
+}
+
+int sdSceneAddUnionAll(SDScene *scene, const int *nodes, int count)
+{
+	if (count <= 0) return -1;
+	if (count == 1) return nodes[0];
+	// Balanced, so the compiled stack depth grows with log2(count)
+	int a = sdSceneAddUnionAll(scene, nodes, count / 2);
+	int b = sdSceneAddUnionAll(scene, nodes + count / 2, count - count / 2);
+	if (a < 0 || b < 0) return -1;
+	return sdSceneAddOp(scene, kSDUnion, a, b, 0.0f);
+}
+
+// Stack slots needed to evaluate a subtree, evaluating the deeper child first (Sethi-Ullman)
+static int sdSceneNeed(const SDScene *scene, int id)
+{
+	const SDNode *nd = &scene->nodes[id];
+	if (nd->op == kSDNodeShape) return 1;
+	int na = sdSceneNeed(scene, nd->a);
+	if (nd->b < 0) return na;
+	int nb = sdSceneNeed(scene, nd->b);
+	return (na == nb) ? na + 1 : (na > nb ? na : nb);
+}
+
+static int sdSceneEmit(SDScene *scene, unsigned short op, int node)
+{
+	if (scene->codeLength == scene->capCode) {
+		int cap = scene->capCode ? scene->capCode * 2 : 32;
+		SDInstr *code = realloc(scene->code, cap * sizeof(SDInstr));
+		if (!code) return -1;
+		scene->code = code;
+		scene->capCode = cap;
+	}
+	scene->code[scene->codeLength].op = op;
+	scene->code[scene->codeLength].node = (unsigned short)node;
+	scene->codeLength++;
+	return 0;
+}
+
+static int sdSceneCompileNode(SDScene *scene, int id, int frames)
+{
+	const SDNode *nd = &scene->nodes[id];
+	int rotated = (nd->c != 1.0f || nd->s != 0.0f);
+	int translated = (nd->tx != 0.0f || nd->ty != 0.0f);
+
+	if (nd->op == kSDNodeShape && !rotated)
+		return sdSceneEmit(scene, translated ? kOpShapeAt : kOpShape, id);
+
+	int pushed = rotated || translated;
+	if (pushed) {
+		if (++frames > SD_SCENE_STACK) return -1;
+		if (sdSceneEmit(scene, rotated ? kOpTransform : kOpTranslate, id)) return -1;
+	}
+
+	if (nd->op == kSDNodeShape) {
+		if (sdSceneEmit(scene, kOpShape, id)) return -1;
+	} else if (nd->b < 0) {
+		if (sdSceneCompileNode(scene, nd->a, frames)) return -1;
+		if (sdSceneEmit(scene, nd->op == kSDOnion ? kOpOnion : kOpRound, id)) return -1;
+	} else {
+		int swap = sdSceneNeed(scene, nd->b) > sdSceneNeed(scene, nd->a);
+		int first = swap ? nd->b : nd->a;
+		int second = swap ? nd->a : nd->b;
+		if (sdSceneCompileNode(scene, first, frames)) return -1;
+		if (sdSceneCompileNode(scene, second, frames)) return -1;
+		unsigned short op;
+		switch (nd->op) {
+		case kSDUnion: op = kOpUnion; break;
+		case kSDIntersect: op = kOpIntersect; break;
+		case kSDSubtract: op = swap ? kOpSubtractRev : kOpSubtract; break;
+		case kSDSmoothUnion: op = kOpSmoothUnion; break;
+		default: return -1;
+		}
+		if (sdSceneEmit(scene, op, id)) return -1;
+	}
+
+	if (pushed && sdSceneEmit(scene, kOpPop, id)) return -1;
+	return 0;
+}
+
+int sdSceneCompile(SDScene *scene, int root)
+{
+	scene->codeLength = 0;
+	scene->root = -1;
+	if (root < 0 || root >= scene->numNodes) return -1;
+	if (sdSceneNeed(scene, root) > SD_SCENE_STACK) return -1;
+	if (sdSceneCompileNode(scene, root, 0)) {
+		scene->codeLength = 0;
+		return -1;
+	}
+	scene->root = root;
+	return 0;
+}
+
+static inline float sdSmoothMin(float a, float b, float k)
+{
+	// no blend: a plain union, and no 0 / 0
+	if (k <= 0.0f) return fminf(a, b);
+	float h = fmaxf(k - fabsf(a - b), 0.0f) / k;
+	return fminf(a, b) - h * h * k * 0.25f;
+}
+
+// Leaves, counted against their node when the scene is profiled (sdf2d_profile.h)
+static inline float sdSceneShape(const SDShape *s, float px, float py, int counter)
+{
+	(void)counter;
+	SD_PROFILE_BEGIN(start, counter);
+	float d = sdShapeEval(s, px, py);
+	SD_PROFILE_END(start, counter, 1);
+	return d;
+}
+
+static inline void sdSceneShapeBatch(const SDShape *s, const float *px, const float *py, float *out, int n, int counter)
+{
+	(void)counter;
+	SD_PROFILE_BEGIN(start, counter);
+	sdShapeEvalBatch(s, px, py, out, n);
+	SD_PROFILE_END(start, counter, n);
+}
+
+float sdSceneEval(const SDScene *scene, float px, float py)
+{
+	float stack[SD_SCENE_STACK];
+	float frames[SD_SCENE_STACK * 2];
+	int sp = 0;
+	int fp = 0;
+	const SDNode *nodes = scene->nodes;
+	const SDInstr *in = scene->code;
+	const SDInstr *end = in + scene->codeLength;
+	int counted;
+	int base = SD_PROFILE_SCENE(scene, counted);
+
+	if (in == end) return 1e30f;
+	for (; in < end; in++) {
+		const SDNode *nd = &nodes[in->node];
+		int counter = in->node < counted ? base + in->node : -1;
+		switch (in->op) {
+		case kOpShape: stack[sp++] = sdSceneShape(&nd->shape, px, py, counter); break;
+		case kOpShapeAt: stack[sp++] = sdSceneShape(&nd->shape, px - nd->tx, py - nd->ty, counter); break;
+		case kOpUnion: sp--; stack[sp-1] = fminf(stack[sp-1], stack[sp]); break;
+		case kOpIntersect: sp--; stack[sp-1] = fmaxf(stack[sp-1], stack[sp]); break;
+		case kOpSubtract: sp--; stack[sp-1] = fmaxf(stack[sp-1], -stack[sp]); break;
+		case kOpSubtractRev: sp--; stack[sp-1] = fmaxf(stack[sp], -stack[sp-1]); break;
+		case kOpSmoothUnion: sp--; stack[sp-1] = sdSmoothMin(stack[sp-1], stack[sp], nd->k); break;
+		case kOpOnion: stack[sp-1] = fabsf(stack[sp-1]) - nd->k; break;
+		case kOpRound: stack[sp-1] -= nd->k; break;
+		case kOpTranslate:
+			frames[fp++] = px;
+			frames[fp++] = py;
+			px -= nd->tx;
+			py -= nd->ty;
+			break;
+		case kOpTransform: {
+			frames[fp++] = px;
+			frames[fp++] = py;
+			float dx = px - nd->tx;
+			float dy = py - nd->ty;
+			px = nd->c * dx + nd->s * dy;
+			py = -nd->s * dx + nd->c * dy;
+			break;
+		}
+		case kOpPop:
+			py = frames[--fp];
+			px = frames[--fp];
+			break;
+		}
+	}
+	return stack[0];
+}
+
+// Runs the instruction stream once per block of points, so the dispatch is paid per block and
+// the shapes use their sdXxxBatch loops.
+static void sdSceneEvalBlock(const SDScene *scene, const float *px, const float *py, float *out, int n, int base, int counted)
+{
+	float stack[SD_SCENE_STACK][SD_SCENE_BLOCK];
+	float fx[SD_SCENE_STACK + 1][SD_SCENE_BLOCK];
+	float fy[SD_SCENE_STACK + 1][SD_SCENE_BLOCK];
+	const float *cx[SD_SCENE_STACK + 1];
+	const float *cy[SD_SCENE_STACK + 1];
+	int sp = 0;
+	int fp = 0;
+	const SDNode *nodes = scene->nodes;
+	const SDInstr *in = scene->code;
+	const SDInstr *end = in + scene->codeLength;
+
+	cx[0] = px;
+	cy[0] = py;
+	for (; in < end; in++) {
+		const SDNode *nd = &nodes[in->node];
+		int counter = in->node < counted ? base + in->node : -1;
+		float *a = stack[sp > 1 ? sp - 2 : 0];
+		float *b = stack[sp > 0 ? sp - 1 : 0];
+		switch (in->op) {
+		case kOpShape:
+			sdSceneShapeBatch(&nd->shape, cx[fp], cy[fp], stack[sp++], n, counter);
+			break;
+		case kOpShapeAt: {
+			float *tx = fx[SD_SCENE_STACK];
+			float *ty = fy[SD_SCENE_STACK];
+			for (int i = 0; i < n; i++) {
+				tx[i] = cx[fp][i] - nd->tx;
+				ty[i] = cy[fp][i] - nd->ty;
+			}
+			sdSceneShapeBatch(&nd->shape, tx, ty, stack[sp++], n, counter);
+			break;
+		}
+		case kOpUnion: for (int i = 0; i < n; i++) a[i] = fminf(a[i], b[i]); sp--; break;
+		case kOpIntersect: for (int i = 0; i < n; i++) a[i] = fmaxf(a[i], b[i]); sp--; break;
+		case kOpSubtract: for (int i = 0; i < n; i++) a[i] = fmaxf(a[i], -b[i]); sp--; break;
+		case kOpSubtractRev: for (int i = 0; i < n; i++) a[i] = fmaxf(b[i], -a[i]); sp--; break;
+		case kOpSmoothUnion: for (int i = 0; i < n; i++) a[i] = sdSmoothMin(a[i], b[i], nd->k); sp--; break;
+		case kOpOnion: for (int i = 0; i < n; i++) b[i] = fabsf(b[i]) - nd->k; break;
+		case kOpRound: for (int i = 0; i < n; i++) b[i] -= nd->k; break;
+		case kOpTranslate:
+			for (int i = 0; i < n; i++) {
+				fx[fp][i] = cx[fp][i] - nd->tx;
+				fy[fp][i] = cy[fp][i] - nd->ty;
+			}
+			cx[fp + 1] = fx[fp];
+			cy[fp + 1] = fy[fp];
+			fp++;
+			break;
+		case kOpTransform:
+			for (int i = 0; i < n; i++) {
+				float dx = cx[fp][i] - nd->tx;
+				float dy = cy[fp][i] - nd->ty;
+				fx[fp][i] = nd->c * dx + nd->s * dy;
+				fy[fp][i] = -nd->s * dx + nd->c * dy;
+			}
+			cx[fp + 1] = fx[fp];
+			cy[fp + 1] = fy[fp];
+			fp++;
+			break;
+		case kOpPop:
+			fp--;
+			break;
+		}
+	}
+	for (int i = 0; i < n; i++) out[i] = stack[0][i];
+}
+
+void sdSceneEvalBatch(const SDScene *scene, const float *px, const float *py, float *out, size_t n)
+{
+	if (scene->codeLength == 0) {
+		for (size_t i = 0; i < n; i++) out[i] = 1e30f;
+		return;
+	}
+	int counted;
+	int base = SD_PROFILE_SCENE(scene, counted);
+	for (size_t i = 0; i < n; i += SD_SCENE_BLOCK) {
+		int m = (n - i < SD_SCENE_BLOCK) ? (int)(n - i) : SD_SCENE_BLOCK;
+		sdSceneEvalBlock(scene, px + i, py + i, out + i, m, base, counted);
+	}
+}
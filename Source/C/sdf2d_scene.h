@@ -0,0 +1,80 @@
+#ifndef SDF2D_SCENE_H
+#define SDF2D_SCENE_H
+
+// Scenes: shapes combined with transforms and CSG operators, evaluated in one C call.
+//
+// Nodes are added bottom-up into a flat array (children before parents), then sdSceneCompile turns
+// the tree under a root node into a compact postfix instruction stream. The evaluator runs that
+// stream with fixed-size stacks: no recursion and no allocation per query.
+//
+//	SDScene scene;
+//	sdSceneInit(&scene);
+//	int a = sdSceneAddShape(&scene, &(SDShape){ kSDCircle, { 20 } });
+//	int b = sdSceneAddShape(&scene, &(SDShape){ kSDBox, { 30, 10 } });
+//	sdSceneSetTransform(&scene, a, 200, 90, 0);
+//	sdSceneCompile(&scene, sdSceneAddOp(&scene, kSDUnion, a, b, 0));
+//	float d = sdSceneEval(&scene, px, py);
+//	sdSceneFree(&scene);
+
+#include <stddef.h>
+#include "sdf2d_shape.h"
+
+#define SD_SCENE_STACK 16   // max value stack and transform depth of a compiled scene
+#define SD_SCENE_BLOCK 32   // points per block in sdSceneEvalBatch
+
+typedef enum {
+	kSDNodeShape,        // leaf: node.shape
+	kSDUnion,            // min(a, b)
+	kSDIntersect,        // max(a, b)
+	kSDSubtract,         // max(a, -b): b carved out of a
+	kSDSmoothUnion,      // polynomial smooth minimum of a and b, blend radius k; k <= 0 is kSDUnion
+	kSDOnion,            // |a| - k: shell of thickness 2k around the surface of a
+	kSDRound,            // a - k: a grown by k
+} SDNodeOp;
+
+typedef struct {
+	SDNodeOp op;
+	int a, b;            // children (operators); b is unused by unary operators
+	float k;             // operator parameter
+	float tx, ty;        // origin of the node frame in its parent frame
+	float c, s;          // rotation of the node frame (cos, sin)
+	SDShape shape;       // kSDNodeShape only
+} SDNode;
+
+typedef struct {
+	unsigned short op;
+	unsigned short node;
+} SDInstr;
+
+typedef struct {
+	SDNode *nodes;
+	int numNodes;
+	int capNodes;
+	SDInstr *code;
+	int codeLength;
+	int capCode;
+	int root;            // root of the compiled stream, -1 before sdSceneCompile
+} SDScene;
+
+void sdSceneInit(SDScene *scene);
+void sdSceneFree(SDScene *scene);
+
+// Add nodes. Both return the node index, or -1 on allocation failure or bad child indices.
+// Children must already exist, so a scene is always acyclic.
+int sdSceneAddShape(SDScene *scene, const SDShape *shape);
+int sdSceneAddOp(SDScene *scene, SDNodeOp op, int a, int b, float k);
+
+// Place a node: its subtree is evaluated in a frame at (tx, ty) rotated by angle (radians).
+void sdSceneSetTransform(SDScene *scene, int node, float tx, float ty, float angle);
+
+// Union of count nodes, returned as a single node index (-1 on failure).
+int sdSceneAddUnionAll(SDScene *scene, const int *nodes, int count);
+
+// Compile the tree under root. Returns 0, or -1 if it is too deep for SD_SCENE_STACK or allocation fails.
+// Recompile after changing the tree or any transform; shape parameters are read at evaluation time.
+int sdSceneCompile(SDScene *scene, int root);
+
+float sdSceneEval(const SDScene *scene, float px, float py);
+void sdSceneEvalBatch(const SDScene *scene, const float *px, const float *py, float *out, size_t n);
+
+#endif
@@ -0,0 +1,308 @@
+#include "sdf2d_shape.h"
+#include "sdf2d.h"
+#include "sdf2d_profile.h"
+#include <math.h>
+
+// SDF2D_FAST_MATH swaps in the fast-math variants of sdf2d_fast.h for distances (not gradients)
+#ifdef SDF2D_FAST_MATH
+#include "sdf2d_fast.h"
+#define sdShapeParabola sdParabolaFast
+#define sdShapeEllipse sdEllipseFast
+#define sdShapeRegularPolygon sdRegularPolygonFast
+#define sdShapePolygon sdPolygonFast
+#else
+#define sdShapeParabola sdParabola
+#define sdShapeEllipse sdEllipse
+#define sdShapeRegularPolygon sdRegularPolygon
+#define sdShapePolygon sdPolygon
+#endif
+
+static inline float sdShapeDistance(const SDShape *s, float px, float py)
+{
+	const float *p = s->p;
+	switch (s->type) {
+	case kSDCircle: return sdCircle(px, py, p[0]);
+	case kSDBox: return sdBox(px, py, p[0], p[1]);
+	case kSDBoxLinf: return sdBoxLinf(px, py, p[0], p[1]);
+	case kSDRoundedBox: return sdRoundedBox(px, py, p[0], p[1], p[2], p[3], p[4], p[5]);
+	case kSDOrientedBox: return sdOrientedBox(px, py, p[0], p[1], p[2], p[3], p[4]);
+	case kSDSegment: return sdSegment(px, py, p[0], p[1], p[2], p[3]);
+	case kSDSegmentLinf: return sdSegmentLinf(px, py, p[0], p[1], p[2], p[3]);
+	case kSDRhombus: return sdRhombus(px, py, p[0], p[1]);
+	case kSDRhombusLinf: return sdRhombusLinf(px, py, p[0], p[1]);
+	case kSDTrapezoid: return sdTrapezoid(px, py, p[0], p[1], p[2]);
+	case kSDParallelogram: return sdParallelogram(px, py, p[0], p[1], p[2]);
+	case kSDTriangle: return sdTriangle(px, py, p[0], p[1], p[2], p[3], p[4], p[5]);
+	case kSDTriangleIsosceles: return sdTriangleIsosceles(px, py, p[0], p[1]);
+	case kSDEquilateralTriangle: return sdEquilateralTriangle(px, py, p[0]);
+	case kSDQuad: return sdQuad(px, py, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+	case kSDStar5: return sdStar5(px, py, p[0], p[1]);
+	case kSDPentagon: return sdPentagon(px, py, p[0]);
+	case kSDHexagon: return sdHexagon(px, py, p[0]);
+	case kSDOctagon: return sdOctagon(px, py, p[0]);
+	case kSDHexagram: return sdHexagram(px, py, p[0]);
+	case kSDPie: return sdPie(px, py, p[0], p[1], p[2]);
+	case kSDCutDisk: return sdCutDisk(px, py, p[0], p[1]);
+	case kSDArc: return sdArc(px, py, p[0], p[1], p[2], p[3]);
+	case kSDRing: return sdRing(px, py, p[0], p[1], p[2], p[3]);
+	case kSDHorseshoe: return sdHorseshoe(px, py, p[0], p[1], p[2], p[3], p[4]);
+	case kSDVesica: return sdVesica(px, py, p[0], p[1]);
+	case kSDOrientedVesica: return sdOrientedVesica(px, py, p[0], p[1], p[2], p[3], p[4]);
+	case kSDMoon: return sdMoon(px, py, p[0], p[1], p[2]);
+	case kSDCross: return sdCross(px, py, p[0], p[1], p[2]);
+	case kSDRoundedX: return sdRoundedX(px, py, p[0], p[1]);
+	case kSDParabola: return sdShapeParabola(px, py, p[0]);
+	case kSDTunnel: return sdTunnel(px, py, p[0], p[1]);
+	case kSDEllipse: return sdShapeEllipse(px, py, p[0], p[1]);
+	case kSDEllipseLinf: return sdEllipseLinf(px, py, p[0], p[1]);
+	case kSDRegularPolygon: return sdShapeRegularPolygon(px, py, p[0], s->n);
+	case kSDPolygon: return sdShapePolygon(px, py, (float *)s->vx, (float *)s->vy, s->n);
+	case kSDRoundSquare: return sdRoundSquare(px, py, p[0], p[1]);
+	case kSDEgg: return sdEgg(px, py, p[0], p[1]);
+	case kSDUnevenCapsule: return sdUnevenCapsule(px, py, p[0], p[1], p[2]);
+	case kSDBezier: return sdBezier(px, py, p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+	default: return 1e30f;
+	}
+}
+
+static inline float sdShapeGradient(const SDShape *s, float px, float py, float *gx, float *gy)
+{
+	const float *p = s->p;
+	switch (s->type) {
+	case kSDCircle: return sdgCircle(px, py, p[0], gx, gy);
+	case kSDBox: return sdgBox(px, py, p[0], p[1], gx, gy);
+	case kSDBoxLinf: return sdgBoxLinf(px, py, p[0], p[1], gx, gy);
+	case kSDRoundedBox: return sdgRoundedBox(px, py, p[0], p[1], p[2], p[3], p[4], p[5], gx, gy);
+	case kSDOrientedBox: return sdgOrientedBox(px, py, p[0], p[1], p[2], p[3], p[4], gx, gy);
+	case kSDSegment: return sdgSegment(px, py, p[0], p[1], p[2], p[3], gx, gy);
+	case kSDSegmentLinf: return sdgSegmentLinf(px, py, p[0], p[1], p[2], p[3], gx, gy);
+	case kSDRhombus: return sdgRhombus(px, py, p[0], p[1], gx, gy);
+	case kSDRhombusLinf: return sdgRhombusLinf(px, py, p[0], p[1], gx, gy);
+	case kSDTrapezoid: return sdgTrapezoid(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDParallelogram: return sdgParallelogram(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDTriangle: return sdgTriangle(px, py, p[0], p[1], p[2], p[3], p[4], p[5], gx, gy);
+	case kSDTriangleIsosceles: return sdgTriangleIsosceles(px, py, p[0], p[1], gx, gy);
+	case kSDEquilateralTriangle: return sdgEquilateralTriangle(px, py, p[0], gx, gy);
+	case kSDQuad: return sdgQuad(px, py, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], gx, gy);
+	case kSDStar5: return sdgStar5(px, py, p[0], p[1], gx, gy);
+	case kSDPentagon: return sdgPentagon(px, py, p[0], gx, gy);
+	case kSDHexagon: return sdgHexagon(px, py, p[0], gx, gy);
+	case kSDOctagon: return sdgOctagon(px, py, p[0], gx, gy);
+	case kSDHexagram: return sdgHexagram(px, py, p[0], gx, gy);
+	case kSDPie: return sdgPie(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDCutDisk: return sdgCutDisk(px, py, p[0], p[1], gx, gy);
+	case kSDArc: return sdgArc(px, py, p[0], p[1], p[2], p[3], gx, gy);
+	case kSDRing: return sdgRing(px, py, p[0], p[1], p[2], p[3], gx, gy);
+	case kSDHorseshoe: return sdgHorseshoe(px, py, p[0], p[1], p[2], p[3], p[4], gx, gy);
+	case kSDVesica: return sdgVesica(px, py, p[0], p[1], gx, gy);
+	case kSDOrientedVesica: return sdgOrientedVesica(px, py, p[0], p[1], p[2], p[3], p[4], gx, gy);
+	case kSDMoon: return sdgMoon(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDCross: return sdgCross(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDRoundedX: return sdgRoundedX(px, py, p[0], p[1], gx, gy);
+	case kSDParabola: return sdgParabola(px, py, p[0], gx, gy);
+	case kSDTunnel: return sdgTunnel(px, py, p[0], p[1], gx, gy);
+	case kSDEllipse: return sdgEllipse(px, py, p[0], p[1], gx, gy);
+	case kSDEllipseLinf: return sdgEllipseLinf(px, py, p[0], p[1], gx, gy);
+	case kSDRegularPolygon: return sdgRegularPolygon(px, py, p[0], s->n, gx, gy);
+	case kSDPolygon: return sdgPolygon(px, py, (float *)s->vx, (float *)s->vy, s->n, gx, gy);
+	case kSDRoundSquare: return sdgRoundSquare(px, py, p[0], p[1], gx, gy);
+	case kSDEgg: return sdgEgg(px, py, p[0], p[1], gx, gy);
+	case kSDUnevenCapsule: return sdgUnevenCapsule(px, py, p[0], p[1], p[2], gx, gy);
+	case kSDBezier: return sdgBezier(px, py, p[0], p[1], p[2], p[3], p[4], p[5], p[6], gx, gy);
+	default: *gx = *gy = 0.0f; return 1e30f;
+	}
+}
+
+static inline void sdShapeBatch(const SDShape *s, const float *px, const float *py, float *out, size_t n)
+{
+	const float *p = s->p;
+	switch (s->type) {
+	case kSDCircle: sdCircleBatch(px, py, out, n, p[0]); break;
+	case kSDBox: sdBoxBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDBoxLinf: sdBoxLinfBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDRoundedBox: sdRoundedBoxBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4], p[5]); break;
+	case kSDOrientedBox: sdOrientedBoxBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4]); break;
+	case kSDSegment: sdSegmentBatch(px, py, out, n, p[0], p[1], p[2], p[3]); break;
+	case kSDSegmentLinf: sdSegmentLinfBatch(px, py, out, n, p[0], p[1], p[2], p[3]); break;
+	case kSDRhombus: sdRhombusBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDRhombusLinf: sdRhombusLinfBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDTrapezoid: sdTrapezoidBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDParallelogram: sdParallelogramBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDTriangle: sdTriangleBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4], p[5]); break;
+	case kSDTriangleIsosceles: sdTriangleIsoscelesBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDEquilateralTriangle: sdEquilateralTriangleBatch(px, py, out, n, p[0]); break;
+	case kSDQuad: sdQuadBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+	case kSDStar5: sdStar5Batch(px, py, out, n, p[0], p[1]); break;
+	case kSDPentagon: sdPentagonBatch(px, py, out, n, p[0]); break;
+	case kSDHexagon: sdHexagonBatch(px, py, out, n, p[0]); break;
+	case kSDOctagon: sdOctagonBatch(px, py, out, n, p[0]); break;
+	case kSDHexagram: sdHexagramBatch(px, py, out, n, p[0]); break;
+	case kSDPie: sdPieBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDCutDisk: sdCutDiskBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDArc: sdArcBatch(px, py, out, n, p[0], p[1], p[2], p[3]); break;
+	case kSDRing: sdRingBatch(px, py, out, n, p[0], p[1], p[2], p[3]); break;
+	case kSDHorseshoe: sdHorseshoeBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4]); break;
+	case kSDVesica: sdVesicaBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDOrientedVesica: sdOrientedVesicaBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4]); break;
+	case kSDMoon: sdMoonBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDCross: sdCrossBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDRoundedX: sdRoundedXBatch(px, py, out, n, p[0], p[1]); break;
+#ifdef SDF2D_FAST_MATH
+	case kSDParabola:
+	case kSDEllipse:
+	case kSDRegularPolygon:
+	case kSDPolygon:
+		for (size_t i = 0; i < n; i++) out[i] = sdShapeDistance(s, px[i], py[i]);
+		break;
+#else
+	case kSDParabola: sdParabolaBatch(px, py, out, n, p[0]); break;
+	case kSDEllipse: sdEllipseBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDRegularPolygon: sdRegularPolygonBatch(px, py, out, n, p[0], s->n); break;
+	case kSDPolygon: sdPolygonBatch(px, py, out, n, (float *)s->vx, (float *)s->vy, s->n); break;
+#endif
+	case kSDTunnel: sdTunnelBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDEllipseLinf: sdEllipseLinfBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDRoundSquare: sdRoundSquareBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDEgg: sdEggBatch(px, py, out, n, p[0], p[1]); break;
+	case kSDUnevenCapsule: sdUnevenCapsuleBatch(px, py, out, n, p[0], p[1], p[2]); break;
+	case kSDBezier: sdBezierBatch(px, py, out, n, p[0], p[1], p[2], p[3], p[4], p[5], p[6]); break;
+	default: for (size_t i = 0; i < n; i++) out[i] = 1e30f; break;
+	}
+}
+
+static const char *const sdShapeNames[kSDShapeCount] = {
+	[kSDCircle] = "sdCircle", [kSDBox] = "sdBox", [kSDBoxLinf] = "sdBoxLinf",
+	[kSDRoundedBox] = "sdRoundedBox", [kSDOrientedBox] = "sdOrientedBox", [kSDSegment] = "sdSegment",
+	[kSDSegmentLinf] = "sdSegmentLinf", [kSDRhombus] = "sdRhombus", [kSDRhombusLinf] = "sdRhombusLinf",
+	[kSDTrapezoid] = "sdTrapezoid", [kSDParallelogram] = "sdParallelogram", [kSDTriangle] = "sdTriangle",
+	[kSDTriangleIsosceles] = "sdTriangleIsosceles", [kSDEquilateralTriangle] = "sdEquilateralTriangle",
+	[kSDQuad] = "sdQuad", [kSDStar5] = "sdStar5", [kSDPentagon] = "sdPentagon", [kSDHexagon] = "sdHexagon",
+	[kSDOctagon] = "sdOctagon", [kSDHexagram] = "sdHexagram", [kSDPie] = "sdPie", [kSDCutDisk] = "sdCutDisk",
+	[kSDArc] = "sdArc", [kSDRing] = "sdRing", [kSDHorseshoe] = "sdHorseshoe", [kSDVesica] = "sdVesica",
+	[kSDOrientedVesica] = "sdOrientedVesica", [kSDMoon] = "sdMoon", [kSDCross] = "sdCross",
+	[kSDRoundedX] = "sdRoundedX", [kSDParabola] = "sdParabola", [kSDTunnel] = "sdTunnel",
+	[kSDEllipse] = "sdEllipse", [kSDEllipseLinf] = "sdEllipseLinf", [kSDRegularPolygon] = "sdRegularPolygon",
+	[kSDPolygon] = "sdPolygon", [kSDRoundSquare] = "sdRoundSquare", [kSDEgg] = "sdEgg",
+	[kSDUnevenCapsule] = "sdUnevenCapsule", [kSDBezier] = "sdBezier",
+};
+
+const char *sdShapeTypeName(SDShapeType type)
+{
+	return (unsigned)type < kSDShapeCount ? sdShapeNames[type] : "?";
+}
+
+// The entry points, counted per shape type when profiling (sdf2d_profile.h)
+#define SD_SHAPE_COUNTER(s) ((unsigned)(s)->type < kSDShapeCount ? (int)(s)->type : -1)
+
+float sdShapeEval(const SDShape *s, float px, float py)
+{
+	SD_PROFILE_BEGIN(start, SD_SHAPE_COUNTER(s));
+	float d = sdShapeDistance(s, px, py);
+	SD_PROFILE_END(start, SD_SHAPE_COUNTER(s), 1);
+	return d;
+}
+
+float sdShapeEvalGrad(const SDShape *s, float px, float py, float *gx, float *gy)
+{
+	SD_PROFILE_BEGIN(start, SD_SHAPE_COUNTER(s));
+	float d = sdShapeGradient(s, px, py, gx, gy);
+	SD_PROFILE_END(start, SD_SHAPE_COUNTER(s), 1);
+	return d;
+}
+
+void sdShapeEvalBatch(const SDShape *s, const float *px, const float *py, float *out, size_t n)
+{
+	SD_PROFILE_BEGIN(start, SD_SHAPE_COUNTER(s));
+	sdShapeBatch(s, px, py, out, n);
+	SD_PROFILE_END(start, SD_SHAPE_COUNTER(s), (long)n);
+}
+
+static void sdBoundsBox(SDBounds *b, float minx, float miny, float maxx, float maxy)
+{
+	b->minx = minx;
+	b->miny = miny;
+	b->maxx = maxx;
+	b->maxy = maxy;
+}
+
+static void sdBoundsPoints(SDBounds *b, const float *xy, int n, float pad)
+{
+	b->minx = b->maxx = xy[0];
+	b->miny = b->maxy = xy[1];
+	for (int i = 1; i < n; i++) {
+		b->minx = fminf(b->minx, xy[2*i]);
+		b->maxx = fmaxf(b->maxx, xy[2*i]);
+		b->miny = fminf(b->miny, xy[2*i+1]);
+		b->maxy = fmaxf(b->maxy, xy[2*i+1]);
+	}
+	b->minx -= pad;
+	b->miny -= pad;
+	b->maxx += pad;
+	b->maxy += pad;
+}
+
+void sdShapeBounds(const SDShape *s, SDBounds *b)
+{
+	const float *p = s->p;
+	float r;
+	switch (s->type) {
+	case kSDCircle: r = p[0]; break;
+	case kSDBox:
+	case kSDBoxLinf:
+	case kSDRoundedBox:
+	case kSDRhombus:
+	case kSDRhombusLinf:
+	case kSDEllipse:
+	case kSDEllipseLinf: sdBoundsBox(b, -p[0], -p[1], p[0], p[1]); return;
+	case kSDOrientedBox: sdBoundsPoints(b, p, 2, p[4]); return;
+	case kSDSegment:
+	case kSDSegmentLinf: sdBoundsPoints(b, p, 2, 0.0f); return;
+	case kSDTrapezoid: r = fmaxf(p[0], p[1]); sdBoundsBox(b, -r, -p[2], r, p[2]); return;
+	case kSDParallelogram: r = p[0] + fabsf(p[2]); sdBoundsBox(b, -r, -p[1], r, p[1]); return;
+	case kSDTriangle: sdBoundsPoints(b, p, 3, 0.0f); return;
+	case kSDQuad: sdBoundsPoints(b, p, 4, 0.0f); return;
+	case kSDTriangleIsosceles: sdBoundsBox(b, -p[0], fminf(0.0f, p[1]), p[0], fmaxf(0.0f, p[1])); return;
+	case kSDEquilateralTriangle: r = p[0] * 1.1547006f; break;   // circumradius
+	case kSDStar5: {
+		// the inner vertices sit at (0, r) + ba * h, h <= r
+		float bax = 0.587785252f * p[1];
+		float bay = 0.809016994f * p[1] - 1.0f;
+		r = p[0] * (1.0f + sqrtf(bax * bax + bay * bay));
+		break;
+	}
+	case kSDPentagon: r = p[0] * 1.2360680f; break;              // apothem / cos(pi/5)
+	case kSDHexagon: r = p[0] * 1.1547006f; break;               // apothem / cos(pi/6)
+	case kSDOctagon: r = p[0] * 1.0823923f; break;               // apothem / cos(pi/8)
+	case kSDHexagram: r = p[0] * 2.0f; break;
+	case kSDPie: r = p[2]; break;
+	case kSDCutDisk: r = p[0]; break;
+	case kSDArc: r = p[2] + p[3]; break;
+	case kSDRing: r = p[2] + p[3] * 0.5f; break;
+	case kSDHorseshoe: r = p[2] + p[3] + p[4]; break;
+	case kSDVesica: r = p[0]; break;
+	case kSDOrientedVesica: sdBoundsPoints(b, p, 2, p[4]); return;
+	case kSDMoon: r = p[1]; break;
+	case kSDCross: r = fmaxf(p[0], p[1]) + fmaxf(-p[2], 0.0f); break;
+	case kSDRoundedX: r = p[0] * 0.5f + p[1]; break;
+	case kSDParabola: r = SD_BOUNDS_HUGE; break;
+	case kSDTunnel: r = fmaxf(p[0], p[1]); break;
+	case kSDRegularPolygon: r = p[0]; break;
+	case kSDPolygon: {
+		b->minx = b->miny = SD_BOUNDS_HUGE;
+		b->maxx = b->maxy = -SD_BOUNDS_HUGE;
+		for (int i = 0; i < s->n; i++) {
+			b->minx = fminf(b->minx, s->vx[i]);
+			b->maxx = fmaxf(b->maxx, s->vx[i]);
+			b->miny = fminf(b->miny, s->vy[i]);
+			b->maxy = fmaxf(b->maxy, s->vy[i]);
+		}
+		return;
+	}
+	case kSDRoundSquare: r = p[0]; break;
+	case kSDEgg: r = fmaxf(p[0], 1.7320508f * (p[0] - p[1]) + p[1]); break;
+	case kSDUnevenCapsule: r = fmaxf(p[0], p[1]); sdBoundsBox(b, -r, -p[0], r, p[2] + p[1]); return;
+	case kSDBezier: sdBoundsPoints(b, p, 3, p[6]); return;   // the curve lies in its control triangle
+	default: r = SD_BOUNDS_HUGE; break;
+	}
+	sdBoundsBox(b, -r, -r, r, r);
+}
@@ -0,0 +1,79 @@
+#ifndef SDF2D_SHAPE_H
+#define SDF2D_SHAPE_H
+
+#include <stddef.h>
+
+// A primitive from sdf2d.h described as data, so that scenes, broadphases and bakers can hold
+// any shape without function pointers. Parameters are stored in the same order as the arguments
+// of the matching sdf2d.h function, eg { kSDBox, { bx, by } }.
+
+typedef enum {
+	kSDCircle,
+	kSDBox,
+	kSDBoxLinf,
+	kSDRoundedBox,
+	kSDOrientedBox,
+	kSDSegment,
+	kSDSegmentLinf,
+	kSDRhombus,
+	kSDRhombusLinf,
+	kSDTrapezoid,
+	kSDParallelogram,
+	kSDTriangle,
+	kSDTriangleIsosceles,
+	kSDEquilateralTriangle,
+	kSDQuad,
+	kSDStar5,
+	kSDPentagon,
+	kSDHexagon,
+	kSDOctagon,
+	kSDHexagram,
+	kSDPie,
+	kSDCutDisk,
+	kSDArc,
+	kSDRing,
+	kSDHorseshoe,
+	kSDVesica,
+	kSDOrientedVesica,
+	kSDMoon,
+	kSDCross,
+	kSDRoundedX,
+	kSDParabola,
+	kSDTunnel,
+	kSDEllipse,
+	kSDEllipseLinf,
+	kSDRegularPolygon,
+	kSDPolygon,
+	kSDRoundSquare,
+	kSDEgg,
+	kSDUnevenCapsule,
+	kSDBezier,
+	kSDShapeCount
+} SDShapeType;
+
+typedef struct {
+	SDShapeType type;
+	float p[8];          // parameters in sdf2d.h argument order
+	int n;               // sides (sdRegularPolygon) or vertex count (sdPolygon)
+	const float *vx;     // vertices (sdPolygon)
+	const float *vy;
+} SDShape;
+
+typedef struct {
+	float minx, miny;
+	float maxx, maxy;
+} SDBounds;
+
+float sdShapeEval(const SDShape *s, float px, float py);
+float sdShapeEvalGrad(const SDShape *s, float px, float py, float *gx, float *gy);   // see sdgXxx
+void sdShapeEvalBatch(const SDShape *s, const float *px, const float *py, float *out, size_t n);
+
+// Conservative bounds of the surface in the shape's own frame: the distance is > 0 outside them.
+// Unbounded shapes (sdParabola) return +/-SD_BOUNDS_HUGE.
+#define SD_BOUNDS_HUGE 1e30f
+void sdShapeBounds(const SDShape *s, SDBounds *b);
+
+// The sdf2d.h function of a type, eg "sdCircle"; "?" if out of range
+const char *sdShapeTypeName(SDShapeType type);
+
+#endif
@@ -0,0 +1,140 @@
+#include "sdf2d_sweep.h"
+
+#include <math.h>
+
+static int validParams(const SDSweepParams *params)
+{
+	return params && params->epsilon > 0.0f && params->maxSteps > 0 && params->normalStep > 0.0f;
+}
+
+// Normals of the hits by central differences, all four samples of every hit in one sampler call
+static void hitNormals(SDSweepSampler sample, void *ctx, float h, const float *dx, const float *dy,
+	const int *hits, int numHits, SDSweepHit *out, long *steps)
+{
+	float qx[4 * SD_SWEEP_PACKET], qy[4 * SD_SWEEP_PACKET], d[4 * SD_SWEEP_PACKET];
+	for (int j = 0; j < numHits; j++) {
+		const SDSweepHit *o = &out[hits[j]];
+		float *x = qx + 4 * j, *y = qy + 4 * j;
+		x[0] = o->x + h; y[0] = o->y;
+		x[1] = o->x - h; y[1] = o->y;
+		x[2] = o->x;     y[2] = o->y + h;
+		x[3] = o->x;     y[3] = o->y - h;
+	}
+	sample(ctx, qx, qy, d, 4 * numHits);
+	*steps += 4 * numHits;
+
+	for (int j = 0; j < numHits; j++) {
+		int i = hits[j];
+		SDSweepHit *o = &out[i];
+		float gx = d[4 * j] - d[4 * j + 1];
+		float gy = d[4 * j + 2] - d[4 * j + 3];
+		float len = sqrtf(gx * gx + gy * gy);
+		if (len > 0.0f) {
+			o->nx = gx / len;
+			o->ny = gy / len;
+		} else {
+			// on a ridge of the field, eg the middle of a shape: push back against the motion
+			o->nx = -dx[i];
+			o->ny = -dy[i];
+		}
+	}
+}
+
+static int sweepPacket(SDSweepSampler sample, void *ctx, const SDSweepParams *params, const float *x0, const float *y0,
+	const float *x1, const float *y1, const float *r, SDSweepHit *out, int n, SDSweepStats *stats)
+{
+	float len[SD_SWEEP_PACKET], dx[SD_SWEEP_PACKET], dy[SD_SWEEP_PACKET], tt[SD_SWEEP_PACKET], dist[SD_SWEEP_PACKET];
+	float qx[SD_SWEEP_PACKET], qy[SD_SWEEP_PACKET], d[SD_SWEEP_PACKET];
+	int active[SD_SWEEP_PACKET], hits[SD_SWEEP_PACKET];
+	int numActive = n, numHits = 0, unfinished = 0;
+	long steps = 0;
+
+	for (int i = 0; i < n; i++) {
+		float mx = x1[i] - x0[i], my = y1[i] - y0[i];
+		len[i] = sqrtf(mx * mx + my * my);
+		dx[i] = len[i] > 0.0f ? mx / len[i] : 0.0f;
+		dy[i] = len[i] > 0.0f ? my / len[i] : 0.0f;
+		tt[i] = 0.0f;
+		dist[i] = 0.0f;
+		active[i] = i;
+	}
+
+	for (int s = 0; s < params->maxSteps && numActive > 0; s++) {
+		for (int j = 0; j < numActive; j++) {
+			int i = active[j];
+			qx[j] = x0[i] + dx[i] * tt[i];
+			qy[j] = y0[i] + dy[i] * tt[i];
+		}
+		sample(ctx, qx, qy, d, numActive);
+		steps += numActive;
+
+		int kept = 0;
+		for (int j = 0; j < numActive; j++) {
+			int i = active[j];
+			float gap = d[j] - r[i];
+			dist[i] = d[j];
+			if (gap < params->epsilon) {
+				hits[numHits++] = i;
+				continue;
+			}
+			if (tt[i] + gap >= len[i]) {
+				tt[i] = len[i];
+				continue;
+			}
+			if (s + 1 == params->maxSteps) {
+				// out of steps, grazing a surface: stop here, where it is known to be clear, and leave
+				// the rest of the move to the caller; not a contact, so no hit
+				unfinished++;
+				continue;
+			}
+			// nothing is closer than gap, so the circle moves that far untouched
+			tt[i] += gap;
+			active[kept++] = i;
+		}
+		numActive = kept;
+	}
+
+	for (int i = 0; i < n; i++) {
+		SDSweepHit *o = &out[i];
+		o->t = len[i] > 0.0f ? tt[i] / len[i] : 1.0f;
+		o->x = x0[i] + dx[i] * tt[i];
+		o->y = y0[i] + dy[i] * tt[i];
+		o->px = o->py = o->nx = o->ny = o->gap = 0.0f;
+		o->hit = 0;
+	}
+	if (numHits > 0) hitNormals(sample, ctx, params->normalStep, dx, dy, hits, numHits, out, &steps);
+	for (int j = 0; j < numHits; j++) {
+		int i = hits[j];
+		SDSweepHit *o = &out[i];
+		o->hit = 1;
+		o->gap = dist[i] - r[i];
+		o->px = o->x - o->nx * dist[i];
+		o->py = o->y - o->ny * dist[i];
+	}
+
+	if (stats) {
+		stats->sweeps += n;
+		stats->steps += steps;
+		stats->hits += numHits;
+		stats->unfinished += unfinished;
+	}
+	return numHits;
+}
+
+int sdSweepCircles(SDSweepSampler sample, void *ctx, const SDSweepParams *params, const float *x0, const float *y0,
+	const float *x1, const float *y1, const float *r, SDSweepHit *out, size_t n, SDSweepStats *stats)
+{
+	if (!sample || !validParams(params) || !x0 || !y0 || !x1 || !y1 || !r || !out) return -1;
+	int hits = 0;
+	for (size_t i = 0; i < n; i += SD_SWEEP_PACKET) {
+		int m = (n - i < SD_SWEEP_PACKET) ? (int)(n - i) : SD_SWEEP_PACKET;
+		hits += sweepPacket(sample, ctx, params, x0 + i, y0 + i, x1 + i, y1 + i, r + i, out + i, m, stats);
+	}
+	return hits;
+}
+
+int sdSweepCircle(SDSweepSampler sample, void *ctx, const SDSweepParams *params, float x0, float y0, float x1, float y1,
+	float r, SDSweepHit *out, SDSweepStats *stats)
+{
+	return sdSweepCircles(sample, ctx, params, &x0, &y0, &x1, &y1, &r, out, 1, stats);
+}
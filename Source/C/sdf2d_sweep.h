@@ -0,0 +1,68 @@
+#ifndef SDF2D_SWEEP_H
+#define SDF2D_SWEEP_H
+
+// Continuous collision detection for moving circles: the time of impact, contact point and normal
+// of a circle swept from (x0, y0) to (x1, y1) against a shape or a scene.
+//
+//	SDSweepParams params = SD_SWEEP_DEFAULTS;
+//	SDSweepHit hit;
+//	sdSweepCircle(sdTileSampleScene, &scene, &params, x, y, x + vx * dt, y + vy * dt, radius, &hit, NULL);
+//	x = hit.x;
+//	y = hit.y;
+//	if (hit.hit) { ...reflect the velocity about (hit.nx, hit.ny)... }
+//	else if (hit.t < 1.0f) { ...out of steps: sweep the rest of the move next frame... }
+//
+// Conservative advancement: the circle is clear of the surface by the distance at its center minus
+// its radius, so it can move that far along the path without touching anything, and repeats from
+// there. It cannot step through a shape however thin, so one sweep per frame replaces substepping.
+// This relies on the distance never being more than the true distance, which holds for the exact
+// SDFs and for bounds below it (eg the L infinity SDFs, the smooth union), though bounds take more
+// steps.
+// Sliding along a surface closer than a few epsilon takes steps of the gap only; a sweep that runs
+// out of steps there stops short where it is known to be clear, without a hit.
+//
+// Sweeps run in packets: each step evaluates every circle still moving with one sampler call.
+
+#include <stddef.h>
+#include "sdf2d_tiles.h"
+
+#define SD_SWEEP_PACKET 64    // circles in flight per sampler call
+
+// Same as SDGridSampler: out[i] = distance at (px[i], py[i]). sdTileSampleShape and
+// sdTileSampleScene (sdf2d_tiles.h) sample a placed shape and a scene.
+typedef SDTileSampler SDSweepSampler;
+
+typedef struct {
+	float epsilon;       // contact when the gap between the circle and the surface falls below this
+	int maxSteps;        // sampler calls per sweep; a sweep that runs out stops there, not as a hit
+	float normalStep;    // central difference step for the normal
+} SDSweepParams;
+
+#define SD_SWEEP_DEFAULTS { 0.05f, 32, 0.25f }
+
+typedef struct {
+	float t;             // fraction of the move done, in [0, 1]; 1 when clear, below 1 without a hit when out of steps
+	float x, y;          // circle center at t, clear of the surface by at most epsilon
+	float px, py;        // hit: closest surface point to the center
+	float nx, ny;        // hit: unit surface normal there, pointing out of the shape
+	float gap;           // hit: distance from the circle to the surface at t, negative when it starts overlapping
+	int hit;
+} SDSweepHit;
+
+typedef struct {
+	long sweeps;
+	long steps;          // sampler evaluations, normals included
+	long hits;
+	long unfinished;     // sweeps that ran out of steps
+} SDSweepStats;
+
+// Sweep n circles of radius r[i] from (x0[i], y0[i]) to (x1[i], y1[i]). A circle that already
+// overlaps at the start hits at t = 0, with gap the (negative) overlap. stats (may be NULL) is added
+// to. Returns the number of hits, or -1 on bad arguments.
+int sdSweepCircles(SDSweepSampler sample, void *ctx, const SDSweepParams *params, const float *x0, const float *y0,
+	const float *x1, const float *y1, const float *r, SDSweepHit *out, size_t n, SDSweepStats *stats);
+
+int sdSweepCircle(SDSweepSampler sample, void *ctx, const SDSweepParams *params, float x0, float y0, float x1, float y1,
+	float r, SDSweepHit *out, SDSweepStats *stats);
+
+#endif
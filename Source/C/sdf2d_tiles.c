@@ -0,0 +1,137 @@
+// Hierarchical tile culling. See sdf2d_tiles.h.
+
+#include "sdf2d_tiles.h"
+#include <math.h>
+
+#define SD_TILE_LEAF_SAMPLES (SD_TILE_LEAF * SD_TILE_LEAF)
+
+typedef struct {
+	const SDTileLayout *layout;
+	SDTileSampler sample;
+	void *sampleCtx;
+	SDTileVisitor visit;
+	void *visitCtx;
+	SDTileStats stats;
+} SDTileWalker;
+
+void sdTileSampleShape(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	const SDTileShape *c = ctx;
+	float lx[SD_TILE_LEAF_SAMPLES], ly[SD_TILE_LEAF_SAMPLES];
+	for (size_t i = 0; i < n; i += SD_TILE_LEAF_SAMPLES) {
+		size_t m = (n - i < SD_TILE_LEAF_SAMPLES) ? n - i : SD_TILE_LEAF_SAMPLES;
+		for (size_t j = 0; j < m; j++) {
+			lx[j] = px[i + j] - c->x;
+			ly[j] = py[i + j] - c->y;
+		}
+		sdShapeEvalBatch(c->shape, lx, ly, out + i, m);
+	}
+}
+
+void sdTileSampleScene(void *ctx, const float *px, const float *py, float *out, size_t n)
+{
+	sdSceneEvalBatch(ctx, px, py, out, n);
+}
+
+// Split a tile side of n > SD_TILE_LEAF samples at a multiple of SD_TILE_LEAF
+static int sdTileSplit(int n)
+{
+	return (n / 2 + SD_TILE_LEAF - 1) / SD_TILE_LEAF * SD_TILE_LEAF;
+}
+
+static void sdTileLeaf(SDTileWalker *w, SDTile *tile)
+{
+	const SDTileLayout *l = w->layout;
+	float px[SD_TILE_LEAF_SAMPLES], py[SD_TILE_LEAF_SAMPLES], d[SD_TILE_LEAF_SAMPLES];
+	int n = tile->w * tile->h;
+	for (int j = 0; j < tile->h; j++) {
+		for (int i = 0; i < tile->w; i++) {
+			px[j * tile->w + i] = l->x + (tile->x + i) * l->cell;
+			py[j * tile->w + i] = l->y + (tile->y + j) * l->cell;
+		}
+	}
+	w->sample(w->sampleCtx, px, py, d, n);
+	w->stats.samples += n;
+	w->stats.leafTiles++;
+	w->visit(w->visitCtx, tile, d);
+}
+
+static void sdTileVisit(SDTileWalker *w, int x, int y, int tw, int th)
+{
+	const SDTileLayout *l = w->layout;
+	SDTile tile = { x, y, tw, th, 0.0f, 0.0f };
+	if (tw <= SD_TILE_LEAF && th <= SD_TILE_LEAF && tw * th <= 4) {
+		// too small for the center sample to pay off
+		sdTileLeaf(w, &tile);
+		return;
+	}
+	float cx = l->x + (x + 0.5f * (tw - 1)) * l->cell;
+	float cy = l->y + (y + 0.5f * (th - 1)) * l->cell;
+	w->sample(w->sampleCtx, &cx, &cy, &tile.d, 1);
+	w->stats.samples++;
+	tile.r = 0.5f * l->cell * sqrtf((float)((tw - 1) * (tw - 1) + (th - 1) * (th - 1)));
+	if (tile.d - tile.r > l->hi || tile.d + tile.r < l->lo) {
+		w->stats.culled += tw * th;
+		w->stats.uniformTiles++;
+		w->visit(w->visitCtx, &tile, NULL);
+		return;
+	}
+	if (tw <= SD_TILE_LEAF && th <= SD_TILE_LEAF) {
+		sdTileLeaf(w, &tile);
+		return;
+	}
+	int sw = tw > SD_TILE_LEAF ? sdTileSplit(tw) : tw;
+	int sh = th > SD_TILE_LEAF ? sdTileSplit(th) : th;
+	sdTileVisit(w, x, y, sw, sh);
+	if (sw < tw) sdTileVisit(w, x + sw, y, tw - sw, sh);
+	if (sh < th) {
+		sdTileVisit(w, x, y + sh, sw, th - sh);
+		if (sw < tw) sdTileVisit(w, x + sw, y + sh, tw - sw, th - sh);
+	}
+}
+
+int sdTileWalk(const SDTileLayout *layout, SDTileSampler sample, void *sampleCtx, SDTileVisitor visit, void *visitCtx,
+	SDTileStats *stats)
+{
+	if (!layout || !sample || !visit || layout->width <= 0 || layout->height <= 0 || !(layout->cell > 0.0f)) return -1;
+	if (layout->lo > layout->hi) return -1;
+	SDTileWalker w = { layout, sample, sampleCtx, visit, visitCtx, { 0 } };
+	for (int y = 0; y < layout->height; y += SD_TILE_ROOT) {
+		for (int x = 0; x < layout->width; x += SD_TILE_ROOT) {
+			int tw = layout->width - x < SD_TILE_ROOT ? layout->width - x : SD_TILE_ROOT;
+			int th = layout->height - y < SD_TILE_ROOT ? layout->height - y : SD_TILE_ROOT;
+			sdTileVisit(&w, x, y, tw, th);
+		}
+	}
+	if (stats) {
+		stats->samples += w.stats.samples;
+		stats->culled += w.stats.culled;
+		stats->uniformTiles += w.stats.uniformTiles;
+		stats->leafTiles += w.stats.leafTiles;
+	}
+	return 0;
+}
+
+typedef struct {
+	unsigned char *mask;
+	int width;
+	float hi;
+} SDTileMask;
+
+static void sdTileMaskVisit(void *ctx, const SDTile *tile, const float *d)
+{
+	const SDTileMask *m = ctx;
+	for (int j = 0; j < tile->h; j++) {
+		unsigned char *row = m->mask + (size_t)(tile->y + j) * m->width + tile->x;
+		for (int i = 0; i < tile->w; i++) row[i] = (d ? d[j * tile->w + i] : tile->d) <= m->hi;
+	}
+}
+
+int sdTileOccupancy(const SDTileLayout *layout, SDTileSampler sample, void *ctx, unsigned char *mask, SDTileStats *stats)
+{
+	if (!layout || !mask) return -1;
+	SDTileLayout l = *layout;
+	l.lo = l.hi;
+	SDTileMask m = { mask, layout->width, layout->hi };
+	return sdTileWalk(&l, sample, ctx, sdTileMaskVisit, &m, stats);
+}
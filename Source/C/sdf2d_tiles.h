@@ -0,0 +1,75 @@
+#ifndef SDF2D_TILES_H
+#define SDF2D_TILES_H
+
+// Hierarchical tile culling: visits a grid of samples as a quadtree of tiles, evaluating the SDF
+// only where it matters. An SDF changes by at most the distance moved, so one sample at the center
+// of a tile bounds every sample in it to d +/- r, where r is the half diagonal. When that interval
+// lies entirely below or above the band [lo, hi] the caller cares about (the surface for a fill, an
+// outline's width, a grid's clamp range), the whole tile is handed over as one uniform tile. Other
+// tiles are split down to SD_TILE_LEAF x SD_TILE_LEAF leaves, whose samples are evaluated in one
+// batch. Screens that are mostly empty cost a few samples per SD_TILE_ROOT square.
+//
+//	SDTileLayout layout = { 0, 0, 400, 240, 1.0f, 0.0f, 0.0f };
+//	SDTileShape placed = { &shape, 200, 120 };
+//	SDTileStats stats = { 0 };
+//	sdTileWalk(&layout, sdTileSampleShape, &placed, visit, &myState, &stats);
+//
+// The bound holds for every function in sdf2d.h and every scene: all are exact distances or
+// underestimate them (smooth union, the L infinity variants). A custom sampler must not change faster
+// than the distance moved either.
+
+#include <stddef.h>
+#include "sdf2d_shape.h"
+#include "sdf2d_scene.h"
+
+#define SD_TILE_ROOT 64    // samples per side of the top level tiles
+#define SD_TILE_LEAF 8     // samples per side of the smallest tiles, evaluated in full
+
+typedef struct {
+	float x, y;          // world position of sample (0, 0)
+	int width, height;   // samples per row and column
+	float cell;          // sample spacing in world units
+	float lo, hi;        // band of interest: tiles whose distances are all below lo or above hi are uniform
+} SDTileLayout;
+
+typedef struct {
+	int x, y;            // first sample
+	int w, h;            // size in samples
+	float d;             // distance at the center of the tile
+	float r;             // half diagonal: every sample of the tile is within d +/- r
+} SDTile;
+
+typedef struct {
+	long samples;        // SDF evaluations, including tile centers
+	long culled;         // samples covered by uniform tiles, never evaluated
+	long uniformTiles;
+	long leafTiles;
+} SDTileStats;
+
+// Same as SDGridSampler: out[i] = distance at (px[i], py[i]).
+typedef void (*SDTileSampler)(void *ctx, const float *px, const float *py, float *out, size_t n);
+
+// Called once per tile, in quadtree order, so that every sample is visited exactly once. For uniform
+// tiles d is NULL and tile->d is on the same side of the band as every sample; for leaves d holds
+// the w * h distances row by row.
+typedef void (*SDTileVisitor)(void *ctx, const SDTile *tile, const float *d);
+
+// Samplers for a shape placed at (x, y) (ctx: SDTileShape) and for a scene (ctx: SDScene)
+typedef struct {
+	const SDShape *shape;
+	float x, y;
+} SDTileShape;
+
+void sdTileSampleShape(void *ctx, const float *px, const float *py, float *out, size_t n);
+void sdTileSampleScene(void *ctx, const float *px, const float *py, float *out, size_t n);
+
+// Walk the layout. stats (may be NULL) is added to. Returns 0, or -1 on a bad layout.
+int sdTileWalk(const SDTileLayout *layout, SDTileSampler sample, void *sampleCtx, SDTileVisitor visit, void *visitCtx,
+	SDTileStats *stats);
+
+// Occupancy mask: mask[y * width + x] = 1 where the distance is <= layout->hi, else 0. With hi = 0
+// that is the inside of the shapes, with hi = radius every position a circle of that radius would
+// touch them. layout->lo is ignored. Returns 0, or -1 on a bad layout.
+int sdTileOccupancy(const SDTileLayout *layout, SDTileSampler sample, void *ctx, unsigned char *mask, SDTileStats *stats);
+
+#endif
@@ -0,0 +1,177 @@
+#include "sdf2d_world.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef SDF2D_THREADS
+#include <pthread.h>
+#endif
+
+#define WORLD_MAX_THREADS 16
+
+typedef struct {
+	SDWorld *world;
+	int begin, end;
+	int steps;
+	SDWorldStats stats;
+} WorldJob;
+
+static void stepBall(const SDWorld *w, int i, SDWorldStats *stats)
+{
+	const SDWorldParams *p = &w->params;
+	const SDBroadphaseItem *items = w->shapes->items;
+	float x = w->x[i], y = w->y[i], r = w->r[i];
+	float vx = w->vx[i] + p->gravityX * p->dt;
+	float vy = w->vy[i] + p->gravityY * p->dt;
+
+	int ids[SD_WORLD_CONTACTS];
+	int found = sdBroadphaseQueryRadius(w->shapes, x, y, r, ids, NULL, SD_WORLD_CONTACTS);
+	if (found > SD_WORLD_CONTACTS) found = SD_WORLD_CONTACTS;
+	float sumX = 0.0f, sumY = 0.0f;
+	int contacts = 0;
+	for (int k = 0; k < found; k++) {
+		const SDBroadphaseItem *it = &items[ids[k]];
+		// at the current position, which earlier contacts may have moved; the gradient is the normal
+		float gx, gy;
+		float d = sdShapeEvalGrad(&it->shape, x - it->x, y - it->y, &gx, &gy);
+		if (d >= r) continue;
+		float len = sqrtf(gx * gx + gy * gy);
+		if (len <= 0.0f) continue;
+		float nx = gx / len, ny = gy / len;
+		x += nx * (r - d + p->slop);
+		y += ny * (r - d + p->slop);
+		sumX += nx;
+		sumY += ny;
+		contacts++;
+	}
+
+	if (contacts > 0) {
+		float len = sqrtf(sumX * sumX + sumY * sumY);
+		if (len > 0.0f) {
+			float nx = sumX / len, ny = sumY / len;
+			float vn = vx * nx + vy * ny;
+			// only balls moving into the surface bounce; pd_complex.lua also reflects balls that
+			// are already moving away, which keeps resting balls hopping
+			if (vn < 0.0f) {
+				float tx = vx - vn * nx, ty = vy - vn * ny;
+				// slow bounces are stopped, else gravity keeps resting balls hopping by a step
+				float bounce = -vn * p->restitution;
+				if (bounce < p->restSpeed) bounce = 0.0f;
+				vx = tx * (1.0f - p->friction) + bounce * nx;
+				vy = ty * (1.0f - p->friction) + bounce * ny;
+			}
+		}
+		stats->contacts += contacts;
+	}
+
+	w->x[i] = x + vx * p->dt;
+	w->y[i] = y + vy * p->dt;
+	w->vx[i] = vx;
+	w->vy[i] = vy;
+}
+
+static void *runJob(void *arg)
+{
+	WorldJob *job = arg;
+	// each ball runs all its steps in turn: balls do not interact
+	for (int i = job->begin; i < job->end; i++)
+		for (int s = 0; s < job->steps; s++) stepBall(job->world, i, &job->stats);
+	job->stats.steps += (long)(job->end - job->begin) * job->steps;
+	return NULL;
+}
+
+void sdWorldInit(SDWorld *world, const SDBroadphase *shapes, const SDWorldParams *params)
+{
+	world->x = world->y = world->vx = world->vy = world->r = NULL;
+	world->count = world->cap = 0;
+	world->shapes = shapes;
+	world->params = params ? *params : (SDWorldParams)SD_WORLD_DEFAULTS;
+}
+
+void sdWorldFree(SDWorld *world)
+{
+	free(world->x);
+	free(world->y);
+	free(world->vx);
+	free(world->vy);
+	free(world->r);
+	sdWorldInit(world, world->shapes, &world->params);
+}
+
+static int growArray(float **a, int cap)
+{
+	float *p = realloc(*a, cap * sizeof(float));
+	if (!p) return -1;
+	*a = p;
+	return 0;
+}
+
+int sdWorldAdd(SDWorld *world, float x, float y, float vx, float vy, float r)
+{
+	if (world->count == world->cap) {
+		int cap = world->cap ? world->cap * 2 : 64;
+		if (growArray(&world->x, cap) || growArray(&world->y, cap) || growArray(&world->vx, cap)
+			|| growArray(&world->vy, cap) || growArray(&world->r, cap)) return -1;
+		world->cap = cap;
+	}
+	int i = world->count++;
+	world->x[i] = x;
+	world->y[i] = y;
+	world->vx[i] = vx;
+	world->vy[i] = vy;
+	world->r[i] = r;
+	return i;
+}
+
+void sdWorldRemove(SDWorld *world, int i)
+{
+	if (i < 0 || i >= world->count) return;
+	int last = --world->count;
+	world->x[i] = world->x[last];
+	world->y[i] = world->y[last];
+	world->vx[i] = world->vx[last];
+	world->vy[i] = world->vy[last];
+	world->r[i] = world->r[last];
+}
+
+int sdWorldStep(SDWorld *world, int steps, SDWorldStats *stats)
+{
+	const SDWorldParams *p = &world->params;
+	if (!world->shapes || steps < 0 || !(p->dt > 0.0f) || p->threads < 1) return -1;
+
+	WorldJob jobs[WORLD_MAX_THREADS];
+	int threads = 1;
+#ifdef SDF2D_THREADS
+	threads = p->threads < WORLD_MAX_THREADS ? p->threads : WORLD_MAX_THREADS;
+	if (threads > world->count) threads = world->count > 0 ? world->count : 1;
+#endif
+	for (int t = 0; t < threads; t++) {
+		jobs[t].world = world;
+		jobs[t].begin = (int)((long)world->count * t / threads);
+		jobs[t].end = (int)((long)world->count * (t + 1) / threads);
+		jobs[t].steps = steps;
+		jobs[t].stats = (SDWorldStats){ 0 };
+	}
+
+#ifdef SDF2D_THREADS
+	// the caller runs the first range itself
+	pthread_t ids[WORLD_MAX_THREADS];
+	int started[WORLD_MAX_THREADS] = { 0 };
+	for (int t = 1; t < threads; t++) started[t] = pthread_create(&ids[t], NULL, runJob, &jobs[t]) == 0;
+	runJob(&jobs[0]);
+	for (int t = 1; t < threads; t++) {
+		if (started[t]) pthread_join(ids[t], NULL);
+		else runJob(&jobs[t]);
+	}
+#else
+	runJob(&jobs[0]);
+#endif
+
+	if (stats) {
+		for (int t = 0; t < threads; t++) {
+			stats->steps += jobs[t].stats.steps;
+			stats->contacts += jobs[t].stats.contacts;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef SDF2D_WORLD_H
+#define SDF2D_WORLD_H
+
+// Particle world: thousands of balls stepped against static shapes in one call, with the collision
+// response of pd_complex.lua. Each fixed step, per ball:
+// - gravity is added to the velocity
+// - every shape closer than the radius (from the broadphase) pushes the ball out along its normal
+//   (the sdShapeEvalGrad gradient, where pd_complex.lua takes central differences) to slop past
+//   its surface, one shape after the other
+// - if anything was touched and the ball is moving into it, the velocity is split along the average
+//   of the contact normals: the normal part is reflected and scaled by restitution (or stopped when
+//   that is slower than restSpeed), the tangential part scaled by 1 - friction
+// - the ball moves by velocity * dt
+//
+//	SDWorldParams params = SD_WORLD_DEFAULTS;
+//	SDWorld world;
+//	sdWorldInit(&world, &bp, &params);
+//	sdWorldAdd(&world, 40, 20, 0, 50, 3);
+//	sdWorldStep(&world, 4, NULL);   // four fixed steps
+//	... world.x[i], world.y[i] ...
+//	sdWorldFree(&world);
+//
+// Balls are stored as arrays (x[], y[], ...), so they can be drawn or copied without gathering.
+// Balls do not collide with each other, so steps split across threads: build with SDF2D_THREADS
+// (POSIX threads) and set params.threads. Results do not depend on the thread count.
+
+#include "sdf2d_broadphase.h"
+
+#define SD_WORLD_CONTACTS 8   // shapes a ball can touch in one step; further ones are ignored
+
+typedef struct {
+	float gravityX, gravityY; // px / s^2
+	float restitution;        // normal velocity kept after a bounce, 0.65 in pd_complex.lua
+	float friction;           // tangential velocity lost per bounce, 0 to 1
+	float restSpeed;          // bounces slower than this (px / s) stop instead, so balls can rest
+	float slop;               // how far past the surface balls are pushed, 0.05 in pd_complex.lua
+	float dt;                 // seconds per step
+	int threads;              // threads per step with SDF2D_THREADS, else ignored
+} SDWorldParams;
+
+#define SD_WORLD_DEFAULTS { 0.0f, 500.0f, 0.65f, 0.0f, 20.0f, 0.05f, 1.0f / 50.0f, 1 }
+
+typedef struct {
+	long steps;               // ball steps
+	long contacts;            // shapes touched
+} SDWorldStats;
+
+typedef struct {
+	float *x, *y;
+	float *vx, *vy;           // px / s
+	float *r;
+	int count;
+	int cap;
+	const SDBroadphase *shapes;
+	SDWorldParams params;
+} SDWorld;
+
+// shapes must be built and stay alive and unchanged while the world uses it.
+void sdWorldInit(SDWorld *world, const SDBroadphase *shapes, const SDWorldParams *params);
+void sdWorldFree(SDWorld *world);
+
+// Returns the ball index, or -1 on allocation failure.
+int sdWorldAdd(SDWorld *world, float x, float y, float vx, float vy, float r);
+
+// Remove ball i by moving the last ball into its place.
+void sdWorldRemove(SDWorld *world, int i);
+
+// Run steps fixed steps. stats (may be NULL) is added to. Returns 0, or -1 on bad parameters.
+int sdWorldStep(SDWorld *world, int steps, SDWorldStats *stats);
+
+#endif
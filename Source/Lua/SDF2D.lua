@@ -21,6 +21,7 @@ local pow = math.pow
 	- Signed distance functions
 	- Gradient functions
 	- Intersection functions
+	- Shape objects
 --]]
 
 
@@ -116,7 +117,7 @@ function sdRoundedBox(px, py, bx, by, rw, rx, ry, rz) -- b:w,h, r:{tr,br,tl,bl}
 end
 
 function sdRoundSquare(px, py, s, r)
-	local sr = s + r
+	local sr = s - r
 	local qx = ((px >= 0) and px or -px) - sr
 	local qy = ((py >= 0) and py or -py) - sr
 	local mq = ((qx > qy) and qx or qy)
@@ -238,7 +239,7 @@ function sdTriangleIsosceles(px, py, qx, qy)
 	local ax = px - qx * m1
 	local ay = py - qy * m1
 	local c1 = px / qx
-	local m2 = ((c1 < 0) and c1 or 0)
+	local m2 = ((c1 < 1) and c1 or 1)
 	local n = ((0 > m2) and 0 or m2)
 	local bx = px - qx * n
 	local by = py - qy
@@ -520,8 +521,8 @@ end
 -- Ring (https://www.shadertoy.com/view/DsccDH)
 function sdRing(px, py, nx, ny, r, th) -- n:aperture e.g. math.cos(math.pi/2),math.sin(math.pi/2), r:radius, th:thickness
 	px = ((px >= 0) and px or -px)
-	local rx = nx * px + ny * py
-	local ry = -ny * px + nx * py
+	local rx = nx * px - ny * py
+	local ry = ny * px + nx * py
 	px = rx
 	py = ry
 	local l = sqrt(px * px + py * py)
@@ -577,7 +578,7 @@ function sdParabola(px, py, k)
 	local dx = px - x
 	local dy = py - (k * x * x)
 	local d = sqrt(dx * dx + dy * dy)
-	return (px < x) and -d or d
+	return ((py - k * px * px) * k > 0) and -d or d
 end
 
 -- Cross (https://www.shadertoy.com/view/XtGfzw)
@@ -834,6 +835,75 @@ function sdPolygon(px, py, vx, vy, n)
 	return s * sqrt(d)
 end
 
+local function cbrt(x)
+	return x < 0 and -((-x) ^ (1/3)) or x ^ (1/3)
+end
+
+-- A Newton step on dot(v(t), v'(t)) = 0, v(t) = d + (2qa + qb t) t the vector from p to the curve
+local function bezierNewton(t, dx, dy, qax, qay, qbx, qby)
+	local tx = qax+qbx*t
+	local ty = qay+qby*t
+	local vx = dx+(2*qax+qbx*t)*t
+	local vy = dy+(2*qay+qby*t)*t
+	local f = vx*tx+vy*ty
+	local df = 2*(tx*tx+ty*ty)+vx*qbx+vy*qby
+	return (df > 0) and t-f/df or t
+end
+
+-- Quadratic Bezier (https://www.shadertoy.com/view/MlKcDD) from a through control point b to c, th either side
+function sdBezier(px, py, ax, ay, bx, by, cx, cy, th)
+	local qax = bx-ax
+	local qay = by-ay
+	local qbx = ax-2*bx+cx
+	local qby = ay-2*by+cy
+	local dx = ax-px
+	local dy = ay-py
+	local bb = qbx*qbx+qby*qby
+	if bb <= 1e-8*(qax*qax+qay*qay) then -- straight with b halfway: the segment a..c
+		return sdSegment(px, py, ax, ay, cx, cy) - th
+	end
+	local kk = 1/bb
+	local kx = kk*(qax*qbx+qay*qby)
+	local ky = kk*(2*(qax*qax+qay*qay)+dx*qbx+dy*qby)/3
+	local kz = kk*(dx*qax+dy*qay)
+	local p = ky-kx*kx
+	local q = kx*(2*kx*kx-3*ky)+kz
+	local h = q*q+4*p*p*p
+	local t0, t1
+	if h >= 0 then
+		h = sqrt(h)
+		-- the sum of cube roots cancels near the curve, and Lua numbers are floats on the device:
+		-- polish the root before clamping it, as sdf2d.c does
+		t0 = cbrt((h-q)*0.5)+cbrt((-h-q)*0.5)-kx
+		t0 = bezierNewton(t0, dx, dy, qax, qay, qbx, qby)
+		t0 = bezierNewton(t0, dx, dy, qax, qay, qbx, qby)
+		t0 = (t0 < 0) and 0 or (t0 > 1) and 1 or t0
+		t1 = t0
+	else -- three real roots; the third cannot be the closest
+		local z = sqrt(-p)
+		local c = q/(p*z*2)
+		local v = math.acos((c < -1) and -1 or (c > 1) and 1 or c)/3
+		local m = cos(v)
+		local n = sin(v)*1.732050808
+		-- acos loses float precision near -1 and 1, so polish these roots too
+		t0 = (m+m)*z-kx
+		t0 = bezierNewton(t0, dx, dy, qax, qay, qbx, qby)
+		t0 = bezierNewton(t0, dx, dy, qax, qay, qbx, qby)
+		t0 = (t0 < 0) and 0 or (t0 > 1) and 1 or t0
+		t1 = (-n-m)*z-kx
+		t1 = bezierNewton(t1, dx, dy, qax, qay, qbx, qby)
+		t1 = bezierNewton(t1, dx, dy, qax, qay, qbx, qby)
+		t1 = (t1 < 0) and 0 or (t1 > 1) and 1 or t1
+	end
+	local v0x = dx+(2*qax+qbx*t0)*t0
+	local v0y = dy+(2*qay+qby*t0)*t0
+	local v1x = dx+(2*qax+qbx*t1)*t1
+	local v1y = dy+(2*qay+qby*t1)*t1
+	local d0 = v0x*v0x+v0y*v0y
+	local d1 = v1x*v1x+v1y*v1y
+	return sqrt((d0 < d1) and d0 or d1) - th
+end
+
 
 --[[
 	Gradient functions
@@ -917,3 +987,62 @@ function iSegmentEllipse2D(x1, y1, x2, y2, ox, oy, w, h)
 	end
 	return i1x, i1y, i2x, i2y	
 end
+
+
+--[[
+	Shape objects
+--]]
+
+-- A shape placed at x, y with its parameters stored once, so that a query is one call with no
+-- table.unpack and no table built:
+--   local box = SDShape.new("sdBox", 200, 120, 40, 20)
+--   local d, nx, ny = box:distanceGradient(ball.x, ball.y)
+-- The name is one of the functions above, and the parameters are as in that function (at most 8).
+-- When the C bindings of Source/C/sdf2d_lua.c are registered, new returns one of their SDShapeC
+-- objects instead: the same methods, with the SDF and an exact gradient in C. Set SDShape.useC to
+-- false to keep Lua objects.
+SDShape = { useC = true }
+SDShape.__index = SDShape
+
+local eps = 1e-3 -- gradient step: larger than the 1e-4 of the examples, which float rounding blurs at screen scale
+
+local function packFloats(v)
+	if type(v) ~= "table" then return v end
+	return string.pack(string.rep("f", #v), table.unpack(v))
+end
+
+function SDShape.new(name, x, y, ...)
+	if SDShape.useC and SDShapeC then
+		local a, b, c, d, e, f, g, h = ...
+		return SDShapeC.new(name, x, y, packFloats(a), packFloats(b), c, d, e, f, g, h) -- sdPolygon's tables as C arrays
+	end
+	local shape = setmetatable({ ... }, SDShape)
+	shape.sdf = _ENV[name]
+	shape.x, shape.y = x, y
+	return shape
+end
+
+function SDShape:moveTo(x, y)
+	self.x, self.y = x, y
+end
+
+function SDShape:distance(x, y)
+	return self.sdf(x - self.x, y - self.y, self[1], self[2], self[3], self[4], self[5], self[6], self[7], self[8])
+end
+
+-- Unit normal nx, ny at x, y: the direction of the shortest way out, from central differences
+function SDShape:gradient(x, y)
+	local f, px, py = self.sdf, x - self.x, y - self.y
+	local a, b, c, d, e, g, h, k = self[1], self[2], self[3], self[4], self[5], self[6], self[7], self[8]
+	local gx = f(px + eps, py, a, b, c, d, e, g, h, k) - f(px - eps, py, a, b, c, d, e, g, h, k)
+	local gy = f(px, py + eps, a, b, c, d, e, g, h, k) - f(px, py - eps, a, b, c, d, e, g, h, k)
+	local l = sqrt(gx*gx + gy*gy)
+	if l > 0 then return gx/l, gy/l end
+	return 0, 0
+end
+
+-- Distance and unit normal in one call: d, nx, ny
+function SDShape:distanceGradient(x, y)
+	local nx, ny = self:gradient(x, y)
+	return self:distance(x, y), nx, ny
+end
@@ -0,0 +1,483 @@
+#!/usr/bin/env python3
+# Generates Source/C/sdf2d_lua.c, the Playdate Lua bindings of every function in Source/C/sdf2d.h.
+# Run it again after changing sdf2d.h:
+#
+#	python3 Source/Tools/gen_lua_bindings.py
+#
+# For each shape sdXxx in sdf2d.h it binds, as global Lua functions of the same name:
+#	sdXxx(px, py, ...)                  -> d
+#	sdgXxx(px, py, ...)                 -> d, gx, gy
+#	sdXxxBatch(px, py, ...)             -> distances       px, py: packed floats, eg string.pack("fff", ...)
+#	sdXxxGrid(x, y, w, h, cell, ...)    -> distances       w x h samples, row by row, at (x + i * cell, y + j * cell)
+#	sdXxxBitmap(image, ox, oy, ...)                        1-bit fill of image (see sdRasterShapeCulled)
+# and the SDShapeC class, shapes with their parameters kept in C (see sdf2d_lua.h), built from a table
+# of each shape's parameter kinds, with their contours traced by sdf2d_contour.c.
+# where ... are the shape parameters as in sdXxx, and distances are packed floats (string.unpack("f", d, 4 * i + 1)).
+# Array parameters (sdPolygon's vx and vy) are packed floats too, followed by their count.
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'C')
+HEADER = os.path.join(ROOT, 'sdf2d.h')
+OUTPUT = os.path.join(ROOT, 'sdf2d_lua.c')
+
+PROTO = re.compile(r'^(float|void) (sd\w+)\((.*)\);')
+
+
+def parseParams(text):
+	params = []
+	for p in text.split(','):
+		p = p.strip()
+		m = re.match(r'^(const )?(float|int|size_t) (\*)?(\w+)(\[\])?$', p)
+		if not m:
+			sys.exit('gen_lua_bindings: cannot parse parameter "%s"' % p)
+		if m.group(3) or m.group(5):
+			kind = 'array' if m.group(5) else 'pointer'
+		else:
+			kind = m.group(2)
+		params.append((kind, m.group(4)))
+	return params
+
+
+def parseHeader():
+	shapes, grads, batches = {}, {}, {}
+	order = []
+	for line in open(HEADER):
+		m = PROTO.match(line.strip())
+		if not m:
+			continue
+		ret, name, params = m.group(1), m.group(2), parseParams(m.group(3))
+		if name.endswith('Batch'):
+			# (px, py, out, n, shape parameters)
+			batches[name[:-len('Batch')]] = params[4:]
+		elif name.startswith('sdg'):
+			# (px, py, shape parameters, gx, gy)
+			grads['sd' + name[3:]] = params[2:-2]
+		else:
+			# (px, py, shape parameters)
+			shapes[name] = params[2:]
+			order.append(name)
+	for name in order:
+		if name not in grads or name not in batches:
+			sys.exit('gen_lua_bindings: %s has no sdg or Batch variant' % name)
+		if [k for k, _ in shapes[name]] != [k for k, _ in batches[name]]:
+			sys.exit('gen_lua_bindings: %s and %sBatch take different parameters' % (name, name))
+	return [(name, shapes[name], batches[name]) for name in order]
+
+
+class Args:
+	# Shape parameters read from Lua, starting at stack position first. Arrays come as a pair
+	# (vx[], vy[]) followed by their int count, and are copied out of their strings.
+
+	def __init__(self, params, first):
+		self.params = params
+		self.first = first
+		self.arrays = [i for i, (k, _) in enumerate(params) if k == 'array']
+		if self.arrays and (len(self.arrays) != 2 or self.arrays[1] != self.arrays[0] + 1
+				or params[self.arrays[1] + 1][0] != 'int'):
+			sys.exit('gen_lua_bindings: arrays must come as (vx[], vy[], int count)')
+
+	def pos(self, i):
+		return self.first + i
+
+	def count(self):
+		return self.params[self.arrays[1] + 1][1] if self.arrays else None
+
+	def vertexSetup(self):
+		# declares the count; the caller then allocates room for 2 * count more floats
+		if not self.arrays:
+			return []
+		ix, iy = self.arrays
+		return ['\tint %s = vertexCount(%d, %d, pd->lua->getArgInt(%d));' % (self.count(), self.pos(ix), self.pos(iy), self.pos(iy + 1)),
+			'\tif (%s < 1) return 0;' % self.count()]
+
+	def vertexCopy(self, base):
+		if not self.arrays:
+			return []
+		ix, iy = self.arrays
+		vx, vy = self.params[ix][1], self.params[iy][1]
+		return ['\tfloat *%s = %s, *%s = %s + %s;' % (vx, base, vy, vx, self.count()),
+			'\tcopyFloats(%d, %s, %s);' % (self.pos(ix), vx, self.count()),
+			'\tcopyFloats(%d, %s, %s);' % (self.pos(iy), vy, self.count())]
+
+	def vertexFloats(self):
+		return ' + 2 * (size_t)%s' % self.count() if self.arrays else ''
+
+	def locals(self):
+		# the scalar parameters as locals, read once
+		out = []
+		for i, (k, name) in enumerate(self.params):
+			if k == 'float':
+				out.append('\tfloat %s = pd->lua->getArgFloat(%d);' % (name, self.pos(i)))
+			elif k == 'int' and not (self.arrays and i == self.arrays[1] + 1):
+				out.append('\tint %s = pd->lua->getArgInt(%d);' % (name, self.pos(i)))
+		return out
+
+	def names(self):
+		return ', '.join(name for _, name in self.params)
+
+	def inline(self):
+		# the parameters as call arguments, for functions that read each once
+		out = []
+		for i, (k, name) in enumerate(self.params):
+			if k == 'float':
+				out.append('pd->lua->getArgFloat(%d)' % self.pos(i))
+			elif k == 'int' and not (self.arrays and i == self.arrays[1] + 1):
+				out.append('pd->lua->getArgInt(%d)' % self.pos(i))
+			else:
+				out.append(name)
+		return ', '.join(out)
+
+	def shape(self, kind):
+		floats = [name for k, name in self.params if k == 'float']
+		ints = [name for i, (k, name) in enumerate(self.params) if k == 'int']
+		init = '{ %s, { %s }' % (kind, ', '.join(floats) if floats else '0')
+		if ints:
+			init += ', %s' % ints[0]
+		if self.arrays:
+			init += ', %s, %s' % (self.params[self.arrays[0]][1], self.params[self.arrays[1]][1])
+		return init + ' }'
+
+
+def scalar(name, params):
+	args = Args(params, 3)
+	out = ['static int lua_%s(lua_State *L)' % name, '{']
+	if args.arrays:
+		out += args.vertexSetup()
+		out += ['\tfloat *vertices = scratchFloats(2 * (size_t)%s);' % args.count(), '\tif (!vertices) return 0;']
+		out += args.vertexCopy('vertices')
+	out += ['\tpd->lua->pushFloat(%s(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), %s));' % (name, args.inline()),
+		'\treturn 1;', '}']
+	return out
+
+
+def gradient(name, params):
+	args = Args(params, 3)
+	g = 'sdg' + name[2:]
+	out = ['static int lua_%s(lua_State *L)' % g, '{']
+	if args.arrays:
+		out += args.vertexSetup()
+		out += ['\tfloat *vertices = scratchFloats(2 * (size_t)%s);' % args.count(), '\tif (!vertices) return 0;']
+		out += args.vertexCopy('vertices')
+	out += ['\tfloat gx, gy;',
+		'\tpd->lua->pushFloat(%s(pd->lua->getArgFloat(1), pd->lua->getArgFloat(2), %s, &gx, &gy));' % (g, args.inline()),
+		'\tpd->lua->pushFloat(gx);', '\tpd->lua->pushFloat(gy);', '\treturn 3;', '}']
+	return out
+
+
+def batch(name, params):
+	args = Args(params, 3)
+	out = ['static int lua_%sBatch(lua_State *L)' % name, '{',
+		'\tsize_t count = pointCount(1, 2);']
+	out += args.vertexSetup()
+	out += ['\tfloat *xs = scratchFloats(3 * count%s);' % args.vertexFloats(), '\tif (!xs) return 0;',
+		'\tfloat *ys = xs + count, *dist = ys + count;',
+		'\tcopyFloats(1, xs, count);', '\tcopyFloats(2, ys, count);']
+	out += args.vertexCopy('dist + count')
+	out += args.locals()
+	out += ['\t%sBatch(xs, ys, dist, count, %s);' % (name, args.names()),
+		'\tpd->lua->pushBytes((const char *)dist, count * sizeof(float));', '\treturn 1;', '}']
+	return out
+
+
+def grid(name, params):
+	args = Args(params, 6)
+	out = ['static int lua_%sGrid(lua_State *L)' % name, '{',
+		'\tfloat x0 = pd->lua->getArgFloat(1), y0 = pd->lua->getArgFloat(2), cell = pd->lua->getArgFloat(5);',
+		'\tint cols = pd->lua->getArgInt(3), rows = pd->lua->getArgInt(4);',
+		'\tif (cols <= 0 || rows <= 0) return 0;']
+	out += args.vertexSetup()
+	out += ['\tfloat *xs = scratchFloats((size_t)cols * ((size_t)rows + 2)%s);' % args.vertexFloats(), '\tif (!xs) return 0;',
+		'\tfloat *ys = xs + cols, *dist = ys + cols;']
+	out += args.vertexCopy('dist + (size_t)cols * rows')
+	out += args.locals()
+	out += ['\tfor (int i = 0; i < cols; i++) xs[i] = x0 + i * cell;',
+		'\tfor (int j = 0; j < rows; j++) {',
+		'\t\tfor (int i = 0; i < cols; i++) ys[i] = y0 + j * cell;',
+		'\t\t%sBatch(xs, ys, dist + (size_t)j * cols, cols, %s);' % (name, args.names()),
+		'\t}',
+		'\tpd->lua->pushBytes((const char *)dist, (size_t)cols * rows * sizeof(float));', '\treturn 1;', '}']
+	return out
+
+
+def bitmap(name, params):
+	args = Args(params, 4)
+	out = ['static int lua_%sBitmap(lua_State *L)' % name, '{',
+		'\tSDBitmap bm;', '\tif (!argBitmap(1, &bm)) return 0;']
+	if args.arrays:
+		out += args.vertexSetup()
+		out += ['\tfloat *vertices = scratchFloats(2 * (size_t)%s);' % args.count(), '\tif (!vertices) return 0;']
+		out += args.vertexCopy('vertices')
+	out += args.locals()
+	out += ['\tSDShape shape = %s;' % args.shape('kSD' + name[2:]),
+		'\tsdRasterShapeCulled(&bm, &shape, pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), &fill, NULL);',
+		'\treturn 0;', '}']
+	return out
+
+
+PROLOGUE = '''// Generated by Source/Tools/gen_lua_bindings.py from sdf2d.h: do not edit, run
+//	python3 Source/Tools/gen_lua_bindings.py
+// instead.
+
+#include "sdf2d_lua.h"
+#include "sdf2d.h"
+#include "sdf2d_contour.h"
+#include "sdf2d_raster.h"
+
+#include <math.h>
+#include <string.h>
+
+static PlaydateAPI *pd = NULL;
+
+static const SDRasterStyle fill = { kSDRasterFill, 0.0f, 0.0f };
+
+// One buffer for the arrays of a call, kept between calls.
+static float *scratch = NULL;
+static size_t scratchCap = 0;
+
+static float *scratchFloats(size_t n)
+{
+	if (n > scratchCap) {
+		float *p = pd->system->realloc(scratch, n * sizeof(float));
+		if (!p) return NULL;
+		scratch = p;
+		scratchCap = n;
+	}
+	return scratch ? scratch : scratchFloats(1);
+}
+
+// Floats in the packed string at pos, 0 if it is not a string.
+static size_t floatCount(int pos)
+{
+	size_t len = 0;
+	return pd->lua->getArgBytes(pos, &len) ? len / sizeof(float) : 0;
+}
+
+static size_t pointCount(int xpos, int ypos)
+{
+	size_t nx = floatCount(xpos), ny = floatCount(ypos);
+	return nx < ny ? nx : ny;
+}
+
+static int vertexCount(int xpos, int ypos, int count)
+{
+	size_t n = pointCount(xpos, ypos);
+	return count < 0 ? 0 : (size_t)count > n ? (int)n : count;
+}
+
+// Lua strings need not be aligned for floats, so they are copied out.
+static void copyFloats(int pos, float *dst, size_t n)
+{
+	size_t len = 0;
+	const char *bytes = pd->lua->getArgBytes(pos, &len);
+	if (n) memcpy(dst, bytes, n * sizeof(float));
+}
+
+static int argBitmap(int pos, SDBitmap *bm)
+{
+	LCDBitmap *img = pd->lua->getBitmap(pos);
+	if (!img) return 0;
+	uint8_t *mask = NULL;
+	pd->graphics->getBitmapData(img, &bm->width, &bm->height, &bm->rowbytes, &mask, &bm->data);
+	return bm->data != NULL;
+}
+'''
+
+
+SHAPE_CLASS = '''
+#define SHAPE_CLASS "SDShapeC"
+
+typedef struct {
+	SDShape shape;
+	float x, y;
+	float vertices[];          // sdPolygon: vx, then vy
+} LuaShape;
+
+// SDShapeC.new(name, x, y, ...): the sdf2d.h shape name (eg "sdBox") placed at x, y, with the
+// parameters of that function
+static int shapeNew(lua_State *L)
+{
+	const char *name = pd->lua->getArgString(1);
+	size_t t = 0, types = sizeof(shapeTypes) / sizeof(shapeTypes[0]);
+	while (t < types && !(name && strcmp(name, shapeTypes[t].name) == 0)) t++;
+	if (t == types) return 0;
+	const char *params = shapeTypes[t].params, *array = strchr(params, 'a');
+	int count = 0, apos = array ? 4 + (int)(array - params) : 0;
+	if (array) {
+		count = vertexCount(apos, apos + 1, pd->lua->getArgInt(apos + 2));
+		if (count < 1) return 0;
+	}
+	LuaShape *s = pd->system->realloc(NULL, sizeof(LuaShape) + 2 * (size_t)count * sizeof(float));
+	if (!s) return 0;
+	memset(s, 0, sizeof(LuaShape));
+	s->shape.type = shapeTypes[t].type;
+	s->x = pd->lua->getArgFloat(2);
+	s->y = pd->lua->getArgFloat(3);
+	for (int k = 0, floats = 0; params[k]; k++) {
+		if (params[k] == 'f') s->shape.p[floats++] = pd->lua->getArgFloat(4 + k);
+		else if (params[k] == 'i') s->shape.n = array ? count : pd->lua->getArgInt(4 + k);
+	}
+	if (array) {
+		copyFloats(apos, s->vertices, count);
+		copyFloats(apos + 1, s->vertices + count, count);
+		s->shape.vx = s->vertices;
+		s->shape.vy = s->vertices + count;
+	}
+	pd->lua->pushObject(s, SHAPE_CLASS, 0);
+	return 1;
+}
+
+static LuaShape *argShape(void)
+{
+	return pd->lua->getArgObject(1, SHAPE_CLASS, NULL);
+}
+
+static int shapeGC(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (s) pd->system->realloc(s, 0);
+	return 0;
+}
+
+// shape:moveTo(x, y)
+static int shapeMoveTo(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	s->x = pd->lua->getArgFloat(2);
+	s->y = pd->lua->getArgFloat(3);
+	return 0;
+}
+
+// shape:distance(x, y) -> d
+static int shapeDistance(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	pd->lua->pushFloat(sdShapeEval(&s->shape, pd->lua->getArgFloat(2) - s->x, pd->lua->getArgFloat(3) - s->y));
+	return 1;
+}
+
+// The distance at the point of arguments 2 and 3, and the unit gradient there: the direction of the
+// shortest way out.
+static float shapeNormal(const LuaShape *s, float *nx, float *ny)
+{
+	float d = sdShapeEvalGrad(&s->shape, pd->lua->getArgFloat(2) - s->x, pd->lua->getArgFloat(3) - s->y, nx, ny);
+	float len = sqrtf(*nx * *nx + *ny * *ny);
+	if (len > 0.0f) {
+		*nx /= len;
+		*ny /= len;
+	}
+	return d;
+}
+
+// shape:gradient(x, y) -> nx, ny
+static int shapeGradient(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	float nx, ny;
+	shapeNormal(s, &nx, &ny);
+	pd->lua->pushFloat(nx);
+	pd->lua->pushFloat(ny);
+	return 2;
+}
+
+// shape:distanceGradient(x, y) -> d, nx, ny
+static int shapeDistanceGradient(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	float nx, ny;
+	pd->lua->pushFloat(shapeNormal(s, &nx, &ny));
+	pd->lua->pushFloat(nx);
+	pd->lua->pushFloat(ny);
+	return 3;
+}
+
+// shape:contour(x, y, width, height, cell, tolerance) -> xy, starts: the surface traced by
+// sdContourShape on width x height samples from x, y, cell apart (1 if left out). xy is the vertices
+// as packed floats x1, y1, x2, y2, ...; starts packed ints, polyline i running from vertex starts[i]
+// up to starts[i + 1], as in SDContours. The contours are kept between calls.
+static SDContours contours;
+static int contoursReady = 0;
+
+static int shapeContour(lua_State *L)
+{
+	LuaShape *s = argShape();
+	if (!s) return 0;
+	if (!contoursReady) {
+		sdContoursInit(&contours);
+		contoursReady = 1;
+	}
+	float cell = pd->lua->getArgFloat(6);
+	SDContourLayout layout = { pd->lua->getArgFloat(2), pd->lua->getArgFloat(3), pd->lua->getArgInt(4),
+		pd->lua->getArgInt(5), cell > 0.0f ? cell : 1.0f, 0.0f, pd->lua->getArgFloat(7) };
+	if (sdContourShape(&contours, &layout, &s->shape, s->x, s->y, NULL) < 0) return 0;
+	float *xy = scratchFloats(2 * (size_t)contours.vertices);
+	if (!xy) return 0;
+	for (int v = 0; v < contours.vertices; v++) {
+		xy[2 * v] = contours.x[v];
+		xy[2 * v + 1] = contours.y[v];
+	}
+	pd->lua->pushBytes((const char *)xy, 2 * (size_t)contours.vertices * sizeof(float));
+	pd->lua->pushBytes((const char *)contours.start, ((size_t)contours.count + 1) * sizeof(int));
+	return 2;
+}
+
+static const lua_reg shapeClass[] = {
+	{ "new", shapeNew },
+	{ "__gc", shapeGC },
+	{ "moveTo", shapeMoveTo },
+	{ "distance", shapeDistance },
+	{ "gradient", shapeGradient },
+	{ "distanceGradient", shapeDistanceGradient },
+	{ "contour", shapeContour },
+	{ NULL, NULL },
+};
+'''
+
+
+def main():
+	shapes = parseHeader()
+	lines = PROLOGUE.split('\n')
+	for name, params, batchParams in shapes:
+		for gen, p in ((scalar, params), (gradient, params), (batch, batchParams), (grid, batchParams), (bitmap, params)):
+			lines += [''] + gen(name, p)
+	kinds = {'float': 'f', 'int': 'i', 'array': 'a'}
+	lines += ['', '// sdf2d.h parameters of each shape: f a float, i an int, a an array of floats',
+		'static const struct {', '\tconst char *name;', '\tSDShapeType type;', '\tconst char *params;', '} shapeTypes[] = {']
+	for name, params, _ in shapes:
+		lines.append('\t{ "%s", kSD%s, "%s" },' % (name, name[2:], ''.join(kinds[k] for k, _ in params)))
+	lines += ['};']
+	lines += SHAPE_CLASS.split('\n')
+	lines += ['', 'static const struct {', '\tlua_CFunction func;', '\tconst char *name;', '} functions[] = {']
+	for name, _, _ in shapes:
+		for lua in (name, 'sdg' + name[2:], name + 'Batch', name + 'Grid', name + 'Bitmap'):
+			lines.append('\t{ lua_%s, "%s" },' % (lua, lua))
+	lines += ['};', '',
+		'int sdLuaRegister(PlaydateAPI *playdate)',
+		'{',
+		'\tconst char *err;',
+		'\tint result = 0;',
+		'\tpd = playdate;',
+		'\tfor (size_t i = 0; i < sizeof(functions) / sizeof(functions[0]); i++) {',
+		'\t\tif (!pd->lua->addFunction(functions[i].func, functions[i].name, &err)) {',
+		'\t\t\tpd->system->logToConsole("sdLuaRegister: %s: %s", functions[i].name, err);',
+		'\t\t\tresult = -1;',
+		'\t\t}',
+		'\t}',
+		'\tif (!pd->lua->registerClass(SHAPE_CLASS, shapeClass, NULL, 0, &err)) {',
+		'\t\tpd->system->logToConsole("sdLuaRegister: %s: %s", SHAPE_CLASS, err);',
+		'\t\tresult = -1;',
+		'\t}',
+		'\treturn result;',
+		'}', '']
+	with open(OUTPUT, 'w') as f:
+		f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+	main()